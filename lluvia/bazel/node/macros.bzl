@@ -60,6 +60,7 @@ def ll_node_library(
         name,
         nodes = [],
         strip_prefix = "",
+        compression_type = "stored",
         visibility = None):
     """
     Declares a node library
@@ -68,6 +69,9 @@ def ll_node_library(
         name: name of the library
         nodes: list of ll_node targets
         strip_prefix:
+        compression_type: zip compression of the library entries, either
+            "stored" or "deflated". Stored entries are read in place from
+            the memory mapped library at runtime.
         visibility: library visibility
     """
 
@@ -75,5 +79,6 @@ def ll_node_library(
         name = name,
         strip_prefix = strip_prefix,
         srcs = nodes,
+        compression_type = compression_type,
         visibility = visibility,
     )
@@ -0,0 +1,142 @@
+/**
+@file       frame_processor_benchmark.cpp
+@brief      Measures the throughput of a node streaming synthetic frames through ll::FrameProcessor.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include <lluvia/core.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const auto USAGE = R"(usage: frame_processor_benchmark <library> <builder> [options]
+
+options:
+    --width=<int>       frame width, default 640.
+    --height=<int>      frame height, default 480.
+    --channels=<1|2|4>  channel count of the uint8 input frames, default 1.
+    --frames=<int>      number of frames to process, default 500.
+    --in_flight=<int>   number of frames in flight, default 2.
+    --in_port=<name>    input port of the node, default in_image.
+    --out_port=<name>   output port of the node, default out_image.
+)";
+
+std::map<std::string, std::string> parseOptions(int argc, char const* argv[])
+{
+
+    auto options = std::map<std::string, std::string> {
+        {"width", "640"},
+        {"height", "480"},
+        {"channels", "1"},
+        {"frames", "500"},
+        {"in_flight", "2"},
+        {"in_port", "in_image"},
+        {"out_port", "out_image"}};
+
+    for (auto i = 3; i < argc; ++i) {
+
+        const auto arg = std::string {argv[i]};
+        const auto eq  = arg.find('=');
+
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos || options.find(arg.substr(2, eq - 2)) == options.end()) {
+            throw std::invalid_argument {"unknown option: " + arg};
+        }
+
+        options[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+    }
+
+    return options;
+}
+
+uint32_t toUint32(const std::string& value)
+{
+    return static_cast<uint32_t>(std::stoul(value));
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+
+    if (argc < 3) {
+        std::cerr << USAGE;
+        return EXIT_FAILURE;
+    }
+
+    auto options = std::map<std::string, std::string> {};
+    try {
+        options = parseOptions(argc, argv);
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl
+                  << USAGE;
+        return EXIT_FAILURE;
+    }
+
+    const auto width      = toUint32(options["width"]);
+    const auto height     = toUint32(options["height"]);
+    const auto frameCount = toUint32(options["frames"]);
+
+    auto session = ll::Session::create();
+    session->loadLibrary(argv[1]);
+
+    const auto desc = ll::FrameProcessorDescriptor {}
+                          .setBuilderName(argv[2])
+                          .setInputPort(options["in_port"])
+                          .setOutputPort(options["out_port"])
+                          .setImageDescriptor(ll::ImageDescriptor {1, height, width,
+                              ll::castChannelCount(toUint32(options["channels"])), ll::ChannelType::Uint8})
+                          .setInFlightCount(toUint32(options["in_flight"]));
+
+    auto processor = session->createFrameProcessor(desc);
+
+    // a handful of distinct frames is enough to keep the host side realistic
+    auto frames = std::vector<std::vector<uint8_t>>(4, std::vector<uint8_t>(processor->getInputSize()));
+    for (auto f = 0u; f < frames.size(); ++f) {
+        for (auto i = 0u; i < frames[f].size(); ++i) {
+            frames[f][i] = static_cast<uint8_t>((i * 7919u + f * 31u) % 251u);
+        }
+    }
+
+    auto output = std::vector<uint8_t>(processor->getOutputSize());
+
+    auto nodeTime = std::chrono::nanoseconds {0};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto f = 0u; f < frameCount; ++f) {
+        if (processor->isFull()) {
+            processor->pop(output.data());
+            nodeTime += processor->getLastFrameDuration();
+        }
+
+        processor->push(frames[f % frames.size()].data());
+    }
+
+    while (processor->getPendingFrameCount() > 0) {
+        processor->pop(output.data());
+        nodeTime += processor->getLastFrameDuration();
+    }
+
+    const auto elapsed   = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+    const auto nodeMs    = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(nodeTime).count();
+    const auto frameRate = frameCount / elapsed.count();
+
+    std::cout << "builder:         " << argv[2] << std::endl;
+    std::cout << "resolution:      " << width << "x" << height << std::endl;
+    std::cout << "frames:          " << frameCount << std::endl;
+    std::cout << "in flight:       " << desc.getInFlightCount() << std::endl;
+    std::cout << "total time:      " << elapsed.count() << " s" << std::endl;
+    std::cout << "throughput:      " << frameRate << " frames/s" << std::endl;
+    std::cout << "mean node time:  " << (frameCount > 0 ? nodeMs / frameCount : 0.0) << " ms" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,678 @@
+/**
+@file       lluvia_bench.cpp
+@brief      Headless runner measuring the throughput of a node from a node library.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include <lluvia/core.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const auto USAGE = R"(usage: lluvia-bench --library=<path> --builder=<name> [options]
+
+Creates a node with the given builder, binds an input image to it and runs it
+warmup + iterations times, each on its own command buffer. Results are printed
+as JSON.
+
+options:
+    --library=<path>        node library to load (.zip).
+    --builder=<name>        node builder, compute or container.
+    --input=<source>        'synthetic' (default), a .pgm file (P5) or a .y4m file.
+                            For files, the resolution and format are taken from
+                            the file and only the luma plane of Y4M frames is used.
+    --width=<int>           width of synthetic frames, default 640.
+    --height=<int>          height of synthetic frames, default 480.
+    --channels=<1|2|4>      channel count of synthetic frames, default 1.
+    --channel_type=<type>   channel type of synthetic frames (Uint8, Uint16,
+                            Float16, Float32, ...), default Uint8.
+    --in_port=<name>        input port of the node, default in_image.
+    --param=<name>=<value>  node parameter, can be repeated. Values are parsed
+                            as int, then float, then kept as string.
+    --warmup=<int>          iterations not included in the results, default 10.
+    --iterations=<int>      measured iterations, default 100.
+    --device=<id|type>      device id or device type (DiscreteGPU, IntegratedGPU,
+                            VirtualGPU, CPU). Use CPU to select a software ICD
+                            such as lavapipe or SwiftShader.
+    --output=<path>         write the JSON report to a file instead of stdout.
+)";
+
+struct Options {
+    std::string library;
+    std::string builder;
+    std::string input {"synthetic"};
+    std::string inPort {"in_image"};
+    std::string device;
+    std::string output;
+
+    uint32_t width {640};
+    uint32_t height {480};
+    uint32_t channels {1};
+    uint32_t warmup {10};
+    uint32_t iterations {100};
+
+    ll::ChannelType channelType {ll::ChannelType::Uint8};
+
+    std::vector<std::pair<std::string, std::string>> parameters;
+};
+
+struct Frames {
+    ll::ImageDescriptor               descriptor;
+    std::vector<std::vector<uint8_t>> data;
+};
+
+/**
+Timing of one iteration, in milliseconds.
+*/
+struct Sample {
+    double gpu;
+    double record;
+    double latency;
+};
+
+Options parseOptions(int argc, char const* argv[])
+{
+
+    auto options = Options {};
+
+    for (auto i = 1; i < argc; ++i) {
+
+        const auto arg = std::string {argv[i]};
+        const auto eq  = arg.find('=');
+
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            throw std::invalid_argument {"invalid argument: " + arg};
+        }
+
+        const auto key   = arg.substr(2, eq - 2);
+        const auto value = arg.substr(eq + 1);
+
+        if (key == "library") {
+            options.library = value;
+        } else if (key == "builder") {
+            options.builder = value;
+        } else if (key == "input") {
+            options.input = value;
+        } else if (key == "in_port") {
+            options.inPort = value;
+        } else if (key == "device") {
+            options.device = value;
+        } else if (key == "output") {
+            options.output = value;
+        } else if (key == "width") {
+            options.width = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "height") {
+            options.height = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "channels") {
+            options.channels = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "channel_type") {
+            options.channelType = ll::stringToChannelType(value);
+        } else if (key == "warmup") {
+            options.warmup = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "iterations") {
+            options.iterations = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "param") {
+
+            const auto paramEq = value.find('=');
+            if (paramEq == std::string::npos) {
+                throw std::invalid_argument {"parameter must be <name>=<value>: " + value};
+            }
+
+            options.parameters.emplace_back(value.substr(0, paramEq), value.substr(paramEq + 1));
+        } else {
+            throw std::invalid_argument {"unknown option: " + arg};
+        }
+    }
+
+    if (options.library.empty() || options.builder.empty()) {
+        throw std::invalid_argument {"--library and --builder are required"};
+    }
+
+    if (options.iterations == 0) {
+        throw std::invalid_argument {"--iterations must be greater than zero"};
+    }
+
+    return options;
+}
+
+ll::Parameter parseParameter(const std::string& value)
+{
+
+    auto param = ll::Parameter {};
+    auto pos   = size_t {0};
+
+    try {
+        const auto intValue = std::stoi(value, &pos);
+        if (pos == value.size()) {
+            param.set(intValue);
+            return param;
+        }
+    } catch (std::exception&) {
+    }
+
+    try {
+        const auto floatValue = std::stof(value, &pos);
+        if (pos == value.size()) {
+            param.set(floatValue);
+            return param;
+        }
+    } catch (std::exception&) {
+    }
+
+    param.set(value);
+    return param;
+}
+
+/**
+Fills the frame with a deterministic pattern valid for the channel type, floating
+point frames contain values in [0, 1).
+*/
+std::vector<uint8_t> createSyntheticFrame(const ll::ImageDescriptor& desc, const uint32_t index)
+{
+
+    auto frame = std::vector<uint8_t>(desc.getSize());
+
+    const auto elementCount = uint64_t {desc.getWidth()} * desc.getHeight() * desc.getDepth() * desc.getChannelCount<uint32_t>();
+
+    for (auto i = uint64_t {0}; i < elementCount; ++i) {
+
+        const auto value = static_cast<uint32_t>((i * 7919u + index * 31u) % 251u);
+
+        switch (desc.getChannelType()) {
+        case ll::ChannelType::Uint8:
+        case ll::ChannelType::Int8:
+            frame[i] = static_cast<uint8_t>(value);
+            break;
+        case ll::ChannelType::Uint16:
+        case ll::ChannelType::Int16:
+            reinterpret_cast<uint16_t*>(frame.data())[i] = static_cast<uint16_t>(value);
+            break;
+        case ll::ChannelType::Float16:
+            // half precision values in [0.5, 1)
+            reinterpret_cast<uint16_t*>(frame.data())[i] = static_cast<uint16_t>(0x3800u | (value << 2));
+            break;
+        case ll::ChannelType::Uint32:
+        case ll::ChannelType::Int32:
+            reinterpret_cast<uint32_t*>(frame.data())[i] = value;
+            break;
+        case ll::ChannelType::Float32:
+            reinterpret_cast<float*>(frame.data())[i] = static_cast<float>(value) / 251.0f;
+            break;
+        default:
+            throw std::invalid_argument {"unsupported channel type for synthetic frames: " + ll::channelTypeToString(desc.getChannelType())};
+        }
+    }
+
+    return frame;
+}
+
+std::string readHeaderToken(std::istream& stream)
+{
+
+    auto token = std::string {};
+
+    while (stream) {
+        const auto c = stream.get();
+
+        if (c == '#' && token.empty()) {
+            stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        } else if (std::isspace(c) || c == EOF) {
+            if (!token.empty()) {
+                return token;
+            }
+        } else {
+            token.push_back(static_cast<char>(c));
+        }
+    }
+
+    return token;
+}
+
+Frames readPGM(const std::string& path)
+{
+
+    auto file = std::ifstream {path, std::ios::binary};
+    if (!file) {
+        throw std::invalid_argument {"error opening file: " + path};
+    }
+
+    if (readHeaderToken(file) != "P5") {
+        throw std::invalid_argument {"only binary PGM files (P5) are supported: " + path};
+    }
+
+    const auto width  = static_cast<uint32_t>(std::stoul(readHeaderToken(file)));
+    const auto height = static_cast<uint32_t>(std::stoul(readHeaderToken(file)));
+    const auto maxVal = std::stoul(readHeaderToken(file));
+
+    const auto channelType = maxVal < 256 ? ll::ChannelType::Uint8 : ll::ChannelType::Uint16;
+
+    auto frames       = Frames {};
+    frames.descriptor = ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, channelType};
+
+    auto frame = std::vector<uint8_t>(frames.descriptor.getSize());
+    file.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(frame.size()));
+    if (!file) {
+        throw std::invalid_argument {"truncated PGM file: " + path};
+    }
+
+    // 16-bit PGM samples are big endian
+    if (channelType == ll::ChannelType::Uint16) {
+        for (auto i = size_t {0}; i < frame.size(); i += 2) {
+            std::swap(frame[i], frame[i + 1]);
+        }
+    }
+
+    frames.data.push_back(std::move(frame));
+    return frames;
+}
+
+Frames readY4M(const std::string& path, const uint32_t maxFrames)
+{
+
+    auto file = std::ifstream {path, std::ios::binary};
+    if (!file) {
+        throw std::invalid_argument {"error opening file: " + path};
+    }
+
+    auto header = std::string {};
+    std::getline(file, header);
+
+    auto headerStream = std::istringstream {header};
+    auto tag          = std::string {};
+    headerStream >> tag;
+
+    if (tag != "YUV4MPEG2") {
+        throw std::invalid_argument {"invalid Y4M header: " + path};
+    }
+
+    auto width      = uint32_t {0};
+    auto height     = uint32_t {0};
+    auto colorSpace = std::string {"420"};
+
+    while (headerStream >> tag) {
+        switch (tag[0]) {
+        case 'W':
+            width = static_cast<uint32_t>(std::stoul(tag.substr(1)));
+            break;
+        case 'H':
+            height = static_cast<uint32_t>(std::stoul(tag.substr(1)));
+            break;
+        case 'C':
+            colorSpace = tag.substr(1);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (width == 0 || height == 0) {
+        throw std::invalid_argument {"Y4M header without width or height: " + path};
+    }
+
+    const auto lumaSize = uint64_t {width} * height;
+
+    auto chromaSize = 2 * uint64_t {(width + 1) / 2} * ((height + 1) / 2);
+    if (colorSpace.rfind("mono", 0) == 0) {
+        chromaSize = 0;
+    } else if (colorSpace.rfind("444", 0) == 0) {
+        chromaSize = 2 * lumaSize;
+    } else if (colorSpace.rfind("422", 0) == 0) {
+        chromaSize = 2 * uint64_t {(width + 1) / 2} * height;
+    } else if (colorSpace.rfind("420", 0) != 0) {
+        throw std::invalid_argument {"unsupported Y4M color space " + colorSpace + ": " + path};
+    }
+
+    if (colorSpace.find("p10") != std::string::npos || colorSpace.find("p12") != std::string::npos) {
+        throw std::invalid_argument {"only 8-bit Y4M files are supported: " + path};
+    }
+
+    auto frames       = Frames {};
+    frames.descriptor = ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, ll::ChannelType::Uint8};
+
+    auto frameHeader = std::string {};
+    while (frames.data.size() < maxFrames && std::getline(file, frameHeader)) {
+
+        if (frameHeader.rfind("FRAME", 0) != 0) {
+            throw std::invalid_argument {"invalid Y4M frame header: " + path};
+        }
+
+        auto frame = std::vector<uint8_t>(lumaSize);
+        file.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(lumaSize));
+        file.ignore(static_cast<std::streamsize>(chromaSize));
+
+        if (!file) {
+            break;
+        }
+
+        frames.data.push_back(std::move(frame));
+    }
+
+    if (frames.data.empty()) {
+        throw std::invalid_argument {"Y4M file without complete frames: " + path};
+    }
+
+    return frames;
+}
+
+Frames loadFrames(const Options& options)
+{
+
+    const auto hasExtension = [&options](const std::string& ext) {
+        return options.input.size() >= ext.size() && options.input.compare(options.input.size() - ext.size(), ext.size(), ext) == 0;
+    };
+
+    if (options.input == "synthetic") {
+
+        auto frames       = Frames {};
+        frames.descriptor = ll::ImageDescriptor {1, options.height, options.width, ll::castChannelCount(options.channels), options.channelType};
+
+        // a few distinct frames keep the caches from holding a single input
+        for (auto i = 0u; i < 4; ++i) {
+            frames.data.push_back(createSyntheticFrame(frames.descriptor, i));
+        }
+
+        return frames;
+    }
+
+    if (hasExtension(".pgm")) {
+        return readPGM(options.input);
+    }
+
+    if (hasExtension(".y4m")) {
+        return readY4M(options.input, std::max(1u, std::min(options.warmup + options.iterations, 64u)));
+    }
+
+    throw std::invalid_argument {"unknown input, use synthetic, a .pgm or a .y4m file: " + options.input};
+}
+
+std::shared_ptr<ll::Session> createSession(const Options& options)
+{
+
+    if (options.device.empty()) {
+        return ll::Session::create();
+    }
+
+    const auto devices = ll::Session::getAvailableDevices();
+
+    const auto isId = std::all_of(options.device.cbegin(), options.device.cend(), [](const char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+
+    const auto it = std::find_if(devices.cbegin(), devices.cend(), [&options, isId](const ll::DeviceDescriptor& device) {
+        return isId ? device.id == std::stoul(options.device) : device.deviceType == ll::stringToDeviceType(options.device);
+    });
+
+    if (it == devices.cend()) {
+        throw std::invalid_argument {"device not found: " + options.device};
+    }
+
+    return ll::Session::create(ll::SessionDescriptor().setDeviceDescriptor(*it));
+}
+
+std::shared_ptr<ll::Node> createNode(ll::Session& session, const std::string& builderName)
+{
+
+    const auto builders = session.getNodeBuilderDescriptors();
+
+    const auto it = std::find_if(builders.cbegin(), builders.cend(), [&builderName](const auto& builder) {
+        return builder.name == builderName;
+    });
+
+    if (it == builders.cend()) {
+        throw std::invalid_argument {"node builder not found: " + builderName};
+    }
+
+    if (it->nodeType == ll::NodeType::Container) {
+        return session.createContainerNode(builderName);
+    }
+
+    return session.createComputeNode(builderName);
+}
+
+std::string escapeJSON(const std::string& value)
+{
+
+    auto out = std::ostringstream {};
+    for (const auto c : value) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            } else {
+                out << c;
+            }
+        }
+    }
+
+    return out.str();
+}
+
+/**
+Writes min, max, mean and nearest-rank percentiles of the values.
+*/
+void writeStatistics(std::ostream& out, std::vector<double> values)
+{
+
+    std::sort(values.begin(), values.end());
+
+    const auto percentile = [&values](const double p) {
+        const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(values.size())));
+        return values[std::max<size_t>(rank, 1) - 1];
+    };
+
+    const auto mean = std::accumulate(values.cbegin(), values.cend(), 0.0) / static_cast<double>(values.size());
+
+    out << "{\"min\": " << values.front()
+        << ", \"max\": " << values.back()
+        << ", \"mean\": " << mean
+        << ", \"p50\": " << percentile(50)
+        << ", \"p90\": " << percentile(90)
+        << ", \"p95\": " << percentile(95)
+        << ", \"p99\": " << percentile(99)
+        << "}";
+}
+
+void writeSamples(std::ostream& out, const std::vector<Sample>& samples, double Sample::*field)
+{
+
+    out << "[";
+    for (auto i = size_t {0}; i < samples.size(); ++i) {
+        out << (i > 0 ? ", " : "") << samples[i].*field;
+    }
+    out << "]";
+}
+
+void writeReport(std::ostream& out, const Options& options, const ll::Session& session,
+    const ll::ImageDescriptor& imgDesc, const std::vector<Sample>& samples, const double totalSeconds)
+{
+
+    const auto& device = session.getDeviceDescriptor();
+
+    const auto column = [&samples](double Sample::*field) {
+        auto values = std::vector<double>(samples.size());
+        std::transform(samples.cbegin(), samples.cend(), values.begin(), [field](const Sample& s) { return s.*field; });
+        return values;
+    };
+
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"builder\": \"" << escapeJSON(options.builder) << "\",\n";
+    out << "  \"library\": \"" << escapeJSON(options.library) << "\",\n";
+    out << "  \"input\": \"" << escapeJSON(options.input) << "\",\n";
+    out << "  \"device\": {\"id\": " << device.id
+        << ", \"type\": \"" << ll::deviceTypeToString(ll::DeviceType {device.deviceType})
+        << "\", \"name\": \"" << escapeJSON(device.name) << "\"},\n";
+    out << "  \"image\": {\"width\": " << imgDesc.getWidth()
+        << ", \"height\": " << imgDesc.getHeight()
+        << ", \"channels\": " << imgDesc.getChannelCount<uint32_t>()
+        << ", \"channel_type\": \"" << ll::channelTypeToString(imgDesc.getChannelType()) << "\"},\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"iterations\": " << options.iterations << ",\n";
+    out << "  \"frames_per_second\": " << static_cast<double>(samples.size()) / totalSeconds << ",\n";
+
+    out << "  \"gpu_ms\": ";
+    writeStatistics(out, column(&Sample::gpu));
+    out << ",\n  \"cpu_record_ms\": ";
+    writeStatistics(out, column(&Sample::record));
+    out << ",\n  \"latency_ms\": ";
+    writeStatistics(out, column(&Sample::latency));
+
+    out << ",\n  \"samples\": {\n    \"gpu_ms\": ";
+    writeSamples(out, samples, &Sample::gpu);
+    out << ",\n    \"cpu_record_ms\": ";
+    writeSamples(out, samples, &Sample::record);
+    out << ",\n    \"latency_ms\": ";
+    writeSamples(out, samples, &Sample::latency);
+    out << "\n  }\n}\n";
+}
+
+int runBenchmark(const Options& options)
+{
+
+    const auto frames = loadFrames(options);
+
+    auto session = createSession(options);
+    session->loadLibrary(options.library);
+
+    const auto usageFlags = ll::ImageUsageFlags {ll::ImageUsageFlagBits::Storage
+                                                 | ll::ImageUsageFlagBits::Sampled
+                                                 | ll::ImageUsageFlagBits::TransferDst};
+
+    auto inputDesc = ll::ImageDescriptor {frames.descriptor}.setUsageFlags(usageFlags);
+
+    auto inputImage = session->getDeviceMemory()->createImage(inputDesc);
+    auto inputView  = inputImage->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false});
+    inputImage->changeImageLayout(ll::ImageLayout::General);
+
+    auto uploadBuffer = session->getUploadMemory()->createBuffer(inputDesc.getSize());
+
+    auto node = createNode(*session, options.builder);
+    for (const auto& kv : options.parameters) {
+        node->setParameter(kv.first, parseParameter(kv.second));
+    }
+
+    // nodes might read the input while initializing
+    {
+        auto staging = uploadBuffer->map<uint8_t[]>();
+        std::memcpy(staging.get(), frames.data[0].data(), frames.data[0].size());
+    }
+
+    {
+        auto cmdBuffer = session->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->changeImageLayout(*inputImage, ll::ImageLayout::TransferDstOptimal);
+        cmdBuffer->copyBufferToImage(*uploadBuffer, *inputImage);
+        cmdBuffer->changeImageLayout(*inputImage, ll::ImageLayout::General);
+        cmdBuffer->end();
+        session->run(*cmdBuffer);
+    }
+
+    node->bind(options.inPort, inputView);
+    node->init();
+
+    auto duration = session->createDuration();
+    auto samples  = std::vector<Sample> {};
+    samples.reserve(options.iterations);
+
+    auto measuredTime = std::chrono::steady_clock::duration {0};
+
+    for (auto i = 0u; i < options.warmup + options.iterations; ++i) {
+
+        const auto& frame = frames.data[i % frames.data.size()];
+        {
+            auto staging = uploadBuffer->map<uint8_t[]>();
+            std::memcpy(staging.get(), frame.data(), frame.size());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        auto cmdBuffer = session->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->changeImageLayout(*inputImage, ll::ImageLayout::TransferDstOptimal);
+        cmdBuffer->copyBufferToImage(*uploadBuffer, *inputImage);
+        cmdBuffer->changeImageLayout(*inputImage, ll::ImageLayout::General);
+        cmdBuffer->durationStart(*duration);
+        node->record(*cmdBuffer);
+        cmdBuffer->durationEnd(*duration);
+        cmdBuffer->end();
+
+        const auto recorded = std::chrono::steady_clock::now();
+
+        // submits and waits for the command buffer to finish
+        session->run(*cmdBuffer);
+
+        const auto finished = std::chrono::steady_clock::now();
+
+        if (i < options.warmup) {
+            continue;
+        }
+
+        measuredTime += finished - start;
+
+        const auto toMs = [](const auto d) {
+            return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(d).count();
+        };
+
+        samples.push_back({toMs(duration->getDuration()), toMs(recorded - start), toMs(finished - start)});
+    }
+
+    const auto totalSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(measuredTime).count();
+
+    if (options.output.empty()) {
+        writeReport(std::cout, options, *session, frames.descriptor, samples, totalSeconds);
+    } else {
+        auto file = std::ofstream {options.output};
+        writeReport(file, options, *session, frames.descriptor, samples, totalSeconds);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+
+    auto options = Options {};
+
+    try {
+        options = parseOptions(argc, argv);
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl
+                  << std::endl
+                  << USAGE;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        return runBenchmark(options);
+    } catch (std::exception& e) {
+        std::cerr << "lluvia-bench: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -14,6 +14,7 @@
 
 #include "core/buffer/Buffer.h"
 #include "core/buffer/BufferUsageFlags.h"
+#include "core/buffer/BufferView.h"
 
 #include "core/device/DeviceDescriptor.h"
 #include "core/device/DeviceType.h"
@@ -34,22 +35,29 @@
 #include "core/node/ContainerNode.h"
 #include "core/node/ContainerNodeDescriptor.h"
 #include "core/node/Node.h"
+#include "core/node/NodeBuilder.h"
 #include "core/node/NodeBuilderDescriptor.h"
 #include "core/node/NodeState.h"
 #include "core/node/NodeType.h"
 #include "core/node/Parameter.h"
+#include "core/node/ParameterBlock.h"
 #include "core/node/ParameterType.h"
 #include "core/node/PortDescriptor.h"
 #include "core/node/PortDirection.h"
 #include "core/node/PortType.h"
 #include "core/node/PushConstants.h"
+#include "core/node/SpecializationConstants.h"
 
 #include "core/CommandBuffer.h"
 #include "core/Duration.h"
 #include "core/FloatPrecision.h"
+#include "core/FrameProcessor.h"
+#include "core/FrameProcessorDescriptor.h"
 #include "core/Interpreter.h"
 #include "core/Program.h"
 #include "core/Session.h"
+#include "core/TiledExecutor.h"
+#include "core/TiledExecutorDescriptor.h"
 #include "core/error.h"
 #include "core/types.h"
 #include "core/utils.h"
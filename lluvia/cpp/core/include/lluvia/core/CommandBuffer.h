@@ -8,9 +8,12 @@
 #ifndef LLUVIA_CORE_COMMAND_BUFFER_H_
 #define LLUVIA_CORE_COMMAND_BUFFER_H_
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "lluvia/core/image/ImageLayout.h"
+#include "lluvia/core/types.h"
 #include "lluvia/core/vulkan/vulkan.hpp"
 
 namespace ll {
@@ -28,6 +31,11 @@ class Image;
 class ImageView;
 class Session;
 
+namespace impl {
+    class GraphSnapshot;
+    struct CommandTrace;
+} // namespace impl
+
 /**
 @brief      Class for command buffer.
 
@@ -106,6 +114,29 @@ public:
     */
     void run(const ll::ContainerNode& node);
 
+    /**
+    @brief      Records an indirect dispatch of the currently bound compute pipeline.
+
+    The grid shape is read by the device from \p buffer at \p offset as a
+    `VkDispatchIndirectCommand` structure, that is, three consecutive `uint32_t`
+    values with the grid size in X, Y and Z. See @VULKAN_DOC#vkCmdDispatchIndirect
+    for more information.
+
+    This method is called by ll::ComputeNode::record for nodes in indirect-dispatch
+    mode. If \p buffer is written by a previous node in the same command buffer,
+    call ll::CommandBuffer::indirectBarrier before recording the dispatch.
+
+    @param[in]  buffer  The buffer. It must be created with ll::BufferUsageFlagBits::IndirectBuffer usage flag.
+    @param[in]  offset  The offset in bytes within \p buffer. It must be a multiple of 4.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p buffer
+                                  does not have the IndirectBuffer usage flag, \p offset is not
+                                  a multiple of 4 or the dispatch arguments exceed the buffer size.
+
+    @sa ll::ComputeNodeDescriptor::setIndirectDispatch
+    */
+    void dispatchIndirect(const ll::Buffer& buffer, const uint64_t offset = 0);
+
     /**
     @brief      Copies \p src buffer into \p dst.
 
@@ -121,23 +152,86 @@ public:
     /**
     @brief      Copies the content of \p src buffer into \p dst image.
 
-    **TODO:** assert image size.
+    The buffer content is interpreted as tightly packed pixels covering the
+    whole image.
 
     @param[in]  src   The source
     @param[in]  dst   The destination
+
+    @throws     std::system_error With error code ll::ErrorCode::BufferCopyError if
+                                  \p src is smaller than the image pixels.
     */
     void copyBufferToImage(const ll::Buffer& src, const ll::Image& dst);
 
+    /**
+    @brief      Copies the content of \p src buffer into a region of \p dst image.
+
+    Pixels are read from \p src starting at \p bufferOffset bytes. Consecutive
+    rows in the buffer are separated by \p bufferRowLength pixels, which allows
+    uploading a crop of a larger host image. A row length of zero means the
+    buffer is tightly packed according to \p imageExtent.
+
+    @param[in]  src              The source buffer.
+    @param[in]  dst              The destination image.
+    @param[in]  imageOffset      The offset in pixels of the region within \p dst.
+    @param[in]  imageExtent      The extent in pixels of the region.
+    @param[in]  bufferOffset     The offset in bytes within \p src. It must be a multiple of the
+                                 pixel size of \p dst.
+    @param[in]  bufferRowLength  The row length, in pixels, of the buffer. It must be zero or greater
+                                 or equal than `imageExtent.x`.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the region
+                                  falls outside \p dst, or \p bufferOffset or \p bufferRowLength
+                                  are invalid.
+
+    @throws     std::system_error With error code ll::ErrorCode::BufferCopyError if
+                                  the region exceeds the size of \p src.
+    */
+    void copyBufferToImage(const ll::Buffer& src, const ll::Image& dst,
+        const ll::vec3ui& imageOffset, const ll::vec3ui& imageExtent,
+        const uint64_t bufferOffset = 0, const uint32_t bufferRowLength = 0);
+
     /**
     @brief      Copies the content of \p src image into \p dst buffer.
 
-    *TODO:* assert buffer size.
+    The pixels are written tightly packed into the buffer.
 
     @param[in]  src   The source
     @param[in]  dst   The destination
+
+    @throws     std::system_error With error code ll::ErrorCode::BufferCopyError if
+                                  \p dst is smaller than the image pixels.
     */
     void copyImageToBuffer(const ll::Image& src, const ll::Buffer& dst);
 
+    /**
+    @brief      Copies a region of \p src image into \p dst buffer.
+
+    Pixels are written into \p dst starting at \p bufferOffset bytes, with consecutive
+    rows separated by \p bufferRowLength pixels. This allows downloading only a crop
+    of the image, possibly into a sub-rectangle of a larger host image. A row length of
+    zero means the buffer is tightly packed according to \p imageExtent.
+
+    @param[in]  src              The source image.
+    @param[in]  dst              The destination buffer.
+    @param[in]  imageOffset      The offset in pixels of the region within \p src.
+    @param[in]  imageExtent      The extent in pixels of the region.
+    @param[in]  bufferOffset     The offset in bytes within \p dst. It must be a multiple of the
+                                 pixel size of \p src.
+    @param[in]  bufferRowLength  The row length, in pixels, of the buffer. It must be zero or greater
+                                 or equal than `imageExtent.x`.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the region
+                                  falls outside \p src, or \p bufferOffset or \p bufferRowLength
+                                  are invalid.
+
+    @throws     std::system_error With error code ll::ErrorCode::BufferCopyError if
+                                  the region exceeds the size of \p dst.
+    */
+    void copyImageToBuffer(const ll::Image& src, const ll::Buffer& dst,
+        const ll::vec3ui& imageOffset, const ll::vec3ui& imageExtent,
+        const uint64_t bufferOffset = 0, const uint32_t bufferRowLength = 0);
+
     /**
     @brief      Copies the content of \p src image into \p dst image.
 
@@ -146,6 +240,21 @@ public:
     */
     void copyImageToImage(const ll::Image& src, const ll::Image& dst);
 
+    /**
+    @brief      Copies a region of \p src image into \p dst image.
+
+    @param[in]  src        The source image.
+    @param[in]  dst        The destination image.
+    @param[in]  srcOffset  The offset in pixels of the region within \p src.
+    @param[in]  dstOffset  The offset in pixels of the region within \p dst.
+    @param[in]  extent     The extent in pixels of the region.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the region
+                                  falls outside \p src or \p dst.
+    */
+    void copyImageToImage(const ll::Image& src, const ll::Image& dst,
+        const ll::vec3ui& srcOffset, const ll::vec3ui& dstOffset, const ll::vec3ui& extent);
+
     /**
     @brief      Change \p image layout.
 
@@ -183,6 +292,14 @@ public:
     */
     void memoryBarrier();
 
+    /**
+    @brief      Adds a memory barrier between shader writes and indirect command reads.
+
+    Use this barrier when the arguments of an indirect dispatch are written by a
+    previous compute node.
+    */
+    void indirectBarrier();
+
     /**
     @brief      Clears the pixels of an image to zero.
     */
@@ -208,9 +325,21 @@ public:
     void durationEnd(ll::Duration& duration);
 
 private:
+    // marks the trace, if any, as not covering every recorded command
+    void traceUnsupported(const char* command);
+
     vk::CommandBuffer m_commandBuffer;
 
     std::shared_ptr<ll::vulkan::Device> m_device;
+
+    // When set, compute nodes and the commands listed in ll::impl::CommandTraceStepType
+    // are appended in the order they are recorded. Used by ll::ContainerNode to find the
+    // lifetime of transient images, and by ll::impl::GraphSnapshot to save the schedule.
+    ll::impl::CommandTrace* m_trace {nullptr};
+
+    friend class ll::ComputeNode;
+    friend class ll::ContainerNode;
+    friend class ll::impl::GraphSnapshot;
 };
 
 } // namespace ll
@@ -0,0 +1,223 @@
+/**
+@file       FrameProcessor.h
+@brief      FrameProcessor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_FRAME_PROCESSOR_H_
+#define LLUVIA_CORE_FRAME_PROCESSOR_H_
+
+#include "lluvia/core/FrameProcessorDescriptor.h"
+#include "lluvia/core/image/ImageDescriptor.h"
+#include "lluvia/core/vulkan/vulkan.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ll {
+
+namespace vulkan {
+    class Device;
+} // namespace vulkan
+
+class Buffer;
+class CommandBuffer;
+class Duration;
+class Image;
+class ImageView;
+class Node;
+class Session;
+
+/**
+@brief      Streams host frames through a node keeping several frames in flight.
+
+The processor creates and initializes the node once, together with its input image. Every
+frame runs through the same node, so nodes keeping state between frames, such as the previous
+frame or an accumulated result, see the whole stream in order.
+
+The processor holds a fixed number of frame slots. Each slot has its own staging buffers,
+command buffer and fence. The command buffer of a slot records the upload of the input frame,
+the node and the download of the output frame once, at construction. It starts with a barrier
+waiting for every command submitted before, so the device processes the frames one after the
+other, in the order they are pushed.
+
+ll::FrameProcessor::push copies a frame into the staging buffer of the next free slot and
+submits its command buffer without waiting for it. ll::FrameProcessor::pop waits for the
+oldest frame in flight and copies its output. While the device processes a frame, the host
+can copy the next ones into their staging buffers and read back the previous ones.
+
+@code
+    auto desc = ll::FrameProcessorDescriptor {}
+                    .setBuilderName("lluvia/color/RGBA2Gray")
+                    .setInputPort("in_rgba")
+                    .setOutputPort("out_gray")
+                    .setImageDescriptor(ll::ImageDescriptor {1, 480, 640, ll::ChannelCount::C4, ll::ChannelType::Uint8})
+                    .setInFlightCount(3);
+
+    auto processor = session->createFrameProcessor(desc);
+
+    auto output = std::vector<uint8_t>(processor->getOutputSize());
+
+    while (camera.read(frame)) {
+        if (processor->isFull()) {
+            processor->pop(output.data());
+            display(output);
+        }
+
+        processor->push(frame.data());
+    }
+
+    while (processor->getPendingFrameCount() > 0) {
+        processor->pop(output.data());
+        display(output);
+    }
+@endcode
+
+@sa ll::Session::createFrameProcessor
+*/
+class FrameProcessor {
+
+public:
+    FrameProcessor()                      = delete;
+    FrameProcessor(const FrameProcessor&) = delete;
+    FrameProcessor(FrameProcessor&&)      = delete;
+
+    /**
+    @brief      Constructs the object.
+
+    Creates and initializes the node, and records the command buffer of every frame slot.
+
+    @param[in]  session     The session.
+    @param[in]  device      The device.
+    @param[in]  descriptor  The descriptor.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the
+                                  descriptor is not valid.
+
+    @throws     std::system_error With error code ll::ErrorCode::PortBindingError if the
+                                  output port does not hold an image.
+    */
+    FrameProcessor(const std::shared_ptr<ll::Session>& session,
+        const std::shared_ptr<ll::vulkan::Device>&     device,
+        const ll::FrameProcessorDescriptor&            descriptor);
+
+    ~FrameProcessor();
+
+    FrameProcessor& operator=(const FrameProcessor&) = delete;
+    FrameProcessor& operator=(FrameProcessor&&)      = delete;
+
+    const ll::FrameProcessorDescriptor& getDescriptor() const noexcept;
+
+    /**
+    @brief      Gets the descriptor of the output frames.
+    */
+    const ll::ImageDescriptor& getOutputImageDescriptor() const noexcept;
+
+    /**
+    @brief      Gets the size in bytes of an input frame.
+    */
+    uint64_t getInputSize() const noexcept;
+
+    /**
+    @brief      Gets the size in bytes of an output frame.
+    */
+    uint64_t getOutputSize() const noexcept;
+
+    /**
+    @brief      Gets the number of frames pushed and not popped yet.
+    */
+    uint32_t getPendingFrameCount() const noexcept;
+
+    /**
+    @brief      Determines if every frame slot holds a frame not popped yet.
+
+    @return     True if a frame must be popped before pushing a new one.
+    */
+    bool isFull() const noexcept;
+
+    /**
+    @brief      Submits a frame for processing without waiting for it.
+
+    @param[in]  input  Pointer to the input pixels, row major and tightly packed. It must
+                       contain at least ll::FrameProcessor::getInputSize bytes. It can be
+                       reused once this method returns.
+
+    @return     The index of the frame, counting from zero.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p input is null.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if every
+                                  frame slot is in use, see ll::FrameProcessor::isFull.
+
+    @throws     std::system_error With error code ll::ErrorCode::VulkanError if the submission fails.
+    */
+    uint64_t push(const void* input);
+
+    /**
+    @brief      Waits for the oldest frame in flight and copies its output.
+
+    @param      output  Pointer to the output pixels, row major and tightly packed. It must
+                        contain at least ll::FrameProcessor::getOutputSize bytes.
+
+    @return     The index of the frame, as returned by ll::FrameProcessor::push.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p output is null.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if there are
+                                  no frames in flight.
+
+    @throws     std::system_error With error code ll::ErrorCode::VulkanError if waiting for
+                                  the frame fails.
+    */
+    uint64_t pop(void* output);
+
+    /**
+    @brief      Gets the device time spent running the node on the last popped frame.
+
+    Upload and download of the frame are not included.
+    */
+    std::chrono::nanoseconds getLastFrameDuration() const noexcept;
+
+private:
+    struct Slot {
+        std::shared_ptr<ll::Buffer>        uploadBuffer;
+        std::shared_ptr<ll::Buffer>        downloadBuffer;
+        std::unique_ptr<ll::Duration>      duration;
+        std::unique_ptr<ll::CommandBuffer> commandBuffer;
+        vk::Fence                          fence;
+
+        bool busy {false};
+    };
+
+    std::shared_ptr<ll::Node> createNode() const;
+    void                      initNode();
+    void                      initSlot(Slot& slot);
+    void                      destroyFences() noexcept;
+
+    ll::FrameProcessorDescriptor m_descriptor;
+    ll::ImageDescriptor          m_outputImageDescriptor;
+
+    // shared by every slot, the frames are processed one after the other
+    std::shared_ptr<ll::Node>      m_node;
+    std::shared_ptr<ll::Image>     m_inputImage;
+    std::shared_ptr<ll::ImageView> m_inputImageView;
+    std::shared_ptr<ll::Image>     m_outputImage;
+
+    std::vector<Slot> m_slots;
+
+    // frames pushed and popped so far. Frame i uses slot i % m_slots.size()
+    uint64_t m_pushCount {0};
+    uint64_t m_popCount {0};
+
+    std::chrono::nanoseconds m_lastFrameDuration {0};
+
+    std::shared_ptr<ll::Session>        m_session;
+    std::shared_ptr<ll::vulkan::Device> m_device;
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_FRAME_PROCESSOR_H_
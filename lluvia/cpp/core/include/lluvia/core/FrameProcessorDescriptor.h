@@ -0,0 +1,164 @@
+/**
+@file       FrameProcessorDescriptor.h
+@brief      FrameProcessorDescriptor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_FRAME_PROCESSOR_DESCRIPTOR_H_
+#define LLUVIA_CORE_FRAME_PROCESSOR_DESCRIPTOR_H_
+
+#include "lluvia/core/image/ImageDescriptor.h"
+#include "lluvia/core/image/ImageViewDescriptor.h"
+#include "lluvia/core/node/Parameter.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace ll {
+
+class Node;
+
+/**
+@brief      Class for describing a frame processor.
+
+Descriptors are used to construct ll::FrameProcessor objects.
+
+@sa ll::FrameProcessor
+*/
+class FrameProcessorDescriptor {
+
+public:
+    /**
+    Function creating a new, not initialized, node.
+    */
+    using NodeFactory = std::function<std::shared_ptr<ll::Node>()>;
+
+    FrameProcessorDescriptor()                                           = default;
+    FrameProcessorDescriptor(const FrameProcessorDescriptor& descriptor) = default;
+    FrameProcessorDescriptor(FrameProcessorDescriptor&& descriptor)      = default;
+
+    ~FrameProcessorDescriptor() = default;
+
+    FrameProcessorDescriptor& operator=(const FrameProcessorDescriptor& descriptor) = default;
+    FrameProcessorDescriptor& operator=(FrameProcessorDescriptor&& descriptor)      = default;
+
+    /**
+    @brief      Sets the name of the node builder used to create the node processing the frames.
+
+    The builder can be either a compute or a container node builder.
+
+    @param[in]  name  The builder name.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setBuilderName(const std::string& name) noexcept;
+
+    /**
+    @brief      Sets a function creating the node processing the frames.
+
+    When set, it takes precedence over the builder name. The function is called
+    once, and must return a new node that has not been initialized.
+
+    @param[in]  factory  The factory.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setNodeFactory(const NodeFactory& factory) noexcept;
+
+    /**
+    @brief      Sets the name of the node port receiving the input frame.
+
+    The port is bound to a ll::ImageView. Defaults to `in_image`.
+
+    @param[in]  name  The port name.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setInputPort(const std::string& name) noexcept;
+
+    /**
+    @brief      Sets the name of the node port containing the output frame after initialization.
+
+    The port must hold either a ll::Image or a ll::ImageView. Defaults to `out_image`.
+
+    @param[in]  name  The port name.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setOutputPort(const std::string& name) noexcept;
+
+    /**
+    @brief      Sets the descriptor of the input frames.
+
+    Only the width, height, depth, channel count and channel type are used.
+
+    @param[in]  descriptor  The image descriptor.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setImageDescriptor(const ll::ImageDescriptor& descriptor) noexcept;
+
+    /**
+    @brief      Sets the image view descriptor used to bind the input frame to the node.
+
+    @param[in]  descriptor  The image view descriptor.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setInputImageViewDescriptor(const ll::ImageViewDescriptor& descriptor) noexcept;
+
+    /**
+    @brief      Sets the number of frames in flight.
+
+    Each frame in flight uses its own staging buffers, command buffer and fence,
+    allowing the host to copy frames into and out of the staging buffers while
+    the device processes others. The node is shared by every frame, see
+    ll::FrameProcessor. Defaults to 2.
+
+    @param[in]  count  The count. It must be greater than zero.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setInFlightCount(const uint32_t count) noexcept;
+
+    /**
+    @brief      Sets a parameter passed to the node before initialization.
+
+    @param[in]  name   The parameter name.
+    @param[in]  value  The value.
+
+    @return     A reference to this object.
+    */
+    FrameProcessorDescriptor& setParameter(const std::string& name, const ll::Parameter& value);
+
+    const std::string&                          getBuilderName() const noexcept;
+    const NodeFactory&                          getNodeFactory() const noexcept;
+    const std::string&                          getInputPort() const noexcept;
+    const std::string&                          getOutputPort() const noexcept;
+    const ll::ImageDescriptor&                  getImageDescriptor() const noexcept;
+    const ll::ImageViewDescriptor&              getInputImageViewDescriptor() const noexcept;
+    uint32_t                                    getInFlightCount() const noexcept;
+    const std::map<std::string, ll::Parameter>& getParameters() const noexcept;
+
+private:
+    std::string m_builderName;
+    NodeFactory m_nodeFactory;
+
+    std::string m_inputPort {"in_image"};
+    std::string m_outputPort {"out_image"};
+
+    ll::ImageDescriptor     m_imageDescriptor;
+    ll::ImageViewDescriptor m_inputImageViewDescriptor;
+
+    uint32_t m_inFlightCount {2};
+
+    std::map<std::string, ll::Parameter> m_parameters;
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_FRAME_PROCESSOR_DESCRIPTOR_H_
@@ -8,6 +8,8 @@
 #ifndef LLUVIA_CORE_PROGRAM_H_
 #define LLUVIA_CORE_PROGRAM_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -52,6 +54,22 @@ public:
         const std::shared_ptr<ll::vulkan::Device>& device,
         const std::vector<uint8_t>&                spirvCode);
 
+    /**
+    @brief      Constructs the object from a Vulkan device and SPIR-V code without keeping a host copy.
+
+    The code is only read to create the shader module, for instance, straight from a
+    memory mapped file. ll::Program::getSpirV returns an empty vector for programs
+    created with this constructor.
+
+    @param[in]  device     The Vulkan device.
+    @param[in]  spirvCode  Pointer to the SPIR-V code. It must be aligned to 4 bytes.
+    @param[in]  codeSize   The code size in bytes.
+    */
+    Program(
+        const std::shared_ptr<ll::vulkan::Device>& device,
+        const uint32_t*                            spirvCode,
+        const size_t                               codeSize);
+
     ~Program();
 
     Program& operator=(const Program& program) = delete;
@@ -71,7 +89,23 @@ public:
     */
     const std::vector<uint8_t>& getSpirV() const noexcept;
 
+    /**
+    @brief      Tells whether this object keeps a host copy of its SPIR-V code.
+
+    @return     True if the SPIR-V code is available through ll::Program::getSpirV.
+    */
+    bool hasSpirV() const noexcept;
+
+    /**
+    @brief      Releases the host copy of the SPIR-V code.
+
+    The shader module remains valid, only the memory used by the code is released.
+    */
+    void releaseSpirV() noexcept;
+
 private:
+    void createShaderModule(const uint32_t* spirvCode, const size_t codeSize);
+
     std::shared_ptr<ll::vulkan::Device> m_device;
 
     vk::ShaderModule     m_module;
@@ -20,6 +20,7 @@
 
 #include "lluvia/core/ComputeDimension.h"
 #include "lluvia/core/SessionDescriptor.h"
+#include "lluvia/core/buffer/BufferUsageFlags.h"
 #include "lluvia/core/device/DeviceDescriptor.h"
 #include "lluvia/core/image/ImageDescriptor.h"
 #include "lluvia/core/memory/MemoryPropertyFlags.h"
@@ -33,6 +34,10 @@ namespace vulkan {
     class Instance;
 } // namespace vulkan
 
+namespace impl {
+    class ZipArchive;
+} // namespace impl
+
 class Buffer;
 class CommandBuffer;
 class ComputeNode;
@@ -40,10 +45,17 @@ class ComputeNodeDescriptor;
 class ContainerNode;
 class ContainerNodeDescriptor;
 class Duration;
+class FrameProcessor;
+class FrameProcessorDescriptor;
 class Image;
 class Interpreter;
 class Memory;
+class Node;
+class NodeBuilder;
+class ParameterBlock;
 class Program;
+class TiledExecutor;
+class TiledExecutorDescriptor;
 
 /**
 @brief      Class that contains all the state required to run compute operations on a compute device.
@@ -126,6 +138,29 @@ public:
      */
     std::shared_ptr<ll::Memory> getDeviceMemory() const noexcept;
 
+    /**
+    @brief      Returns a pointer to a ll::Memory object optimized for reading device data on the host.
+
+    The memory prefers memory types with ll::MemoryPropertyFlagBits::HostCached, where
+    host reads are fast. If the selected type is not host coherent, mapped buffers are
+    invalidated when mapped. This memory should be used for the destination of
+    transfers from the device to the host.
+
+    @return     The readback memory.
+    */
+    std::shared_ptr<ll::Memory> getReadbackMemory() const noexcept;
+
+    /**
+    @brief      Returns a pointer to a ll::Memory object optimized for writing data from the host.
+
+    The memory prefers host coherent types without ll::MemoryPropertyFlagBits::HostCached,
+    usually write-combined, where sequential host writes are fast but host reads are slow.
+    This memory should be used for the source of transfers from the host to the device.
+
+    @return     The upload memory.
+    */
+    std::shared_ptr<ll::Memory> getUploadMemory() const noexcept;
+
     /**
     @brief      Gets the Lua interpreter.
 
@@ -157,6 +192,16 @@ public:
      */
     const ll::DeviceDescriptor& getDeviceDescriptor() const noexcept;
 
+    /**
+    @brief      Gets the number of Vulkan samplers allocated by this session.
+
+    Image views with the same sampler configuration share a single sampler,
+    hence this number is usually much smaller than the number of sampled image views.
+
+    @return     The sampler count.
+    */
+    size_t getSamplerCount() const noexcept;
+
     /**
     @brief      Determines if parameters in image descriptor are supported for image creation.
 
@@ -189,6 +234,106 @@ public:
     */
     std::shared_ptr<ll::Memory> createMemory(const ll::MemoryPropertyFlags& flags, const uint64_t pageSize, bool exactFlagsMatch = false);
 
+    /**
+    @brief      Creates a parameter block.
+
+    The uniform buffer backing the block is allocated in the session's host memory and
+    each slot is aligned to the device's minUniformBufferOffsetAlignment limit.
+
+    @param[in]  blockSize  The size in bytes of each slot's content. It must be less or equal
+                           than the device's maxUniformBufferRange limit.
+    @param[in]  slotCount  The number of slots. Typically, one per frame in flight, see
+                           ll::ComputeNode::setFrameIndex.
+
+    @return     A new ll::ParameterBlock object.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p blockSize
+                                  is zero or greater than maxUniformBufferRange, or \p slotCount is zero.
+
+    @sa ll::ParameterBlock
+    */
+    std::shared_ptr<ll::ParameterBlock> createParameterBlock(const uint64_t blockSize, const uint32_t slotCount);
+
+    /**
+    @brief      Creates a tiled executor.
+
+    The executor processes host images larger than the device image limits
+    by streaming overlapping tiles through the node described in \p descriptor.
+
+    @param[in]  descriptor  The descriptor.
+
+    @return     A new ll::TiledExecutor object.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the
+                                  descriptor is not valid.
+
+    @sa ll::TiledExecutor
+    */
+    std::shared_ptr<ll::TiledExecutor> createTiledExecutor(const ll::TiledExecutorDescriptor& descriptor);
+
+    /**
+    @brief      Creates a frame processor.
+
+    The processor streams host frames through the node described in \p descriptor,
+    keeping several frames in flight so that the host copies of consecutive frames
+    overlap with the execution of the node.
+
+    @param[in]  descriptor  The descriptor.
+
+    @return     A new ll::FrameProcessor object.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the
+                                  descriptor is not valid.
+
+    @sa ll::FrameProcessor
+    */
+    std::shared_ptr<ll::FrameProcessor> createFrameProcessor(const ll::FrameProcessorDescriptor& descriptor);
+
+    /**
+    @brief      Determines if host memory can be imported with ll::Session::importHostMemory.
+
+    Importing host memory requires the VK_EXT_external_memory_host device extension.
+    */
+    bool isHostMemoryImportSupported() const noexcept;
+
+    /**
+    @brief      Gets the alignment required for the address and size of imported host memory.
+
+    @throws     std::system_error With error code ll::ErrorCode::ExtensionNotFound if
+                                  host memory import is not supported.
+    */
+    uint64_t getMinImportedHostPointerAlignment() const;
+
+    /**
+    @brief      Creates a buffer aliasing host memory, without copying it.
+
+    This removes the copy into a staging buffer when uploading data produced
+    by other libraries, such as camera frames. The buffer is created from the
+    host memory of this session with storage and transfer usage flags.
+
+    @param[in]  ptr   The host pointer. It must be aligned to ll::Session::getMinImportedHostPointerAlignment
+                      and remain valid until the returned buffer is deleted.
+    @param[in]  size  The size in bytes. It must be a multiple of ll::Session::getMinImportedHostPointerAlignment.
+
+    @return     A new ll::Buffer object.
+
+    @throws     std::system_error See ll::Memory::importHostMemory.
+    */
+    std::shared_ptr<ll::Buffer> importHostMemory(void* ptr, const uint64_t size);
+
+    /**
+    @brief      Creates a buffer aliasing host memory, without copying it.
+
+    @param[in]  ptr         The host pointer.
+    @param[in]  size        The size in bytes.
+    @param[in]  usageFlags  The buffer usage flags.
+
+    @return     A new ll::Buffer object.
+
+    @throws     std::system_error See ll::Memory::importHostMemory.
+    */
+    std::shared_ptr<ll::Buffer> importHostMemory(void* ptr, const uint64_t size, const ll::BufferUsageFlags usageFlags);
+
     /**
     @brief      Creates a command buffer.
 
@@ -251,9 +396,36 @@ public:
      */
     std::shared_ptr<ll::Program> getProgram(const std::string& name) const;
 
+    /**
+    @brief      Registers a node builder implemented in C++.
+
+    Native builders share the namespace of the Lua builders registered through
+    `ll.registerNodeBuilder`, and take precedence over them if both are registered
+    with the same name. Any previous native builder with the same name is replaced.
+
+    @param[in]  name     The builder name.
+    @param[in]  builder  The builder. It must be either a ll::ComputeNodeBuilder or
+                         a ll::ContainerNodeBuilder.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p builder is null or \p name is empty.
+    */
+    void registerNodeBuilder(const std::string& name, const std::shared_ptr<ll::NodeBuilder>& builder);
+
+    /**
+    @brief      Gets a node builder implemented in C++.
+
+    @param[in]  name  The builder name.
+
+    @return     The builder, or nullptr if there is no native builder registered with \p name.
+    */
+    std::shared_ptr<ll::NodeBuilder> getNodeBuilder(const std::string& name) const noexcept;
+
     /**
     @brief      Gets the node builder descriptors currently registered.
 
+    The descriptors include both native and Lua builders.
+
     @return     The node builder descriptors.
     */
     std::vector<ll::NodeBuilderDescriptor> getNodeBuilderDescriptors() const;
@@ -281,7 +453,8 @@ public:
     /**
     @brief      Creates a compute node descriptor given its builder name.
 
-    Builders can be registered by running Lua scripts using ll::Session::script method.
+    Builders can be registered by running Lua scripts using ll::Session::script method,
+    or natively through ll::Session::registerNodeBuilder.
 
     @param[in]  builderName  The builder name.
 
@@ -368,13 +541,105 @@ public:
     /**
     @brief      Loads a library made of SPIR-V shader code and Lua scripts.
 
+    By default, every Lua script in the library is run and a ll::Program is
+    created for every SPIR-V file.
+
+    The library file is memory mapped. Programs loaded from libraries keep a host
+    copy of their SPIR-V code, unless disabled with
+    ll::SessionDescriptor::enableLibrarySpirVCopy. In that case, SPIR-V files stored
+    without compression are passed to the driver straight from the mapping, and the
+    programs do not keep their code (see ll::Program::hasSpirV).
+
+    If \p lazy is true, only the archive's central directory is read. Each
+    `<name>.spv` file is registered as program `<name>` and each `<name>.lua`
+    file as node builder `<name>`, but nothing is decompressed until the program
+    is requested through ll::Session::getProgram or the builder is used to create
+    a node. The archive is kept open by the session until then, and must not be
+    modified while the session is alive.
+
     @param[in]  filename  The path of the library file. It must be a valid
                           zip archive.
+    @param[in]  lazy      Whether to defer loading of programs and builders until first use.
 
     @throws     std::system_error With error code ll::ErrorCode::IOError if there is
                                   some problem reading the library archive.
     */
-    void loadLibrary(const std::string& filename);
+    void loadLibrary(const std::string& filename, const bool lazy = false);
+
+    /**
+    @brief      Loads a node builder registered lazily by ll::Session::loadLibrary.
+
+    This method is called by the Lua `ll.getNodeBuilder` function when the
+    requested builder is not yet registered, and there is usually no need to
+    call it directly.
+
+    @param[in]  builderName  The builder name.
+
+    @return     True if the builder was pending and its script has been run.
+
+    @throws     std::system_error With error code ll::ErrorCode::IOError if there is
+                                  some problem reading the library archive.
+    */
+    bool loadLazyNodeBuilder(const std::string& builderName) const;
+
+    /**
+    @brief      Saves an initialized node graph into a file.
+
+    The snapshot stores everything needed to create the graph again without running
+    any node builder: node descriptors with their grid shapes, push and specialization
+    constants, the buffers, images and views bound to the nodes, and the commands
+    recorded by every container node. Programs are embedded as SPIR-V when they keep
+    a host copy of their code (see ll::Program::hasSpirV), otherwise they are referred
+    to by their name in the program registry.
+
+    The content of buffers is saved if they are host visible or were created with both
+    ll::BufferUsageFlagBits::TransferSrc and ll::BufferUsageFlagBits::TransferDst flags.
+    The content of images is saved if they were created with both ll::ImageUsageFlagBits::TransferSrc
+    and ll::ImageUsageFlagBits::TransferDst flags.
+
+    Container nodes are recorded once while saving. Their record method must only run
+    nodes, add barriers, clear images or change image layouts. The recorded commands
+    are replayed by the loaded containers every time they are recorded, that is,
+    the schedule is fixed at the time of saving.
+
+    @param[in]  node                  The root node of the graph. Every node in the graph must be initialized.
+    @param[in]  filename              The filename.
+    @param[in]  includePipelineCache  Whether to save the content of the device pipeline cache.
+                                      When loaded on the same device and driver, compute pipelines
+                                      are created without compiling the shaders again.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if some node
+                                  of the graph is not initialized.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if some container
+                                  records unsupported commands, a compute node uses a parameter block,
+                                  or a program is neither registered nor keeps its SPIR-V code.
+
+    @throws     std::system_error With error code ll::ErrorCode::IOError if there is some problem
+                                  writing the file.
+
+    @sa ll::Session::loadGraph
+    */
+    void saveGraph(const std::shared_ptr<ll::Node>& node, const std::string& filename, const bool includePipelineCache = true);
+
+    /**
+    @brief      Loads a node graph saved by ll::Session::saveGraph.
+
+    Nodes are created and initialized directly from the snapshot, without running the
+    Lua interpreter nor any native builder. Transient images aliased in the saved graph
+    are created without aliasing.
+
+    @param[in]  filename  The filename.
+
+    @return     The root node of the graph, in ll::NodeState::Init state.
+
+    @throws     std::system_error With error code ll::ErrorCode::IOError if the file cannot be
+                                  read or is not a valid graph snapshot.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if a program
+                                  saved by name is not registered in this session.
+    */
+    std::shared_ptr<ll::Node> loadGraph(const std::string& filename);
 
     /**
     @brief      Returns the suggested local grid shape for compute nodes given the number of dimensions.
@@ -410,6 +675,24 @@ private:
     void initDescriptor();
     void initDevice();
 
+    // creates a memory with the types matching required, sorted by
+    // preference. Types with preferred flags and without avoided flags go first.
+    std::shared_ptr<ll::Memory> createPreferredMemory(const ll::MemoryPropertyFlags& required,
+        const ll::MemoryPropertyFlags&                                                preferred,
+        const ll::MemoryPropertyFlags&                                                avoided,
+        const uint64_t                                                                pageSize);
+
+    std::shared_ptr<ll::Memory> createMemoryFromTypes(const std::vector<uint32_t>& typeIndices, const uint64_t pageSize);
+
+    // runs the scripts of all the node builders that are still pending
+    void loadLazyNodeBuilders() const;
+
+    // file of a library loaded lazily, decompressed on first use
+    struct LazyLibraryEntry {
+        std::shared_ptr<ll::impl::ZipArchive> archive;
+        size_t                                fileIndex;
+    };
+
     const ll::SessionDescriptor m_descriptor;
     ll::DeviceDescriptor        m_deviceDescriptor;
 
@@ -418,10 +701,16 @@ private:
 
     std::shared_ptr<ll::Interpreter> m_interpreter;
 
-    std::map<std::string, std::shared_ptr<ll::Program>> m_programRegistry;
+    // programs and builders of lazily loaded libraries are moved to the
+    // registry and the interpreter on first use, possibly from const methods.
+    mutable std::map<std::string, std::shared_ptr<ll::Program>> m_programRegistry;
+    mutable std::map<std::string, LazyLibraryEntry>             m_lazyPrograms;
+    mutable std::map<std::string, LazyLibraryEntry>             m_lazyNodeBuilders;
 
     std::shared_ptr<ll::Memory> m_hostMemory;
     std::shared_ptr<ll::Memory> m_deviceMemory;
+    std::shared_ptr<ll::Memory> m_readbackMemory;
+    std::shared_ptr<ll::Memory> m_uploadMemory;
 };
 
 } // namespace ll
@@ -44,8 +44,28 @@ public:
 
     const std::optional<ll::DeviceDescriptor>& getDeviceDescriptor() const noexcept;
 
+    /**
+    @brief     Enables keeping a host copy of the SPIR-V code of programs loaded from libraries.
+
+    Enabled by default, so that ll::Program::getSpirV returns the code of every program.
+    When disabled, uncompressed library entries are read in place to create the shader
+    modules and library programs do not keep their code, see ll::Program::hasSpirV.
+
+    @param[in] enable whether or not library programs keep their SPIR-V code.
+
+    @return    A reference to this object.
+     */
+    SessionDescriptor& enableLibrarySpirVCopy(const bool enable) noexcept;
+
+    /**
+
+    @return whether or not library programs keep a host copy of their SPIR-V code.
+     */
+    bool isLibrarySpirVCopyEnabled() const noexcept;
+
 private:
     bool m_enableDebug {false};
+    bool m_enableLibrarySpirVCopy {true};
 
     std::optional<ll::DeviceDescriptor> m_deviceDescriptor {};
 };
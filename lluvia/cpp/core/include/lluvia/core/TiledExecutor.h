@@ -0,0 +1,204 @@
+/**
+@file       TiledExecutor.h
+@brief      TiledExecutor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_TILED_EXECUTOR_H_
+#define LLUVIA_CORE_TILED_EXECUTOR_H_
+
+#include "lluvia/core/TiledExecutorDescriptor.h"
+#include "lluvia/core/image/ImageDescriptor.h"
+#include "lluvia/core/types.h"
+#include "lluvia/core/vulkan/vulkan.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ll {
+
+namespace vulkan {
+    class Device;
+} // namespace vulkan
+
+class Buffer;
+class CommandBuffer;
+class Image;
+class ImageView;
+class Node;
+class Session;
+
+/**
+@brief      Runs a node over a host image larger than the device limits by splitting it into tiles.
+
+The host image is split into overlapping tiles that fit the device image limits and
+the memory budget set in the descriptor. Each tile is extended by a halo equal to the
+stencil radius of the node, so that the pixels of the tile core are computed exactly
+as if the whole image had been processed at once. Tiles touching the image border are
+shifted inwards instead of padded, hence all device tiles have the same shape.
+
+Several tiles are kept in flight, each with its own node instance, images and staging
+buffers. While the device uploads, computes and downloads one tile, the host copies the
+next tile into its staging buffer and stitches the cores of the finished ones into the output.
+
+@code
+    auto desc = ll::TiledExecutorDescriptor {}
+                    .setBuilderName("lluvia/color/RGBA2Gray")
+                    .setImageDescriptor(ll::ImageDescriptor {1, 16384, 16384, ll::ChannelCount::C4, ll::ChannelType::Uint8})
+                    .setMemoryBudget(256 * 1024 * 1024);
+
+    auto executor = session->createTiledExecutor(desc);
+
+    auto output = std::vector<uint8_t>(executor->getOutputSize());
+    executor->run(input.data(), output.data());
+@endcode
+
+@sa ll::Session::createTiledExecutor
+@sa ll::Node::getStencilRadius
+*/
+class TiledExecutor {
+
+public:
+    /**
+    @brief      Region of the host image processed by one device tile.
+
+    All coordinates are in pixels of the host image.
+    */
+    struct Tile {
+        // offset of the device tile, including the halo
+        ll::vec3ui inputOffset;
+
+        // region of the output written by this tile
+        ll::vec3ui coreOffset;
+        ll::vec3ui coreShape;
+    };
+
+    TiledExecutor()                     = delete;
+    TiledExecutor(const TiledExecutor&) = delete;
+    TiledExecutor(TiledExecutor&&)      = delete;
+
+    /**
+    @brief      Constructs the object.
+
+    Creates and initializes one node per tile in flight.
+
+    @param[in]  session     The session.
+    @param[in]  device      The device.
+    @param[in]  descriptor  The descriptor.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the
+                                  descriptor is not valid, the tile shape cannot hold the halo,
+                                  or the output image of the node does not match the tile shape.
+
+    @throws     std::system_error With error code ll::ErrorCode::PortBindingError if the
+                                  output port does not hold an image.
+    */
+    TiledExecutor(const std::shared_ptr<ll::Session>& session,
+        const std::shared_ptr<ll::vulkan::Device>&    device,
+        const ll::TiledExecutorDescriptor&            descriptor);
+
+    ~TiledExecutor();
+
+    TiledExecutor& operator=(const TiledExecutor&) = delete;
+    TiledExecutor& operator=(TiledExecutor&&)      = delete;
+
+    const ll::TiledExecutorDescriptor& getDescriptor() const noexcept;
+
+    /**
+    @brief      Gets the shape of the device tiles, including the halo.
+    */
+    ll::vec3ui getTileShape() const noexcept;
+
+    /**
+    @brief      Gets the halo radius in pixels.
+    */
+    uint32_t getHaloRadius() const noexcept;
+
+    /**
+    @brief      Gets the tiles, in processing order.
+    */
+    const std::vector<Tile>& getTiles() const noexcept;
+
+    /**
+    @brief      Gets the descriptor of the full size output image.
+    */
+    const ll::ImageDescriptor& getOutputImageDescriptor() const noexcept;
+
+    /**
+    @brief      Gets the size in bytes of the host input image.
+    */
+    uint64_t getInputSize() const noexcept;
+
+    /**
+    @brief      Gets the size in bytes of the host output image.
+    */
+    uint64_t getOutputSize() const noexcept;
+
+    /**
+    @brief      Processes a host image.
+
+    @param[in]  input   Pointer to the input pixels, row major and tightly packed. It must
+                        contain at least ll::TiledExecutor::getInputSize bytes.
+    @param      output  Pointer to the output pixels, row major and tightly packed. It must
+                        contain at least ll::TiledExecutor::getOutputSize bytes.
+
+    @throws     std::system_error With error code ll::ErrorCode::VulkanError if a submission fails.
+    */
+    void run(const void* input, void* output);
+
+    /**
+    @brief      Splits an image into tiles.
+
+    @param[in]  imageShape  The image shape.
+    @param[in]  tileShape   The device tile shape, including the halo. Each component must be
+                            less or equal than the image shape.
+    @param[in]  halo        The halo radius.
+
+    @return     The tiles, in row major order.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p tileShape is greater than \p imageShape, or it is not
+                                  greater than twice the halo along an axis requiring several tiles.
+    */
+    static std::vector<Tile> computeTiles(const ll::vec3ui& imageShape, const ll::vec3ui& tileShape, const uint32_t halo);
+
+private:
+    struct Slot {
+        std::shared_ptr<ll::Node>          node;
+        std::shared_ptr<ll::Image>         inputImage;
+        std::shared_ptr<ll::ImageView>     inputImageView;
+        std::shared_ptr<ll::Image>         outputImage;
+        std::shared_ptr<ll::Buffer>        uploadBuffer;
+        std::shared_ptr<ll::Buffer>        downloadBuffer;
+        std::unique_ptr<ll::CommandBuffer> commandBuffer;
+        vk::Fence                          fence;
+
+        bool   busy {false};
+        size_t tileIndex {0};
+    };
+
+    std::shared_ptr<ll::Node> createNode() const;
+    ll::vec3ui                computeTileShape(const uint32_t halo) const;
+    void                      initSlot(Slot& slot);
+
+    void upload(Slot& slot, const uint8_t* input) const;
+    void waitAndStitch(Slot& slot, uint8_t* output);
+
+    ll::TiledExecutorDescriptor m_descriptor;
+
+    ll::vec3ui          m_tileShape;
+    uint32_t            m_haloRadius {0};
+    std::vector<Tile>   m_tiles;
+    ll::ImageDescriptor m_outputImageDescriptor;
+
+    std::vector<Slot> m_slots;
+
+    std::shared_ptr<ll::Session>        m_session;
+    std::shared_ptr<ll::vulkan::Device> m_device;
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_TILED_EXECUTOR_H_
@@ -0,0 +1,211 @@
+/**
+@file       TiledExecutorDescriptor.h
+@brief      TiledExecutorDescriptor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_TILED_EXECUTOR_DESCRIPTOR_H_
+#define LLUVIA_CORE_TILED_EXECUTOR_DESCRIPTOR_H_
+
+#include "lluvia/core/image/ImageDescriptor.h"
+#include "lluvia/core/image/ImageViewDescriptor.h"
+#include "lluvia/core/node/Parameter.h"
+#include "lluvia/core/types.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace ll {
+
+class Node;
+
+/**
+@brief      Class for describing a tiled executor.
+
+Descriptors are used to construct ll::TiledExecutor objects.
+
+@sa ll::TiledExecutor
+*/
+class TiledExecutorDescriptor {
+
+public:
+    /**
+    Function creating a new, not initialized, node.
+    */
+    using NodeFactory = std::function<std::shared_ptr<ll::Node>()>;
+
+    TiledExecutorDescriptor()                                          = default;
+    TiledExecutorDescriptor(const TiledExecutorDescriptor& descriptor) = default;
+    TiledExecutorDescriptor(TiledExecutorDescriptor&& descriptor)      = default;
+
+    ~TiledExecutorDescriptor() = default;
+
+    TiledExecutorDescriptor& operator=(const TiledExecutorDescriptor& descriptor) = default;
+    TiledExecutorDescriptor& operator=(TiledExecutorDescriptor&& descriptor)      = default;
+
+    /**
+    @brief      Sets the name of the node builder used to create the nodes processing each tile.
+
+    The builder can be either a compute or a container node builder.
+
+    @param[in]  name  The builder name.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setBuilderName(const std::string& name) noexcept;
+
+    /**
+    @brief      Sets a function creating the nodes processing each tile.
+
+    When set, it takes precedence over the builder name. The function must
+    return a new node that has not been initialized.
+
+    @param[in]  factory  The factory.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setNodeFactory(const NodeFactory& factory) noexcept;
+
+    /**
+    @brief      Sets the name of the node port receiving the input tile.
+
+    The port is bound to a ll::ImageView. Defaults to `in_image`.
+
+    @param[in]  name  The port name.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setInputPort(const std::string& name) noexcept;
+
+    /**
+    @brief      Sets the name of the node port containing the output tile after initialization.
+
+    The port must hold either a ll::Image or a ll::ImageView with the same width and
+    height as the input tile. Defaults to `out_image`.
+
+    @param[in]  name  The port name.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setOutputPort(const std::string& name) noexcept;
+
+    /**
+    @brief      Sets the descriptor of the full size host image to process.
+
+    Only the width, height, channel count and channel type are used. The
+    depth must be 1. The image can be larger than the device image limits.
+
+    @param[in]  descriptor  The image descriptor.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setImageDescriptor(const ll::ImageDescriptor& descriptor) noexcept;
+
+    /**
+    @brief      Sets the image view descriptor used to bind the input tile to the node.
+
+    @param[in]  descriptor  The image view descriptor.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setInputImageViewDescriptor(const ll::ImageViewDescriptor& descriptor) noexcept;
+
+    /**
+    @brief      Sets the shape of the device tiles, including the halo.
+
+    A zero component means the tile shape is computed from the device image
+    limits and the memory budget.
+
+    @param[in]  shape  The tile shape. The Z component is ignored.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setTileShape(const ll::vec3ui& shape) noexcept;
+
+    /**
+    @brief      Sets the device memory budget in bytes.
+
+    The budget is shared among the tiles in flight and used to compute the tile
+    shape when it is not set explicitly. The estimate accounts for the input and
+    output images and their staging buffers; intermediate images allocated by the
+    nodes are not included. Zero means no budget.
+
+    @param[in]  budget  The budget in bytes.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setMemoryBudget(const uint64_t budget) noexcept;
+
+    /**
+    @brief      Sets the minimum halo radius in pixels.
+
+    The halo used is the maximum between this value and the stencil radius
+    reported by the nodes.
+
+    @param[in]  radius  The radius.
+
+    @return     A reference to this object.
+
+    @sa ll::Node::getStencilRadius
+    */
+    TiledExecutorDescriptor& setHaloRadius(const uint32_t radius) noexcept;
+
+    /**
+    @brief      Sets the number of tiles in flight.
+
+    Each tile in flight uses its own node, images and staging buffers, allowing
+    the host to prepare and stitch tiles while the device processes others. Defaults to 2.
+
+    @param[in]  count  The count. It must be greater than zero.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setInFlightCount(const uint32_t count) noexcept;
+
+    /**
+    @brief      Sets a parameter passed to every node before initialization.
+
+    @param[in]  name   The parameter name.
+    @param[in]  value  The value.
+
+    @return     A reference to this object.
+    */
+    TiledExecutorDescriptor& setParameter(const std::string& name, const ll::Parameter& value);
+
+    const std::string&                          getBuilderName() const noexcept;
+    const NodeFactory&                          getNodeFactory() const noexcept;
+    const std::string&                          getInputPort() const noexcept;
+    const std::string&                          getOutputPort() const noexcept;
+    const ll::ImageDescriptor&                  getImageDescriptor() const noexcept;
+    const ll::ImageViewDescriptor&              getInputImageViewDescriptor() const noexcept;
+    ll::vec3ui                                  getTileShape() const noexcept;
+    uint64_t                                    getMemoryBudget() const noexcept;
+    uint32_t                                    getHaloRadius() const noexcept;
+    uint32_t                                    getInFlightCount() const noexcept;
+    const std::map<std::string, ll::Parameter>& getParameters() const noexcept;
+
+private:
+    std::string m_builderName;
+    NodeFactory m_nodeFactory;
+
+    std::string m_inputPort {"in_image"};
+    std::string m_outputPort {"out_image"};
+
+    ll::ImageDescriptor     m_imageDescriptor;
+    ll::ImageViewDescriptor m_inputImageViewDescriptor;
+
+    ll::vec3ui m_tileShape {0, 0, 1};
+    uint64_t   m_memoryBudget {0};
+    uint32_t   m_haloRadius {0};
+    uint32_t   m_inFlightCount {2};
+
+    std::map<std::string, ll::Parameter> m_parameters;
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_TILED_EXECUTOR_DESCRIPTOR_H_
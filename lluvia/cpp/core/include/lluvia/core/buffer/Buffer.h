@@ -11,6 +11,7 @@
 #include "lluvia/core/Object.h"
 #include "lluvia/core/buffer/BufferUsageFlags.h"
 #include "lluvia/core/error.h"
+#include "lluvia/core/image/ImageDescriptor.h"
 #include "lluvia/core/memory/Memory.h"
 #include "lluvia/core/memory/MemoryAllocationInfo.h"
 
@@ -28,6 +29,7 @@
 namespace ll {
 
 class Buffer;
+class BufferView;
 class CommandBuffer;
 class ComputeGraph;
 class ComputeNode;
@@ -54,7 +56,8 @@ guaranteeing the memory is not deleted before this buffer is.
 Upon destruction of this object, the underlying memory space is released
 from the ll::Memory instance.
 */
-class Buffer : public Object {
+class Buffer : public Object,
+               public std::enable_shared_from_this<ll::Buffer> {
 
 public:
     Buffer()                = delete;
@@ -204,6 +207,30 @@ public:
         return std::unique_ptr<T, ll::Buffer::BufferMapDeleter> {static_cast<baseType*>(ptr), deleter};
     }
 
+    /**
+    @brief      Creates a view of this buffer as an array of formatted texels.
+
+    The format of the texels is defined by the channel count and type, as
+    it is done for images in ll::ImageDescriptor.
+
+    @param[in]  channelCount  The channel count of each texel.
+    @param[in]  channelType   The channel type of each texel.
+    @param[in]  offset        The offset in bytes from the start of the buffer. It must be a
+                              multiple of the device minTexelBufferOffsetAlignment limit.
+    @param[in]  range         The size in bytes of the view. VK_WHOLE_SIZE covers the buffer
+                              from offset up to the last complete texel.
+
+    @return     A new buffer view.
+
+    @throws     std::system_error if the buffer was not created with ll::BufferUsageFlagBits::UniformTexelBuffer
+                                  or ll::BufferUsageFlagBits::StorageTexelBuffer usage flags, the format
+                                  is not supported for the usage flags of the buffer, or the range is not valid.
+    */
+    std::shared_ptr<ll::BufferView> createBufferView(const ll::ChannelCount channelCount,
+        const ll::ChannelType                                               channelType,
+        const uint64_t                                                      offset = 0,
+        const uint64_t                                                      range  = VK_WHOLE_SIZE);
+
     template <typename T>
     void mapAndSet(T&& obj)
     {
@@ -239,6 +266,8 @@ private:
 
     void unmap();
 
+    void recreateBufferViews();
+
     vk::Buffer           m_vkBuffer;
     ll::BufferUsageFlags m_usageFlags;
 
@@ -254,6 +283,15 @@ private:
     // avoiding reference to a corrupted memory location.
     std::shared_ptr<ll::Memory> m_memory;
 
+    // compute nodes this buffer has been bound to. Their descriptor
+    // sets are updated if the buffer is moved by ll::Memory::defragment.
+    std::vector<std::weak_ptr<ll::ComputeNode>> m_boundNodes;
+
+    // Views created from this buffer. They are recreated if the
+    // buffer is moved by ll::Memory::defragment.
+    std::vector<std::weak_ptr<ll::BufferView>> m_bufferViews;
+
+    friend class ll::BufferView;
     friend class ll::CommandBuffer;
     friend class ll::ComputeGraph;
     friend class ll::ComputeNode;
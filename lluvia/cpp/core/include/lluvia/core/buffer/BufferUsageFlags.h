@@ -14,10 +14,13 @@
 namespace ll {
 
 enum class BufferUsageFlagBits : ll::enum_t {
-    StorageBuffer = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eStorageBuffer),
-    TransferDst   = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eTransferDst),
-    TransferSrc   = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eTransferSrc),
-    UniformBuffer = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eUniformBuffer)
+    StorageBuffer      = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eStorageBuffer),
+    TransferDst        = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eTransferDst),
+    TransferSrc        = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eTransferSrc),
+    UniformBuffer      = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eUniformBuffer),
+    IndirectBuffer     = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eIndirectBuffer),
+    UniformTexelBuffer = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eUniformTexelBuffer),
+    StorageTexelBuffer = static_cast<ll::enum_t>(vk::BufferUsageFlagBits::eStorageTexelBuffer)
 };
 
 using BufferUsageFlags = ll::Flags<BufferUsageFlagBits, ll::enum_t>;
@@ -49,10 +52,13 @@ namespace impl {
         return vk::BufferUsageFlags {static_cast<VkFlags>(flags)};
     }
 
-    constexpr const std::array<std::tuple<const char*, ll::BufferUsageFlagBits>, 4> BufferUsageFlagBitsStrings {{std::make_tuple("StorageBuffer", ll::BufferUsageFlagBits::StorageBuffer),
+    constexpr const std::array<std::tuple<const char*, ll::BufferUsageFlagBits>, 7> BufferUsageFlagBitsStrings {{std::make_tuple("StorageBuffer", ll::BufferUsageFlagBits::StorageBuffer),
         std::make_tuple("TransferDst", ll::BufferUsageFlagBits::TransferDst),
         std::make_tuple("TransferSrc", ll::BufferUsageFlagBits::TransferSrc),
-        std::make_tuple("UniformBuffer", ll::BufferUsageFlagBits::UniformBuffer)}};
+        std::make_tuple("UniformBuffer", ll::BufferUsageFlagBits::UniformBuffer),
+        std::make_tuple("IndirectBuffer", ll::BufferUsageFlagBits::IndirectBuffer),
+        std::make_tuple("UniformTexelBuffer", ll::BufferUsageFlagBits::UniformTexelBuffer),
+        std::make_tuple("StorageTexelBuffer", ll::BufferUsageFlagBits::StorageTexelBuffer)}};
 
 } // namespace impl
 
@@ -0,0 +1,154 @@
+/**
+@file       BufferView.h
+@brief      BufferView class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_BUFFER_BUFFER_VIEW_H_
+#define LLUVIA_CORE_BUFFER_BUFFER_VIEW_H_
+
+#include "lluvia/core/Object.h"
+#include "lluvia/core/image/ImageDescriptor.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "lluvia/core/vulkan/vulkan.hpp"
+
+namespace ll {
+
+namespace vulkan {
+    class Device;
+} // namespace vulkan
+
+class Buffer;
+class ComputeNode;
+
+/**
+@brief      Represents a range of a ll::Buffer as an array of formatted texels.
+
+Buffer views are created by calling ll::Buffer::createBufferView on buffers
+created with ll::BufferUsageFlagBits::UniformTexelBuffer or
+ll::BufferUsageFlagBits::StorageTexelBuffer usage flags.
+
+@code
+    auto session = ll::Session::create();
+
+    const auto usageFlags = ll::BufferUsageFlagBits::UniformTexelBuffer | ll::BufferUsageFlagBits::TransferDst;
+
+    // 640x480 BGRA frame
+    auto buffer = session->getDeviceMemory()->createBuffer(640 * 480 * 4, usageFlags);
+    auto view   = buffer->createBufferView(ll::ChannelCount::C4, ll::ChannelType::Uint8);
+@endcode
+
+BufferView objects are bound to ports of type ll::PortType::UniformTexelBuffer or
+ll::PortType::StorageTexelBuffer. In GLSL, they are accessed as `samplerBuffer` and
+`imageBuffer` objects respectively, where each texel is converted according to the
+view format, as it happens with images.
+
+@code
+    #version 450
+
+    layout(binding = 0) uniform samplerBuffer in_bgra;
+    layout(binding = 1, r8) uniform writeonly imageBuffer out_gray;
+
+    void main() {
+        const int index = int(gl_GlobalInvocationID.x);
+
+        const vec4 bgra = texelFetch(in_bgra, index);
+        imageStore(out_gray, index, vec4(dot(bgra.zyx, vec3(0.299, 0.587, 0.114))));
+    }
+@endcode
+*/
+class BufferView : public Object {
+
+public:
+    BufferView()                  = delete;
+    BufferView(const BufferView&) = delete;
+    BufferView(BufferView&&)      = delete;
+
+    ~BufferView();
+
+    BufferView& operator=(const BufferView&) = delete;
+    BufferView& operator=(BufferView&&)      = delete;
+
+    ll::ObjectType getType() const noexcept override;
+
+    /**
+    @brief      Gets the buffer this view was created from.
+
+    @return     The buffer.
+    */
+    const std::shared_ptr<ll::Buffer>& getBuffer() const noexcept;
+
+    /**
+    @brief      Gets the channel count of each texel.
+
+    @return     The channel count.
+    */
+    ll::ChannelCount getChannelCount() const noexcept;
+
+    /**
+    @brief      Gets the channel type of each texel.
+
+    @return     The channel type.
+    */
+    ll::ChannelType getChannelType() const noexcept;
+
+    /**
+    @brief      Gets the Vulkan format of the texels.
+
+    @return     The format.
+    */
+    vk::Format getFormat() const noexcept;
+
+    /**
+    @brief      Gets the offset in bytes from the start of the buffer.
+
+    @return     The offset.
+    */
+    uint64_t getOffset() const noexcept;
+
+    /**
+    @brief      Gets the size in bytes of the range covered by this view.
+
+    @return     The range.
+    */
+    uint64_t getRange() const noexcept;
+
+    /**
+    @brief      Gets the number of texels in this view.
+
+    @return     The texel count.
+    */
+    uint64_t getTexelCount() const noexcept;
+
+private:
+    BufferView(const std::shared_ptr<ll::vulkan::Device>& device,
+        const std::shared_ptr<ll::Buffer>&                buffer,
+        const ll::ChannelCount                            channelCount,
+        const ll::ChannelType                             channelType,
+        const uint64_t                                    offset,
+        const uint64_t                                    range);
+
+    // creates the Vulkan buffer view. Called again if the buffer is moved by ll::Memory::defragment.
+    void createVkBufferView();
+
+    ll::ChannelCount m_channelCount;
+    ll::ChannelType  m_channelType;
+    uint64_t         m_offset;
+    uint64_t         m_range;
+
+    vk::BufferView m_vkBufferView;
+
+    std::shared_ptr<ll::vulkan::Device> m_device;
+    std::shared_ptr<ll::Buffer>         m_buffer;
+
+    friend class Buffer;
+    friend class ComputeNode;
+};
+
+} // namespace ll
+
+#endif /* LLUVIA_CORE_BUFFER_BUFFER_VIEW_H_ */
@@ -9,6 +9,7 @@
 #define LLUVIA_CORE_IMAGE_IMAGE_H_
 
 #include "lluvia/core/Object.h"
+#include "lluvia/core/error.h"
 #include "lluvia/core/image/ImageDescriptor.h"
 #include "lluvia/core/image/ImageLayout.h"
 #include "lluvia/core/image/ImageTiling.h"
@@ -31,14 +32,23 @@ namespace vulkan {
     class Device;
 } // namespace vulkan
 
+namespace impl {
+    class AliasedMemoryBlock;
+    class GraphSnapshot;
+} // namespace impl
+
 class CommandBuffer;
 class ComputeNode;
 class ComputeGraph;
+class ContainerNode;
 class ImageView;
 class ImageViewDescriptor;
 class Memory;
 class Session;
 
+template <typename T>
+class ImageMapping;
+
 /**
 @brief      Objects to manage images.
 
@@ -99,6 +109,21 @@ public:
     */
     const std::shared_ptr<ll::Memory>& getMemory() const noexcept;
 
+    /**
+    @brief      Determines if the memory of this image is aliased with other images.
+
+    Aliased images share a memory range with other images whose lifetime
+    does not overlap with this one. The content of an aliased image is
+    undefined before it is written in each execution of the schedule it
+    belongs to.
+
+    @return     True if aliased, False otherwise.
+
+    @sa ll::Memory::aliasImages
+    @sa ll::ContainerNode::markTransient
+    */
+    bool isAliased() const noexcept;
+
     /**
     @brief      Gets the memory allocation size in bytes.
 
@@ -253,6 +278,22 @@ public:
     */
     void changeImageLayout(const ll::ImageLayout newLayout);
 
+    /**
+    @brief      Changes the shape of this image.
+
+    The format, tiling and usage flags are kept. The memory of the image is
+    reused if the new shape fits in it. Views created from this image and the
+    descriptor sets of the compute nodes it is bound to are updated, see
+    ll::Memory::reshapeImage. The content of the image is undefined after
+    this call.
+
+    @param[in]  shape  The new shape.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  any component of \p shape is zero.
+    */
+    void reshape(const ll::vec3ui& shape);
+
     /**
     @brief      Immediately clears the image pixels to zero.
 
@@ -274,6 +315,96 @@ public:
     */
     void copyTo(ll::Image& dst);
 
+    /**
+    @brief      Determines if this image is mappable to host-visible memory.
+
+    Only images created with ll::ImageTiling::Linear in a host-visible
+    memory can be mapped.
+
+    @return     True if mappable, False otherwise.
+    */
+    bool isMappable() const noexcept;
+
+    /**
+    @brief      Gets the number of bytes between consecutive rows of the image in memory.
+
+    The row pitch is defined by the device and can be greater than
+    the width times the texel size.
+
+    @return     The row pitch in bytes.
+
+    @throws     std::system_error if the image tiling is not ll::ImageTiling::Linear.
+    */
+    uint64_t getRowPitch() const;
+
+    /**
+    @brief      Gets the number of bytes between consecutive depth slices of the image in memory.
+
+    @return     The depth pitch in bytes.
+
+    @throws     std::system_error if the image tiling is not ll::ImageTiling::Linear.
+    */
+    uint64_t getDepthPitch() const;
+
+    /**
+    @brief      Deleter for unmapping images from host memory.
+    */
+    struct ImageMapDeleter {
+
+        template <typename T>
+        void operator()([[maybe_unused]] T* ptr) const
+        {
+            image->unmap();
+        }
+
+        ll::Image* image {nullptr};
+    };
+
+    /**
+    @brief      Maps the pixels of this image to host-visible memory.
+
+    The returned ll::ImageMapping accesses the pixels following the row
+    and depth pitch of the image, as reported by the device.
+
+    @code
+        auto desc = ll::ImageDescriptor {1, 480, 640, ll::ChannelCount::C1, ll::ChannelType::Uint8}
+                        .setTiling(ll::ImageTiling::Linear);
+
+        auto image = session->getHostMemory()->createImage(desc);
+        image->changeImageLayout(ll::ImageLayout::General);
+
+        {
+            auto mapping = image->map<uint8_t>();
+
+            for (auto y = 0u; y < image->getHeight(); ++y) {
+                auto row = mapping.getRow(y);
+                std::fill(row, row + image->getWidth(), 0);
+            }
+
+        } // the image is unmapped once mapping goes out of scope
+    @endcode
+
+    Host access to the image requires the image to be in ll::ImageLayout::General
+    or ll::ImageLayout::Preinitialized layout. Linear images are created in
+    ll::ImageLayout::Preinitialized layout so that their content written
+    before the first layout transition is preserved.
+
+    @warning    This image object needs to be kept alive during the whole
+                lifetime of the returned mapping.
+
+    @tparam     T     The channel type. Its size must divide the image channel type size.
+                      Types narrower than the channel type, such as uint8_t, give access
+                      to the raw bytes of each channel.
+
+    @return     The mapping. The image is unmapped once the mapping is destroyed.
+
+    @throws     std::system_error if the image is not mappable, it is not in a layout
+                that allows host access, or the size of T does not divide the channel
+                type size.
+    */
+    template <typename T>
+    ll::ImageMapping<T> map();
+
 private:
     Image(const std::shared_ptr<ll::vulkan::Device>& device,
         const vk::Image&                             vkImage,
@@ -282,6 +413,17 @@ private:
         const ll::MemoryAllocationInfo&              allocInfo,
         const ll::ImageLayout                        layout);
 
+    void recreateImageViews();
+
+    // creates the Vulkan image view shared by the views of this image, if needed
+    vk::ImageView getVkImageView();
+    void          createVkImageView();
+
+    vk::SubresourceLayout getSubresourceLayout() const;
+
+    uint8_t* mapMemory();
+    void     unmap();
+
     std::shared_ptr<ll::vulkan::Device> m_device;
 
     ll::ImageDescriptor      m_descriptor;
@@ -290,19 +432,181 @@ private:
     vk::Image       m_vkImage;
     ll::ImageLayout m_layout;
 
+    // every view covers the whole image with its format, hence all the
+    // views of this image use the same Vulkan image view.
+    vk::ImageView m_vkImageView;
+
     // Shared pointer to the memory this image was created from
     // This will keep the memory alive until this image is deleted
     // avoiding reference to a corrupted memory location.
     std::shared_ptr<ll::Memory> m_memory;
 
+    // Set when the memory of this image is shared with other images.
+    // The shared range is released once every image aliasing it is deleted.
+    std::shared_ptr<ll::impl::AliasedMemoryBlock> m_aliasedBlock;
+
+    // Views created from this image. They are updated if the
+    // underlying Vulkan image is replaced while aliasing or moving its memory.
+    std::vector<std::weak_ptr<ll::ImageView>> m_imageViews;
+
+    // compute nodes any view of this image has been bound to. Their descriptor
+    // sets are updated if the image is moved by ll::Memory::defragment.
+    std::vector<std::weak_ptr<ll::ComputeNode>> m_boundNodes;
+
     friend class ll::CommandBuffer;
     friend class ll::ComputeNode;
     friend class ll::ComputeGraph;
+    friend class ll::ContainerNode;
     friend class ll::ImageView;
     friend class ll::Memory;
     friend class ll::Session;
+    friend class ll::impl::GraphSnapshot;
 };
 
+/**
+@brief      Host access to the pixels of a mapped ll::Image.
+
+Pixels are addressed through the row and depth pitch of the image,
+hence rows can be padded in memory. Objects of this class are returned
+by ll::Image::map.
+
+@tparam     T     The channel type.
+*/
+template <typename T>
+class ImageMapping {
+
+public:
+    ImageMapping()                    = default;
+    ImageMapping(const ImageMapping&) = delete;
+    ImageMapping(ImageMapping&&)      = default;
+
+    ~ImageMapping() = default;
+
+    ImageMapping& operator=(const ImageMapping&) = delete;
+    ImageMapping& operator=(ImageMapping&&)      = default;
+
+    ImageMapping(std::unique_ptr<uint8_t, ll::Image::ImageMapDeleter>&& ptr,
+        const uint64_t                                                   rowPitch,
+        const uint64_t                                                   depthPitch,
+        const ll::vec3ui&                                                shape,
+        const uint32_t                                                   channelCount,
+        const uint64_t                                                   channelTypeSize)
+        : m_ptr {std::move(ptr)}
+        , m_rowPitch {rowPitch}
+        , m_depthPitch {depthPitch}
+        , m_shape {shape}
+        , m_channelCount {channelCount}
+        , m_channelTypeSize {channelTypeSize}
+    {
+    }
+
+    /**
+    @brief      Determines if the image is mapped.
+
+    @return     True if mapped, False otherwise.
+    */
+    bool isMapped() const noexcept
+    {
+        return m_ptr != nullptr;
+    }
+
+    /**
+    @brief      Unmaps the image. The mapping cannot be used afterwards.
+    */
+    void unmap() noexcept
+    {
+        m_ptr.reset();
+    }
+
+    /**
+    @brief      Gets a pointer to the first channel of the first pixel.
+
+    @return     The pointer.
+    */
+    T* data() const noexcept
+    {
+        return reinterpret_cast<T*>(m_ptr.get());
+    }
+
+    /**
+    @brief      Gets a pointer to the first channel of a row.
+
+    The channels of the row are contiguous in memory. If T is narrower than
+    the channel type, each channel spans several elements of the row.
+
+    @param[in]  y     The row index.
+    @param[in]  z     The depth index.
+
+    @return     The row pointer.
+    */
+    T* getRow(const uint32_t y, const uint32_t z = 0) const noexcept
+    {
+        return reinterpret_cast<T*>(m_ptr.get() + z * m_depthPitch + y * m_rowPitch);
+    }
+
+    /**
+    @brief      Accesses a channel of a pixel.
+
+    @param[in]  x     The column index.
+    @param[in]  y     The row index.
+    @param[in]  z     The depth index.
+    @param[in]  c     The channel index.
+
+    @return     Reference to the channel value. If T is narrower than the channel
+                type, the reference points to the first bytes of the channel.
+    */
+    T& operator()(const uint32_t x, const uint32_t y, const uint32_t z = 0, const uint32_t c = 0) const noexcept
+    {
+        return *reinterpret_cast<T*>(m_ptr.get() + z * m_depthPitch + y * m_rowPitch + (x * m_channelCount + c) * m_channelTypeSize);
+    }
+
+    uint64_t getRowPitch() const noexcept
+    {
+        return m_rowPitch;
+    }
+
+    uint64_t getDepthPitch() const noexcept
+    {
+        return m_depthPitch;
+    }
+
+    /**
+    @brief      Gets the number of mapped bytes from the first to the last pixel, inclusive.
+
+    @return     The size in bytes.
+    */
+    uint64_t getSize() const noexcept
+    {
+        return (m_shape.z - 1) * m_depthPitch + (m_shape.y - 1) * m_rowPitch + m_shape.x * m_channelCount * m_channelTypeSize;
+    }
+
+private:
+    std::unique_ptr<uint8_t, ll::Image::ImageMapDeleter> m_ptr;
+
+    uint64_t   m_rowPitch {0};
+    uint64_t   m_depthPitch {0};
+    ll::vec3ui m_shape {0, 0, 0};
+    uint32_t   m_channelCount {0};
+    uint64_t   m_channelTypeSize {0};
+};
+
+template <typename T>
+ll::ImageMapping<T> Image::map()
+{
+
+    ll::throwSystemErrorIf(getChannelTypeSize() % sizeof(T) != 0, ll::ErrorCode::MemoryMapFailed,
+        "size of the mapped type (" + std::to_string(sizeof(T)) + " bytes) must divide the channel type size (" + std::to_string(getChannelTypeSize()) + " bytes)");
+
+    auto deleter  = ll::Image::ImageMapDeleter {};
+    deleter.image = this;
+
+    // the subresource offset is applied by mapMemory
+    const auto layout = getSubresourceLayout();
+
+    return ll::ImageMapping<T> {std::unique_ptr<uint8_t, ll::Image::ImageMapDeleter> {mapMemory(), deleter},
+        layout.rowPitch, layout.depthPitch, getShape(), getChannelCount<uint32_t>(), getChannelTypeSize()};
+}
+
 } // namespace ll
 
 #endif /* LLUVIA_CORE_IMAGE_IMAGE_H_ */
@@ -0,0 +1,65 @@
+/**
+@file       CommandTrace.h
+@brief      CommandTrace struct.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_IMPL_COMMAND_TRACE_H_
+#define LLUVIA_CORE_IMPL_COMMAND_TRACE_H_
+
+#include "lluvia/core/image/ImageLayout.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ll {
+
+class ComputeNode;
+class Image;
+
+namespace impl {
+
+    /**
+    @brief      Commands recorded by a ll::impl::CommandTrace.
+    */
+    enum class CommandTraceStepType : uint32_t {
+        Run               = 0,
+        MemoryBarrier     = 1,
+        IndirectBarrier   = 2,
+        ClearImage        = 3,
+        ChangeImageLayout = 4,
+    };
+
+    /**
+    @brief      Command recorded into a ll::CommandBuffer.
+
+    For ChangeImageLayout steps, \p previousLayout holds the layout the
+    image had before the command was recorded.
+    */
+    struct CommandTraceStep {
+        CommandTraceStepType type {CommandTraceStepType::Run};
+        const ll::ComputeNode* node {nullptr};
+        ll::Image*             image {nullptr};
+        ll::ImageLayout        layout {ll::ImageLayout::Undefined};
+        ll::ImageLayout        previousLayout {ll::ImageLayout::Undefined};
+    };
+
+    /**
+    @brief      Sequence of commands recorded into a ll::CommandBuffer.
+
+    When a trace is attached to a command buffer, compute nodes, barriers, image
+    clears and layout changes append a step in the order they are recorded. Any other
+    command is named in \p unsupportedCommand, as the trace no longer describes
+    everything recorded into the command buffer.
+    */
+    struct CommandTrace {
+        std::vector<CommandTraceStep> steps;
+        std::string                   unsupportedCommand;
+    };
+
+} // namespace impl
+} // namespace ll
+
+#endif // LLUVIA_CORE_IMPL_COMMAND_TRACE_H_
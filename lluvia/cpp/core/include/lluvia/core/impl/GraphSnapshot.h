@@ -0,0 +1,174 @@
+/**
+@file       GraphSnapshot.h
+@brief      GraphSnapshot class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_IMPL_GRAPH_SNAPSHOT_H_
+#define LLUVIA_CORE_IMPL_GRAPH_SNAPSHOT_H_
+
+#include "lluvia/core/Object.h"
+#include "lluvia/core/impl/CommandTrace.h"
+#include "lluvia/core/node/Parameter.h"
+#include "lluvia/core/node/PortDescriptor.h"
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ll {
+
+namespace vulkan {
+    class Device;
+} // namespace vulkan
+
+class Buffer;
+class ComputeNode;
+class ContainerNode;
+class Image;
+class Interpreter;
+class Memory;
+class Node;
+class Program;
+class Session;
+
+namespace impl {
+
+    /**
+    @brief      Serializes initialized node graphs and creates them back without running their builders.
+
+    This class is used by ll::Session::saveGraph and ll::Session::loadGraph.
+
+    A snapshot stores, in dependency order:
+
+    - The programs used by the compute nodes. SPIR-V code is embedded when the
+      program keeps a host copy of it (see ll::Program::hasSpirV), otherwise the
+      program is looked up by name in the session loading the snapshot.
+    - The memories, either one of the default memories of the session or the
+      property flags and page size of a custom one.
+    - The buffers, images and views bound to any node. The content of buffers is stored if
+      they are host visible or can be both source and destination of transfers. The
+      content of images is stored if they can be both source and destination of transfers.
+    - The compute nodes, with their descriptor, port bindings, buffer ranges and dynamic offsets.
+    - The container nodes, with their ports, inner nodes and the commands recorded by
+      ll::ContainerNode::record. Loaded containers replay those commands instead of calling
+      their builder.
+
+    Images aliased as transient images are loaded without aliasing.
+    */
+    class GraphSnapshot {
+
+    public:
+        GraphSnapshot()                     = delete;
+        GraphSnapshot(const GraphSnapshot&) = delete;
+        GraphSnapshot(GraphSnapshot&&)      = delete;
+
+        ~GraphSnapshot() = default;
+
+        GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+        GraphSnapshot& operator=(GraphSnapshot&&)      = delete;
+
+        /**
+        @brief      Writes the graph rooted at \p node into \p out.
+
+        @param[in]  device                The device.
+        @param[in]  session               The session the graph was created from.
+        @param[in]  programs              The program registry of the session, used to name programs.
+        @param[in]  node                  The root node. Every node in the graph must be initialized.
+        @param      out                   The output stream.
+        @param[in]  includePipelineCache  Whether to store the content of the device pipeline cache.
+
+        @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if some node
+                                      is not initialized.
+
+        @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if the graph
+                                      uses features that cannot be stored.
+        */
+        static void save(const std::shared_ptr<ll::vulkan::Device>&  device,
+            ll::Session&                                               session,
+            const std::map<std::string, std::shared_ptr<ll::Program>>& programs,
+            const std::shared_ptr<ll::Node>&                           node,
+            std::ostream&                                              out,
+            const bool                                                 includePipelineCache);
+
+        /**
+        @brief      Creates the graph stored in \p in.
+
+        @param[in]  device       The device.
+        @param      session      The session the graph is created in.
+        @param[in]  interpreter  The interpreter of the session.
+        @param      in           The input stream.
+
+        @return     The root node of the graph, already initialized.
+
+        @throws     std::system_error With error code ll::ErrorCode::IOError if \p in does
+                                      not contain a valid snapshot.
+        */
+        static std::shared_ptr<ll::Node> load(const std::shared_ptr<ll::vulkan::Device>& device,
+            ll::Session&                                                                session,
+            const std::weak_ptr<ll::Interpreter>&                                       interpreter,
+            std::istream&                                                               in);
+
+    private:
+        class Reader;
+        class Writer;
+
+        GraphSnapshot(const std::shared_ptr<ll::vulkan::Device>& device, ll::Session& session);
+
+        uint32_t collectNode(const std::shared_ptr<ll::Node>& node);
+        void     collectObject(const std::shared_ptr<ll::Object>& obj);
+        void     collectMemory(const std::shared_ptr<ll::Memory>& memory);
+        void     collectProgram(const std::shared_ptr<ll::Program>& program, const std::map<std::string, std::shared_ptr<ll::Program>>& programs);
+        void     traceContainer(const ll::ContainerNode& node);
+
+        void writeObject(Writer& writer, ll::Object& obj);
+        void writeComputeNode(Writer& writer, const ll::ComputeNode& node);
+        void writeContainerNode(Writer& writer, const ll::ContainerNode& node);
+        void writePorts(Writer& writer, const std::vector<ll::PortDescriptor>& ports);
+        void writeParameters(Writer& writer, const std::vector<ll::Parameter>& parameters, const std::map<std::string, uint32_t>& indices);
+
+        std::shared_ptr<ll::Object>                         readObject(Reader& reader);
+        std::shared_ptr<ll::Node>                           readComputeNode(Reader& reader, const std::weak_ptr<ll::Interpreter>& interpreter);
+        std::shared_ptr<ll::Node>                           readContainerNode(Reader& reader, const std::weak_ptr<ll::Interpreter>& interpreter);
+        std::vector<ll::PortDescriptor>                     readPorts(Reader& reader);
+        std::vector<std::pair<std::string, ll::Parameter>> readParameters(Reader& reader);
+
+        const std::shared_ptr<ll::Memory>& getMemory(const uint32_t id) const;
+        const std::shared_ptr<ll::Node>&   getNode(const uint32_t id) const;
+        const std::shared_ptr<ll::Object>& getObject(const uint32_t id) const;
+
+        template <typename T>
+        std::shared_ptr<T> getObject(const uint32_t id, const ll::ObjectType type) const;
+
+        std::vector<uint8_t> readBufferContent(ll::Buffer& buffer);
+        std::vector<uint8_t> readImageContent(ll::Image& image);
+        void                 writeBufferContent(ll::Buffer& buffer, const std::vector<uint8_t>& content);
+        void                 writeImageContent(ll::Image& image, const std::vector<uint8_t>& content);
+
+        std::shared_ptr<ll::vulkan::Device> m_device;
+        ll::Session&                        m_session;
+
+        std::vector<std::pair<std::string, std::shared_ptr<ll::Program>>> m_programs;
+        std::vector<std::shared_ptr<ll::Memory>>                          m_memories;
+        std::vector<std::shared_ptr<ll::Object>>                          m_objects;
+        std::vector<std::shared_ptr<ll::Node>>                            m_nodes;
+
+        std::map<const ll::Program*, uint32_t> m_programIds;
+        std::map<const ll::Memory*, uint32_t>  m_memoryIds;
+        std::map<const ll::Object*, uint32_t>  m_objectIds;
+        std::map<const ll::Node*, uint32_t>    m_nodeIds;
+
+        // commands recorded by each container node
+        std::map<const ll::ContainerNode*, ll::impl::CommandTrace> m_traces;
+    };
+
+} // namespace impl
+} // namespace ll
+
+#endif // LLUVIA_CORE_IMPL_GRAPH_SNAPSHOT_H_
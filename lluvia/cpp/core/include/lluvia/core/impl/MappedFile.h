@@ -0,0 +1,57 @@
+/**
+@file       MappedFile.h
+@brief      MappedFile class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_IMPL_MAPPED_FILE_H_
+#define LLUVIA_CORE_IMPL_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ll {
+namespace impl {
+
+    /**
+    @brief      Read-only memory mapping of a whole file.
+
+    Pages are loaded by the operating system on first access and are
+    shared among all the processes mapping the same file.
+    */
+    class MappedFile {
+
+    public:
+        MappedFile()                  = delete;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&&)      = delete;
+
+        /**
+        @brief      Maps a file into the address space of the process.
+
+        @param[in]  filename  The filename.
+
+        @throws     std::system_error With error code ll::ErrorCode::IOError if
+                                      the file cannot be opened or mapped.
+        */
+        MappedFile(const std::string& filename);
+
+        ~MappedFile();
+
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&)      = delete;
+
+        const uint8_t* data() const noexcept;
+        size_t         size() const noexcept;
+
+    private:
+        const uint8_t* m_data {nullptr};
+        size_t         m_size {0};
+    };
+
+} // namespace impl
+} // namespace ll
+
+#endif // LLUVIA_CORE_IMPL_MAPPED_FILE_H_
@@ -0,0 +1,54 @@
+/**
+@file       ObjectShape.h
+@brief      Helper functions to follow the shape of the images bound to nodes.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_IMPL_OBJECT_SHAPE_H_
+#define LLUVIA_CORE_IMPL_OBJECT_SHAPE_H_
+
+#include "lluvia/core/types.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace ll {
+
+class Image;
+class Object;
+
+namespace impl {
+
+    /**
+    @brief      Gets the image of an ll::Image or ll::ImageView object.
+
+    @param[in]  obj   The object. It can be null.
+
+    @return     The image, or null if \p obj is neither an image nor an image view.
+    */
+    std::shared_ptr<ll::Image> getObjectImage(const std::shared_ptr<ll::Object>& obj);
+
+    /**
+    @brief      Scales a shape following the change of a reference shape from \p oldRef to \p newRef.
+
+    A shape is derived from the reference if both its width and height are equal to the
+    reference dimension, a power of two level of it, as in an image pyramid, rounded either
+    down or up, or a power of two multiple of it. Dimensions of one pixel are only derived
+    from a reference of one pixel. Derived shapes have their width and height scaled by the
+    same powers of two, depth is kept.
+
+    @param[in]  shape   The shape.
+    @param[in]  oldRef  The old reference shape.
+    @param[in]  newRef  The new reference shape.
+
+    @return     The scaled shape, or empty if \p shape is not derived from \p oldRef, for
+                instance, the shape of a lookup table or a histogram.
+    */
+    std::optional<ll::vec3ui> scaleShape(const ll::vec3ui& shape, const ll::vec3ui& oldRef, const ll::vec3ui& newRef) noexcept;
+
+} // namespace impl
+} // namespace ll
+
+#endif // LLUVIA_CORE_IMPL_OBJECT_SHAPE_H_
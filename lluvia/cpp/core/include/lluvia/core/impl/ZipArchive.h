@@ -20,12 +20,20 @@
 
 #include "miniz.h"
 
+#include "lluvia/core/impl/MappedFile.h"
+
 #include <string>
 #include <vector>
 
 namespace ll {
 namespace impl {
 
+    /**
+    @brief      Read-only zip archive.
+
+    The archive file is memory mapped, so entries stored without compression
+    can be read in place through ZipArchive::getStoredFileData.
+    */
     class ZipArchive {
 
     public:
@@ -47,7 +55,18 @@ namespace impl {
 
         std::vector<uint8_t> uncompressBinaryFile(mz_zip_archive_file_stat& stat);
 
+        /**
+        @brief      Gets the data of an entry stored without compression.
+
+        @param[in]  stat  The entry stat.
+
+        @return     Pointer to the entry data within the mapped archive, valid
+                    while the archive is alive, or nullptr if the entry is compressed.
+        */
+        const uint8_t* getStoredFileData(const mz_zip_archive_file_stat& stat) const;
+
     private:
+        MappedFile     mFile;
         mz_zip_archive mArchive {};
     };
 
@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "lluvia/core/vulkan/vulkan.hpp"
@@ -20,6 +21,7 @@
 #include "lluvia/core/buffer/BufferUsageFlags.h"
 #include "lluvia/core/memory/MemoryFreeSpaceManager.h"
 #include "lluvia/core/memory/MemoryPropertyFlags.h"
+#include "lluvia/core/types.h"
 
 namespace ll {
 
@@ -29,12 +31,43 @@ namespace vulkan {
 
 // forward declarations
 class Buffer;
+class ComputeNode;
 class Image;
 class ImageDescriptor;
 class ImageView;
 class ImageViewDescriptor;
+class Object;
 class Session;
 
+namespace impl {
+
+    /**
+    @brief      Memory range shared by aliased images.
+
+    The range is released back to its ll::Memory once every image aliasing
+    it is deleted.
+    */
+    class AliasedMemoryBlock {
+
+    public:
+        AliasedMemoryBlock(const std::shared_ptr<ll::Memory>& memory, const ll::MemoryAllocationInfo& allocInfo);
+        AliasedMemoryBlock(const AliasedMemoryBlock&) = delete;
+        AliasedMemoryBlock(AliasedMemoryBlock&&)      = delete;
+
+        ~AliasedMemoryBlock();
+
+        AliasedMemoryBlock& operator=(const AliasedMemoryBlock&) = delete;
+        AliasedMemoryBlock& operator=(AliasedMemoryBlock&&)      = delete;
+
+        const ll::MemoryAllocationInfo& getAllocationInfo() const noexcept;
+
+    private:
+        std::shared_ptr<ll::Memory> m_memory;
+        ll::MemoryAllocationInfo    m_allocInfo;
+    };
+
+} // namespace impl
+
 /**
 @brief      Vulkan heap information
 */
@@ -59,6 +92,115 @@ struct VkHeapInfo {
     Family queue indices this memory will be used on.
     */
     std::vector<uint32_t> familyQueueIndices;
+
+    /**
+    Other memory types matching the requested flags, in the order they are tried
+    when a page cannot be allocated in the type at typeIndex.
+    */
+    std::vector<uint32_t> fallbackTypeIndices;
+};
+
+/**
+@brief      Budget of a memory heap used by a ll::Memory.
+*/
+struct MemoryHeapBudget {
+
+    /**
+    Index of the Vulkan memory heap.
+    */
+    uint32_t heapIndex;
+
+    /**
+    Bytes the process can allocate in the heap. If VK_EXT_memory_budget is not
+    available, this is the heap size.
+    */
+    uint64_t budget;
+
+    /**
+    Bytes currently allocated in the heap by the process. If VK_EXT_memory_budget
+    is not available, only the pages allocated by this ll::Memory are counted.
+    */
+    uint64_t usage;
+};
+
+/**
+@brief      Usage statistics of a memory page.
+*/
+struct MemoryPageStatistics {
+
+    /**
+    Page index.
+    */
+    uint32_t page;
+
+    /**
+    Index of the Vulkan memory type the page is allocated from.
+    */
+    uint32_t memoryTypeIndex;
+
+    /**
+    True if the page is a dedicated allocation holding a single object.
+    */
+    bool dedicated;
+
+    /**
+    Size in bytes of the Vulkan memory object backing the page.
+    */
+    uint64_t committedSize;
+
+    /**
+    Bytes used by allocated objects, including the padding needed to align them.
+    */
+    uint64_t usedSize;
+
+    /**
+    Size in bytes of the largest contiguous free range.
+    */
+    uint64_t largestFreeSize;
+};
+
+/**
+@brief      Usage statistics of a ll::Memory object.
+*/
+struct MemoryStatistics {
+
+    /**
+    Total size in bytes of the Vulkan memory objects allocated.
+    */
+    uint64_t committedSize;
+
+    /**
+    Total bytes used by allocated objects.
+    */
+    uint64_t usedSize;
+
+    /**
+    Statistics of each allocated page.
+    */
+    std::vector<ll::MemoryPageStatistics> pages;
+};
+
+/**
+@brief      Result of a call to ll::Memory::defragment.
+*/
+struct MemoryDefragmentationResult {
+
+    /**
+    Bytes of object content copied to new locations.
+    */
+    uint64_t movedBytes;
+
+    /**
+    Number of buffers and images moved.
+    */
+    uint32_t movedObjects;
+
+    /**
+    True if every sparse page was processed without exhausting the budget.
+    Calling defragment again will not move any object unless the memory
+    usage changes.
+    */
+    bool complete;
 };
 
 /**
@@ -69,6 +211,13 @@ Within each page, the memory for objects such as ll::Buffer and ll::Image is res
 of such objets can be allocated in the same page. New pages are created on demand and managed
 by this class.
 
+Objects for which the driver prefers or requires a dedicated allocation are placed in a
+page of their own, whose Vulkan memory is released as soon as the object is deleted.
+
+New pages are allocated in the memory type selected by ll::Session::createMemory. If that
+type has no budget left or the allocation fails, the other memory types matching the requested
+flags are tried before throwing a std::system_error with error code ll::ErrorCode::OutOfMemory.
+
 ll::Memory objects are constructed by calling ll::Session::createMemory on a valid session object.
 
 @code
@@ -132,10 +281,102 @@ public:
     /**
     @brief      Gets the number of pages used.
 
+    Pages released by ll::Memory::trim are not counted.
+
     @return     The page count.
     */
     uint32_t getPageCount() const noexcept;
 
+    /**
+    @brief      Gets the usage statistics of this memory.
+
+    @return     The statistics.
+    */
+    ll::MemoryStatistics getStatistics() const;
+
+    /**
+    @brief      Gets the budget of the heaps this memory can allocate pages from.
+
+    @return     One entry per heap.
+    */
+    std::vector<ll::MemoryHeapBudget> getHeapBudgets() const;
+
+    /**
+    @brief      Releases the pages without any object allocated in them.
+
+    The Vulkan memory of each empty page is freed. Its page index can be reused
+    by pages created later on.
+
+    @return     The number of bytes released.
+    */
+    uint64_t trim();
+
+    /**
+    @brief      Enables releasing empty pages automatically.
+
+    Each time an object is deleted and leaves its page empty, the total size of
+    the empty pages is compared with \p highThreshold. If it is greater, empty pages
+    are released until their total size is less or equal than \p lowThreshold.
+    Keeping some empty pages avoids allocating and freeing Vulkan memory when
+    objects are created and deleted repeatedly.
+
+    @param[in]  highThreshold  Size in bytes of empty pages that triggers the release.
+    @param[in]  lowThreshold   Size in bytes of empty pages kept after the release.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p lowThreshold is greater than \p highThreshold.
+    */
+    void enableAutoTrim(const uint64_t highThreshold, const uint64_t lowThreshold);
+
+    /**
+    @brief      Disables releasing empty pages automatically.
+    */
+    void disableAutoTrim() noexcept;
+
+    /**
+    @brief      Determines if empty pages are released automatically.
+
+    @return     True if enabled, False otherwise.
+    */
+    bool isAutoTrimEnabled() const noexcept;
+
+    /**
+    @brief      Moves objects out of sparsely used pages.
+
+    Pages using at most half of their size are processed from the least to
+    the most used one. Each live buffer and image in them is copied with a
+    transfer command into free space of the other pages, and its Vulkan
+    object is replaced by one bound to the new location. No new page is
+    allocated while defragmenting. Pages left empty can be released with
+    ll::Memory::trim, or automatically if auto-trim is enabled.
+
+    Views of moved images are recreated, and every descriptor set of the compute
+    nodes bound to moved objects is updated, not only the selected one, see
+    ll::ComputeNode::setFrameIndex. Command buffers recorded with
+    any of the moved objects must be recorded again, and none of the objects
+    of this memory can be in use by the device during this call.
+
+    The following objects are never moved:
+        - Buffers without ll::BufferUsageFlagBits::TransferSrc and ll::BufferUsageFlagBits::TransferDst usage.
+        - Images without ll::ImageUsageFlagBits::TransferSrc and ll::ImageUsageFlagBits::TransferDst usage.
+        - Aliased images.
+        - Objects in a page currently mapped to host memory.
+
+    The work can be split in several calls by setting a budget. Objects are
+    copied one page at a time, and the call returns once the moved bytes or
+    the elapsed time reach their budget.
+
+    @param[in]  maxBytes         Maximum number of bytes moved. Zero means no limit.
+    @param[in]  maxMicroseconds  Time budget in microseconds, checked after each page.
+                                 Zero means no limit.
+
+    @return     The defragmentation result.
+
+    @throws     std::system_error With error code ll::ErrorCode::VulkanError if the
+                                  copy commands cannot be submitted.
+    */
+    ll::MemoryDefragmentationResult defragment(const uint64_t maxBytes = 0, const uint64_t maxMicroseconds = 0);
+
     /**
     @brief      Determines if this memory is mappable to host-visible memory.
 
@@ -156,6 +397,19 @@ public:
     */
     bool isPageMappable(const uint32_t page) const noexcept;
 
+    /**
+    @brief      Determines if a certain memory page is host coherent.
+
+    Pages allocated from memory types without ll::MemoryPropertyFlagBits::HostCoherent
+    are mapped as a whole. Their mapped range is invalidated after mapping and
+    flushed before unmapping, so that host and device writes are visible to each other.
+
+    @param[in]  page  The page index.
+
+    @return     True if the page is host coherent or it is not host visible.
+    */
+    bool isPageHostCoherent(const uint32_t page) const noexcept;
+
     /**
     @brief      Creates a buffer.
 
@@ -202,6 +456,36 @@ public:
     */
     std::shared_ptr<ll::Buffer> createBufferWithUnsafeFlags(const uint64_t size, const uint32_t usageFlags);
 
+    /**
+    @brief      Creates a buffer aliasing host memory allocated by the caller.
+
+    The host memory is imported through VK_EXT_external_memory_host without
+    copying it. Reads and writes of the device through the buffer are visible
+    to the host and vice-versa, once the commands using the buffer complete.
+
+    The imported memory is placed in its own memory page, which is
+    released when the buffer is deleted.
+
+    @param[in]  ptr         The host pointer. It must be aligned to the device's
+                            minImportedHostPointerAlignment and remain valid
+                            until the returned buffer is deleted.
+    @param[in]  size        The size in bytes. It must be a multiple of the
+                            device's minImportedHostPointerAlignment.
+    @param[in]  usageFlags  The buffer usage flags.
+
+    @return     A new ll::Buffer object.
+
+    @throws     std::system_error With error code ll::ErrorCode::ExtensionNotFound if
+                                  VK_EXT_external_memory_host is not enabled.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p ptr or \p size are not aligned.
+
+    @throws     std::system_error With error code ll::ErrorCode::ObjectAllocationError if
+                                  none of the memory types of this memory can import \p ptr.
+    */
+    std::shared_ptr<ll::Buffer> importHostMemory(void* ptr, const uint64_t size, const ll::BufferUsageFlags usageFlags);
+
     /**
     @brief      Creates a new ll::Image object.
 
@@ -245,15 +529,94 @@ public:
         const ll::ImageDescriptor&     imgDescriptor,
         const ll::ImageViewDescriptor& viewDescriptor);
 
+    /**
+    @brief      Makes images with non-overlapping lifetimes share the same memory.
+
+    The lifetime of each image is given as the closed interval of steps of a
+    schedule in which the image content is needed. Images whose lifetimes do not
+    overlap are placed at overlapping ranges of a single allocation, reducing the
+    memory needed to hold all of them.
+
+    The Vulkan image of each object is recreated and bound to the shared
+    allocation, and the views created from it are updated accordingly. The
+    previous allocation of each image is released. After this call, the content
+    of the images is undefined and their layout is ll::ImageLayout::Undefined.
+    Descriptor sets referring to the images or their views must be updated by
+    binding the objects again.
+
+    @param[in]  images     The images. They must be allocated in this memory and not be aliased already.
+    @param[in]  lifetimes  The first and last step in which each image is used.
+
+    @return     The size in bytes of the allocation shared by the images.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p images
+                                  and \p lifetimes have different sizes, an image is not
+                                  allocated in this memory, is already aliased, or a lifetime
+                                  interval is not valid.
+    */
+    uint64_t aliasImages(const std::vector<std::shared_ptr<ll::Image>>& images,
+        const std::vector<std::pair<uint32_t, uint32_t>>&               lifetimes);
+
+    /**
+    @brief      Changes the shape of an image allocated in this memory.
+
+    The Vulkan image is recreated with the new shape. Its current allocation is kept
+    if the new image fits in it, otherwise a new one is made in this memory and the
+    previous one is released. Aliased images always move to a new allocation, leaving
+    the shared block of the remaining images untouched.
+
+    The views created from the image are updated and the compute nodes the image is
+    bound to get their descriptor sets rewritten. Command buffers recording those nodes
+    must be recorded again. After this call, the content of the image is undefined, and its
+    layout is the same as before unless it was ll::ImageLayout::Undefined or
+    ll::ImageLayout::Preinitialized.
+
+    @param      image  The image. It must be allocated in this memory and not be in use by the device.
+    @param[in]  shape  The new shape.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p image is not
+                                  allocated in this memory or any component of \p shape is zero.
+    */
+    void reshapeImage(ll::Image& image, const ll::vec3ui& shape);
+
 private:
+    vk::Buffer createVkBuffer(const uint64_t size, const ll::BufferUsageFlags usageFlags);
+    vk::Image  createVkImage(const ll::ImageDescriptor& descriptor);
+
+    vk::MemoryRequirements getBufferMemoryRequirements(const vk::Buffer& vkBuffer, bool& dedicated) const;
+    vk::MemoryRequirements getImageMemoryRequirements(const vk::Image& vkImage, bool& dedicated) const;
+
+    uint32_t getMemoryTypeBits() const noexcept;
+    uint32_t allocatePage(const uint64_t size, const uint32_t memoryTypeBits, const void* allocateInfoNext, const bool dedicated);
+    void     releasePage(const uint32_t page);
+
     impl::MemoryAllocationTryInfo getSuitableMemoryPage(const vk::MemoryRequirements& memRequirements);
+    impl::MemoryAllocationTryInfo getDedicatedMemoryPage(const vk::MemoryRequirements& memRequirements, const vk::MemoryDedicatedAllocateInfo& dedicatedInfo);
     void                          releaseMemoryAllocation(const ll::MemoryAllocationInfo& allocInfo);
 
+    uint64_t getEmptyPagesSize() const noexcept;
+    uint64_t releaseEmptyPages(const uint64_t keepSize);
+
+    bool tryAllocateInPages(const vk::MemoryRequirements& memRequirements,
+        const std::vector<bool>&                          allowedPages,
+        impl::MemoryAllocationTryInfo&                    tryInfo);
+
+    uint64_t defragmentPage(const uint32_t page, const std::vector<bool>& allowedPages,
+        const uint64_t maxBytes, uint32_t& movedObjects, bool& budgetReached);
+
+    void rebindComputeNodes(std::vector<std::weak_ptr<ll::ComputeNode>>& nodes, const ll::Object& obj) const;
+    void pruneObjectRegistry();
+
+    void* mapPageRange(const uint32_t page, const uint64_t offset, const uint64_t size);
+    void  unmapPage(const uint32_t page);
+
     void  releaseBuffer(const ll::Buffer& buffer);
     void* mapBuffer(const ll::Buffer& buffer);
     void  unmapBuffer(const ll::Buffer& buffer);
 
-    void releaseImage(const ll::Image& image);
+    void  releaseImage(const ll::Image& image);
+    void* mapImage(const ll::Image& image);
+    void  unmapImage(const ll::Image& image);
 
     std::shared_ptr<ll::vulkan::Device> m_device;
 
@@ -263,9 +626,20 @@ private:
     std::vector<vk::DeviceMemory>                 m_memoryPages;
     std::vector<ll::impl::MemoryFreeSpaceManager> m_pageManagers;
     std::vector<bool>                             m_memoryPageMappingFlags;
+    std::vector<bool>                             m_memoryPageDedicatedFlags;
+    std::vector<uint32_t>                         m_memoryPageTypeIndices;
+
+    // live objects allocated in this memory, used for relocating them while defragmenting
+    std::vector<std::weak_ptr<ll::Buffer>> m_buffers;
+    std::vector<std::weak_ptr<ll::Image>>  m_images;
+
+    bool     m_isAutoTrimEnabled {false};
+    uint64_t m_autoTrimHighThreshold {0};
+    uint64_t m_autoTrimLowThreshold {0};
 
     friend class ll::Buffer;
     friend class ll::Image;
+    friend class ll::impl::AliasedMemoryBlock;
 };
 
 } // namespace ll
@@ -43,6 +43,11 @@ namespace impl {
         uint64_t getSize() const noexcept;
         uint64_t getFreeSpaceCount() const noexcept;
 
+        // bytes used by allocations, including the padding needed to align them
+        uint64_t getUsedSize() const noexcept;
+        uint64_t getLargestFreeSize() const noexcept;
+        bool     isEmpty() const noexcept;
+
         const std::vector<uint64_t>& getOffsetVector() const noexcept;
         const std::vector<uint64_t>& getSizeVector() const noexcept;
 
@@ -57,6 +62,7 @@ namespace impl {
 
     private:
         uint64_t m_size {0};
+        uint64_t m_usedSize {0};
 
         // separate offset and size vectors help to keep data locality
         // when scanning for inserting or deleting a new interval.
@@ -15,6 +15,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "lluvia/core/vulkan/vulkan.hpp"
 
@@ -24,12 +26,21 @@ namespace vulkan {
     class Device;
 } // namespace vulkan
 
+namespace impl {
+    class GraphSnapshot;
+} // namespace impl
+
 class Buffer;
+class BufferView;
 class CommandBuffer;
+class ComputeNodeBuilder;
+class ContainerNode;
 class Image;
 class ImageView;
 class Interpreter;
+class Memory;
 class Object;
+class ParameterBlock;
 class Program;
 
 /**
@@ -49,6 +60,9 @@ public:
     @param[in]  descriptor  The descriptor. A copy of this descriptor is kept within this object.
                              So this one can be modified after the compute node is constructed.
     @param[in]  interpreter Interpreter to use for running Lua scripts.
+    @param[in]  builder     Native builder of the node. If not null, its onNodeInit method
+                            is called when the node is initialized instead of the Lua builder
+                            named in the descriptor.
 
     @throws     std::system_error With error code ll::ErrorCode::InvalidShaderFunctionName
                                   if desc.getFunctionName() is empty string.
@@ -58,10 +72,15 @@ public:
 
     @throws     std::system_error With error code ll::ErrorCode::InvalidLocalShape
                                   if any of the components of descriptor.localShape is zero.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound or ll::ErrorCode::PortBindingError
+                                  if the indirect dispatch port is not a ll::PortType::Buffer port
+                                  of the descriptor.
     */
     ComputeNode(const std::shared_ptr<ll::vulkan::Device>& device,
         const ll::ComputeNodeDescriptor&                   descriptor,
-        const std::weak_ptr<ll::Interpreter>&              interpreter);
+        const std::weak_ptr<ll::Interpreter>&              interpreter,
+        const std::shared_ptr<ll::ComputeNodeBuilder>&     builder = nullptr);
 
     virtual ~ComputeNode();
 
@@ -217,10 +236,61 @@ public:
     /**
     @brief      Configures the grid shape given a global shape.
 
+    The global shape is kept to scale the grid in ll::ComputeNode::scaleGridShape.
+
     @param[in]  globalShape  The global shape.
     */
     void configureGridShape(const ll::vec3ui& globalShape) noexcept;
 
+    /**
+    @brief      Scales the grid shape following the change of shape of the images bound to the ports.
+
+    The first port image whose width or height changed since the node was initialized, or
+    since the last call to ll::ComputeNode::reinit, is taken as reference. The width and
+    height of the global shape set with ll::ComputeNode::configureGridShape are scaled
+    following the reference if both are derived from it: equal to the reference dimension,
+    a power of two level of it, as in an image pyramid, or a power of two multiple of it.
+    Otherwise the grid shape is kept. If the grid was not configured from a global shape,
+    the grid shape times the local shape is used instead.
+
+    The grid shape is kept if no port image changed. Changes in the size of buffers are
+    not considered.
+
+    This is the default behavior of ll::ComputeNode::reinit for builders not implementing
+    `onNodeReshape`.
+    */
+    void scaleGridShape();
+
+    /**
+    @brief      Sets the grid offset.
+
+    See ll::ComputeNodeDescriptor::setGridOffset for more information.
+
+    The offset is read when the node is recorded into a ll::CommandBuffer.
+    Hence, several regions of the same node can be recorded in a single
+    command buffer by changing the offset between calls to ll::CommandBuffer::run.
+
+    @param[in]  offset  The grid offset in number of local groups.
+    */
+    void setGridOffset(const ll::vec3ui& offset) noexcept;
+
+    /**
+    @brief      Configures the grid offset and shape to cover a region of interest.
+
+    See ll::ComputeNodeDescriptor::configureGridRegion for more information.
+
+    @param[in]  globalOffset  The offset of the region in global coordinates.
+    @param[in]  globalShape   The shape of the region in global coordinates.
+    */
+    void configureGridRegion(const ll::vec3ui& globalOffset, const ll::vec3ui& globalShape);
+
+    /**
+    @brief      Gets the grid offset.
+
+    @return     The grid offset in number of local groups.
+    */
+    ll::vec3ui getGridOffset() const noexcept;
+
     /**
     @brief      Gets the grid shape.
 
@@ -234,27 +304,313 @@ public:
 
     std::shared_ptr<ll::Object> getPort(const std::string& name) const override;
 
-    void setPushConstants(const ll::PushConstants& constants) noexcept;
+    /**
+    @brief      Gets the object bound to a port given its index.
+
+    @param[in]  index  The port index, as returned by ll::ComputeNodeDescriptor::getPortIndex.
+
+    @return     The object.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range or no object is bound to the port.
+    */
+    std::shared_ptr<ll::Object> getPort(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a port.
+
+    See ll::ComputeNodeDescriptor::getPortIndex.
+
+    @param[in]  name  The port name.
+
+    @return     The port index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if name is not
+                                  in the ports table.
+    */
+    uint32_t getPortIndex(const std::string& name) const;
+
+    /**
+    @brief      Sets the push constants.
+
+    If a ll::ParameterBlock is bound to this node and the node is initialized,
+    \p constants are also written into the current parameter block slot. Command
+    buffers recorded with this node see the new values in their next submission.
+    Submissions using the current slot must have completed execution.
+
+    @param[in]  constants  The constants.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  the size of \p constants is greater than the parameter block size.
+    */
+    void setPushConstants(const ll::PushConstants& constants);
 
     const ll::PushConstants& getPushConstants() const noexcept;
 
+    /**
+    @brief      Sets the specialization constants.
+
+    This method must be called before the node is initialized, for instance
+    from the `onNodeInit` function of the node builder. Changes made after
+    initialization have no effect on the compute pipeline.
+
+    @param[in]  constants  The constants.
+    */
+    void setSpecializationConstants(const ll::SpecializationConstants& constants) noexcept;
+
+    const ll::SpecializationConstants& getSpecializationConstants() const noexcept;
+
+    /**
+    @brief      Binds a parameter block to this node.
+
+    The descriptor of this node must have the parameter-block mode enabled. At
+    initialization, the push constants of the node are written into all the slots
+    of \p block.
+
+    @param[in]  block  The parameter block.
+
+    @throws     std::system_error With error code ll::ErrorCode::PortBindingError if
+                                  the parameter-block mode is not enabled in the descriptor.
+
+    @sa ll::ComputeNodeDescriptor::setParameterBlockBinding
+    */
+    void bindParameterBlock(const std::shared_ptr<ll::ParameterBlock>& block);
+
+    const std::shared_ptr<ll::ParameterBlock>& getParameterBlock() const noexcept;
+
+    /**
+    @brief      Sets the parameter block slot used by subsequent calls to ll::ComputeNode::record.
+
+    @param[in]  slot  The slot.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  there is no parameter block bound or \p slot is out of range.
+    */
+    void setParameterBlockSlot(const uint32_t slot);
+
+    uint32_t getParameterBlockSlot() const noexcept;
+
+    /**
+    @brief      Selects the descriptor set used by subsequent calls to ll::ComputeNode::record and ll::ComputeNode::bind.
+
+    The descriptor set index is \p frameIndex modulo ll::ComputeNodeDescriptor::getDescriptorSetCount.
+    Ports bound while other descriptor sets were selected are written into the selected
+    set before this method returns. Hence, command buffers using the selected set must
+    have completed execution, and must be recorded again before their next submission.
+
+    If a ll::ParameterBlock is bound to this node, the parameter block slot is also
+    selected, as \p frameIndex modulo ll::ParameterBlock::getSlotCount.
+
+    @code
+        // descriptor.setDescriptorSetCount(2)
+        for (auto frame = 0u; frame < frames.size(); ++frame) {
+
+            // waits for the submission two frames behind, which used the same descriptor set
+            waitFrame(frame - 2);
+
+            node->setFrameIndex(frame);
+            node->bind(inGray, frames[frame]);
+            submitFrame(frame, *node);
+        }
+    @endcode
+
+    @param[in]  frameIndex  The frame index.
+    */
+    void setFrameIndex(const uint32_t frameIndex);
+
+    /**
+    @brief      Gets the index of the descriptor set selected with ll::ComputeNode::setFrameIndex.
+
+    @return     The descriptor set index.
+    */
+    uint32_t getDescriptorSetIndex() const noexcept;
+
+    /**
+    @brief      Creates a new node sharing the compute pipeline of this node.
+
+    The new node uses the pipeline, pipeline layout and descriptor set layout
+    of this node, and allocates only its own descriptor sets. Its descriptor
+    is a copy of the descriptor of this node, including the grid shape and
+    push constants. Its ports are not bound.
+
+    Calling ll::ComputeNode::init on the new node does not run the node builder.
+
+    @return     The new node.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if
+                                  this node is not initialized.
+
+    @sa ll::ContainerNode::instantiate
+    */
+    std::shared_ptr<ll::ComputeNode> instantiate() const;
+
+    /**
+    @brief      Configures this node again for the objects currently bound to its ports.
+
+    This method is meant to be called after binding objects of a different shape
+    to an initialized node, or after reshaping them with ll::Image::reshape. The
+    `onNodeReshape` function of the node builder is called to configure the node for
+    the current ports. It only updates the node, typically its grid shape, and does
+    not create or bind any object, as `onNodeInit` does. Builders without `onNodeReshape`
+    and nodes without a builder call ll::ComputeNode::scaleGridShape.
+
+    The pipeline and layouts created by ll::ComputeNode::init are kept, as well as the
+    content of the parameter block bound to the node. Command buffers recording this
+    node must be recorded again.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if
+                                  this node is not initialized.
+
+    @sa ll::ContainerNode::reinit
+    */
+    void reinit();
+
     void bind(const std::string& name, const std::shared_ptr<ll::Object>& obj) override;
 
+    /**
+    @brief      Binds a ll::Object to a port given its index.
+
+    Rebinding a port through its index avoids looking up the port name, which
+    is useful when the inputs of a node are bound again for every frame.
+
+    @code
+        const auto inGray = node->getPortIndex("in_gray");
+
+        for (const auto& frame : frames) {
+            node->bind(inGray, frame);
+            session->run(*node);
+        }
+    @endcode
+
+    @param[in]  index  The port index, as returned by ll::ComputeNodeDescriptor::getPortIndex.
+    @param[in]  obj    The object to bind.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range, or ll::ErrorCode::PortBindingError if \p obj
+                                  cannot be bound to the port.
+    */
+    void bind(const uint32_t index, const std::shared_ptr<ll::Object>& obj);
+
+    /**
+    @brief      Binds a range of a buffer to a port.
+
+    Several nodes, or several ports of the same node, can read small
+    blocks of data from a single buffer by binding different ranges of it.
+
+    Ports of type ll::PortType::UniformBufferDynamic and ll::PortType::StorageBufferDynamic
+    must be bound with this method. For those ports, the range is further displaced
+    by the offset set with ll::ComputeNode::setDynamicOffset, which is reset to zero.
+
+    @param[in]  name    The port name.
+    @param[in]  buffer  The buffer.
+    @param[in]  offset  The offset in bytes of the range. It must be a multiple of the
+                        device's minUniformBufferOffsetAlignment or minStorageBufferOffsetAlignment
+                        limit, according to the port type.
+    @param[in]  range   The size in bytes of the range. It must be greater than zero.
+
+    @throws     std::system_error With error code ll::ErrorCode::PortBindingError if
+                                  \p buffer is not valid for the port.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  the range is empty, exceeds the buffer size or
+                                  \p offset is not aligned.
+    */
+    void bindRange(const std::string& name, const std::shared_ptr<ll::Buffer>& buffer, const uint64_t offset, const uint64_t range);
+
+    /**
+    @brief      Sets the dynamic offset of a port.
+
+    The offset is read when the node is recorded into a ll::CommandBuffer and is
+    added to the offset of the range bound to the port. Hence, the data read by
+    the node can be switched between submissions by recording the command buffer
+    again, without updating the descriptor set of the node.
+
+    @param[in]  name    The port name. The port must be of type ll::PortType::UniformBufferDynamic
+                        or ll::PortType::StorageBufferDynamic and bound with ll::ComputeNode::bindRange.
+    @param[in]  offset  The offset in bytes. It must be aligned as the offset passed to
+                        ll::ComputeNode::bindRange.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  the port is not dynamic or not bound, \p offset is not aligned,
+                                  or the displaced range exceeds the buffer size.
+    */
+    void setDynamicOffset(const std::string& name, const uint32_t offset);
+
+    /**
+    @brief      Gets the dynamic offset of a port.
+
+    @param[in]  name  The port name.
+
+    @return     The dynamic offset in bytes. Zero if it has not been set.
+    */
+    uint32_t getDynamicOffset(const std::string& name) const;
+
     void record(ll::CommandBuffer& commandBuffer) const override;
 
+    uint32_t getStencilRadius() const noexcept override;
+
     void setParameter(const std::string& name, const ll::Parameter& value) override;
 
     const ll::Parameter& getParameter(const std::string& name) const override;
 
+    /**
+    @brief      Sets the value of a parameter given its index.
+
+    @param[in]  index  The parameter index, as returned by ll::ComputeNodeDescriptor::getParameterIndex.
+    @param[in]  value  The value.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    void setParameter(const uint32_t index, const ll::Parameter& value);
+
+    /**
+    @brief      Gets a parameter given its index.
+
+    @param[in]  index  The parameter index, as returned by ll::ComputeNodeDescriptor::getParameterIndex.
+
+    @return     The parameter.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    const ll::Parameter& getParameter(const uint32_t index) const;
+
 protected:
     void onInit() override;
 
 private:
+    explicit ComputeNode(const std::shared_ptr<const ll::ComputeNode>& prototype);
+
     void initPortBindings();
     void initPipeline();
 
-    void bindBuffer(const ll::PortDescriptor& port, const std::shared_ptr<ll::Buffer>& buffer);
-    void bindImageView(const ll::PortDescriptor& port, const std::shared_ptr<ll::ImageView>& imageView);
+    // runs the onNodeInit function of the native or Lua builder of this node
+    void runBuilderInit();
+
+    // runs the onNodeReshape function of the native or Lua builder of this node
+    void runBuilderReshape();
+
+    // keeps the shape of the images bound to the ports, used by scaleGridShape()
+    void saveInitPortShapes();
+
+    void bindBuffer(const uint32_t index, const std::shared_ptr<ll::Buffer>& buffer);
+    void bindImageView(const uint32_t index, const std::shared_ptr<ll::ImageView>& imageView);
+    void bindBufferView(const uint32_t index, const std::shared_ptr<ll::BufferView>& bufferView);
+
+    // writes the descriptor of the port at index into the selected descriptor set,
+    // deferring the update of the other sets until they are selected.
+    void updatePortDescriptor(const uint32_t index);
+    void writePortDescriptor(const uint32_t index, const vk::DescriptorSet& descriptorSet);
+
+    uint64_t getMinOffsetAlignment(const ll::PortType portType) const;
+
+    // writes again the descriptors of the ports bound to obj, or to a view of it, in every
+    // descriptor set, as the previous Vulkan objects may already be destroyed.
+    void rebind(const ll::Object& obj);
+
+    // writes the descriptor of the port at index into every descriptor set
+    void writePortDescriptors(const uint32_t index);
 
     std::vector<vk::DescriptorPoolSize> getDescriptorPoolSizes() const noexcept;
     uint32_t                            countDescriptorType(const vk::DescriptorType type) const noexcept;
@@ -266,21 +622,49 @@ private:
     vk::PipelineLayout m_pipelineLayout;
     vk::Pipeline       m_pipeline;
 
-    vk::DescriptorSet  m_descriptorSet;
-    vk::DescriptorPool m_descriptorPool;
+    std::vector<vk::DescriptorSet> m_descriptorSets;
+    vk::DescriptorPool             m_descriptorPool;
+    uint32_t                       m_descriptorSetIndex {0};
+
+    // port indices whose descriptors are outdated, for each descriptor set
+    std::vector<std::vector<uint32_t>> m_outdatedPorts;
 
     ll::ComputeNodeDescriptor m_descriptor;
 
     std::vector<vk::DescriptorSetLayoutBinding> m_parameterBindings;
 
-    // specialization constants
-    // vk::SpecializationInfo specializationInfo;
-    // std::vector<vk::SpecializationMapEntry> specializationMapEntries;
-    // // uint32_t local_x {1};
+    // objects bound to the ports, by port index. Unbound ports are null.
+    std::vector<std::shared_ptr<ll::Object>> m_objects;
+
+    // offset and size of the buffer ranges bound with bindRange(), by port index
+    std::map<uint32_t, std::pair<uint64_t, uint64_t>> m_bufferRanges;
+
+    // dynamic offsets of the ports, by binding index
+    std::map<uint32_t, uint32_t> m_dynamicOffsets;
+
+    std::shared_ptr<ll::ParameterBlock> m_parameterBlock;
+    uint32_t                            m_parameterBlockSlot {0};
+
+    std::weak_ptr<ll::Interpreter>          m_interpreter;
+    std::shared_ptr<ll::ComputeNodeBuilder> m_builder;
+
+    // transient images whose lifetime starts at this node. Their previous
+    // content is discarded when the node is recorded.
+    std::vector<std::shared_ptr<ll::Image>> m_transientImages;
+
+    // node whose pipeline and layouts are used by this one. Null if this node owns them.
+    std::shared_ptr<const ll::ComputeNode> m_prototype;
+
+    // global shape given to configureGridShape(). Zero if the grid was set otherwise.
+    ll::vec3ui m_globalShape;
 
-    std::map<std::string, std::shared_ptr<ll::Object>> m_objects;
+    // shape of the images bound to the ports at the last init or reinit, by port index.
+    // Zero for ports not bound to images.
+    std::vector<ll::vec3ui> m_initPortShapes;
 
-    std::weak_ptr<ll::Interpreter> m_interpreter;
+    friend class ll::ContainerNode;
+    friend class ll::Memory;
+    friend class ll::impl::GraphSnapshot;
 };
 
 } // namespace ll
@@ -11,6 +11,7 @@
 #include "lluvia/core/node/Node.h"
 #include "lluvia/core/node/Parameter.h"
 #include "lluvia/core/node/PushConstants.h"
+#include "lluvia/core/node/SpecializationConstants.h"
 
 #include "lluvia/core/types.h"
 
@@ -19,9 +20,14 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace ll {
 
+namespace impl {
+    class GraphSnapshot;
+} // namespace impl
+
 class ComputeNode;
 class Program;
 
@@ -74,6 +80,19 @@ public:
     */
     ComputeNodeDescriptor& setParameter(const std::string& name, const ll::Parameter& value);
 
+    /**
+    @brief      Sets the value of an existing parameter given its index.
+
+    @param[in]  index  The parameter index, as returned by ll::ComputeNodeDescriptor::getParameterIndex.
+    @param[in]  value  The value.
+
+    @return     A reference to this object.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    ComputeNodeDescriptor& setParameter(const uint32_t index, const ll::Parameter& value);
+
     /**
     @brief      Sets the function name within the program object to run in the ll::ComputeNode.
 
@@ -193,6 +212,51 @@ public:
     */
     ComputeNodeDescriptor& configureGridShape(const ll::vec3ui& globalShape) noexcept;
 
+    /**
+    @brief      Sets the grid offset.
+
+    The grid offset defines the index of the first local group
+    to be run, allowing a node to process only a region of interest
+    of its outputs. It corresponds to the `baseGroupX`, `baseGroupY` and
+    `baseGroupZ` parameters of vkCmdDispatchBase. See @VULKAN_DOC#vkCmdDispatchBase
+    for more information.
+
+    The offset is included in the values of `gl_WorkGroupID` and `gl_GlobalInvocationID`,
+    hence shaders using the `LL_GLOBAL_COORDS_*` macros of `lluvia/core.glsl` do not
+    require any modification.
+
+    @param[in]  offset  The grid offset in number of local groups.
+
+    @return     A reference to this object.
+    */
+    ComputeNodeDescriptor& setGridOffset(const ll::vec3ui& offset) noexcept;
+
+    /**
+    @brief      Configures the grid offset and shape to cover a region of interest.
+
+    The calculation is done as:
+
+    @code
+        gridOffset.x = globalOffset.x / local.x
+        grid.x       = ceil(globalShape.x / local.x)
+    @endcode
+
+    and equivalently for the Y and Z axes.
+
+    @param[in]  globalOffset  The offset of the region in global coordinates. Each component
+                              must be a multiple of the corresponding local shape component.
+    @param[in]  globalShape   The shape of the region in global coordinates.
+
+    @return     A reference to this object.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p globalOffset is not aligned to the local shape.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidLocalShape if
+                                  any component of the local shape is zero.
+    */
+    ComputeNodeDescriptor& configureGridRegion(const ll::vec3ui& globalOffset, const ll::vec3ui& globalShape);
+
     /**
     @brief      Sets the local group size in the X axis.
 
@@ -239,6 +303,109 @@ public:
     */
     ComputeNodeDescriptor& setPushConstants(const ll::PushConstants& constants) noexcept;
 
+    /**
+    @brief      Sets the specialization constants for this compute node.
+
+    The constants are baked into the compute pipeline when the node is initialized.
+    IDs 1 to 3 are reserved for the local shape.
+
+    @param[in]  constants  The specialization constants.
+
+    @return     A reference to this object
+
+    @sa ll::SpecializationConstants
+    */
+    ComputeNodeDescriptor& setSpecializationConstants(const ll::SpecializationConstants& constants) noexcept;
+
+    /**
+    @brief      Enables the parameter-block mode for this compute node.
+
+    In parameter-block mode, the push constants of the node are not pushed at record
+    time. Instead, they are read by the shader from a uniform block at \p binding, backed
+    by a slot of a ll::ParameterBlock bound with ll::ComputeNode::bindParameterBlock.
+    Updating the parameters becomes a host memcpy into the slot, and command buffers
+    recording the node do not need to be recorded again.
+
+    The binding is counted together with the port bindings, so \p binding must not
+    be used by any port.
+
+    @param[in]  binding  The binding of the uniform block in the shader.
+
+    @return     A reference to this object.
+
+    @sa ll::ParameterBlock
+    */
+    ComputeNodeDescriptor& setParameterBlockBinding(const uint32_t binding) noexcept;
+
+    /**
+    @brief      Enables the indirect-dispatch mode for this compute node.
+
+    In indirect-dispatch mode, the grid shape of the node is not taken from this
+    descriptor. Instead, the device reads it when the node is executed from the
+    ll::Buffer bound to port \p portName, at \p offset bytes, as three consecutive
+    `uint32_t` values. Such buffer can be written by a previous node, allowing
+    data-dependent grid sizes.
+
+    The buffer bound to the port must be created with the ll::BufferUsageFlagBits::IndirectBuffer
+    usage flag.
+
+    @param[in]  portName  The name of a ll::PortType::Buffer port of this descriptor.
+    @param[in]  offset    The offset in bytes. It must be a multiple of 4.
+
+    @return     A reference to this object.
+
+    @sa ll::CommandBuffer::dispatchIndirect
+    */
+    ComputeNodeDescriptor& setIndirectDispatch(const std::string& portName, const uint64_t offset = 0) noexcept;
+
+    /**
+    @brief      Sets the stencil radius.
+
+    The stencil radius is the maximum distance, in pixels, between an output
+    pixel and the input pixels read to compute it. For instance, a 5x5
+    convolution has a stencil radius of 2. Point-wise operations have a radius of 0.
+
+    @param[in]  radius  The radius.
+
+    @return     A reference to this object.
+
+    @sa ll::TiledExecutor
+    */
+    ComputeNodeDescriptor& setStencilRadius(const uint32_t radius) noexcept;
+
+    /**
+    @brief      Sets the number of descriptor sets of the compute node.
+
+    With more than one descriptor set, ports can be bound again while command
+    buffers recorded with the node are still executing. Each call to
+    ll::ComputeNode::bind updates only the descriptor set selected with
+    ll::ComputeNode::setFrameIndex. The other sets are updated when they are
+    selected again, which must happen only after the submissions using them
+    have completed.
+
+    A typical value is the number of frames in flight.
+
+    @param[in]  count  The number of descriptor sets. It must be greater than zero.
+                       Defaults to 1.
+
+    @return     A reference to this object.
+    */
+    ComputeNodeDescriptor& setDescriptorSetCount(const uint32_t count) noexcept;
+
+    /**
+    @brief      Disables the indirect-dispatch mode.
+
+    @return     A reference to this object.
+    */
+    ComputeNodeDescriptor& disableIndirectDispatch() noexcept;
+
+    /**
+    @brief      Disables the parameter-block mode.
+
+    @return     A reference to this object.
+    */
+    ComputeNodeDescriptor& disableParameterBlock() noexcept;
+
     /**
     @brief      Gets the program associated to this compute node.
 
@@ -258,6 +425,53 @@ public:
     */
     const ll::PortDescriptor& getPort(const std::string& name) const;
 
+    /**
+    @brief      Gets a port descriptor given its index.
+
+    @param[in]  index  The port index, as returned by ll::ComputeNodeDescriptor::getPortIndex.
+
+    @return     The port descriptor.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    const ll::PortDescriptor& getPort(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a port.
+
+    Ports are indexed in the order they are added to the descriptor. Adding
+    a port with the name of an existing one replaces it and keeps its index.
+    Hence, the index of a port is stable and is the same in the ll::ComputeNode
+    objects created from this descriptor. Indices can be resolved once, for instance
+    in the builder's `onNodeInit`, and then used to bind or read ports without
+    looking up their names.
+
+    @param[in]  name  The port name.
+
+    @return     The port index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if name is not
+                                  in the ports table.
+    */
+    uint32_t getPortIndex(const std::string& name) const;
+
+    /**
+    @brief      Returns whether or not a port exists with a given name.
+
+    @param[in]  name  The port name.
+
+    @return     true if the port exists, false otherwise.
+    */
+    bool hasPort(const std::string& name) const noexcept;
+
+    /**
+    @brief      Gets the number of ports.
+
+    @return     The port count.
+    */
+    size_t getPortCount() const noexcept;
+
     /**
     @brief      Gets a parameter.
 
@@ -270,6 +484,32 @@ public:
     */
     const ll::Parameter& getParameter(const std::string& name) const;
 
+    /**
+    @brief      Gets a parameter given its index.
+
+    @param[in]  index  The parameter index, as returned by ll::ComputeNodeDescriptor::getParameterIndex.
+
+    @return     The parameter.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    const ll::Parameter& getParameter(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a parameter.
+
+    Parameters are indexed in the order they are first set.
+
+    @param[in]  name  The parameter name.
+
+    @return     The parameter index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if name is not
+                                  in the parameters table.
+    */
+    uint32_t getParameterIndex(const std::string& name) const;
+
     /**
     @brief      Gets the function name within the ll::Program object used by this node.
 
@@ -291,6 +531,13 @@ public:
     */
     ll::vec3ui getGridShape() const noexcept;
 
+    /**
+    @brief      Gets the grid offset.
+
+    @return     The grid offset in number of local groups.
+    */
+    ll::vec3ui getGridOffset() const noexcept;
+
     /**
     @brief      Gets the local group shape.
 
@@ -308,6 +555,19 @@ public:
 
     const ll::PushConstants& getPushConstants() const noexcept;
 
+    const ll::SpecializationConstants& getSpecializationConstants() const noexcept;
+
+    bool     isParameterBlockEnabled() const noexcept;
+    uint32_t getParameterBlockBinding() const noexcept;
+
+    bool               isIndirectDispatchEnabled() const noexcept;
+    const std::string& getIndirectDispatchPort() const noexcept;
+    uint64_t           getIndirectDispatchOffset() const noexcept;
+
+    uint32_t getStencilRadius() const noexcept;
+
+    uint32_t getDescriptorSetCount() const noexcept;
+
     std::vector<vk::DescriptorSetLayoutBinding> getParameterBindings() const;
 
 private:
@@ -318,11 +578,28 @@ private:
     // local and global work group
     ll::vec3ui m_localShape {1, 1, 1};
     ll::vec3ui m_gridShape {1, 1, 1};
+    ll::vec3ui m_gridOffset {0, 0, 0};
+
+    // ports and parameters in insertion order, indexed by name
+    std::vector<ll::PortDescriptor>  m_ports;
+    std::vector<ll::Parameter>       m_parameters;
+    std::map<std::string, uint32_t> m_portIndices;
+    std::map<std::string, uint32_t> m_parameterIndices;
+
+    ll::PushConstants           m_pushConstants;
+    ll::SpecializationConstants m_specializationConstants;
+
+    bool     m_parameterBlockEnabled {false};
+    uint32_t m_parameterBlockBinding {0};
+
+    // indirect dispatch port name, empty if disabled
+    std::string m_indirectDispatchPort;
+    uint64_t    m_indirectDispatchOffset {0};
 
-    std::map<std::string, ll::PortDescriptor> m_ports;
-    std::map<std::string, ll::Parameter>      m_parameters;
+    uint32_t m_stencilRadius {0};
+    uint32_t m_descriptorSetCount {1};
 
-    ll::PushConstants m_pushConstants;
+    friend class ll::impl::GraphSnapshot;
 };
 
 } // namespace ll
@@ -10,15 +10,24 @@
 
 #include "lluvia/core/node/ContainerNodeDescriptor.h"
 #include "lluvia/core/node/Node.h"
+#include "lluvia/core/types.h"
 
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ll {
 
+namespace impl {
+    class GraphSnapshot;
+} // namespace impl
+
 class CommandBuffer;
+class ComputeNode;
+class ContainerNodeBuilder;
+class Image;
 class Interpreter;
 
 class ContainerNode : public Node, public std::enable_shared_from_this<ll::ContainerNode> {
@@ -26,7 +35,8 @@ class ContainerNode : public Node, public std::enable_shared_from_this<ll::Conta
 public:
     ContainerNode(const std::weak_ptr<ll::Interpreter>& interpreter);
     ContainerNode(const std::weak_ptr<ll::Interpreter>& interpreter,
-        const ll::ContainerNodeDescriptor&              descriptor);
+        const ll::ContainerNodeDescriptor&              descriptor,
+        const std::shared_ptr<ll::ContainerNodeBuilder>& builder = nullptr);
 
     ContainerNode(const ll::ContainerNode&) = delete;
     ContainerNode(ll::ContainerNode&&)      = delete;
@@ -44,27 +54,272 @@ public:
 
     std::shared_ptr<ll::Object> getPort(const std::string& name) const override;
 
+    /**
+    @brief      Gets the object bound to a port given its index.
+
+    @param[in]  index  The port index, as returned by ll::ContainerNode::getPortIndex.
+
+    @return     The object.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range or no object is bound to the port.
+    */
+    std::shared_ptr<ll::Object> getPort(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a port.
+
+    The ports of the descriptor keep the index given by ll::ContainerNodeDescriptor::getPortIndex.
+    Ports bound by name that are not in the descriptor are indexed after them, in
+    the order they are first bound.
+
+    @param[in]  name  The port name.
+
+    @return     The port index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p name is
+                                  neither a port of the descriptor nor has been bound.
+    */
+    uint32_t getPortIndex(const std::string& name) const;
+
     void bind(const std::string& name, const std::shared_ptr<ll::Object>& obj) override;
 
+    /**
+    @brief      Binds a ll::Object to a port given its index.
+
+    @param[in]  index  The port index, as returned by ll::ContainerNode::getPortIndex.
+    @param[in]  obj    The object to bind.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    void bind(const uint32_t index, const std::shared_ptr<ll::Object>& obj);
+
     void bindNode(const std::string& name, const std::shared_ptr<ll::Node>& node);
 
     std::shared_ptr<ll::Node> getNode(const std::string& name) const;
 
+    /**
+    @brief      Gets a node given its index.
+
+    @param[in]  index  The node index, as returned by ll::ContainerNode::getNodeIndex.
+
+    @return     The node.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    std::shared_ptr<ll::Node> getNode(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a node.
+
+    Nodes are indexed in the order they are first bound with ll::ContainerNode::bindNode.
+    Binding another node with the same name replaces it and keeps its index. Builders
+    can resolve the indices in `onNodeInit` and use them in `onNodeRecord` instead of
+    formatting the node names at every record.
+
+    @param[in]  name  The node name.
+
+    @return     The node index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p name is
+                                  not bound.
+    */
+    uint32_t getNodeIndex(const std::string& name) const;
+
+    /**
+    @brief      Marks an image as transient.
+
+    Transient images hold intermediate results only needed within one execution
+    of this container. Once the builder's `onNodeInit` returns, the container records
+    its schedule once and computes the first and last command using each transient
+    image, either a compute node, an image clear or a layout change. Transient images
+    allocated in the same ll::Memory whose lifetimes do not overlap are then aliased
+    to the same memory range.
+
+    Transient images are excluded from aliasing, and keep their own memory, if they
+    are bound to a port of this container, if the first command using them is not a
+    compute node writing them, or if they are used by a compute node not reachable
+    from this container. No image is aliased if the container records commands other
+    than compute nodes, barriers, image clears and layout changes, such as copies.
+
+    The content of an aliased image is undefined before the first compute node using
+    it runs, which must write all the pixels read by later nodes. Aliased images must
+    not be used outside of this container.
+
+    This method must be called before the initialization of the container completes,
+    typically in the builder's `onNodeInit` function.
+
+    @param[in]  obj   The object. It must be either an ll::Image or an ll::ImageView.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if \p obj is
+                                  not an image or image view.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if the
+                                  transient images have already been aliased.
+
+    @sa ll::Memory::aliasImages
+    */
+    void markTransient(const std::shared_ptr<ll::Object>& obj);
+
+    /**
+    @brief      Gets the size in bytes of the memory shared by the aliased transient images.
+
+    @return     The size.
+    */
+    uint64_t getTransientMemorySize() const noexcept;
+
+    /**
+    @brief      Selects the descriptor set used by the compute nodes of this container.
+
+    Calls ll::ComputeNode::setFrameIndex on every compute node reachable from this container.
+
+    @param[in]  frameIndex  The frame index.
+    */
+    void setFrameIndex(const uint32_t frameIndex);
+
+    /**
+    @brief      Creates a new instance of this container.
+
+    Instances run the same graph as this container with their own inputs and outputs.
+    They are cheaper to create than a new container because none of the node builders
+    runs during their initialization:
+
+    - The compute nodes of the instance share the pipelines and layouts of the compute
+      nodes of this container (see ll::ComputeNode::instantiate). Only their descriptor
+      sets are allocated.
+    - Buffers and images written by any compute node of this container are created
+      again for the instance, with the same memory and parameters. Objects that are
+      only read, such as lookup tables, are shared.
+    - Compute nodes bound to a ll::ParameterBlock get their own block, initialized with
+      the current content of the prototype's block. Updating the parameters of one
+      instance does not change the others.
+    - The instance records the same commands as this container, using the
+      `onNodeRecord` function of its builder.
+
+    Objects bound to the ports of the instance before calling ll::ContainerNode::init
+    replace the corresponding objects of this container. Unbound ports follow the rules above.
+    Transient images are aliased again within the instance.
+
+    @code
+        auto instances = std::vector<std::shared_ptr<ll::ContainerNode>> {};
+        for (const auto& camera : cameras) {
+            auto instance = prototype->instantiate();
+            instance->bind("in_rgba", camera.image);
+            instance->init();
+            instances.push_back(instance);
+        }
+    @endcode
+
+    @return     The new instance, not initialized.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if
+                                  this container is not initialized.
+    */
+    std::shared_ptr<ll::ContainerNode> instantiate() const;
+
+    /**
+    @brief      Configures this container again for the objects currently bound to its ports.
+
+    This method is meant for input streams whose resolution changes. Instead of creating
+    the container again, the new objects are bound to its ports, or the images bound to
+    them are reshaped with ll::Image::reshape, and this method is called. None of the
+    pipelines, layouts or samplers of the compute nodes is created again:
+
+    - Objects bound to a port since the last initialization replace the previous ones in
+      every node within this container. Views over a replaced buffer or image are created
+      again over the new one.
+    - The first port image whose width or height changed is taken as reference. The images
+      written by the compute nodes of this container are reshaped following the reference if
+      both their width and height are derived from it: equal to the reference dimension, a
+      power of two level of it, as in an image pyramid, or a power of two multiple of it.
+      Dimensions of one pixel are only derived from a reference of one pixel. Other images,
+      such as lookup tables or histograms, keep their shape. Depth is always kept. Reshaped images keep their memory
+      if the new shape fits in it. Port images bound or reshaped since the last initialization
+      keep the shape given by the caller, while output images created by the builders follow
+      the reference as any other internal image.
+    - Every compute node configures its grid shape for the reshaped images, see
+      ll::ComputeNode::reinit. Node builders do not run `onNodeInit` again, so the objects
+      connecting the nodes and the content of their parameter blocks are kept.
+    - Reshaped transient images are aliased again.
+
+    Buffers created within the container keep their size, and objects bound through
+    parameters or push constants are not updated. Command buffers recording this container
+    must be recorded again.
+
+    @code
+        container->bind("in_rgba", camera.image);
+        container->reinit();
+
+        cmdBuffer = session->createCommandBuffer();
+        cmdBuffer->begin();
+        container->record(*cmdBuffer);
+        cmdBuffer->end();
+    @endcode
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidNodeState if
+                                  this container is not initialized.
+    */
+    void reinit();
+
     void record(ll::CommandBuffer& commandBuffer) const override;
 
+    /**
+    @brief      Gets the stencil radius of this container.
+
+    If the descriptor declares a non-zero radius, that value is returned.
+    Otherwise, the sum of the stencil radii of the contained nodes is returned,
+    which is an upper bound for any chain of nodes within the container.
+
+    @return     The stencil radius.
+    */
+    uint32_t getStencilRadius() const noexcept override;
+
     void setParameter(const std::string& name, const ll::Parameter& value) override;
 
     const ll::Parameter& getParameter(const std::string& name) const override;
 
+    void setParameter(const uint32_t index, const ll::Parameter& value);
+
+    const ll::Parameter& getParameter(const uint32_t index) const;
+
 protected:
     void onInit() override;
 
+    void initInstance();
+    void aliasTransientImages();
+
+    void rebindObjects(std::map<const ll::Object*, std::shared_ptr<ll::Object>>& objects);
+    void reinitNodes();
+    void saveInitPorts();
+    void collectComputeNodes(std::vector<std::shared_ptr<ll::ComputeNode>>& nodes) const;
+
     ll::ContainerNodeDescriptor m_descriptor;
 
-    std::map<std::string, std::shared_ptr<ll::Object>> m_objects;
-    std::map<std::string, std::shared_ptr<ll::Node>>   m_nodes;
+    // bound objects and nodes by index, together with their names
+    std::vector<std::pair<std::string, std::shared_ptr<ll::Object>>> m_objects;
+    std::vector<std::pair<std::string, std::shared_ptr<ll::Node>>>   m_nodes;
+    std::map<std::string, uint32_t>                                  m_objectIndices;
+    std::map<std::string, uint32_t>                                  m_nodeIndices;
 
     std::weak_ptr<ll::Interpreter> m_interpreter;
+
+    // native builder, used instead of the Lua builder named in the descriptor
+    std::shared_ptr<ll::ContainerNodeBuilder> m_builder;
+
+    std::vector<std::shared_ptr<ll::Image>> m_transientImages;
+    bool                                    m_transientImagesAliased {false};
+    uint64_t                                m_transientMemorySize {0};
+
+    // objects bound to the ports at the last initialization, with the shape of their
+    // images. Used by ll::ContainerNode::reinit to find the ports that changed.
+    std::vector<std::pair<std::shared_ptr<ll::Object>, ll::vec3ui>> m_initPorts;
+
+    // container this node is an instance of, null otherwise
+    std::shared_ptr<const ll::ContainerNode> m_prototype;
+
+    friend class ll::impl::GraphSnapshot;
 };
 
 } // namespace ll
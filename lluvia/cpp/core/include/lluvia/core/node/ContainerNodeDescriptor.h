@@ -14,9 +14,14 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ll {
 
+namespace impl {
+    class GraphSnapshot;
+} // namespace impl
+
 /**
 @brief      Class for describing a container node.
 
@@ -64,6 +69,40 @@ public:
     */
     const ll::PortDescriptor& getPort(const std::string& name) const;
 
+    /**
+    @brief      Gets a port descriptor given its index.
+
+    @param[in]  index  The port index, as returned by ll::ContainerNodeDescriptor::getPortIndex.
+
+    @return     The port descriptor.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    const ll::PortDescriptor& getPort(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a port.
+
+    Ports are indexed in the order they are added to the descriptor. The same
+    indices are used by the ll::ContainerNode objects created from this descriptor.
+
+    @param[in]  name  The port name.
+
+    @return     The port index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if name is not
+                                  in the ports table.
+    */
+    uint32_t getPortIndex(const std::string& name) const;
+
+    /**
+    @brief      Gets the number of ports.
+
+    @return     The port count.
+    */
+    size_t getPortCount() const noexcept;
+
     /**
     @brief      Adds a parameter.
 
@@ -86,6 +125,45 @@ public:
     */
     const ll::Parameter& getParameter(const std::string& name) const;
 
+    /**
+    @brief      Sets the value of an existing parameter given its index.
+
+    @param[in]  index  The parameter index, as returned by ll::ContainerNodeDescriptor::getParameterIndex.
+    @param[in]  value  The value.
+
+    @return     A reference to this object.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    ContainerNodeDescriptor& setParameter(const uint32_t index, const ll::Parameter& value);
+
+    /**
+    @brief      Gets a parameter given its index.
+
+    @param[in]  index  The parameter index.
+
+    @return     The parameter.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p index is
+                                  out of range.
+    */
+    const ll::Parameter& getParameter(const uint32_t index) const;
+
+    /**
+    @brief      Gets the index of a parameter.
+
+    Parameters are indexed in the order they are first set.
+
+    @param[in]  name  The parameter name.
+
+    @return     The parameter index.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if name is not
+                                  in the parameters table.
+    */
+    uint32_t getParameterIndex(const std::string& name) const;
+
     /**
     @brief      Sets the builder name this descriptor refers to within the Lua interpreter.
 
@@ -102,10 +180,39 @@ public:
     */
     const std::string& getBuilderName() const noexcept;
 
+    /**
+    @brief      Sets the stencil radius of the container.
+
+    If the radius is zero, the container reports the sum of the stencil radii
+    of its contained nodes, which is only available once the container is initialized.
+    Declaring the radius in the descriptor makes it available before initialization.
+
+    @param[in]  radius  The radius.
+
+    @return     A reference to this object.
+
+    @sa ll::ComputeNodeDescriptor::setStencilRadius
+    */
+    ContainerNodeDescriptor& setStencilRadius(const uint32_t radius) noexcept;
+
+    /**
+    @brief      Gets the stencil radius declared in this descriptor.
+
+    @return     The stencil radius.
+    */
+    uint32_t getStencilRadius() const noexcept;
+
 private:
-    std::string                               m_builderName;
-    std::map<std::string, ll::PortDescriptor> m_ports;
-    std::map<std::string, ll::Parameter>      m_parameters;
+    std::string m_builderName;
+    uint32_t    m_stencilRadius {0};
+
+    // ports and parameters in insertion order, indexed by name
+    std::vector<ll::PortDescriptor>  m_ports;
+    std::vector<ll::Parameter>       m_parameters;
+    std::map<std::string, uint32_t> m_portIndices;
+    std::map<std::string, uint32_t> m_parameterIndices;
+
+    friend class ll::impl::GraphSnapshot;
 };
 
 } // namespace ll
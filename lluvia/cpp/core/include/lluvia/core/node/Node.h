@@ -108,6 +108,17 @@ public:
     */
     virtual void record(ll::CommandBuffer& commandBuffer) const = 0;
 
+    /**
+    @brief      Gets the stencil radius of this node.
+
+    The stencil radius is the maximum distance, in pixels, between an output
+    pixel and the input pixels it reads. It is used by ll::TiledExecutor to
+    compute the halo around each tile.
+
+    @return     The stencil radius.
+    */
+    virtual uint32_t getStencilRadius() const noexcept = 0;
+
 protected:
     virtual void onInit() = 0;
 
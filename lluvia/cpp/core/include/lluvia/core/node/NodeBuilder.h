@@ -0,0 +1,167 @@
+/**
+@file       NodeBuilder.h
+@brief      NodeBuilder classes.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_NODE_NODE_BUILDER_H_
+#define LLUVIA_CORE_NODE_NODE_BUILDER_H_
+
+#include "lluvia/core/node/ComputeNodeDescriptor.h"
+#include "lluvia/core/node/ContainerNodeDescriptor.h"
+#include "lluvia/core/node/NodeType.h"
+
+#include <string>
+
+namespace ll {
+
+class CommandBuffer;
+class ComputeNode;
+class ContainerNode;
+class Session;
+
+/**
+@brief      Base class of node builders implemented in C++.
+
+Native builders are registered into a session through ll::Session::registerNodeBuilder
+and share the namespace of the builders registered in Lua through `ll.registerNodeBuilder`.
+That is, ll::Session::createComputeNode, ll::Session::createContainerNode and their Lua
+counterparts resolve builder names of either kind. If a name is registered both in C++
+and in Lua, the native builder is used.
+
+Nodes created from native builders do not run any Lua code when they are initialized
+or recorded into a command buffer.
+
+@sa ll::ComputeNodeBuilder
+@sa ll::ContainerNodeBuilder
+*/
+class NodeBuilder {
+
+public:
+    virtual ~NodeBuilder() = default;
+
+    /**
+    @brief      Gets the type of the nodes created by this builder.
+
+    @return     The node type.
+    */
+    virtual ll::NodeType getType() const noexcept = 0;
+
+    /**
+    @brief      Gets the documentation string of this builder.
+
+    The first line is used as summary in ll::NodeBuilderDescriptor.
+
+    @return     The documentation string.
+    */
+    virtual std::string getDoc() const { return std::string {}; }
+};
+
+/**
+@brief      Builder of ll::ComputeNode objects implemented in C++.
+
+@code
+    class Assign : public ll::ComputeNodeBuilder {
+
+    public:
+        ll::ComputeNodeDescriptor newDescriptor(const ll::Session& session) override {
+
+            return ll::ComputeNodeDescriptor()
+                .setProgram(session.getProgram("assign.comp"))
+                .setFunctionName("main")
+                .setLocalX(32)
+                .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+        }
+
+        void onNodeInit(ll::ComputeNode& node) override {
+
+            const auto buffer = std::static_pointer_cast<ll::Buffer>(node.getPort("out_buffer"));
+            node.configureGridShape({static_cast<uint32_t>(buffer->getSize() / sizeof(float)), 1, 1});
+        }
+    };
+
+    session->registerNodeBuilder("Assign", std::make_shared<Assign>());
+
+    auto node = session->createComputeNode("Assign");
+@endcode
+*/
+class ComputeNodeBuilder : public NodeBuilder {
+
+public:
+    ll::NodeType getType() const noexcept override { return ll::NodeType::Compute; }
+
+    /**
+    @brief      Creates a new descriptor for nodes of this builder.
+
+    If the builder name of the returned descriptor is empty, it is set to the
+    name used to register this builder.
+
+    @param[in]  session  The session creating the node.
+
+    @return     The descriptor.
+    */
+    virtual ll::ComputeNodeDescriptor newDescriptor(const ll::Session& session) = 0;
+
+    /**
+    @brief      Called when a node of this builder is initialized.
+
+    Input ports are already bound, output ports are typically created and bound here.
+
+    @param[in]  node  The node.
+    */
+    virtual void onNodeInit(ll::ComputeNode& /*node*/) { }
+
+    /**
+    @brief      Called by ll::ComputeNode::reinit after the shape of the objects bound to the node changed.
+
+    Every port is already bound, possibly to reshaped images. Implementations must only
+    configure the node for the current ports, typically its grid shape, and must not
+    create or bind objects. The default implementation calls ll::ComputeNode::scaleGridShape.
+
+    @param[in]  node  The node.
+    */
+    virtual void onNodeReshape(ll::ComputeNode& node);
+};
+
+/**
+@brief      Builder of ll::ContainerNode objects implemented in C++.
+*/
+class ContainerNodeBuilder : public NodeBuilder {
+
+public:
+    ll::NodeType getType() const noexcept override { return ll::NodeType::Container; }
+
+    /**
+    @brief      Creates a new descriptor for nodes of this builder.
+
+    If the builder name of the returned descriptor is empty, it is set to the
+    name used to register this builder.
+
+    @param[in]  session  The session creating the node.
+
+    @return     The descriptor.
+    */
+    virtual ll::ContainerNodeDescriptor newDescriptor(const ll::Session& session) = 0;
+
+    /**
+    @brief      Called when a node of this builder is initialized.
+
+    Inner nodes are typically created, initialized and bound to the container here.
+
+    @param[in]  node  The node.
+    */
+    virtual void onNodeInit(ll::ContainerNode& /*node*/) { }
+
+    /**
+    @brief      Called when a node of this builder is recorded into a command buffer.
+
+    @param[in]  node           The node.
+    @param      commandBuffer  The command buffer.
+    */
+    virtual void onNodeRecord(const ll::ContainerNode& /*node*/, ll::CommandBuffer& /*commandBuffer*/) { }
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_NODE_NODE_BUILDER_H_
@@ -0,0 +1,204 @@
+/**
+@file       ParameterBlock.h
+@brief      ParameterBlock class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_NODE_PARAMETER_BLOCK_H_
+#define LLUVIA_CORE_NODE_PARAMETER_BLOCK_H_
+
+#include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/node/PushConstants.h"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace ll {
+
+class Memory;
+
+/**
+@brief      Uniform buffer slots backing the push constants of a ll::ComputeNode.
+
+The underlying uniform buffer is mapped to host memory once, when the block is
+created, and stays mapped for the lifetime of this object. Updating the
+parameters of a node is then a host memcpy into one of the slots.
+
+Command buffers recording a node bound to a parameter block reference the slot
+selected at record time through a dynamic offset. Hence, they stay valid while
+the content of the slot changes between submissions.
+
+The device reads a slot while a submission using it is executing. A slot must
+not be written while such a submission is in flight, the host must wait for it
+first. To update parameters every frame without stalling, use one slot and one
+pre-recorded command buffer per frame in flight. ll::ComputeNode::setFrameIndex
+selects the slot together with the descriptor set of the frame.
+
+@code
+    auto block = session->createParameterBlock(sizeof(params), 2);
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    // ...
+                    .setParameterBlockBinding(1);
+
+    auto node = session->createComputeNode(desc);
+    node->bindParameterBlock(block);
+    node->init();
+
+    // one command buffer per slot, recorded once
+    for (auto slot = 0u; slot < 2; ++slot) {
+        node->setFrameIndex(slot);
+        cmdBuffers[slot]->begin();
+        cmdBuffers[slot]->run(*node);
+        cmdBuffers[slot]->end();
+    }
+
+    for (auto frame = 0u; frame < frameCount; ++frame) {
+
+        const auto slot = frame % 2;
+
+        // waits for the submission two frames behind, which used the same slot
+        waitFrame(frame - 2);
+
+        block->write(slot, params[frame]);
+        submitFrame(frame, *cmdBuffers[slot]);
+    }
+@endcode
+
+@sa ll::Session::createParameterBlock
+*/
+class ParameterBlock {
+
+public:
+    ParameterBlock()                      = delete;
+    ParameterBlock(const ParameterBlock&) = delete;
+    ParameterBlock(ParameterBlock&&)      = delete;
+
+    /**
+    @brief      Constructs the object.
+
+    @param[in]  memory         The memory where the uniform buffer is allocated. It must be
+                               host visible and the page containing the buffer must not be
+                               shared with other mapped objects.
+    @param[in]  blockSize      The size in bytes of each slot's content.
+    @param[in]  slotCount      The number of slots.
+    @param[in]  slotAlignment  The alignment in bytes of each slot. It must be a multiple of
+                               the device's minUniformBufferOffsetAlignment limit.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p blockSize or \p slotCount are zero, or \p memory is not mappable.
+
+    @throws     std::system_error With error code ll::ErrorCode::MemoryMapFailed if
+                                  the buffer cannot be mapped.
+    */
+    ParameterBlock(const std::shared_ptr<ll::Memory>& memory,
+        const uint64_t                                blockSize,
+        const uint32_t                                slotCount,
+        const uint64_t                                slotAlignment);
+
+    ~ParameterBlock() = default;
+
+    ParameterBlock& operator=(const ParameterBlock&) = delete;
+    ParameterBlock& operator=(ParameterBlock&&)      = delete;
+
+    /**
+    @brief      Gets the size in bytes of the content of each slot.
+    */
+    uint64_t getBlockSize() const noexcept;
+
+    /**
+    @brief      Gets the number of slots.
+    */
+    uint32_t getSlotCount() const noexcept;
+
+    /**
+    @brief      Gets the distance in bytes between two consecutive slots.
+    */
+    uint64_t getSlotStride() const noexcept;
+
+    /**
+    @brief      Gets the offset in bytes of a slot within the uniform buffer.
+
+    @param[in]  slot  The slot.
+
+    @return     The slot offset.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p slot is greater or equal than the slot count.
+    */
+    uint64_t getSlotOffset(const uint32_t slot) const;
+
+    /**
+    @brief      Gets the uniform buffer.
+    */
+    const std::shared_ptr<ll::Buffer>& getBuffer() const noexcept;
+
+    /**
+    @brief      Writes data into a slot.
+
+    @param[in]  slot  The slot.
+    @param[in]  data  The data.
+    @param[in]  size  The size in bytes of data. It must be less or equal than the block size.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  \p slot is out of range or \p size is greater than the block size.
+    */
+    void write(const uint32_t slot, const void* data, const uint64_t size);
+
+    /**
+    @brief      Writes push constants into a slot.
+
+    @param[in]  slot       The slot.
+    @param[in]  constants  The constants.
+    */
+    void write(const uint32_t slot, const ll::PushConstants& constants);
+
+    /**
+    @brief      Writes an object into a slot.
+
+    @param[in]  slot  The slot.
+    @param[in]  obj   The object.
+
+    @tparam     T     Object type. It must be trivially copyable.
+    */
+    template <typename T>
+    void write(const uint32_t slot, const T& obj)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        write(slot, &obj, sizeof(T));
+    }
+
+    /**
+    @brief      Writes push constants into all the slots.
+
+    @param[in]  constants  The constants.
+    */
+    void writeAll(const ll::PushConstants& constants);
+
+    /**
+    @brief      Copies the content of all the slots of another parameter block.
+
+    @param[in]  other  The parameter block to copy from. It must have the same block
+                       size, slot count and slot stride as this block.
+
+    @throws     std::system_error With error code ll::ErrorCode::InvalidArgument if
+                                  the layout of \p other differs from the layout of this block.
+    */
+    void copyFrom(const ll::ParameterBlock& other);
+
+private:
+    uint64_t m_blockSize;
+    uint32_t m_slotCount;
+    uint64_t m_slotStride;
+
+    std::shared_ptr<ll::Buffer> m_buffer;
+
+    // declared after m_buffer so the buffer is unmapped before being released
+    std::unique_ptr<uint8_t[], ll::Buffer::BufferMapDeleter> m_mappedPtr;
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_NODE_PARAMETER_BLOCK_H_
@@ -22,6 +22,7 @@ namespace ll {
 
 class Object;
 class Buffer;
+class BufferView;
 class ImageView;
 
 class PortDescriptor {
@@ -65,6 +66,9 @@ private:
     std::pair<bool, std::string> validateBuffer(const std::shared_ptr<ll::Buffer>& port) const noexcept;
     std::pair<bool, std::string> validateImageView(const std::shared_ptr<ll::ImageView>& port) const noexcept;
 
+    // the image channel count and type checks also apply to the texel format of buffer views
+    std::pair<bool, std::string> validateBufferView(const std::shared_ptr<ll::BufferView>& port) const noexcept;
+
     std::string toString() const noexcept;
 
     /**
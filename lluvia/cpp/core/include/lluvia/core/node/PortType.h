@@ -19,10 +19,14 @@ namespace ll {
 @sa ll::impl::ParameterTypeStrings string values for this enum.
 */
 enum class PortType : ll::enum_t {
-    Buffer           = 0, /**< value for ll::Buffer type. */
-    ImageView        = 1, /**< value for ll::ImageView without pixel sampler.*/
-    SampledImageView = 2, /**< value for ll::ImageView objects coupled with a pixel sampler. */
-    UniformBuffer    = 3, /**< value for ll::Buffer objects allocated to be used as uniform buffer. */
+    Buffer               = 0, /**< value for ll::Buffer type. */
+    ImageView            = 1, /**< value for ll::ImageView without pixel sampler.*/
+    SampledImageView     = 2, /**< value for ll::ImageView objects coupled with a pixel sampler. */
+    UniformBuffer        = 3, /**< value for ll::Buffer objects allocated to be used as uniform buffer. */
+    UniformBufferDynamic = 4, /**< value for ll::Buffer ranges used as uniform buffer, with an offset set at record time. */
+    StorageBufferDynamic = 5, /**< value for ll::Buffer ranges used as storage buffer, with an offset set at record time. */
+    UniformTexelBuffer   = 6, /**< value for ll::BufferView objects read as formatted texels through a GLSL samplerBuffer. */
+    StorageTexelBuffer   = 7, /**< value for ll::BufferView objects read and written as formatted texels through a GLSL imageBuffer. */
 };
 
 namespace impl {
@@ -32,11 +36,15 @@ namespace impl {
 
     @sa ll::PortType enum values for this array.
     */
-    constexpr const std::array<std::tuple<const char*, ll::PortType>, 4> PortTypeStrings {{
+    constexpr const std::array<std::tuple<const char*, ll::PortType>, 8> PortTypeStrings {{
         std::make_tuple("Buffer", ll::PortType::Buffer),
         std::make_tuple("ImageView", ll::PortType::ImageView),
         std::make_tuple("SampledImageView", ll::PortType::SampledImageView),
         std::make_tuple("UniformBuffer", ll::PortType::UniformBuffer),
+        std::make_tuple("UniformBufferDynamic", ll::PortType::UniformBufferDynamic),
+        std::make_tuple("StorageBufferDynamic", ll::PortType::StorageBufferDynamic),
+        std::make_tuple("UniformTexelBuffer", ll::PortType::UniformTexelBuffer),
+        std::make_tuple("StorageTexelBuffer", ll::PortType::StorageTexelBuffer),
     }};
 
 } // namespace impl
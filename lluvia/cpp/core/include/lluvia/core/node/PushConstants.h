@@ -17,6 +17,10 @@
 
 namespace ll {
 
+namespace impl {
+    class GraphSnapshot;
+} // namespace impl
+
 class PushConstants {
 
 public:
@@ -95,6 +99,8 @@ public:
 
 private:
     std::vector<uint8_t> m_data {};
+
+    friend class ll::impl::GraphSnapshot;
 };
 
 } // namespace ll
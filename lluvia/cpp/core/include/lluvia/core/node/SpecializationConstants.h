@@ -0,0 +1,185 @@
+/**
+@file       SpecializationConstants.h
+@brief      SpecializationConstants class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#ifndef LLUVIA_CORE_NODE_SPECIALIZATION_CONSTANTS_H_
+#define LLUVIA_CORE_NODE_SPECIALIZATION_CONSTANTS_H_
+
+#include "lluvia/core/enums/enums.h"
+#include "lluvia/core/error.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace ll {
+
+/**
+@brief      Types of specialization constants.
+
+All types are 32 bits wide. Bool constants are stored as `VkBool32`.
+*/
+enum class SpecializationConstantType : ll::enum_t {
+    Int32  = 0,
+    Uint32 = 1,
+    Float  = 2,
+    Bool   = 3,
+};
+
+namespace impl {
+
+    /**
+     @brief String values used for converting ll::SpecializationConstantType to std::string and vice-versa.
+
+     @sa ll::SpecializationConstantType enum values for this array.
+     */
+    constexpr const std::array<std::tuple<const char*, ll::SpecializationConstantType>, 4> SpecializationConstantTypeStrings {{std::make_tuple("Int32", ll::SpecializationConstantType::Int32),
+        std::make_tuple("Uint32", ll::SpecializationConstantType::Uint32),
+        std::make_tuple("Float", ll::SpecializationConstantType::Float),
+        std::make_tuple("Bool", ll::SpecializationConstantType::Bool)}};
+
+} // namespace impl
+
+/**
+@brief      Typed specialization constants of a ll::ComputeNode.
+
+Specialization constants are baked into the compute pipeline when the
+node is initialized, allowing the driver to constant-fold them.
+
+IDs 1, 2 and 3 are reserved for the local group shape. User defined
+constants start at ll::SpecializationConstants::BEGIN, which matches the
+`LL_SPECIALIZATION_BEGIN` macro defined in `lluvia/core.glsl`:
+
+@code
+    layout(constant_id = LL_SPECIALIZATION_BEGIN) const bool reverse = false;
+@endcode
+*/
+class SpecializationConstants {
+
+public:
+    /**
+    First ID available for user defined specialization constants.
+    */
+    static constexpr const uint32_t BEGIN = 4;
+
+    /**
+    @brief      Value of a specialization constant.
+
+    The raw 32 bits of the value are stored in \p data.
+    */
+    struct Value {
+        ll::SpecializationConstantType type {ll::SpecializationConstantType::Int32};
+        uint32_t                       data {0};
+    };
+
+    SpecializationConstants()                               = default;
+    SpecializationConstants(const SpecializationConstants&) = default;
+    SpecializationConstants(SpecializationConstants&&)      = default;
+
+    ~SpecializationConstants() = default;
+
+    SpecializationConstants& operator=(const SpecializationConstants&) = default;
+    SpecializationConstants& operator=(SpecializationConstants&&)      = default;
+
+    void setInt32(const uint32_t id, const int32_t value) { set(id, ll::SpecializationConstantType::Int32, value); }
+    void setUint32(const uint32_t id, const uint32_t value) { set(id, ll::SpecializationConstantType::Uint32, value); }
+    void setFloat(const uint32_t id, const float value) { set(id, ll::SpecializationConstantType::Float, value); }
+    void setBool(const uint32_t id, const bool value) { set(id, ll::SpecializationConstantType::Bool, static_cast<uint32_t>(value)); }
+
+    int32_t  getInt32(const uint32_t id) const { return get<int32_t>(id, ll::SpecializationConstantType::Int32); }
+    uint32_t getUint32(const uint32_t id) const { return get<uint32_t>(id, ll::SpecializationConstantType::Uint32); }
+    float    getFloat(const uint32_t id) const { return get<float>(id, ll::SpecializationConstantType::Float); }
+    bool     getBool(const uint32_t id) const { return get<uint32_t>(id, ll::SpecializationConstantType::Bool) != 0; }
+
+    /**
+    @brief      Determines if a constant with a given ID has been set.
+
+    @param[in]  id    The constant ID.
+
+    @return     True if the constant exists, False otherwise.
+    */
+    bool contains(const uint32_t id) const noexcept
+    {
+        return m_values.find(id) != m_values.cend();
+    }
+
+    /**
+    @brief      Gets the type of a constant.
+
+    @param[in]  id    The constant ID.
+
+    @return     The type.
+
+    @throws     std::system_error With error code ll::ErrorCode::KeyNotFound if \p id
+                                  has not been set.
+    */
+    ll::SpecializationConstantType getType(const uint32_t id) const
+    {
+        return find(id).type;
+    }
+
+    /**
+    @brief      Gets the number of constants.
+    */
+    size_t getCount() const noexcept
+    {
+        return m_values.size();
+    }
+
+    /**
+    @brief      Gets the constant values, sorted by ID.
+    */
+    const std::map<uint32_t, Value>& getValues() const noexcept
+    {
+        return m_values;
+    }
+
+private:
+    template <typename T>
+    void set(const uint32_t id, const ll::SpecializationConstantType type, const T& value)
+    {
+
+        static_assert(sizeof(T) == sizeof(uint32_t), "specialization constants must be 32 bits wide");
+
+        ll::throwSystemErrorIf(id < BEGIN, ll::ErrorCode::InvalidArgument,
+            "specialization constant ID must be greater or equal than " + std::to_string(BEGIN)
+                + ", IDs 1 to 3 are reserved for the local shape, got: " + std::to_string(id));
+
+        auto v = Value {type, 0};
+        std::memcpy(&v.data, &value, sizeof(uint32_t));
+
+        m_values[id] = v;
+    }
+
+    template <typename T>
+    T get(const uint32_t id, const ll::SpecializationConstantType type) const
+    {
+
+        const auto& v = find(id);
+        ll::throwSystemErrorIf(v.type != type, ll::ErrorCode::InvalidParameterType,
+            "specialization constant [" + std::to_string(id) + "] type does not match the requested type");
+
+        T out {};
+        std::memcpy(&out, &v.data, sizeof(uint32_t));
+        return out;
+    }
+
+    const Value& find(const uint32_t id) const
+    {
+        const auto it = m_values.find(id);
+        ll::throwSystemErrorIf(it == m_values.cend(), ll::ErrorCode::KeyNotFound, "specialization constant [" + std::to_string(id) + "] not found.");
+        return it->second;
+    }
+
+    std::map<uint32_t, Value> m_values {};
+};
+
+} // namespace ll
+
+#endif // LLUVIA_CORE_NODE_SPECIALIZATION_CONSTANTS_H_
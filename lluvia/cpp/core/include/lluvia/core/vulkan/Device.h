@@ -9,6 +9,8 @@
 #define LLUVIA_CORE_VULKAN_DEVICE_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "lluvia/core/ComputeDimension.h"
 #include "lluvia/core/types.h"
@@ -36,7 +38,8 @@ namespace vulkan {
         Device(const vk::Device&                         device,
             const vk::PhysicalDevice&                    physicalDevice,
             const uint32_t                               computeQueueFamilyIndex,
-            const std::shared_ptr<ll::vulkan::Instance>& instance);
+            const std::shared_ptr<ll::vulkan::Instance>& instance,
+            const std::vector<std::string>&              enabledExtensions = {});
         ~Device();
 
         Device& operator=(const Device& device) = delete;
@@ -46,25 +49,152 @@ namespace vulkan {
         vk::PhysicalDevice&             getPhysicalDevice() noexcept;
         const vk::PhysicalDeviceLimits& getPhysicalDeviceLimits() noexcept;
         vk::CommandPool&                getCommandPool() noexcept;
+        vk::PipelineCache&              getPipelineCache() noexcept;
         uint32_t                        getComputeFamilyQueueIndex() const noexcept;
 
         ll::vec3ui getComputeLocalShape(ll::ComputeDimension dimension) const noexcept;
 
         bool isImageDescriptorSupported(const ll::ImageDescriptor& descriptor) const noexcept;
 
+        bool isExtensionEnabled(const std::string& name) const noexcept;
+
+        /**
+        @brief      Determines if the memory requirements of buffers and images can report
+                    whether they prefer a dedicated allocation.
+
+        Dedicated allocations are part of Vulkan 1.1.
+        */
+        bool isDedicatedAllocationSupported() const noexcept;
+
+        /**
+        @brief      Determines if VK_EXT_memory_budget is enabled.
+        */
+        bool isMemoryBudgetSupported() const noexcept;
+
+        /**
+        @brief      Queries the current budget and usage of each memory heap.
+
+        @return     The budget properties.
+
+        @throws     std::system_error With error code ll::ErrorCode::ExtensionNotFound if
+                                      VK_EXT_memory_budget is not enabled.
+        */
+        vk::PhysicalDeviceMemoryBudgetPropertiesEXT getMemoryBudgetProperties();
+
+        /**
+        @brief      Determines if VK_EXT_external_memory_host is enabled.
+        */
+        bool isExternalMemoryHostSupported() const noexcept;
+
+        /**
+        @brief      Gets the alignment required for the address and size of imported host memory.
+
+        @throws     std::system_error With error code ll::ErrorCode::ExtensionNotFound if
+                                      VK_EXT_external_memory_host is not enabled.
+        */
+        uint64_t getMinImportedHostPointerAlignment();
+
+        /**
+        @brief      Gets the memory types that can import a host pointer.
+
+        @param[in]  ptr   The host pointer.
+
+        @return     Bit mask with one bit set per compatible memory type index.
+
+        @throws     std::system_error With error code ll::ErrorCode::ExtensionNotFound if
+                                      VK_EXT_external_memory_host is not enabled.
+
+        @throws     std::system_error With error code ll::ErrorCode::VulkanError if the
+                                      pointer cannot be imported.
+        */
+        uint32_t getHostPointerMemoryTypeBits(const void* ptr);
+
         std::unique_ptr<ll::CommandBuffer> createCommandBuffer();
 
         void run(const ll::CommandBuffer& cmdBuffer);
 
+        /**
+        @brief      Submits a command buffer for execution without waiting for it to finish.
+
+        @param[in]  cmdBuffer  The command buffer.
+        @param[in]  fence      Fence signaled once the command buffer completes execution.
+                               It must be unsignaled.
+
+        @throws     std::system_error With error code ll::ErrorCode::VulkanError if the
+                                      submission fails.
+        */
+        void submit(const ll::CommandBuffer& cmdBuffer, const vk::Fence& fence);
+
+        /**
+        @brief      Gets the content of the pipeline cache.
+
+        Every compute pipeline of this device is created through the same
+        pipeline cache. The returned blob can be passed to
+        ll::vulkan::Device::mergePipelineCacheData of a later process running
+        on the same device and driver to skip shader compilation.
+
+        @return     The pipeline cache data.
+        */
+        std::vector<uint8_t> getPipelineCacheData() const;
+
+        /**
+        @brief      Merges previously saved data into the pipeline cache.
+
+        Data saved by a different device or driver version is ignored by the driver.
+
+        @param[in]  data  The data returned by ll::vulkan::Device::getPipelineCacheData.
+        */
+        void mergePipelineCacheData(const std::vector<uint8_t>& data);
+
+        /**
+        @brief      Gets a sampler for the given create info.
+
+        Samplers are shared among all the callers requesting the same create info
+        and are reference counted. Every call must be matched by a call to
+        ll::vulkan::Device::releaseSampler.
+
+        @param[in]  info  The sampler create info.
+
+        @return     The sampler.
+        */
+        vk::Sampler acquireSampler(const vk::SamplerCreateInfo& info);
+
+        /**
+        @brief      Releases a sampler returned by ll::vulkan::Device::acquireSampler.
+
+        The sampler is destroyed once it is released by all its users.
+
+        @param[in]  sampler  The sampler.
+        */
+        void releaseSampler(const vk::Sampler& sampler) noexcept;
+
+        /**
+        @brief      Gets the number of Vulkan samplers currently allocated.
+        */
+        size_t getSamplerCount() const noexcept;
+
     private:
+        struct SamplerCacheEntry {
+            vk::SamplerCreateInfo info;
+            vk::Sampler           sampler;
+            uint32_t              referenceCount {0};
+        };
+
         vk::Device               m_device;
         vk::PhysicalDevice       m_physicalDevice;
         vk::PhysicalDeviceLimits m_physicalDeviceLimits;
         vk::CommandPool          m_commandPool;
+        vk::PipelineCache        m_pipelineCache;
 
         vk::Queue m_queue;
         uint32_t  m_computeQueueFamilyIndex;
 
+        std::vector<std::string> m_enabledExtensions;
+        uint32_t                 m_apiVersion {0};
+
+        // only a few sampler configurations exist, a linear search is enough
+        std::vector<SamplerCacheEntry> m_samplerCache;
+
         // cached local compute shapes for each compute dimension
         ll::vec3ui m_localComputeShapeD1;
         ll::vec3ui m_localComputeShapeD2;
@@ -7,7 +7,11 @@
 
 #include "lluvia/core/buffer/Buffer.h"
 
+#include "lluvia/core/buffer/BufferView.h"
 #include "lluvia/core/memory/Memory.h"
+#include "lluvia/core/vulkan/Device.h"
+
+#include <algorithm>
 
 namespace ll {
 
@@ -67,4 +71,61 @@ void Buffer::unmap()
     m_memory->unmapBuffer(*this);
 }
 
+std::shared_ptr<ll::BufferView> Buffer::createBufferView(const ll::ChannelCount channelCount,
+    const ll::ChannelType                                                       channelType,
+    const uint64_t                                                              offset,
+    const uint64_t                                                              range)
+{
+
+    const auto isUniform = static_cast<ll::enum_t>(m_usageFlags & ll::BufferUsageFlagBits::UniformTexelBuffer) != 0;
+    const auto isStorage = static_cast<ll::enum_t>(m_usageFlags & ll::BufferUsageFlagBits::StorageTexelBuffer) != 0;
+
+    ll::throwSystemErrorIf(!isUniform && !isStorage, ll::ErrorCode::InvalidArgument,
+        "buffer must be created with ll::BufferUsageFlagBits::UniformTexelBuffer or ll::BufferUsageFlagBits::StorageTexelBuffer usage flags");
+
+    const auto& device    = m_memory->m_device;
+    const auto  format    = ll::getVulkanImageFormat(channelCount, channelType);
+    const auto  texelSize = ll::getChannelTypeSize(channelType) * static_cast<uint64_t>(channelCount);
+
+    const auto features = device->getPhysicalDevice().getFormatProperties(format).bufferFeatures;
+    ll::throwSystemErrorIf(isUniform && !(features & vk::FormatFeatureFlagBits::eUniformTexelBuffer), ll::ErrorCode::InvalidArgument,
+        "format " + vk::to_string(format) + " is not supported for uniform texel buffers");
+    ll::throwSystemErrorIf(isStorage && !(features & vk::FormatFeatureFlagBits::eStorageTexelBuffer), ll::ErrorCode::InvalidArgument,
+        "format " + vk::to_string(format) + " is not supported for storage texel buffers");
+
+    const auto& limits = device->getPhysicalDeviceLimits();
+    ll::throwSystemErrorIf(offset % limits.minTexelBufferOffsetAlignment != 0, ll::ErrorCode::InvalidArgument,
+        "buffer view offset " + std::to_string(offset) + " must be a multiple of " + std::to_string(limits.minTexelBufferOffsetAlignment));
+    ll::throwSystemErrorIf(offset >= getSize(), ll::ErrorCode::InvalidArgument,
+        "buffer view offset " + std::to_string(offset) + " must be less than the buffer size: " + std::to_string(getSize()));
+
+    // the whole size covers up to the last complete texel
+    const auto viewRange = range == VK_WHOLE_SIZE ? ((getSize() - offset) / texelSize) * texelSize : range;
+
+    ll::throwSystemErrorIf(viewRange == 0 || viewRange % texelSize != 0, ll::ErrorCode::InvalidArgument,
+        "buffer view range " + std::to_string(viewRange) + " must be a non-zero multiple of the texel size: " + std::to_string(texelSize));
+    ll::throwSystemErrorIf(offset + viewRange > getSize(), ll::ErrorCode::InvalidArgument,
+        "buffer view range [" + std::to_string(offset) + ", " + std::to_string(offset + viewRange) + ") exceeds the buffer size: " + std::to_string(getSize()));
+    ll::throwSystemErrorIf(viewRange / texelSize > limits.maxTexelBufferElements, ll::ErrorCode::InvalidArgument,
+        "buffer view texel count " + std::to_string(viewRange / texelSize) + " exceeds the device limit: " + std::to_string(limits.maxTexelBufferElements));
+
+    auto view = std::shared_ptr<ll::BufferView> {new ll::BufferView {device, shared_from_this(), channelCount, channelType, offset, viewRange}};
+
+    // drop views already deleted before tracking the new one
+    m_bufferViews.erase(std::remove_if(m_bufferViews.begin(), m_bufferViews.end(), [](const auto& v) { return v.expired(); }), m_bufferViews.end());
+    m_bufferViews.push_back(view);
+
+    return view;
+}
+
+void Buffer::recreateBufferViews()
+{
+
+    for (const auto& weakView : m_bufferViews) {
+        if (auto view = weakView.lock()) {
+            view->createVkBufferView();
+        }
+    }
+}
+
 } // namespace ll
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+@file       BufferView.cpp
+@brief      BufferView class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/buffer/BufferView.h"
+
+#include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/vulkan/Device.h"
+
+namespace ll {
+
+BufferView::BufferView(const std::shared_ptr<ll::vulkan::Device>& device,
+    const std::shared_ptr<ll::Buffer>&                            buffer,
+    const ll::ChannelCount                                        channelCount,
+    const ll::ChannelType                                         channelType,
+    const uint64_t                                                offset,
+    const uint64_t                                                range)
+    : m_channelCount {channelCount}
+    , m_channelType {channelType}
+    , m_offset {offset}
+    , m_range {range}
+    , m_device {device}
+    , m_buffer {buffer}
+{
+
+    createVkBufferView();
+}
+
+BufferView::~BufferView()
+{
+    m_device->get().destroyBufferView(m_vkBufferView);
+}
+
+ll::ObjectType BufferView::getType() const noexcept
+{
+    return ll::ObjectType::BufferView;
+}
+
+const std::shared_ptr<ll::Buffer>& BufferView::getBuffer() const noexcept
+{
+    return m_buffer;
+}
+
+ll::ChannelCount BufferView::getChannelCount() const noexcept
+{
+    return m_channelCount;
+}
+
+ll::ChannelType BufferView::getChannelType() const noexcept
+{
+    return m_channelType;
+}
+
+vk::Format BufferView::getFormat() const noexcept
+{
+    return ll::getVulkanImageFormat(m_channelCount, m_channelType);
+}
+
+uint64_t BufferView::getOffset() const noexcept
+{
+    return m_offset;
+}
+
+uint64_t BufferView::getRange() const noexcept
+{
+    return m_range;
+}
+
+uint64_t BufferView::getTexelCount() const noexcept
+{
+    return m_range / (ll::getChannelTypeSize(m_channelType) * static_cast<uint64_t>(m_channelCount));
+}
+
+void BufferView::createVkBufferView()
+{
+
+    if (m_vkBufferView) {
+        m_device->get().destroyBufferView(m_vkBufferView);
+    }
+
+    const auto info = vk::BufferViewCreateInfo {}
+                          .setBuffer(m_buffer->m_vkBuffer)
+                          .setFormat(getFormat())
+                          .setOffset(m_offset)
+                          .setRange(m_range);
+
+    m_vkBufferView = m_device->get().createBufferView(info);
+}
+
+} // namespace ll
@@ -2,8 +2,10 @@
 
 #include "lluvia/core/Duration.h"
 #include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/error.h"
 #include "lluvia/core/image/Image.h"
 #include "lluvia/core/image/ImageView.h"
+#include "lluvia/core/impl/CommandTrace.h"
 #include "lluvia/core/node/ComputeNode.h"
 #include "lluvia/core/node/ContainerNode.h"
 
@@ -11,6 +13,67 @@
 
 namespace ll {
 
+namespace impl {
+
+    vk::Offset3D toVkOffset3D(const ll::vec3ui& offset)
+    {
+        return vk::Offset3D {static_cast<int32_t>(offset.x), static_cast<int32_t>(offset.y), static_cast<int32_t>(offset.z)};
+    }
+
+    void checkImageRegion(const ll::Image& image, const ll::vec3ui& offset, const ll::vec3ui& extent)
+    {
+
+        const auto fits = [](const uint32_t o, const uint32_t e, const uint32_t size) {
+            return e > 0 && o < size && e <= size - o;
+        };
+
+        ll::throwSystemErrorIf(!fits(offset.x, extent.x, image.getWidth()) || !fits(offset.y, extent.y, image.getHeight()) || !fits(offset.z, extent.z, image.getDepth()),
+            ll::ErrorCode::InvalidArgument,
+            "image region [offset: (" + std::to_string(offset.x) + ", " + std::to_string(offset.y) + ", " + std::to_string(offset.z)
+                + ") extent: (" + std::to_string(extent.x) + ", " + std::to_string(extent.y) + ", " + std::to_string(extent.z)
+                + ")] must be non-empty and fit within the image shape: (" + std::to_string(image.getWidth()) + ", " + std::to_string(image.getHeight()) + ", " + std::to_string(image.getDepth()) + ")");
+    }
+
+    vk::BufferImageCopy createBufferImageCopy(const ll::Buffer& buffer, const ll::Image& image,
+        const ll::vec3ui& imageOffset, const ll::vec3ui& imageExtent,
+        const uint64_t bufferOffset, const uint32_t bufferRowLength)
+    {
+
+        checkImageRegion(image, imageOffset, imageExtent);
+
+        const auto pixelSize = image.getChannelTypeSize() * image.getChannelCount<uint64_t>();
+
+        ll::throwSystemErrorIf(bufferOffset % pixelSize != 0, ll::ErrorCode::InvalidArgument,
+            "buffer offset must be a multiple of the image pixel size (" + std::to_string(pixelSize) + " bytes), got: " + std::to_string(bufferOffset));
+
+        ll::throwSystemErrorIf(bufferRowLength != 0 && bufferRowLength < imageExtent.x, ll::ErrorCode::InvalidArgument,
+            "buffer row length must be zero or greater or equal than the region width (" + std::to_string(imageExtent.x) + "), got: " + std::to_string(bufferRowLength));
+
+        // last byte touched by the copy, rows are bufferRowLength pixels apart
+        const auto rowLength   = uint64_t {bufferRowLength == 0 ? imageExtent.x : bufferRowLength};
+        const auto pixelCount  = (uint64_t {imageExtent.z} - 1) * rowLength * imageExtent.y + (uint64_t {imageExtent.y} - 1) * rowLength + imageExtent.x;
+        const auto requiredEnd = bufferOffset + pixelCount * pixelSize;
+
+        ll::throwSystemErrorIf(requiredEnd > buffer.getSize(), ll::ErrorCode::BufferCopyError,
+            "buffer size (" + std::to_string(buffer.getSize()) + " bytes) is smaller than the image region requires (" + std::to_string(requiredEnd) + " bytes)");
+
+        auto imgSubresourceLayers = vk::ImageSubresourceLayers {}
+                                        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                                        .setMipLevel(0)
+                                        .setBaseArrayLayer(0)
+                                        .setLayerCount(1);
+
+        return vk::BufferImageCopy {}
+            .setBufferOffset(bufferOffset)
+            .setBufferImageHeight(0) // thightly packed rows in the Z axis
+            .setBufferRowLength(bufferRowLength)
+            .setImageSubresource(imgSubresourceLayers)
+            .setImageOffset(toVkOffset3D(imageOffset))
+            .setImageExtent({imageExtent.x, imageExtent.y, imageExtent.z});
+    }
+
+} // namespace impl
+
 CommandBuffer::CommandBuffer(const std::shared_ptr<ll::vulkan::Device>& device)
     : m_device {device}
 {
@@ -59,9 +122,26 @@ void CommandBuffer::run(const ll::ContainerNode& node)
     node.record(*this);
 }
 
+void CommandBuffer::dispatchIndirect(const ll::Buffer& buffer, const uint64_t offset)
+{
+
+    ll::throwSystemErrorIf(static_cast<ll::enum_t>(buffer.getUsageFlags() & ll::BufferUsageFlagBits::IndirectBuffer) == 0,
+        ll::ErrorCode::InvalidArgument, "buffer must be created with ll::BufferUsageFlagBits::IndirectBuffer usage flag");
+
+    ll::throwSystemErrorIf(offset % 4 != 0, ll::ErrorCode::InvalidArgument,
+        "indirect dispatch offset must be a multiple of 4, got: " + std::to_string(offset));
+
+    ll::throwSystemErrorIf(offset + sizeof(vk::DispatchIndirectCommand) > buffer.getSize(), ll::ErrorCode::InvalidArgument,
+        "indirect dispatch arguments at offset " + std::to_string(offset) + " exceed the buffer size: " + std::to_string(buffer.getSize()));
+
+    m_commandBuffer.dispatchIndirect(buffer.m_vkBuffer, offset);
+}
+
 void CommandBuffer::copyBuffer(const ll::Buffer& src, const ll::Buffer& dst)
 {
 
+    traceUnsupported("copyBuffer");
+
     if (dst.getSize() < src.getSize()) {
         throw std::system_error(createErrorCode(ll::ErrorCode::BufferCopyError), "destination size must be greater or equal than source: got " + std::to_string(dst.getSize()) + " expected: " + std::to_string(src.getSize()));
     }
@@ -77,19 +157,17 @@ void CommandBuffer::copyBuffer(const ll::Buffer& src, const ll::Buffer& dst)
 void CommandBuffer::copyBufferToImage(const ll::Buffer& src, const ll::Image& dst)
 {
 
-    auto imgSubresourceLayers = vk::ImageSubresourceLayers {}
-                                    .setAspectMask(vk::ImageAspectFlagBits::eColor)
-                                    .setMipLevel(0)
-                                    .setBaseArrayLayer(0)
-                                    .setLayerCount(1);
+    this->copyBufferToImage(src, dst, {0, 0, 0}, dst.getShape());
+}
+
+void CommandBuffer::copyBufferToImage(const ll::Buffer& src, const ll::Image& dst,
+    const ll::vec3ui& imageOffset, const ll::vec3ui& imageExtent,
+    const uint64_t bufferOffset, const uint32_t bufferRowLength)
+{
+
+    traceUnsupported("copyBufferToImage");
 
-    auto copyInfo = vk::BufferImageCopy {}
-                        .setBufferOffset(0)
-                        .setBufferImageHeight(0) // thightly packed
-                        .setBufferRowLength(0)
-                        .setImageSubresource(imgSubresourceLayers)
-                        .setImageOffset({0, 0, 0})
-                        .setImageExtent({dst.getWidth(), dst.getHeight(), dst.getDepth()});
+    const auto copyInfo = impl::createBufferImageCopy(src, dst, imageOffset, imageExtent, bufferOffset, bufferRowLength);
 
     m_commandBuffer.copyBufferToImage(src.m_vkBuffer, dst.m_vkImage,
         ll::impl::toVkImageLayout(dst.m_layout), 1, &copyInfo);
@@ -98,19 +176,17 @@ void CommandBuffer::copyBufferToImage(const ll::Buffer& src, const ll::Image& ds
 void CommandBuffer::copyImageToBuffer(const ll::Image& src, const ll::Buffer& dst)
 {
 
-    auto imgSubresourceLayers = vk::ImageSubresourceLayers {}
-                                    .setAspectMask(vk::ImageAspectFlagBits::eColor)
-                                    .setMipLevel(0)
-                                    .setBaseArrayLayer(0)
-                                    .setLayerCount(1);
+    this->copyImageToBuffer(src, dst, {0, 0, 0}, src.getShape());
+}
+
+void CommandBuffer::copyImageToBuffer(const ll::Image& src, const ll::Buffer& dst,
+    const ll::vec3ui& imageOffset, const ll::vec3ui& imageExtent,
+    const uint64_t bufferOffset, const uint32_t bufferRowLength)
+{
+
+    traceUnsupported("copyImageToBuffer");
 
-    auto copyInfo = vk::BufferImageCopy {}
-                        .setBufferOffset(0)
-                        .setBufferImageHeight(0) // thightly packed
-                        .setBufferRowLength(0)
-                        .setImageSubresource(imgSubresourceLayers)
-                        .setImageOffset({0, 0, 0})
-                        .setImageExtent({src.getWidth(), src.getHeight(), src.getDepth()});
+    const auto copyInfo = impl::createBufferImageCopy(dst, src, imageOffset, imageExtent, bufferOffset, bufferRowLength);
 
     m_commandBuffer.copyImageToBuffer(src.m_vkImage,
         ll::impl::toVkImageLayout(src.m_layout), dst.m_vkBuffer, 1, &copyInfo);
@@ -119,6 +195,18 @@ void CommandBuffer::copyImageToBuffer(const ll::Image& src, const ll::Buffer& ds
 void CommandBuffer::copyImageToImage(const ll::Image& src, const ll::Image& dst)
 {
 
+    this->copyImageToImage(src, dst, {0, 0, 0}, {0, 0, 0}, src.getShape());
+}
+
+void CommandBuffer::copyImageToImage(const ll::Image& src, const ll::Image& dst,
+    const ll::vec3ui& srcOffset, const ll::vec3ui& dstOffset, const ll::vec3ui& extent)
+{
+
+    traceUnsupported("copyImageToImage");
+
+    impl::checkImageRegion(src, srcOffset, extent);
+    impl::checkImageRegion(dst, dstOffset, extent);
+
     auto imgSubresourceLayers = vk::ImageSubresourceLayers {}
                                     .setAspectMask(vk::ImageAspectFlagBits::eColor)
                                     .setMipLevel(0)
@@ -126,11 +214,11 @@ void CommandBuffer::copyImageToImage(const ll::Image& src, const ll::Image& dst)
                                     .setLayerCount(1);
 
     auto copyRegion = vk::ImageCopy {}
-                          .setSrcOffset({0, 0, 0})
+                          .setSrcOffset(impl::toVkOffset3D(srcOffset))
                           .setSrcSubresource(imgSubresourceLayers)
-                          .setDstOffset({0, 0, 0})
+                          .setDstOffset(impl::toVkOffset3D(dstOffset))
                           .setDstSubresource(imgSubresourceLayers)
-                          .setExtent({src.getWidth(), src.getHeight(), src.getDepth()});
+                          .setExtent({extent.x, extent.y, extent.z});
 
     m_commandBuffer.copyImage(src.m_vkImage,
         ll::impl::toVkImageLayout(src.m_layout),
@@ -143,6 +231,10 @@ void CommandBuffer::copyImageToImage(const ll::Image& src, const ll::Image& dst)
 void CommandBuffer::changeImageLayout(ll::Image& image, const ll::ImageLayout newLayout)
 {
 
+    if (m_trace != nullptr) {
+        m_trace->steps.push_back({ll::impl::CommandTraceStepType::ChangeImageLayout, nullptr, &image, newLayout, image.m_layout});
+    }
+
     // FIXME: compute according to current and new layout
     const auto srcAccessFlags = vk::AccessFlags {vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
     const auto dstAccessFlags = vk::AccessFlags {vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
@@ -183,6 +275,10 @@ void CommandBuffer::changeImageLayout(ll::ImageView& imageView, const ll::ImageL
 void CommandBuffer::memoryBarrier()
 {
 
+    if (m_trace != nullptr) {
+        m_trace->steps.push_back({ll::impl::CommandTraceStepType::MemoryBarrier});
+    }
+
     auto barrier = vk::MemoryBarrier {}
                        .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
                        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
@@ -195,9 +291,32 @@ void CommandBuffer::memoryBarrier()
         0, nullptr);
 }
 
+void CommandBuffer::indirectBarrier()
+{
+
+    if (m_trace != nullptr) {
+        m_trace->steps.push_back({ll::impl::CommandTraceStepType::IndirectBarrier});
+    }
+
+    auto barrier = vk::MemoryBarrier {}
+                       .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+                       .setDstAccessMask(vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eShaderRead);
+
+    m_commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eComputeShader,
+        vk::DependencyFlags {},
+        1, &barrier,
+        0, nullptr,
+        0, nullptr);
+}
+
 void CommandBuffer::clearImage(ll::Image& image)
 {
 
+    if (m_trace != nullptr) {
+        m_trace->steps.push_back({ll::impl::CommandTraceStepType::ClearImage, nullptr, &image});
+    }
+
     auto clearColor = vk::ClearColorValue {std::array<int32_t, 4> {0, 0, 0, 0}};
 
     auto range = vk::ImageSubresourceRange()
@@ -219,6 +338,8 @@ void CommandBuffer::clearImage(ll::ImageView& imageView)
 void CommandBuffer::durationStart(ll::Duration& duration)
 {
 
+    traceUnsupported("durationStart");
+
     m_commandBuffer.resetQueryPool(duration.getQueryPool(), 0, 2);
 
     m_commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
@@ -229,9 +350,19 @@ void CommandBuffer::durationStart(ll::Duration& duration)
 void CommandBuffer::durationEnd(ll::Duration& duration)
 {
 
+    traceUnsupported("durationEnd");
+
     m_commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
         duration.getQueryPool(),
         duration.getEndTimeQueryIndex());
 }
 
+void CommandBuffer::traceUnsupported(const char* command)
+{
+
+    if (m_trace != nullptr && m_trace->unsupportedCommand.empty()) {
+        m_trace->unsupportedCommand = command;
+    }
+}
+
 } // namespace ll
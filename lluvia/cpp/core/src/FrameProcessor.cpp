@@ -0,0 +1,285 @@
+/**
+@file       FrameProcessor.cpp
+@brief      FrameProcessor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/FrameProcessor.h"
+
+#include "lluvia/core/CommandBuffer.h"
+#include "lluvia/core/Duration.h"
+#include "lluvia/core/Object.h"
+#include "lluvia/core/Session.h"
+#include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/error.h"
+#include "lluvia/core/image/Image.h"
+#include "lluvia/core/image/ImageView.h"
+#include "lluvia/core/memory/Memory.h"
+#include "lluvia/core/node/ComputeNode.h"
+#include "lluvia/core/node/ContainerNode.h"
+#include "lluvia/core/node/Node.h"
+#include "lluvia/core/vulkan/Device.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ll {
+
+FrameProcessor::FrameProcessor(const std::shared_ptr<ll::Session>& session,
+    const std::shared_ptr<ll::vulkan::Device>&                     device,
+    const ll::FrameProcessorDescriptor&                            descriptor)
+    : m_descriptor {descriptor}
+    , m_session {session}
+    , m_device {device}
+{
+
+    const auto& imgDesc = m_descriptor.getImageDescriptor();
+
+    ll::throwSystemErrorIf(imgDesc.getWidth() == 0 || imgDesc.getHeight() == 0 || imgDesc.getDepth() == 0,
+        ll::ErrorCode::InvalidArgument, "image width, height and depth must be greater than zero");
+    ll::throwSystemErrorIf(m_descriptor.getInFlightCount() == 0, ll::ErrorCode::InvalidArgument, "in flight count must be greater than zero");
+    ll::throwSystemErrorIf(!m_descriptor.getNodeFactory() && m_descriptor.getBuilderName().empty(), ll::ErrorCode::InvalidArgument,
+        "either a node builder name or a node factory must be set");
+
+    initNode();
+
+    m_outputImageDescriptor = ll::ImageDescriptor {m_outputImage->getDepth(), m_outputImage->getHeight(), m_outputImage->getWidth(),
+        m_outputImage->getChannelCount(), m_outputImage->getChannelType()};
+
+    m_slots.resize(m_descriptor.getInFlightCount());
+
+    // the destructor does not run if the constructor throws
+    try {
+        for (auto& slot : m_slots) {
+            initSlot(slot);
+        }
+    } catch (...) {
+        destroyFences();
+        throw;
+    }
+}
+
+FrameProcessor::~FrameProcessor()
+{
+
+    destroyFences();
+}
+
+const ll::FrameProcessorDescriptor& FrameProcessor::getDescriptor() const noexcept
+{
+    return m_descriptor;
+}
+
+const ll::ImageDescriptor& FrameProcessor::getOutputImageDescriptor() const noexcept
+{
+    return m_outputImageDescriptor;
+}
+
+uint64_t FrameProcessor::getInputSize() const noexcept
+{
+    return m_descriptor.getImageDescriptor().getSize();
+}
+
+uint64_t FrameProcessor::getOutputSize() const noexcept
+{
+    return m_outputImageDescriptor.getSize();
+}
+
+uint32_t FrameProcessor::getPendingFrameCount() const noexcept
+{
+    return static_cast<uint32_t>(m_pushCount - m_popCount);
+}
+
+bool FrameProcessor::isFull() const noexcept
+{
+    return getPendingFrameCount() == m_slots.size();
+}
+
+uint64_t FrameProcessor::push(const void* input)
+{
+
+    ll::throwSystemErrorIf(input == nullptr, ll::ErrorCode::InvalidArgument, "input pointer must not be null");
+    ll::throwSystemErrorIf(isFull(), ll::ErrorCode::InvalidNodeState,
+        "all the " + std::to_string(m_slots.size()) + " frame slots are in flight, pop a frame before pushing a new one");
+
+    auto& slot = m_slots[m_pushCount % m_slots.size()];
+
+    {
+        auto staging = slot.uploadBuffer->map<uint8_t[]>();
+        std::memcpy(staging.get(), input, getInputSize());
+    }
+
+    m_device->get().resetFences(slot.fence);
+    m_device->submit(*slot.commandBuffer, slot.fence);
+    slot.busy = true;
+
+    return m_pushCount++;
+}
+
+uint64_t FrameProcessor::pop(void* output)
+{
+
+    ll::throwSystemErrorIf(output == nullptr, ll::ErrorCode::InvalidArgument, "output pointer must not be null");
+    ll::throwSystemErrorIf(getPendingFrameCount() == 0, ll::ErrorCode::InvalidNodeState, "there are no frames in flight");
+
+    auto& slot = m_slots[m_popCount % m_slots.size()];
+
+    const auto result = m_device->get().waitForFences(1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    slot.busy         = false;
+
+    ll::throwSystemErrorIf(result != vk::Result::eSuccess, ll::ErrorCode::VulkanError, "error waiting for frame execution to finish");
+
+    {
+        auto staging = slot.downloadBuffer->map<uint8_t[]>();
+        std::memcpy(output, staging.get(), getOutputSize());
+    }
+
+    m_lastFrameDuration = slot.duration->getDuration();
+
+    return m_popCount++;
+}
+
+std::chrono::nanoseconds FrameProcessor::getLastFrameDuration() const noexcept
+{
+    return m_lastFrameDuration;
+}
+
+std::shared_ptr<ll::Node> FrameProcessor::createNode() const
+{
+
+    auto node = std::shared_ptr<ll::Node> {};
+
+    if (m_descriptor.getNodeFactory()) {
+        node = m_descriptor.getNodeFactory()();
+
+    } else {
+
+        const auto& builderName = m_descriptor.getBuilderName();
+        const auto  builders    = m_session->getNodeBuilderDescriptors();
+
+        const auto it = std::find_if(builders.cbegin(), builders.cend(), [&builderName](const auto& builder) {
+            return builder.name == builderName;
+        });
+
+        ll::throwSystemErrorIf(it == builders.cend(), ll::ErrorCode::KeyNotFound, "node builder [" + builderName + "] not found");
+
+        if (it->nodeType == ll::NodeType::Container) {
+            node = m_session->createContainerNode(builderName);
+        } else {
+            node = m_session->createComputeNode(builderName);
+        }
+    }
+
+    ll::throwSystemErrorIf(node == nullptr, ll::ErrorCode::InvalidArgument, "node factory returned a null node");
+    ll::throwSystemErrorIf(node->getState() != ll::NodeState::Created, ll::ErrorCode::InvalidNodeState, "nodes used by the frame processor must not be initialized");
+
+    for (const auto& kv : m_descriptor.getParameters()) {
+        node->setParameter(kv.first, kv.second);
+    }
+
+    return node;
+}
+
+void FrameProcessor::initNode()
+{
+
+    const auto& imgDesc = m_descriptor.getImageDescriptor();
+
+    const auto usageFlags = ll::ImageUsageFlags {ll::ImageUsageFlagBits::Storage
+                                                 | ll::ImageUsageFlagBits::Sampled
+                                                 | ll::ImageUsageFlagBits::TransferSrc
+                                                 | ll::ImageUsageFlagBits::TransferDst};
+
+    const auto frameDesc = ll::ImageDescriptor {imgDesc.getDepth(), imgDesc.getHeight(), imgDesc.getWidth(),
+        imgDesc.getChannelCount(), imgDesc.getChannelType()}
+                               .setUsageFlags(usageFlags);
+
+    m_inputImage     = m_session->getDeviceMemory()->createImage(frameDesc);
+    m_inputImageView = m_inputImage->createImageView(m_descriptor.getInputImageViewDescriptor());
+
+    // the descriptor set of the node is written with the layout the image has at binding time
+    m_inputImage->changeImageLayout(ll::ImageLayout::General);
+
+    m_node = createNode();
+    m_node->bind(m_descriptor.getInputPort(), m_inputImageView);
+    m_node->init();
+
+    const auto outputObj = m_node->getPort(m_descriptor.getOutputPort());
+    ll::throwSystemErrorIf(outputObj == nullptr, ll::ErrorCode::PortBindingError, "output port [" + m_descriptor.getOutputPort() + "] is not bound");
+
+    switch (outputObj->getType()) {
+    case ll::ObjectType::Image:
+        m_outputImage = std::static_pointer_cast<ll::Image>(outputObj);
+        break;
+    case ll::ObjectType::ImageView:
+        m_outputImage = std::static_pointer_cast<ll::ImageView>(outputObj)->getImage();
+        break;
+    default:
+        ll::throwSystemError(ll::ErrorCode::PortBindingError, "output port [" + m_descriptor.getOutputPort() + "] must hold an Image or ImageView object");
+    }
+
+    // both images start in General layout, so the recorded layout transitions are valid on every submission
+    if (m_outputImage->getLayout() != ll::ImageLayout::General) {
+        m_outputImage->changeImageLayout(ll::ImageLayout::General);
+    }
+}
+
+void FrameProcessor::initSlot(Slot& slot)
+{
+
+    // staging buffers in memories optimized for each transfer direction
+    slot.uploadBuffer   = m_session->getUploadMemory()->createBuffer(m_inputImage->getDescriptor().getSize());
+    slot.downloadBuffer = m_session->getReadbackMemory()->createBuffer(m_outputImage->getDescriptor().getSize());
+
+    slot.duration = m_session->createDuration();
+
+    // upload, compute and download are recorded once, only the content of the staging buffers changes between frames
+    slot.commandBuffer = m_device->createCommandBuffer();
+    slot.commandBuffer->begin();
+
+    // the node and its images are shared by every slot: wait for the frames submitted before,
+    // so that only the host copies into and out of the staging buffers overlap
+    const auto frameBarrier = vk::MemoryBarrier {}
+                                  .setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite)
+                                  .setDstAccessMask(vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite);
+
+    slot.commandBuffer->getVkCommandBuffer().pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eAllCommands,
+        vk::DependencyFlags {},
+        1, &frameBarrier,
+        0, nullptr,
+        0, nullptr);
+
+    slot.commandBuffer->changeImageLayout(*m_inputImage, ll::ImageLayout::TransferDstOptimal);
+    slot.commandBuffer->copyBufferToImage(*slot.uploadBuffer, *m_inputImage);
+    slot.commandBuffer->changeImageLayout(*m_inputImage, ll::ImageLayout::General);
+    slot.commandBuffer->durationStart(*slot.duration);
+    m_node->record(*slot.commandBuffer);
+    slot.commandBuffer->durationEnd(*slot.duration);
+    slot.commandBuffer->memoryBarrier();
+    slot.commandBuffer->changeImageLayout(*m_outputImage, ll::ImageLayout::TransferSrcOptimal);
+    slot.commandBuffer->copyImageToBuffer(*m_outputImage, *slot.downloadBuffer);
+    slot.commandBuffer->changeImageLayout(*m_outputImage, ll::ImageLayout::General);
+    slot.commandBuffer->end();
+
+    slot.fence = m_device->get().createFence(vk::FenceCreateInfo {});
+}
+
+void FrameProcessor::destroyFences() noexcept
+{
+
+    for (auto& slot : m_slots) {
+        if (slot.fence) {
+            if (slot.busy) {
+                static_cast<void>(m_device->get().waitForFences(1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+            }
+
+            m_device->get().destroyFence(slot.fence);
+            slot.fence = nullptr;
+        }
+    }
+}
+
+} // namespace ll
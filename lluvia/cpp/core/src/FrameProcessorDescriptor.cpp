@@ -0,0 +1,100 @@
+/**
+@file       FrameProcessorDescriptor.cpp
+@brief      FrameProcessorDescriptor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/FrameProcessorDescriptor.h"
+
+namespace ll {
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setBuilderName(const std::string& name) noexcept
+{
+    m_builderName = name;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setNodeFactory(const NodeFactory& factory) noexcept
+{
+    m_nodeFactory = factory;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setInputPort(const std::string& name) noexcept
+{
+    m_inputPort = name;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setOutputPort(const std::string& name) noexcept
+{
+    m_outputPort = name;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setImageDescriptor(const ll::ImageDescriptor& descriptor) noexcept
+{
+    m_imageDescriptor = descriptor;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setInputImageViewDescriptor(const ll::ImageViewDescriptor& descriptor) noexcept
+{
+    m_inputImageViewDescriptor = descriptor;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setInFlightCount(const uint32_t count) noexcept
+{
+    m_inFlightCount = count;
+    return *this;
+}
+
+FrameProcessorDescriptor& FrameProcessorDescriptor::setParameter(const std::string& name, const ll::Parameter& value)
+{
+    m_parameters[name] = value;
+    return *this;
+}
+
+const std::string& FrameProcessorDescriptor::getBuilderName() const noexcept
+{
+    return m_builderName;
+}
+
+const FrameProcessorDescriptor::NodeFactory& FrameProcessorDescriptor::getNodeFactory() const noexcept
+{
+    return m_nodeFactory;
+}
+
+const std::string& FrameProcessorDescriptor::getInputPort() const noexcept
+{
+    return m_inputPort;
+}
+
+const std::string& FrameProcessorDescriptor::getOutputPort() const noexcept
+{
+    return m_outputPort;
+}
+
+const ll::ImageDescriptor& FrameProcessorDescriptor::getImageDescriptor() const noexcept
+{
+    return m_imageDescriptor;
+}
+
+const ll::ImageViewDescriptor& FrameProcessorDescriptor::getInputImageViewDescriptor() const noexcept
+{
+    return m_inputImageViewDescriptor;
+}
+
+uint32_t FrameProcessorDescriptor::getInFlightCount() const noexcept
+{
+    return m_inFlightCount;
+}
+
+const std::map<std::string, ll::Parameter>& FrameProcessorDescriptor::getParameters() const noexcept
+{
+    return m_parameters;
+}
+
+} // namespace ll
@@ -14,6 +14,7 @@
 #include "lluvia/core/Program.h"
 #include "lluvia/core/Session.h"
 #include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/buffer/BufferView.h"
 #include "lluvia/core/types.h"
 
 #include "lluvia/core/image/Image.h"
@@ -37,7 +38,9 @@
 #include "lluvia/core/node/Node.h"
 #include "lluvia/core/node/NodeBuilderDescriptor.h"
 #include "lluvia/core/node/Parameter.h"
+#include "lluvia/core/node/ParameterBlock.h"
 #include "lluvia/core/node/PushConstants.h"
+#include "lluvia/core/node/SpecializationConstants.h"
 
 #include "lluvia/core/impl/LuaLibrary.h"
 
@@ -93,6 +96,7 @@ void registerTypes(sol::table& lib)
     registerEnum<ll::ParameterType, ll::impl::ParameterTypeStrings.size(), ll::impl::ParameterTypeStrings>(lib, "ParameterType");
     registerEnum<ll::PortDirection, ll::impl::PortDirectionStrings.size(), ll::impl::PortDirectionStrings>(lib, "PortDirection");
     registerEnum<ll::PortType, ll::impl::PortTypeStrings.size(), ll::impl::PortTypeStrings>(lib, "PortType");
+    registerEnum<ll::SpecializationConstantType, ll::impl::SpecializationConstantTypeStrings.size(), ll::impl::SpecializationConstantTypeStrings>(lib, "SpecializationConstantType");
 
     ///////////////////////////////////////////////////////
     // Types
@@ -109,6 +113,29 @@ void registerTypes(sol::table& lib)
         "leftPadding", &ll::MemoryAllocationInfo::leftPadding,
         "page", &ll::MemoryAllocationInfo::page);
 
+    lib.new_usertype<ll::MemoryPageStatistics>("MemoryPageStatistics",
+        "page", &ll::MemoryPageStatistics::page,
+        "memoryTypeIndex", &ll::MemoryPageStatistics::memoryTypeIndex,
+        "dedicated", &ll::MemoryPageStatistics::dedicated,
+        "committedSize", &ll::MemoryPageStatistics::committedSize,
+        "usedSize", &ll::MemoryPageStatistics::usedSize,
+        "largestFreeSize", &ll::MemoryPageStatistics::largestFreeSize);
+
+    lib.new_usertype<ll::MemoryHeapBudget>("MemoryHeapBudget",
+        "heapIndex", &ll::MemoryHeapBudget::heapIndex,
+        "budget", &ll::MemoryHeapBudget::budget,
+        "usage", &ll::MemoryHeapBudget::usage);
+
+    lib.new_usertype<ll::MemoryStatistics>("MemoryStatistics",
+        "committedSize", &ll::MemoryStatistics::committedSize,
+        "usedSize", &ll::MemoryStatistics::usedSize,
+        "pages", &ll::MemoryStatistics::pages);
+
+    lib.new_usertype<ll::MemoryDefragmentationResult>("MemoryDefragmentationResult",
+        "movedBytes", &ll::MemoryDefragmentationResult::movedBytes,
+        "movedObjects", &ll::MemoryDefragmentationResult::movedObjects,
+        "complete", &ll::MemoryDefragmentationResult::complete);
+
     lib.new_usertype<ll::Parameter>("Parameter",
         sol::constructors<ll::Parameter(), ll::Parameter(const ll::Parameter&), ll::Parameter(ll::Parameter &&)>(),
         "type", sol::property(&ll::Parameter::getType),
@@ -168,18 +195,38 @@ void registerTypes(sol::table& lib)
         "program", sol::property(&ll::ComputeNodeDescriptor::getProgram, (ComputeNodeDescriptor & (ll::ComputeNodeDescriptor::*)(const std::shared_ptr<ll::Program>&) noexcept) & ll::ComputeNodeDescriptor::setProgram),
         "localShape", sol::property(&ll::ComputeNodeDescriptor::getLocalShape, &ll::ComputeNodeDescriptor::setLocalShape),
         "gridShape", sol::property(&ll::ComputeNodeDescriptor::getGridShape, &ll::ComputeNodeDescriptor::setGridShape),
+        "gridOffset", sol::property(&ll::ComputeNodeDescriptor::getGridOffset, &ll::ComputeNodeDescriptor::setGridOffset),
         "pushConstants", sol::property(&ll::ComputeNodeDescriptor::getPushConstants, &ll::ComputeNodeDescriptor::setPushConstants),
+        "specializationConstants", sol::property(&ll::ComputeNodeDescriptor::getSpecializationConstants, &ll::ComputeNodeDescriptor::setSpecializationConstants),
+        "isParameterBlockEnabled", sol::property(&ll::ComputeNodeDescriptor::isParameterBlockEnabled),
+        "parameterBlockBinding", sol::property(&ll::ComputeNodeDescriptor::getParameterBlockBinding, &ll::ComputeNodeDescriptor::setParameterBlockBinding),
+        "disableParameterBlock", &ll::ComputeNodeDescriptor::disableParameterBlock,
+        "isIndirectDispatchEnabled", sol::property(&ll::ComputeNodeDescriptor::isIndirectDispatchEnabled),
+        "indirectDispatchPort", sol::property(&ll::ComputeNodeDescriptor::getIndirectDispatchPort),
+        "indirectDispatchOffset", sol::property(&ll::ComputeNodeDescriptor::getIndirectDispatchOffset),
+        "setIndirectDispatch", &ll::ComputeNodeDescriptor::setIndirectDispatch,
+        "disableIndirectDispatch", &ll::ComputeNodeDescriptor::disableIndirectDispatch,
+        "stencilRadius", sol::property(&ll::ComputeNodeDescriptor::getStencilRadius, &ll::ComputeNodeDescriptor::setStencilRadius),
+        "descriptorSetCount", sol::property(&ll::ComputeNodeDescriptor::getDescriptorSetCount, &ll::ComputeNodeDescriptor::setDescriptorSetCount),
         "addPort", &ll::ComputeNodeDescriptor::addPort,
+        "portCount", sol::property(&ll::ComputeNodeDescriptor::getPortCount),
+        "getPortIndex", &ll::ComputeNodeDescriptor::getPortIndex,
+        "getParameterIndex", &ll::ComputeNodeDescriptor::getParameterIndex,
         "configureGridShape", &ll::ComputeNodeDescriptor::configureGridShape,
-        "__setParameter", &ll::ComputeNodeDescriptor::setParameter, // user facing setParameter() implemented in library.lua
-        "__getParameter", &ll::ComputeNodeDescriptor::getParameter  // user facing getParameter() implemented in library.lua
+        "configureGridRegion", &ll::ComputeNodeDescriptor::configureGridRegion,
+        "__setParameter", sol::overload((ll::ComputeNodeDescriptor & (ll::ComputeNodeDescriptor::*)(const std::string&, const ll::Parameter&)) & ll::ComputeNodeDescriptor::setParameter, (ll::ComputeNodeDescriptor & (ll::ComputeNodeDescriptor::*)(const uint32_t, const ll::Parameter&)) & ll::ComputeNodeDescriptor::setParameter), // user facing setParameter() implemented in library.lua
+        "__getParameter", sol::overload((const ll::Parameter& (ll::ComputeNodeDescriptor::*)(const std::string&) const) & ll::ComputeNodeDescriptor::getParameter, (const ll::Parameter& (ll::ComputeNodeDescriptor::*)(const uint32_t) const) & ll::ComputeNodeDescriptor::getParameter) // user facing getParameter() implemented in library.lua
     );
 
     lib.new_usertype<ll::ContainerNodeDescriptor>("ContainerNodeDescriptor",
         "builderName", sol::property(&ll::ContainerNodeDescriptor::getBuilderName, &ll::ContainerNodeDescriptor::setBuilderName),
+        "stencilRadius", sol::property(&ll::ContainerNodeDescriptor::getStencilRadius, &ll::ContainerNodeDescriptor::setStencilRadius),
         "addPort", &ll::ContainerNodeDescriptor::addPort,
-        "__setParameter", &ll::ContainerNodeDescriptor::setParameter, // user facing setParameter() implemented in library.lua
-        "__getParameter", &ll::ContainerNodeDescriptor::getParameter  // user facing getParameter() implemented in library.lua
+        "portCount", sol::property(&ll::ContainerNodeDescriptor::getPortCount),
+        "getPortIndex", &ll::ContainerNodeDescriptor::getPortIndex,
+        "getParameterIndex", &ll::ContainerNodeDescriptor::getParameterIndex,
+        "__setParameter", sol::overload((ll::ContainerNodeDescriptor & (ll::ContainerNodeDescriptor::*)(const std::string&, const ll::Parameter&)) & ll::ContainerNodeDescriptor::setParameter, (ll::ContainerNodeDescriptor & (ll::ContainerNodeDescriptor::*)(const uint32_t, const ll::Parameter&)) & ll::ContainerNodeDescriptor::setParameter), // user facing setParameter() implemented in library.lua
+        "__getParameter", sol::overload((const ll::Parameter& (ll::ContainerNodeDescriptor::*)(const std::string&) const) & ll::ContainerNodeDescriptor::getParameter, (const ll::Parameter& (ll::ContainerNodeDescriptor::*)(const uint32_t) const) & ll::ContainerNodeDescriptor::getParameter) // user facing getParameter() implemented in library.lua
     );
 
     lib.new_usertype<ll::PushConstants>("PushConstants",
@@ -190,6 +237,31 @@ void registerTypes(sol::table& lib)
         "pushFloat", &ll::PushConstants::pushFloat,
         "pushInt32", &ll::PushConstants::pushInt32);
 
+    lib.new_usertype<ll::SpecializationConstants>("SpecializationConstants",
+        sol::constructors<ll::SpecializationConstants(), ll::SpecializationConstants(const ll::SpecializationConstants&)>(),
+        "BEGIN", sol::var(ll::SpecializationConstants::BEGIN),
+        "count", sol::property(&ll::SpecializationConstants::getCount),
+        "contains", &ll::SpecializationConstants::contains,
+        "getType", &ll::SpecializationConstants::getType,
+        "setInt32", &ll::SpecializationConstants::setInt32,
+        "setUint32", &ll::SpecializationConstants::setUint32,
+        "setFloat", &ll::SpecializationConstants::setFloat,
+        "setBool", &ll::SpecializationConstants::setBool,
+        "getInt32", &ll::SpecializationConstants::getInt32,
+        "getUint32", &ll::SpecializationConstants::getUint32,
+        "getFloat", &ll::SpecializationConstants::getFloat,
+        "getBool", &ll::SpecializationConstants::getBool);
+
+    lib.new_usertype<ll::ParameterBlock>("ParameterBlock",
+        sol::no_constructor,
+        "blockSize", sol::property(&ll::ParameterBlock::getBlockSize),
+        "slotCount", sol::property(&ll::ParameterBlock::getSlotCount),
+        "slotStride", sol::property(&ll::ParameterBlock::getSlotStride),
+        "buffer", sol::property(&ll::ParameterBlock::getBuffer),
+        "getSlotOffset", &ll::ParameterBlock::getSlotOffset,
+        "write", (void(ll::ParameterBlock::*)(const uint32_t, const ll::PushConstants&)) & ll::ParameterBlock::write,
+        "writeAll", &ll::ParameterBlock::writeAll);
+
     lib.new_usertype<ll::NodeBuilderDescriptor>("NodeBuilderDescriptor",
         sol::constructors<ll::NodeBuilderDescriptor(), ll::NodeBuilderDescriptor(ll::NodeType, const std::string&, const std::string&)>(),
         "name", &ll::NodeBuilderDescriptor::name,
@@ -211,7 +283,24 @@ void registerTypes(sol::table& lib)
         "allocationInfo", sol::property(&ll::Buffer::getAllocationInfo),
         "usageFlags", sol::property(&ll::Buffer::getUsageFlagsUnsafe),
         "memory", sol::property(&ll::Buffer::getMemory),
-        "mapAndSetFromVectorUint8", &ll::Buffer::mapAndSetFromVector<uint8_t>);
+        "mapAndSetFromVectorUint8", &ll::Buffer::mapAndSetFromVector<uint8_t>,
+        "createBufferView", sol::overload(
+                                [](ll::Buffer& self, ll::ChannelCount channelCount, ll::ChannelType channelType) {
+                                    return self.createBufferView(channelCount, channelType);
+                                },
+                                [](ll::Buffer& self, ll::ChannelCount channelCount, ll::ChannelType channelType, uint64_t offset, uint64_t range) {
+                                    return self.createBufferView(channelCount, channelType, offset, range);
+                                }));
+
+    lib.new_usertype<ll::BufferView>("BufferView",
+        sol::no_constructor,
+        sol::base_classes, sol::bases<ll::Object>(),
+        "buffer", sol::property(&ll::BufferView::getBuffer),
+        "channelCount", sol::property(&ll::BufferView::getChannelCount),
+        "channelType", sol::property(&ll::BufferView::getChannelType),
+        "offset", sol::property(&ll::BufferView::getOffset),
+        "range", sol::property(&ll::BufferView::getRange),
+        "texelCount", sol::property(&ll::BufferView::getTexelCount));
 
     lib.new_usertype<ll::Image>("Image",
         sol::no_constructor,
@@ -220,6 +309,7 @@ void registerTypes(sol::table& lib)
         "descriptor", sol::property(&ll::Image::getDescriptor),
         "allocationInfo", sol::property(&ll::Image::getAllocationInfo),
         "memory", sol::property(&ll::Image::getMemory),
+        "isAliased", sol::property(&ll::Image::isAliased),
         "channelType", sol::property(&ll::Image::getChannelType),
         "channelCount", sol::property(&ll::Image::getChannelCount<ll::ChannelCount>),
         "width", sol::property(&ll::Image::getWidth),
@@ -229,7 +319,11 @@ void registerTypes(sol::table& lib)
         "layout", sol::property(&ll::Image::getLayout),
         "tiling", sol::property(&ll::Image::getTiling),
         "usageFlags", sol::property(&ll::Image::getUsageFlagsUnsafe),
+        "isMappable", sol::property(&ll::Image::isMappable),
+        "getRowPitch", &ll::Image::getRowPitch,
+        "getDepthPitch", &ll::Image::getDepthPitch,
         "changeImageLayout", &ll::Image::changeImageLayout,
+        "reshape", &ll::Image::reshape,
         "clear", &ll::Image::clear,
         "copyTo", &ll::Image::copyTo,
         "createImageView", &ll::Image::createImageView);
@@ -290,15 +384,30 @@ void registerTypes(sol::table& lib)
         "gridY", sol::property(&ll::ComputeNode::getGridY, &ll::ComputeNode::setGridY),
         "gridZ", sol::property(&ll::ComputeNode::getGridZ, &ll::ComputeNode::setGridZ),
         "gridShape", sol::property(&ll::ComputeNode::getGridShape, &ll::ComputeNode::setGridShape),
+        "gridOffset", sol::property(&ll::ComputeNode::getGridOffset, &ll::ComputeNode::setGridOffset),
         "pushConstants", sol::property(&ll::ComputeNode::getPushConstants, &ll::ComputeNode::setPushConstants),
+        "specializationConstants", sol::property(&ll::ComputeNode::getSpecializationConstants, &ll::ComputeNode::setSpecializationConstants),
+        "parameterBlock", sol::property(&ll::ComputeNode::getParameterBlock),
+        "parameterBlockSlot", sol::property(&ll::ComputeNode::getParameterBlockSlot, &ll::ComputeNode::setParameterBlockSlot),
+        "bindParameterBlock", &ll::ComputeNode::bindParameterBlock,
+        "setFrameIndex", &ll::ComputeNode::setFrameIndex,
+        "instantiate", &ll::ComputeNode::instantiate,
+        "reinit", &ll::ComputeNode::reinit,
+        "descriptorSetIndex", sol::property(&ll::ComputeNode::getDescriptorSetIndex),
+        "bindRange", &ll::ComputeNode::bindRange,
+        "setDynamicOffset", &ll::ComputeNode::setDynamicOffset,
+        "getDynamicOffset", &ll::ComputeNode::getDynamicOffset,
         "configureGridShape", &ll::ComputeNode::configureGridShape,
+        "scaleGridShape", &ll::ComputeNode::scaleGridShape,
+        "configureGridRegion", &ll::ComputeNode::configureGridRegion,
         "init", &ll::ComputeNode::init,
         "record", &ll::ComputeNode::record,
         "hasPort", &ll::ComputeNode::hasPort,
-        "__setParameter", &ll::ComputeNode::setParameter,
-        "__getParameter", &ll::ComputeNode::getParameter,
-        "__getPort", &ll::ComputeNode::getPort, // user facing getPort() implemented in library.lua
-        "__bind", &ll::ComputeNode::bind        // user facing bind() implemented in library.lua
+        "getPortIndex", &ll::ComputeNode::getPortIndex,
+        "__setParameter", sol::overload((void(ll::ComputeNode::*)(const std::string&, const ll::Parameter&)) & ll::ComputeNode::setParameter, (void(ll::ComputeNode::*)(const uint32_t, const ll::Parameter&)) & ll::ComputeNode::setParameter),
+        "__getParameter", sol::overload((const ll::Parameter& (ll::ComputeNode::*)(const std::string&) const) & ll::ComputeNode::getParameter, (const ll::Parameter& (ll::ComputeNode::*)(const uint32_t) const) & ll::ComputeNode::getParameter),
+        "__getPort", sol::overload((std::shared_ptr<ll::Object>(ll::ComputeNode::*)(const std::string&) const) & ll::ComputeNode::getPort, (std::shared_ptr<ll::Object>(ll::ComputeNode::*)(const uint32_t) const) & ll::ComputeNode::getPort), // user facing getPort() implemented in library.lua
+        "__bind", sol::overload((void(ll::ComputeNode::*)(const std::string&, const std::shared_ptr<ll::Object>&)) & ll::ComputeNode::bind, (void(ll::ComputeNode::*)(const uint32_t, const std::shared_ptr<ll::Object>&)) & ll::ComputeNode::bind) // user facing bind() implemented in library.lua
     );
 
     lib.new_usertype<ll::ContainerNode>("ContainerNode",
@@ -306,27 +415,38 @@ void registerTypes(sol::table& lib)
         "type", sol::property(&ll::ContainerNode::getType),
         "state", sol::property(&ll::ContainerNode::getState),
         "descriptor", sol::property(&ll::ContainerNode::getDescriptor),
+        "transientMemorySize", sol::property(&ll::ContainerNode::getTransientMemorySize),
         "init", &ll::ContainerNode::init,
         "record", &ll::ContainerNode::record,
         "hasPort", &ll::ContainerNode::hasPort,
-        "__setParameter", &ll::ContainerNode::setParameter,
-        "__getParameter", &ll::ContainerNode::getParameter,
-        "__getPort", &ll::ContainerNode::getPort,   // user facing getPort() implemented in library.lua
-        "__bind", &ll::ContainerNode::bind,         // user facing bind() implemented in library.lua
+        "getPortIndex", &ll::ContainerNode::getPortIndex,
+        "getNodeIndex", &ll::ContainerNode::getNodeIndex,
+        "setFrameIndex", &ll::ContainerNode::setFrameIndex,
+        "instantiate", &ll::ContainerNode::instantiate,
+        "reinit", &ll::ContainerNode::reinit,
+        "__setParameter", sol::overload((void(ll::ContainerNode::*)(const std::string&, const ll::Parameter&)) & ll::ContainerNode::setParameter, (void(ll::ContainerNode::*)(const uint32_t, const ll::Parameter&)) & ll::ContainerNode::setParameter),
+        "__getParameter", sol::overload((const ll::Parameter& (ll::ContainerNode::*)(const std::string&) const) & ll::ContainerNode::getParameter, (const ll::Parameter& (ll::ContainerNode::*)(const uint32_t) const) & ll::ContainerNode::getParameter),
+        "__getPort", sol::overload((std::shared_ptr<ll::Object>(ll::ContainerNode::*)(const std::string&) const) & ll::ContainerNode::getPort, (std::shared_ptr<ll::Object>(ll::ContainerNode::*)(const uint32_t) const) & ll::ContainerNode::getPort), // user facing getPort() implemented in library.lua
+        "__bind", sol::overload((void(ll::ContainerNode::*)(const std::string&, const std::shared_ptr<ll::Object>&)) & ll::ContainerNode::bind, (void(ll::ContainerNode::*)(const uint32_t, const std::shared_ptr<ll::Object>&)) & ll::ContainerNode::bind), // user facing bind() implemented in library.lua
         "__bindNode", &ll::ContainerNode::bindNode, // user facing bindNode() implemented in library.lua
-        "__getNode", &ll::ContainerNode::getNode    // user facing getNode() implemented in library.lua
+        "__getNode", sol::overload((std::shared_ptr<ll::Node>(ll::ContainerNode::*)(const std::string&) const) & ll::ContainerNode::getNode, (std::shared_ptr<ll::Node>(ll::ContainerNode::*)(const uint32_t) const) & ll::ContainerNode::getNode), // user facing getNode() implemented in library.lua
+        "__markTransient", &ll::ContainerNode::markTransient  // user facing markTransient() implemented in library.lua
     );
 
     lib.new_usertype<ll::Session>("Session",
         sol::no_constructor,
         "getHostMemory", &ll::Session::getHostMemory,
+        "getReadbackMemory", &ll::Session::getReadbackMemory,
+        "getUploadMemory", &ll::Session::getUploadMemory,
         "getDeviceMemory", &ll::Session::getDeviceMemory,
         "isImageDescriptorSupported", &ll::Session::isImageDescriptorSupported,
         "getProgram", &ll::Session::getProgram,
         "createCommandBuffer", &ll::Session::createCommandBuffer,
         "createComputeNode", (std::shared_ptr<ll::ComputeNode>(ll::Session::*)(const std::string& builderName)) & ll::Session::createComputeNode,
         "createContainerNode", (std::shared_ptr<ll::ContainerNode>(ll::Session::*)(const std::string& builderName)) & ll::Session::createContainerNode,
+        "createParameterBlock", &ll::Session::createParameterBlock,
         "getGoodComputeLocalShape", &ll::Session::getGoodComputeLocalShape,
+        "__loadLazyNodeBuilder", &ll::Session::loadLazyNodeBuilder,
         "__runComputeNode", (void(ll::Session::*)(const ll::ComputeNode& node)) & ll::Session::run,
         "__runContainerNode", (void(ll::Session::*)(const ll::ContainerNode& node)) & ll::Session::run,
         "__runCommandBuffer", (void(ll::Session::*)(const ll::CommandBuffer& node)) & ll::Session::run);
@@ -337,6 +457,13 @@ void registerTypes(sol::table& lib)
         "pageCount", sol::property(&ll::Memory::getPageCount),
         "isMappable", sol::property(&ll::Memory::isMappable),
         "isPageMappable", &ll::Memory::isPageMappable,
+        "statistics", sol::property(&ll::Memory::getStatistics),
+        "heapBudgets", sol::property(&ll::Memory::getHeapBudgets),
+        "trim", &ll::Memory::trim,
+        "enableAutoTrim", &ll::Memory::enableAutoTrim,
+        "disableAutoTrim", &ll::Memory::disableAutoTrim,
+        "isAutoTrimEnabled", sol::property(&ll::Memory::isAutoTrimEnabled),
+        "defragment", &ll::Memory::defragment,
         "createBuffer", sol::overload((std::shared_ptr<ll::Buffer>(ll::Memory::*)(const uint64_t)) & ll::Memory::createBuffer, &ll::Memory::createBufferWithUnsafeFlags),
         "createImage", &ll::Memory::createImage,
         "createImageView", &ll::Memory::createImageView);
@@ -347,11 +474,14 @@ void registerTypes(sol::table& lib)
         "ends", &ll::CommandBuffer::end,
         "run", (void(ll::CommandBuffer::*)(const ll::ComputeNode& node)) & ll::CommandBuffer::run,
         "memoryBarrier", &ll::CommandBuffer::memoryBarrier,
+        "indirectBarrier", &ll::CommandBuffer::indirectBarrier,
+        "dispatchIndirect", &ll::CommandBuffer::dispatchIndirect,
         "changeImageLayout", (void(ll::CommandBuffer::*)(ll::Image & image, const ll::ImageLayout newLayout)) & ll::CommandBuffer::changeImageLayout,
         "clearImage", (void(ll::CommandBuffer::*)(ll::Image & image)) & ll::CommandBuffer::clearImage,
         "clearImage", (void(ll::CommandBuffer::*)(ll::ImageView & imageView)) & ll::CommandBuffer::clearImage,
-        "copyImageToImage", &ll::CommandBuffer::copyImageToImage,
-        "copyBufferToImage", &ll::CommandBuffer::copyBufferToImage);
+        "copyImageToImage", sol::overload((void(ll::CommandBuffer::*)(const ll::Image&, const ll::Image&)) & ll::CommandBuffer::copyImageToImage, (void(ll::CommandBuffer::*)(const ll::Image&, const ll::Image&, const ll::vec3ui&, const ll::vec3ui&, const ll::vec3ui&)) & ll::CommandBuffer::copyImageToImage),
+        "copyBufferToImage", sol::overload((void(ll::CommandBuffer::*)(const ll::Buffer&, const ll::Image&)) & ll::CommandBuffer::copyBufferToImage, (void(ll::CommandBuffer::*)(const ll::Buffer&, const ll::Image&, const ll::vec3ui&, const ll::vec3ui&, const uint64_t, const uint32_t)) & ll::CommandBuffer::copyBufferToImage),
+        "copyImageToBuffer", sol::overload((void(ll::CommandBuffer::*)(const ll::Image&, const ll::Buffer&)) & ll::CommandBuffer::copyImageToBuffer, (void(ll::CommandBuffer::*)(const ll::Image&, const ll::Buffer&, const ll::vec3ui&, const ll::vec3ui&, const uint64_t, const uint32_t)) & ll::CommandBuffer::copyImageToBuffer));
 
     ///////////////////////////////////////////////////////
     // Utility methods
@@ -373,13 +503,15 @@ Interpreter::Interpreter()
 
     registerTypes(m_lib);
 
-    m_libImpl["castObjectToBuffer"]    = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::Buffer>(obj); };
-    m_libImpl["castObjectToImage"]     = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::Image>(obj); };
-    m_libImpl["castObjectToImageView"] = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::ImageView>(obj); };
+    m_libImpl["castObjectToBuffer"]     = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::Buffer>(obj); };
+    m_libImpl["castObjectToImage"]      = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::Image>(obj); };
+    m_libImpl["castObjectToImageView"]  = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::ImageView>(obj); };
+    m_libImpl["castObjectToBufferView"] = [](std::shared_ptr<ll::Object> obj) { return std::static_pointer_cast<ll::BufferView>(obj); };
 
-    m_libImpl["castBufferToObject"]    = [](std::shared_ptr<ll::Buffer> buffer) { return std::static_pointer_cast<ll::Object>(buffer); };
-    m_libImpl["castImageToObject"]     = [](std::shared_ptr<ll::Image> image) { return std::static_pointer_cast<ll::Object>(image); };
-    m_libImpl["castImageViewToObject"] = [](std::shared_ptr<ll::ImageView> imageView) { return std::static_pointer_cast<ll::Object>(imageView); };
+    m_libImpl["castBufferToObject"]     = [](std::shared_ptr<ll::Buffer> buffer) { return std::static_pointer_cast<ll::Object>(buffer); };
+    m_libImpl["castImageToObject"]      = [](std::shared_ptr<ll::Image> image) { return std::static_pointer_cast<ll::Object>(image); };
+    m_libImpl["castImageViewToObject"]  = [](std::shared_ptr<ll::ImageView> imageView) { return std::static_pointer_cast<ll::Object>(imageView); };
+    m_libImpl["castBufferViewToObject"] = [](std::shared_ptr<ll::BufferView> bufferView) { return std::static_pointer_cast<ll::Object>(bufferView); };
 
     m_libImpl["castComputeNodeToNode"]   = [](std::shared_ptr<ll::ComputeNode> node) { return std::static_pointer_cast<ll::Node>(node); };
     m_libImpl["castContainerNodeToNode"] = [](std::shared_ptr<ll::ContainerNode> node) { return std::static_pointer_cast<ll::Node>(node); };
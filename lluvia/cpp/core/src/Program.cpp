@@ -21,13 +21,17 @@ Program::Program(
     , m_spirvCode {spirvCode}
 {
 
-    ll::throwSystemErrorIf(m_spirvCode.empty(), ll::ErrorCode::ProgramCompilationError, "Zero size SPIR-V code.");
+    createShaderModule(reinterpret_cast<const uint32_t*>(m_spirvCode.data()), m_spirvCode.size());
+}
 
-    vk::ShaderModuleCreateInfo moduleCreateInfo = vk::ShaderModuleCreateInfo()
-                                                      .setCodeSize(m_spirvCode.size())
-                                                      .setPCode(reinterpret_cast<const uint32_t*>(m_spirvCode.data()));
+Program::Program(
+    const std::shared_ptr<ll::vulkan::Device>& device,
+    const uint32_t*                            spirvCode,
+    const size_t                               codeSize)
+    : m_device {device}
+{
 
-    m_module = m_device->get().createShaderModule(moduleCreateInfo);
+    createShaderModule(spirvCode, codeSize);
 }
 
 Program::~Program()
@@ -45,4 +49,27 @@ const std::vector<uint8_t>& Program::getSpirV() const noexcept
     return m_spirvCode;
 }
 
+bool Program::hasSpirV() const noexcept
+{
+    return !m_spirvCode.empty();
+}
+
+void Program::releaseSpirV() noexcept
+{
+    // swap to actually release the vector capacity
+    std::vector<uint8_t> {}.swap(m_spirvCode);
+}
+
+void Program::createShaderModule(const uint32_t* spirvCode, const size_t codeSize)
+{
+
+    ll::throwSystemErrorIf(spirvCode == nullptr || codeSize == 0, ll::ErrorCode::ProgramCompilationError, "Zero size SPIR-V code.");
+
+    vk::ShaderModuleCreateInfo moduleCreateInfo = vk::ShaderModuleCreateInfo()
+                                                      .setCodeSize(codeSize)
+                                                      .setPCode(spirvCode);
+
+    m_module = m_device->get().createShaderModule(moduleCreateInfo);
+}
+
 } // namespace ll
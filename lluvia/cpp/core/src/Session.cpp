@@ -11,8 +11,10 @@
 
 #include "lluvia/core/CommandBuffer.h"
 #include "lluvia/core/Duration.h"
+#include "lluvia/core/FrameProcessor.h"
 #include "lluvia/core/Interpreter.h"
 #include "lluvia/core/Program.h"
+#include "lluvia/core/TiledExecutor.h"
 #include "lluvia/core/buffer/Buffer.h"
 #include "lluvia/core/error.h"
 #include "lluvia/core/image/Image.h"
@@ -22,22 +24,53 @@
 #include "lluvia/core/node/ComputeNodeDescriptor.h"
 #include "lluvia/core/node/ContainerNode.h"
 #include "lluvia/core/node/ContainerNodeDescriptor.h"
+#include "lluvia/core/node/NodeBuilder.h"
+#include "lluvia/core/node/ParameterBlock.h"
 
+#include "lluvia/core/impl/GraphSnapshot.h"
 #include "lluvia/core/impl/ZipArchive.h"
 
 #include "lluvia/core/vulkan/Device.h"
 #include "lluvia/core/vulkan/Instance.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cstring>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 
 namespace ll {
 
 using namespace std;
 
+namespace {
+
+    // unless keepSpirV is set, library programs do not keep a host copy of their SPIR-V code
+    std::shared_ptr<ll::Program> createLibraryProgram(const std::shared_ptr<ll::vulkan::Device>& device,
+        ll::impl::ZipArchive&                                                                      archive,
+        mz_zip_archive_file_stat&                                                                  stat,
+        const bool                                                                                 keepSpirV)
+    {
+
+        if (keepSpirV) {
+            return std::make_shared<ll::Program>(device, archive.uncompressBinaryFile(stat));
+        }
+
+        // entries stored uncompressed are read in place from the mapped archive
+        const auto data = archive.getStoredFileData(stat);
+        if (data != nullptr && reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) == 0) {
+            return std::make_shared<ll::Program>(device, reinterpret_cast<const uint32_t*>(data), static_cast<size_t>(stat.m_uncomp_size));
+        }
+
+        // compressed or misaligned entries go through a temporary copy
+        const auto spirv = archive.uncompressBinaryFile(stat);
+        return std::make_shared<ll::Program>(device, reinterpret_cast<const uint32_t*>(spirv.data()), spirv.size());
+    }
+
+} // namespace
+
 std::shared_ptr<ll::Session> Session::create()
 {
     return create(ll::SessionDescriptor {});
@@ -102,6 +135,12 @@ Session::Session(const ll::SessionDescriptor& descriptor)
         0, false);
 
     m_deviceMemory = createMemory(ll::MemoryPropertyFlagBits::DeviceLocal, 0, false);
+
+    m_readbackMemory = createPreferredMemory(ll::MemoryPropertyFlagBits::HostVisible,
+        ll::MemoryPropertyFlagBits::HostCached, ll::MemoryPropertyFlags {}, 0);
+
+    m_uploadMemory = createPreferredMemory(ll::MemoryPropertyFlagBits::HostVisible | ll::MemoryPropertyFlagBits::HostCoherent,
+        ll::MemoryPropertyFlags {}, ll::MemoryPropertyFlagBits::HostCached, 0);
 }
 
 Session::~Session()
@@ -122,6 +161,16 @@ std::shared_ptr<ll::Memory> Session::getDeviceMemory() const noexcept
     return m_deviceMemory;
 }
 
+std::shared_ptr<ll::Memory> Session::getReadbackMemory() const noexcept
+{
+    return m_readbackMemory;
+}
+
+std::shared_ptr<ll::Memory> Session::getUploadMemory() const noexcept
+{
+    return m_uploadMemory;
+}
+
 vk::PhysicalDeviceMemoryProperties Session::getPhysicalDeviceMemoryProperties() const
 {
     return m_device->getPhysicalDevice().getMemoryProperties();
@@ -158,6 +207,11 @@ const ll::DeviceDescriptor& Session::getDeviceDescriptor() const noexcept
     return m_deviceDescriptor;
 }
 
+size_t Session::getSamplerCount() const noexcept
+{
+    return m_device->getSamplerCount();
+}
+
 bool Session::isImageDescriptorSupported(const ll::ImageDescriptor& descriptor) const noexcept
 {
 
@@ -173,28 +227,75 @@ std::shared_ptr<ll::Memory> Session::createMemory(const ll::MemoryPropertyFlags&
 
     const auto memProperties = m_device->getPhysicalDevice().getMemoryProperties();
 
-    for (auto i = 0u; i < memProperties.memoryTypeCount; ++i) {
+    auto matchingTypes = std::vector<uint32_t> {};
 
-        const auto& memType = memProperties.memoryTypes[i];
+    for (auto i = 0u; i < memProperties.memoryTypeCount; ++i) {
 
-        const auto memoryPropertyFlags = ll::impl::fromVkMemoryPropertyFlags(memType.propertyFlags);
+        const auto memoryPropertyFlags = ll::impl::fromVkMemoryPropertyFlags(memProperties.memoryTypes[i].propertyFlags);
 
         if (compareFlags(memoryPropertyFlags, flags, exactFlagsMatch)) {
+            matchingTypes.push_back(i);
+        }
+    }
+
+    return createMemoryFromTypes(matchingTypes, pageSize);
+}
 
-            auto heapInfo = ll::VkHeapInfo {};
+std::shared_ptr<ll::Memory> Session::createPreferredMemory(const ll::MemoryPropertyFlags& required,
+    const ll::MemoryPropertyFlags&                                                         preferred,
+    const ll::MemoryPropertyFlags&                                                         avoided,
+    const uint64_t                                                                         pageSize)
+{
 
-            heapInfo.typeIndex          = i;
-            heapInfo.size               = memProperties.memoryHeaps[memType.heapIndex].size;
-            heapInfo.flags              = memoryPropertyFlags;
-            heapInfo.familyQueueIndices = std::vector<uint32_t> {m_device->getComputeFamilyQueueIndex()};
+    const auto memProperties = m_device->getPhysicalDevice().getMemoryProperties();
 
-            // can throw exception. Invariants of Session are kept.
-            return std::make_shared<ll::Memory>(m_device, heapInfo, pageSize);
+    auto rankedTypes = std::vector<std::pair<uint32_t, uint32_t>> {};
+
+    for (auto i = 0u; i < memProperties.memoryTypeCount; ++i) {
+
+        const auto flags = ll::impl::fromVkMemoryPropertyFlags(memProperties.memoryTypes[i].propertyFlags);
+
+        if ((flags & required) == required) {
+            const auto rank = ((flags & preferred) == preferred ? 2u : 0u) + (static_cast<uint32_t>(flags & avoided) == 0u ? 1u : 0u);
+            rankedTypes.push_back(std::make_pair(rank, i));
         }
     }
 
-    throw std::system_error(createErrorCode(ll::ErrorCode::MemoryCreationError),
+    ll::throwSystemErrorIf(rankedTypes.empty(), ll::ErrorCode::MemoryCreationError,
+        "No memory was found that matched the requested flags.");
+
+    // keep the device order among types with the same rank
+    std::stable_sort(rankedTypes.begin(), rankedTypes.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    auto matchingTypes = std::vector<uint32_t> {};
+    for (const auto& ranked : rankedTypes) {
+        matchingTypes.push_back(ranked.second);
+    }
+
+    return createMemoryFromTypes(matchingTypes, pageSize);
+}
+
+std::shared_ptr<ll::Memory> Session::createMemoryFromTypes(const std::vector<uint32_t>& typeIndices, const uint64_t pageSize)
+{
+
+    ll::throwSystemErrorIf(typeIndices.empty(), ll::ErrorCode::MemoryCreationError,
         "No memory was found that matched the requested flags.");
+
+    const auto memProperties = m_device->getPhysicalDevice().getMemoryProperties();
+    const auto& memType      = memProperties.memoryTypes[typeIndices[0]];
+
+    auto heapInfo = ll::VkHeapInfo {};
+
+    heapInfo.typeIndex          = typeIndices[0];
+    heapInfo.size               = memProperties.memoryHeaps[memType.heapIndex].size;
+    heapInfo.flags              = ll::impl::fromVkMemoryPropertyFlags(memType.propertyFlags);
+    heapInfo.familyQueueIndices = std::vector<uint32_t> {m_device->getComputeFamilyQueueIndex()};
+
+    // the remaining types are used when the first one runs out of memory
+    heapInfo.fallbackTypeIndices = std::vector<uint32_t>(typeIndices.cbegin() + 1, typeIndices.cend());
+
+    // can throw exception. Invariants of Session are kept.
+    return std::make_shared<ll::Memory>(m_device, heapInfo, pageSize);
 }
 
 std::shared_ptr<ll::Program> Session::createProgram(const std::string& spirvPath) const
@@ -234,6 +335,9 @@ void Session::setProgram(const std::string& name, const std::shared_ptr<ll::Prog
     ll::throwSystemErrorIf(program == nullptr, ll::ErrorCode::InvalidArgument, "program parameter must be not null");
 
     m_programRegistry.insert_or_assign(name, program);
+
+    // the program set by the user takes precedence over any lazy library entry
+    m_lazyPrograms.erase(name);
 }
 
 std::shared_ptr<ll::Program> Session::getProgram(const std::string& name) const
@@ -242,16 +346,46 @@ std::shared_ptr<ll::Program> Session::getProgram(const std::string& name) const
     auto iter = m_programRegistry.find(name);
 
     if (iter == m_programRegistry.cend()) {
-        // FIXME: what to do?
-        return nullptr;
+
+        auto lazyIter = m_lazyPrograms.find(name);
+        if (lazyIter == m_lazyPrograms.cend()) {
+            // FIXME: what to do?
+            return nullptr;
+        }
+
+        auto& archive = *lazyIter->second.archive;
+        auto  stat    = archive.getFileStat(lazyIter->second.fileIndex);
+        auto  program = createLibraryProgram(m_device, archive, stat, m_descriptor.isLibrarySpirVCopyEnabled());
+
+        m_lazyPrograms.erase(lazyIter);
+        iter = m_programRegistry.insert_or_assign(name, program).first;
     }
 
     return iter->second;
 }
 
+void Session::registerNodeBuilder(const std::string& name, const std::shared_ptr<ll::NodeBuilder>& builder)
+{
+
+    ll::throwSystemErrorIf(name.empty(), ll::ErrorCode::InvalidArgument, "builder name must be not empty");
+    ll::throwSystemErrorIf(builder == nullptr, ll::ErrorCode::InvalidArgument, "builder parameter must be not null");
+
+    m_nodeBuilders.insert_or_assign(name, builder);
+}
+
+std::shared_ptr<ll::NodeBuilder> Session::getNodeBuilder(const std::string& name) const noexcept
+{
+
+    const auto iter = m_nodeBuilders.find(name);
+    return iter != m_nodeBuilders.cend() ? iter->second : nullptr;
+}
+
 std::vector<ll::NodeBuilderDescriptor> Session::getNodeBuilderDescriptors() const
 {
 
+    // descriptors are built from the builder scripts
+    loadLazyNodeBuilders();
+
     constexpr auto lua = R"(
         local fromCpp = ...
         local descriptors = ll.getNodeBuilderDescriptors()
@@ -261,15 +395,63 @@ std::vector<ll::NodeBuilderDescriptor> Session::getNodeBuilderDescriptors() cons
         end
     )";
 
+    auto luaDescriptors = std::vector<ll::NodeBuilderDescriptor> {};
+    m_interpreter->loadAndRunNoReturn(lua, luaDescriptors);
+
+    // native builders hide the Lua builders with the same name
     auto output = std::vector<ll::NodeBuilderDescriptor> {};
-    m_interpreter->loadAndRunNoReturn(lua, output);
+    for (const auto& kv : m_nodeBuilders) {
+        const auto doc = kv.second->getDoc();
+        output.emplace_back(kv.second->getType(), kv.first, doc.substr(0, doc.find('\n')));
+    }
+
+    std::copy_if(luaDescriptors.cbegin(), luaDescriptors.cend(), std::back_inserter(output),
+        [this](const auto& desc) { return m_nodeBuilders.find(desc.name) == m_nodeBuilders.cend(); });
+
+    // same case-insensitive order as ll.getNodeBuilderDescriptors
+    const auto toLower = [](std::string str) {
+        std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return str;
+    };
+
+    std::stable_sort(output.begin(), output.end(), [&toLower](const auto& a, const auto& b) { return toLower(a.name) < toLower(b.name); });
 
     return output;
 }
 
+std::shared_ptr<ll::ParameterBlock> Session::createParameterBlock(const uint64_t blockSize, const uint32_t slotCount)
+{
+
+    const auto& limits = m_device->getPhysicalDeviceLimits();
+
+    ll::throwSystemErrorIf(blockSize > limits.maxUniformBufferRange, ll::ErrorCode::InvalidArgument,
+        "parameter block size (" + std::to_string(blockSize) + " bytes) is greater than the device maxUniformBufferRange limit (" + std::to_string(limits.maxUniformBufferRange) + " bytes)");
+
+    // host memory has page size 0, so the mapped buffer does not share its page with other objects
+    return std::make_shared<ll::ParameterBlock>(m_hostMemory, blockSize, slotCount, limits.minUniformBufferOffsetAlignment);
+}
+
+std::shared_ptr<ll::TiledExecutor> Session::createTiledExecutor(const ll::TiledExecutorDescriptor& descriptor)
+{
+
+    return std::make_shared<ll::TiledExecutor>(shared_from_this(), m_device, descriptor);
+}
+
+std::shared_ptr<ll::FrameProcessor> Session::createFrameProcessor(const ll::FrameProcessorDescriptor& descriptor)
+{
+
+    return std::make_shared<ll::FrameProcessor>(shared_from_this(), m_device, descriptor);
+}
+
 std::shared_ptr<ll::ComputeNode> Session::createComputeNode(const ll::ComputeNodeDescriptor& descriptor)
 {
 
+    // nodes of native builders run the builder's onNodeInit instead of the Lua one
+    const auto builder = getNodeBuilder(descriptor.getBuilderName());
+    if (builder != nullptr && builder->getType() == ll::NodeType::Compute) {
+        return std::make_shared<ll::ComputeNode>(m_device, descriptor, m_interpreter, std::static_pointer_cast<ll::ComputeNodeBuilder>(builder));
+    }
+
     return std::make_shared<ll::ComputeNode>(m_device, descriptor, m_interpreter);
 }
 
@@ -287,6 +469,19 @@ std::shared_ptr<ll::ComputeNode> Session::createComputeNode(const std::string& b
 ll::ComputeNodeDescriptor Session::createComputeNodeDescriptor(const std::string& builderName) const
 {
 
+    if (const auto builder = getNodeBuilder(builderName)) {
+
+        ll::throwSystemErrorIf(builder->getType() != ll::NodeType::Compute, ll::ErrorCode::InvalidArgument,
+            "builder [" + builderName + "] does not create compute nodes");
+
+        auto descriptor = std::static_pointer_cast<ll::ComputeNodeBuilder>(builder)->newDescriptor(*this);
+        if (descriptor.getBuilderName().empty()) {
+            descriptor.setBuilderName(builderName);
+        }
+
+        return descriptor;
+    }
+
     // FIXME: need to distinguish between Compute and Container builders
     constexpr auto lua = R"(
         local builderName = ...
@@ -300,6 +495,11 @@ ll::ComputeNodeDescriptor Session::createComputeNodeDescriptor(const std::string
 std::shared_ptr<ll::ContainerNode> Session::createContainerNode(const ll::ContainerNodeDescriptor& descriptor)
 {
 
+    const auto builder = getNodeBuilder(descriptor.getBuilderName());
+    if (builder != nullptr && builder->getType() == ll::NodeType::Container) {
+        return std::make_shared<ll::ContainerNode>(m_interpreter, descriptor, std::static_pointer_cast<ll::ContainerNodeBuilder>(builder));
+    }
+
     return std::make_shared<ll::ContainerNode>(m_interpreter, descriptor);
 }
 
@@ -313,6 +513,19 @@ std::shared_ptr<ll::ContainerNode> Session::createContainerNode(const std::strin
 ll::ContainerNodeDescriptor Session::createContainerNodeDescriptor(const std::string& builderName) const
 {
 
+    if (const auto builder = getNodeBuilder(builderName)) {
+
+        ll::throwSystemErrorIf(builder->getType() != ll::NodeType::Container, ll::ErrorCode::InvalidArgument,
+            "builder [" + builderName + "] does not create container nodes");
+
+        auto descriptor = std::static_pointer_cast<ll::ContainerNodeBuilder>(builder)->newDescriptor(*this);
+        if (descriptor.getBuilderName().empty()) {
+            descriptor.setBuilderName(builderName);
+        }
+
+        return descriptor;
+    }
+
     // FIXME: need to distinguish between Compute and Container builders
     constexpr auto lua = R"(
         local builderName = ...
@@ -329,6 +542,31 @@ std::unique_ptr<ll::Duration> Session::createDuration() const
     return std::make_unique<ll::Duration>(m_device);
 }
 
+bool Session::isHostMemoryImportSupported() const noexcept
+{
+    return m_device->isExternalMemoryHostSupported();
+}
+
+uint64_t Session::getMinImportedHostPointerAlignment() const
+{
+    return m_device->getMinImportedHostPointerAlignment();
+}
+
+std::shared_ptr<ll::Buffer> Session::importHostMemory(void* ptr, const uint64_t size)
+{
+
+    const auto usageFlags = ll::BufferUsageFlags {ll::BufferUsageFlagBits::StorageBuffer
+                                                  | ll::BufferUsageFlagBits::TransferSrc
+                                                  | ll::BufferUsageFlagBits::TransferDst};
+
+    return importHostMemory(ptr, size, usageFlags);
+}
+
+std::shared_ptr<ll::Buffer> Session::importHostMemory(void* ptr, const uint64_t size, const ll::BufferUsageFlags usageFlags)
+{
+    return m_hostMemory->importHostMemory(ptr, size, usageFlags);
+}
+
 std::unique_ptr<ll::CommandBuffer> Session::createCommandBuffer() const
 {
 
@@ -375,18 +613,19 @@ void Session::scriptFile(const std::string& filename)
     m_interpreter->runFile(filename);
 }
 
-void Session::loadLibrary(const std::string& filename)
+void Session::loadLibrary(const std::string& filename, const bool lazy)
 {
 
     constexpr const auto LUA_EXTENSION    = ".lua";
     constexpr const auto SPV_EXTENSION    = ".spv";
     constexpr const auto EXTENSION_LENGTH = 4;
 
-    auto       archive     = ll::impl::ZipArchive {filename};
-    const auto numberFiles = archive.numberFiles();
+    // lazy entries keep the archive open until all of them are loaded
+    auto       archive     = std::make_shared<ll::impl::ZipArchive>(filename);
+    const auto numberFiles = archive->numberFiles();
     for (auto i = 0u; i < numberFiles; ++i) {
 
-        auto stat     = archive.getFileStat(i);
+        auto stat     = archive->getFileStat(i);
         auto filepath = std::string {stat.m_filename};
 
         // ignore filepaths whose length is less than the extension length
@@ -394,20 +633,86 @@ void Session::loadLibrary(const std::string& filename)
             continue;
         }
 
+        const auto name = filepath.substr(0, filepath.size() - EXTENSION_LENGTH);
+
         if (filepath.compare(filepath.size() - EXTENSION_LENGTH, EXTENSION_LENGTH, LUA_EXTENSION) == 0) {
 
-            auto luaScript = archive.uncompressTextFile(stat);
+            // library scripts are named after the builder they register
+            if (lazy) {
+                m_lazyNodeBuilders.insert_or_assign(name, LazyLibraryEntry {archive, i});
+                continue;
+            }
+
+            auto luaScript = archive->uncompressTextFile(stat);
             script(luaScript);
         } else if (filepath.compare(filepath.size() - EXTENSION_LENGTH, EXTENSION_LENGTH, SPV_EXTENSION) == 0) {
-            auto spirv = archive.uncompressBinaryFile(stat);
 
-            auto program     = createProgram(spirv);
-            auto programName = filepath.substr(0, filepath.size() - EXTENSION_LENGTH);
-            setProgram(programName, program);
+            if (lazy) {
+                m_programRegistry.erase(name);
+                m_lazyPrograms.insert_or_assign(name, LazyLibraryEntry {archive, i});
+                continue;
+            }
+
+            setProgram(name, createLibraryProgram(m_device, *archive, stat, m_descriptor.isLibrarySpirVCopyEnabled()));
         }
     }
 }
 
+bool Session::loadLazyNodeBuilder(const std::string& builderName) const
+{
+
+    auto iter = m_lazyNodeBuilders.find(builderName);
+    if (iter == m_lazyNodeBuilders.end()) {
+        return false;
+    }
+
+    // erase the entry before running the script, so that the script itself
+    // can query ll.getNodeBuilder without recursing into this method.
+    const auto entry = iter->second;
+    m_lazyNodeBuilders.erase(iter);
+
+    // builders registered by scripts after the library was loaded take precedence
+    constexpr auto lua = R"(
+        local builderName = ...
+        return ll.nodeBuilders[builderName] ~= nil
+    )";
+
+    if (m_interpreter->loadAndRun<bool>(lua, builderName)) {
+        return false;
+    }
+
+    auto stat = entry.archive->getFileStat(entry.fileIndex);
+    m_interpreter->run(entry.archive->uncompressTextFile(stat));
+
+    return true;
+}
+
+void Session::loadLazyNodeBuilders() const
+{
+
+    while (!m_lazyNodeBuilders.empty()) {
+        loadLazyNodeBuilder(m_lazyNodeBuilders.cbegin()->first);
+    }
+}
+
+void Session::saveGraph(const std::shared_ptr<ll::Node>& node, const std::string& filename, const bool includePipelineCache)
+{
+
+    auto file = std::ofstream {filename, std::ios::binary | std::ios::trunc};
+    ll::throwSystemErrorIf(!file, ll::ErrorCode::IOError, "error opening file for writing: " + filename);
+
+    ll::impl::GraphSnapshot::save(m_device, *this, m_programRegistry, node, file, includePipelineCache);
+}
+
+std::shared_ptr<ll::Node> Session::loadGraph(const std::string& filename)
+{
+
+    auto file = std::ifstream {filename, std::ios::binary};
+    ll::throwSystemErrorIf(!file, ll::ErrorCode::IOError, "error opening file: " + filename);
+
+    return ll::impl::GraphSnapshot::load(m_device, *this, m_interpreter, file);
+}
+
 ll::vec3ui Session::getGoodComputeLocalShape(ll::ComputeDimension dimensions) const noexcept
 {
     return m_device->getComputeLocalShape(dimensions);
@@ -416,6 +721,10 @@ ll::vec3ui Session::getGoodComputeLocalShape(ll::ComputeDimension dimensions) co
 std::string Session::help(const std::string& builderName) const
 {
 
+    if (const auto builder = getNodeBuilder(builderName)) {
+        return builder->getDoc();
+    }
+
     constexpr auto lua = R"(
         local builderName = ...
         local builder = ll.getNodeBuilder(builderName)
@@ -483,15 +792,42 @@ void Session::initDevice()
     auto desiredFeatures = vk::PhysicalDeviceFeatures {}
                                .setShaderStorageImageExtendedFormats(supportedFeatures.shaderStorageImageExtendedFormats);
 
+    // optional extensions, enabled only if the device supports them
+    const auto optionalExtensions = std::vector<std::string> {
+        VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+        VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
+        VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME};
+
+    const auto availableExtensions = physicalDevice.enumerateDeviceExtensionProperties();
+
+    auto enabledExtensions = std::vector<std::string> {};
+    for (const auto& name : optionalExtensions) {
+
+        const auto it = std::find_if(availableExtensions.cbegin(), availableExtensions.cend(), [&name](const auto& props) {
+            return name == static_cast<const char*>(props.extensionName);
+        });
+
+        if (it != availableExtensions.cend()) {
+            enabledExtensions.push_back(name);
+        }
+    }
+
+    auto enabledExtensionNames = std::vector<const char*> {};
+    for (const auto& name : enabledExtensions) {
+        enabledExtensionNames.push_back(name.c_str());
+    }
+
     auto devCreateInfo = vk::DeviceCreateInfo()
                              .setQueueCreateInfoCount(1)
                              .setPQueueCreateInfos(&devQueueCreateInfo)
+                             .setEnabledExtensionCount(static_cast<uint32_t>(enabledExtensionNames.size()))
+                             .setPpEnabledExtensionNames(enabledExtensionNames.data())
                              .setPEnabledFeatures(&desiredFeatures);
 
     auto device = physicalDevice.createDevice(devCreateInfo);
     VULKAN_HPP_DEFAULT_DISPATCHER.init(device);
 
-    m_device = std::make_shared<ll::vulkan::Device>(device, physicalDevice, computeQueueFamilyIndex, m_instance);
+    m_device = std::make_shared<ll::vulkan::Device>(device, physicalDevice, computeQueueFamilyIndex, m_instance, enabledExtensions);
 }
 
 uint32_t Session::findComputeFamilyQueueIndex(vk::PhysicalDevice& physicalDevice)
@@ -32,4 +32,15 @@ const std::optional<ll::DeviceDescriptor>& SessionDescriptor::getDeviceDescripto
     return m_deviceDescriptor;
 }
 
+SessionDescriptor& SessionDescriptor::enableLibrarySpirVCopy(const bool enable) noexcept
+{
+    m_enableLibrarySpirVCopy = enable;
+    return *this;
+}
+
+bool SessionDescriptor::isLibrarySpirVCopyEnabled() const noexcept
+{
+    return m_enableLibrarySpirVCopy;
+}
+
 } // namespace ll
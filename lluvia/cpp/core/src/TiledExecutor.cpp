@@ -0,0 +1,415 @@
+/**
+@file       TiledExecutor.cpp
+@brief      TiledExecutor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/TiledExecutor.h"
+
+#include "lluvia/core/CommandBuffer.h"
+#include "lluvia/core/Object.h"
+#include "lluvia/core/Session.h"
+#include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/error.h"
+#include "lluvia/core/image/Image.h"
+#include "lluvia/core/image/ImageView.h"
+#include "lluvia/core/memory/Memory.h"
+#include "lluvia/core/node/ComputeNode.h"
+#include "lluvia/core/node/ContainerNode.h"
+#include "lluvia/core/node/Node.h"
+#include "lluvia/core/vulkan/Device.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ll {
+
+namespace impl {
+
+    // splits an axis of the given size into core intervals and their input windows
+    void splitAxis(const uint32_t size, const uint32_t tile, const uint32_t halo,
+        std::vector<uint32_t>& windowOffsets, std::vector<uint32_t>& coreOffsets, std::vector<uint32_t>& coreSizes)
+    {
+
+        if (tile == size) {
+            windowOffsets.push_back(0);
+            coreOffsets.push_back(0);
+            coreSizes.push_back(size);
+            return;
+        }
+
+        ll::throwSystemErrorIf(tile <= 2 * halo, ll::ErrorCode::InvalidArgument,
+            "tile size (" + std::to_string(tile) + ") must be greater than twice the halo radius (" + std::to_string(halo) + ")");
+
+        const auto step = tile - 2 * halo;
+
+        for (auto coreOffset = uint32_t {0}; coreOffset < size; coreOffset += step) {
+
+            const auto coreSize = std::min(step, size - coreOffset);
+
+            // shift the window inwards at the image borders, so every window has the same size
+            const auto windowOffset = coreOffset < halo ? uint32_t {0} : std::min(coreOffset - halo, size - tile);
+
+            windowOffsets.push_back(windowOffset);
+            coreOffsets.push_back(coreOffset);
+            coreSizes.push_back(coreSize);
+        }
+    }
+
+} // namespace impl
+
+TiledExecutor::TiledExecutor(const std::shared_ptr<ll::Session>& session,
+    const std::shared_ptr<ll::vulkan::Device>&                   device,
+    const ll::TiledExecutorDescriptor&                           descriptor)
+    : m_descriptor {descriptor}
+    , m_session {session}
+    , m_device {device}
+{
+
+    const auto& imgDesc = m_descriptor.getImageDescriptor();
+
+    ll::throwSystemErrorIf(imgDesc.getWidth() == 0 || imgDesc.getHeight() == 0, ll::ErrorCode::InvalidArgument, "image width and height must be greater than zero");
+    ll::throwSystemErrorIf(imgDesc.getDepth() != 1, ll::ErrorCode::InvalidArgument, "image depth must be 1, got: " + std::to_string(imgDesc.getDepth()));
+    ll::throwSystemErrorIf(m_descriptor.getInFlightCount() == 0, ll::ErrorCode::InvalidArgument, "in flight count must be greater than zero");
+    ll::throwSystemErrorIf(!m_descriptor.getNodeFactory() && m_descriptor.getBuilderName().empty(), ll::ErrorCode::InvalidArgument,
+        "either a node builder name or a node factory must be set");
+
+    m_slots.resize(m_descriptor.getInFlightCount());
+    for (auto& slot : m_slots) {
+        slot.node = createNode();
+    }
+
+    // the stencil radius of compute nodes, and of containers declaring it, is known before initialization
+    m_haloRadius = std::max(m_descriptor.getHaloRadius(), m_slots[0].node->getStencilRadius());
+    m_tileShape  = computeTileShape(m_haloRadius);
+    m_tiles      = computeTiles(imgDesc.getShape(), m_tileShape, m_haloRadius);
+
+    for (auto& slot : m_slots) {
+        initSlot(slot);
+    }
+
+    // containers computing their radius from the contained nodes only know it after initialization
+    const auto initRadius = m_slots[0].node->getStencilRadius();
+    ll::throwSystemErrorIf(initRadius > m_haloRadius, ll::ErrorCode::InvalidArgument,
+        "node stencil radius after initialization (" + std::to_string(initRadius) + ") is greater than the halo radius ("
+            + std::to_string(m_haloRadius) + "). Declare the radius in the node descriptor or in ll::TiledExecutorDescriptor::setHaloRadius");
+
+    const auto& outputImage = *m_slots[0].outputImage;
+    m_outputImageDescriptor = ll::ImageDescriptor {1, imgDesc.getHeight(), imgDesc.getWidth(),
+        outputImage.getChannelCount(), outputImage.getChannelType()};
+}
+
+TiledExecutor::~TiledExecutor()
+{
+
+    for (auto& slot : m_slots) {
+        if (slot.fence) {
+            if (slot.busy) {
+                static_cast<void>(m_device->get().waitForFences(1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+            }
+
+            m_device->get().destroyFence(slot.fence);
+        }
+    }
+}
+
+const ll::TiledExecutorDescriptor& TiledExecutor::getDescriptor() const noexcept
+{
+    return m_descriptor;
+}
+
+ll::vec3ui TiledExecutor::getTileShape() const noexcept
+{
+    return m_tileShape;
+}
+
+uint32_t TiledExecutor::getHaloRadius() const noexcept
+{
+    return m_haloRadius;
+}
+
+const std::vector<TiledExecutor::Tile>& TiledExecutor::getTiles() const noexcept
+{
+    return m_tiles;
+}
+
+const ll::ImageDescriptor& TiledExecutor::getOutputImageDescriptor() const noexcept
+{
+    return m_outputImageDescriptor;
+}
+
+uint64_t TiledExecutor::getInputSize() const noexcept
+{
+    return m_descriptor.getImageDescriptor().getSize();
+}
+
+uint64_t TiledExecutor::getOutputSize() const noexcept
+{
+    return m_outputImageDescriptor.getSize();
+}
+
+void TiledExecutor::run(const void* input, void* output)
+{
+
+    ll::throwSystemErrorIf(input == nullptr || output == nullptr, ll::ErrorCode::InvalidArgument, "input and output pointers must not be null");
+
+    const auto inputPtr  = static_cast<const uint8_t*>(input);
+    auto       outputPtr = static_cast<uint8_t*>(output);
+
+    try {
+
+        for (auto t = size_t {0}; t < m_tiles.size(); ++t) {
+
+            auto& slot = m_slots[t % m_slots.size()];
+
+            // the host stitches this slot's previous tile while the device processes the others
+            if (slot.busy) {
+                waitAndStitch(slot, outputPtr);
+            }
+
+            slot.tileIndex = t;
+            upload(slot, inputPtr);
+
+            m_device->get().resetFences(slot.fence);
+            m_device->submit(*slot.commandBuffer, slot.fence);
+            slot.busy = true;
+        }
+
+        // slots are submitted in round robin order, drain them in the same order
+        for (auto t = m_tiles.size() < m_slots.size() ? size_t {0} : m_tiles.size() - m_slots.size(); t < m_tiles.size(); ++t) {
+            waitAndStitch(m_slots[t % m_slots.size()], outputPtr);
+        }
+
+    } catch (...) {
+
+        // do not leave work in flight writing to the caller's memory
+        for (auto& slot : m_slots) {
+            if (slot.busy) {
+                static_cast<void>(m_device->get().waitForFences(1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+                slot.busy = false;
+            }
+        }
+
+        throw;
+    }
+}
+
+std::vector<TiledExecutor::Tile> TiledExecutor::computeTiles(const ll::vec3ui& imageShape, const ll::vec3ui& tileShape, const uint32_t halo)
+{
+
+    ll::throwSystemErrorIf(tileShape.x == 0 || tileShape.y == 0 || tileShape.x > imageShape.x || tileShape.y > imageShape.y,
+        ll::ErrorCode::InvalidArgument,
+        "tile shape (" + std::to_string(tileShape.x) + ", " + std::to_string(tileShape.y) + ") must be non-zero and less or equal than the image shape ("
+            + std::to_string(imageShape.x) + ", " + std::to_string(imageShape.y) + ")");
+
+    auto windowX = std::vector<uint32_t> {};
+    auto coreX   = std::vector<uint32_t> {};
+    auto sizeX   = std::vector<uint32_t> {};
+    impl::splitAxis(imageShape.x, tileShape.x, halo, windowX, coreX, sizeX);
+
+    auto windowY = std::vector<uint32_t> {};
+    auto coreY   = std::vector<uint32_t> {};
+    auto sizeY   = std::vector<uint32_t> {};
+    impl::splitAxis(imageShape.y, tileShape.y, halo, windowY, coreY, sizeY);
+
+    auto tiles = std::vector<Tile> {};
+    tiles.reserve(windowX.size() * windowY.size());
+
+    for (auto j = size_t {0}; j < windowY.size(); ++j) {
+        for (auto i = size_t {0}; i < windowX.size(); ++i) {
+
+            auto tile        = Tile {};
+            tile.inputOffset = {windowX[i], windowY[j], 0};
+            tile.coreOffset  = {coreX[i], coreY[j], 0};
+            tile.coreShape   = {sizeX[i], sizeY[j], 1};
+
+            tiles.push_back(tile);
+        }
+    }
+
+    return tiles;
+}
+
+std::shared_ptr<ll::Node> TiledExecutor::createNode() const
+{
+
+    auto node = std::shared_ptr<ll::Node> {};
+
+    if (m_descriptor.getNodeFactory()) {
+        node = m_descriptor.getNodeFactory()();
+
+    } else {
+
+        const auto& builderName = m_descriptor.getBuilderName();
+        const auto  builders    = m_session->getNodeBuilderDescriptors();
+
+        const auto it = std::find_if(builders.cbegin(), builders.cend(), [&builderName](const auto& builder) {
+            return builder.name == builderName;
+        });
+
+        ll::throwSystemErrorIf(it == builders.cend(), ll::ErrorCode::KeyNotFound, "node builder [" + builderName + "] not found");
+
+        if (it->nodeType == ll::NodeType::Container) {
+            node = m_session->createContainerNode(builderName);
+        } else {
+            node = m_session->createComputeNode(builderName);
+        }
+    }
+
+    ll::throwSystemErrorIf(node == nullptr, ll::ErrorCode::InvalidArgument, "node factory returned a null node");
+    ll::throwSystemErrorIf(node->getState() != ll::NodeState::Created, ll::ErrorCode::InvalidNodeState, "nodes used by the tiled executor must not be initialized");
+
+    for (const auto& kv : m_descriptor.getParameters()) {
+        node->setParameter(kv.first, kv.second);
+    }
+
+    return node;
+}
+
+ll::vec3ui TiledExecutor::computeTileShape(const uint32_t halo) const
+{
+
+    const auto& imgDesc = m_descriptor.getImageDescriptor();
+    const auto  maxSize = m_device->getPhysicalDeviceLimits().maxImageDimension2D;
+
+    auto tileShape = m_descriptor.getTileShape();
+
+    if (tileShape.x == 0 || tileShape.y == 0) {
+
+        auto side = uint64_t {maxSize};
+
+        if (m_descriptor.getMemoryBudget() != 0) {
+
+            // input and output images plus their staging buffers, assuming same size pixels
+            const auto pixelSize      = imgDesc.getChannelCount<uint64_t>() * ll::getChannelTypeSize(imgDesc.getChannelType());
+            const auto bytesPerPixel  = 4 * pixelSize;
+            const auto budgetPerSlot  = m_descriptor.getMemoryBudget() / m_descriptor.getInFlightCount();
+            const auto budgetSideSize = static_cast<uint64_t>(std::sqrt(static_cast<double>(budgetPerSlot / bytesPerPixel)));
+
+            ll::throwSystemErrorIf(budgetSideSize <= 2 * halo, ll::ErrorCode::InvalidArgument,
+                "memory budget of " + std::to_string(m_descriptor.getMemoryBudget()) + " bytes is too small for the halo radius " + std::to_string(halo));
+
+            side = std::min(side, budgetSideSize);
+        }
+
+        tileShape.x = tileShape.x == 0 ? static_cast<uint32_t>(side) : tileShape.x;
+        tileShape.y = tileShape.y == 0 ? static_cast<uint32_t>(side) : tileShape.y;
+    }
+
+    ll::throwSystemErrorIf(tileShape.x > maxSize || tileShape.y > maxSize, ll::ErrorCode::InvalidArgument,
+        "tile shape (" + std::to_string(tileShape.x) + ", " + std::to_string(tileShape.y) + ") exceeds the device maxImageDimension2D limit: " + std::to_string(maxSize));
+
+    return ll::vec3ui {std::min(tileShape.x, imgDesc.getWidth()), std::min(tileShape.y, imgDesc.getHeight()), 1};
+}
+
+void TiledExecutor::initSlot(Slot& slot)
+{
+
+    const auto& imgDesc = m_descriptor.getImageDescriptor();
+
+    const auto usageFlags = ll::ImageUsageFlags {ll::ImageUsageFlagBits::Storage
+                                                 | ll::ImageUsageFlagBits::Sampled
+                                                 | ll::ImageUsageFlagBits::TransferSrc
+                                                 | ll::ImageUsageFlagBits::TransferDst};
+
+    const auto tileDesc = ll::ImageDescriptor {1, m_tileShape.y, m_tileShape.x,
+        imgDesc.getChannelCount(), imgDesc.getChannelType()}
+                              .setUsageFlags(usageFlags);
+
+    slot.inputImage     = m_session->getDeviceMemory()->createImage(tileDesc);
+    slot.inputImageView = slot.inputImage->createImageView(m_descriptor.getInputImageViewDescriptor());
+
+    // the descriptor set of the node is written with the layout the image has at binding time
+    slot.inputImage->changeImageLayout(ll::ImageLayout::General);
+
+    slot.node->bind(m_descriptor.getInputPort(), slot.inputImageView);
+    slot.node->init();
+
+    const auto outputObj = slot.node->getPort(m_descriptor.getOutputPort());
+
+    switch (outputObj->getType()) {
+    case ll::ObjectType::Image:
+        slot.outputImage = std::static_pointer_cast<ll::Image>(outputObj);
+        break;
+    case ll::ObjectType::ImageView:
+        slot.outputImage = std::static_pointer_cast<ll::ImageView>(outputObj)->getImage();
+        break;
+    default:
+        ll::throwSystemError(ll::ErrorCode::PortBindingError, "output port [" + m_descriptor.getOutputPort() + "] must hold an Image or ImageView object");
+    }
+
+    ll::throwSystemErrorIf(slot.outputImage->getWidth() != m_tileShape.x || slot.outputImage->getHeight() != m_tileShape.y,
+        ll::ErrorCode::InvalidArgument,
+        "output image shape (" + std::to_string(slot.outputImage->getWidth()) + ", " + std::to_string(slot.outputImage->getHeight())
+            + ") must match the tile shape (" + std::to_string(m_tileShape.x) + ", " + std::to_string(m_tileShape.y) + ")");
+
+    // staging buffers in memories optimized for each transfer direction
+    slot.uploadBuffer   = m_session->getUploadMemory()->createBuffer(tileDesc.getSize());
+    slot.downloadBuffer = m_session->getReadbackMemory()->createBuffer(slot.outputImage->getDescriptor().getSize());
+
+    // both images start in General layout, so the recorded layout transitions are valid on every submission
+    if (slot.outputImage->getLayout() != ll::ImageLayout::General) {
+        slot.outputImage->changeImageLayout(ll::ImageLayout::General);
+    }
+
+    // upload, compute and download are recorded once, only the staging buffers change between tiles
+    slot.commandBuffer = m_device->createCommandBuffer();
+    slot.commandBuffer->begin();
+    slot.commandBuffer->changeImageLayout(*slot.inputImage, ll::ImageLayout::TransferDstOptimal);
+    slot.commandBuffer->copyBufferToImage(*slot.uploadBuffer, *slot.inputImage);
+    slot.commandBuffer->changeImageLayout(*slot.inputImage, ll::ImageLayout::General);
+    slot.node->record(*slot.commandBuffer);
+    slot.commandBuffer->memoryBarrier();
+    slot.commandBuffer->changeImageLayout(*slot.outputImage, ll::ImageLayout::TransferSrcOptimal);
+    slot.commandBuffer->copyImageToBuffer(*slot.outputImage, *slot.downloadBuffer);
+    slot.commandBuffer->changeImageLayout(*slot.outputImage, ll::ImageLayout::General);
+    slot.commandBuffer->end();
+
+    slot.fence = m_device->get().createFence(vk::FenceCreateInfo {});
+}
+
+void TiledExecutor::upload(Slot& slot, const uint8_t* input) const
+{
+
+    const auto& imgDesc   = m_descriptor.getImageDescriptor();
+    const auto& tile      = m_tiles[slot.tileIndex];
+    const auto  pixelSize = imgDesc.getChannelCount<uint64_t>() * ll::getChannelTypeSize(imgDesc.getChannelType());
+    const auto  rowSize   = m_tileShape.x * pixelSize;
+
+    auto staging = slot.uploadBuffer->map<uint8_t[]>();
+
+    for (auto row = uint64_t {0}; row < m_tileShape.y; ++row) {
+        const auto srcOffset = ((tile.inputOffset.y + row) * imgDesc.getWidth() + tile.inputOffset.x) * pixelSize;
+        std::memcpy(staging.get() + row * rowSize, input + srcOffset, rowSize);
+    }
+}
+
+void TiledExecutor::waitAndStitch(Slot& slot, uint8_t* output)
+{
+
+    const auto result = m_device->get().waitForFences(1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    slot.busy         = false;
+
+    ll::throwSystemErrorIf(result != vk::Result::eSuccess, ll::ErrorCode::VulkanError, "error waiting for tile execution to finish");
+
+    const auto& tile      = m_tiles[slot.tileIndex];
+    const auto  width     = uint64_t {m_descriptor.getImageDescriptor().getWidth()};
+    const auto  pixelSize = m_outputImageDescriptor.getChannelCount<uint64_t>() * ll::getChannelTypeSize(m_outputImageDescriptor.getChannelType());
+
+    // position of the tile core within the device tile
+    const auto localX = uint64_t {tile.coreOffset.x - tile.inputOffset.x};
+    const auto localY = uint64_t {tile.coreOffset.y - tile.inputOffset.y};
+
+    auto staging = slot.downloadBuffer->map<uint8_t[]>();
+
+    for (auto row = uint64_t {0}; row < tile.coreShape.y; ++row) {
+        const auto srcOffset = ((localY + row) * m_tileShape.x + localX) * pixelSize;
+        const auto dstOffset = ((tile.coreOffset.y + row) * width + tile.coreOffset.x) * pixelSize;
+        std::memcpy(output + dstOffset, staging.get() + srcOffset, tile.coreShape.x * pixelSize);
+    }
+}
+
+} // namespace ll
@@ -0,0 +1,133 @@
+/**
+@file       TiledExecutorDescriptor.cpp
+@brief      TiledExecutorDescriptor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/TiledExecutorDescriptor.h"
+
+namespace ll {
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setBuilderName(const std::string& name) noexcept
+{
+    m_builderName = name;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setNodeFactory(const NodeFactory& factory) noexcept
+{
+    m_nodeFactory = factory;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setInputPort(const std::string& name) noexcept
+{
+    m_inputPort = name;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setOutputPort(const std::string& name) noexcept
+{
+    m_outputPort = name;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setImageDescriptor(const ll::ImageDescriptor& descriptor) noexcept
+{
+    m_imageDescriptor = descriptor;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setInputImageViewDescriptor(const ll::ImageViewDescriptor& descriptor) noexcept
+{
+    m_inputImageViewDescriptor = descriptor;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setTileShape(const ll::vec3ui& shape) noexcept
+{
+    m_tileShape = shape;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setMemoryBudget(const uint64_t budget) noexcept
+{
+    m_memoryBudget = budget;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setHaloRadius(const uint32_t radius) noexcept
+{
+    m_haloRadius = radius;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setInFlightCount(const uint32_t count) noexcept
+{
+    m_inFlightCount = count;
+    return *this;
+}
+
+TiledExecutorDescriptor& TiledExecutorDescriptor::setParameter(const std::string& name, const ll::Parameter& value)
+{
+    m_parameters[name] = value;
+    return *this;
+}
+
+const std::string& TiledExecutorDescriptor::getBuilderName() const noexcept
+{
+    return m_builderName;
+}
+
+const TiledExecutorDescriptor::NodeFactory& TiledExecutorDescriptor::getNodeFactory() const noexcept
+{
+    return m_nodeFactory;
+}
+
+const std::string& TiledExecutorDescriptor::getInputPort() const noexcept
+{
+    return m_inputPort;
+}
+
+const std::string& TiledExecutorDescriptor::getOutputPort() const noexcept
+{
+    return m_outputPort;
+}
+
+const ll::ImageDescriptor& TiledExecutorDescriptor::getImageDescriptor() const noexcept
+{
+    return m_imageDescriptor;
+}
+
+const ll::ImageViewDescriptor& TiledExecutorDescriptor::getInputImageViewDescriptor() const noexcept
+{
+    return m_inputImageViewDescriptor;
+}
+
+ll::vec3ui TiledExecutorDescriptor::getTileShape() const noexcept
+{
+    return m_tileShape;
+}
+
+uint64_t TiledExecutorDescriptor::getMemoryBudget() const noexcept
+{
+    return m_memoryBudget;
+}
+
+uint32_t TiledExecutorDescriptor::getHaloRadius() const noexcept
+{
+    return m_haloRadius;
+}
+
+uint32_t TiledExecutorDescriptor::getInFlightCount() const noexcept
+{
+    return m_inFlightCount;
+}
+
+const std::map<std::string, ll::Parameter>& TiledExecutorDescriptor::getParameters() const noexcept
+{
+    return m_parameters;
+}
+
+} // namespace ll
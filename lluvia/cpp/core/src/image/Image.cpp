@@ -15,6 +15,8 @@
 
 #include "lluvia/core/vulkan/Device.h"
 
+#include <algorithm>
+
 namespace ll {
 
 Image::Image(
@@ -38,6 +40,10 @@ Image::Image(
 Image::~Image()
 {
 
+    if (m_vkImageView) {
+        m_device->get().destroyImageView(m_vkImageView);
+    }
+
     m_memory->releaseImage(*this);
 }
 
@@ -56,6 +62,11 @@ const std::shared_ptr<ll::Memory>& Image::getMemory() const noexcept
     return m_memory;
 }
 
+bool Image::isAliased() const noexcept
+{
+    return m_aliasedBlock != nullptr;
+}
+
 uint64_t Image::getSize() const noexcept
 {
     return m_allocInfo.size;
@@ -123,7 +134,74 @@ ll::vec3ui Image::getShape() const noexcept
 
 std::shared_ptr<ll::ImageView> Image::createImageView(const ll::ImageViewDescriptor& tDescriptor)
 {
-    return std::shared_ptr<ll::ImageView> {new ll::ImageView {m_device, shared_from_this(), tDescriptor}};
+
+    auto imageView = std::shared_ptr<ll::ImageView> {new ll::ImageView {m_device, shared_from_this(), tDescriptor}};
+
+    // drop views already deleted before tracking the new one
+    m_imageViews.erase(std::remove_if(m_imageViews.begin(), m_imageViews.end(), [](const auto& view) { return view.expired(); }),
+        m_imageViews.end());
+
+    m_imageViews.push_back(imageView);
+    return imageView;
+}
+
+void Image::recreateImageViews()
+{
+
+    if (!m_vkImageView) {
+        return;
+    }
+
+    m_device->get().destroyImageView(m_vkImageView);
+    createVkImageView();
+
+    for (const auto& view : m_imageViews) {
+        if (auto imageView = view.lock()) {
+            imageView->m_vkImageView = m_vkImageView;
+        }
+    }
+}
+
+vk::ImageView Image::getVkImageView()
+{
+
+    if (!m_vkImageView) {
+        createVkImageView();
+    }
+
+    return m_vkImageView;
+}
+
+void Image::createVkImageView()
+{
+
+    auto imageViewType = vk::ImageViewType::e2D;
+
+    switch (m_descriptor.getImageType()) {
+    case vk::ImageType::e1D:
+        imageViewType = vk::ImageViewType::e1D;
+        break;
+    case vk::ImageType::e2D:
+        imageViewType = vk::ImageViewType::e2D;
+        break;
+    case vk::ImageType::e3D:
+        imageViewType = vk::ImageViewType::e3D;
+        break;
+    }
+
+    auto imageViewInfo = vk::ImageViewCreateInfo {}
+                             .setViewType(imageViewType)
+                             .setFormat(m_descriptor.getFormat())
+                             .setImage(m_vkImage);
+
+    // TODO
+    imageViewInfo.subresourceRange.setAspectMask(vk::ImageAspectFlagBits::eColor);
+    imageViewInfo.subresourceRange.setBaseMipLevel(0);
+    imageViewInfo.subresourceRange.setLevelCount(1);
+    imageViewInfo.subresourceRange.setBaseArrayLayer(0);
+    imageViewInfo.subresourceRange.setLayerCount(1);
+
+    m_vkImageView = m_device->get().createImageView(imageViewInfo);
 }
 
 void Image::changeImageLayout(const ll::ImageLayout newLayout)
@@ -137,6 +215,11 @@ void Image::changeImageLayout(const ll::ImageLayout newLayout)
     m_device->run(*cmdBuffer);
 }
 
+void Image::reshape(const ll::vec3ui& shape)
+{
+    m_memory->reshapeImage(*this, shape);
+}
+
 void Image::clear()
 {
 
@@ -151,8 +234,13 @@ void Image::clear()
 void Image::copyTo(ll::Image& dst)
 {
 
-    const auto srcCurrentLayout = getLayout();
-    const auto dstCurrentLayout = dst.getLayout();
+    // images cannot transition back to Undefined or Preinitialized layouts
+    const auto restoredLayout = [](const ll::ImageLayout layout) {
+        return layout == ll::ImageLayout::Undefined || layout == ll::ImageLayout::Preinitialized ? ll::ImageLayout::General : layout;
+    };
+
+    const auto srcCurrentLayout = restoredLayout(getLayout());
+    const auto dstCurrentLayout = restoredLayout(dst.getLayout());
 
     auto cmdBuffer = m_device->createCommandBuffer();
 
@@ -167,4 +255,50 @@ void Image::copyTo(ll::Image& dst)
     m_device->run(*cmdBuffer);
 }
 
+bool Image::isMappable() const noexcept
+{
+    return getTiling() == ll::ImageTiling::Linear && m_memory->isPageMappable(m_allocInfo.page);
+}
+
+uint64_t Image::getRowPitch() const
+{
+    return getSubresourceLayout().rowPitch;
+}
+
+uint64_t Image::getDepthPitch() const
+{
+    return getSubresourceLayout().depthPitch;
+}
+
+vk::SubresourceLayout Image::getSubresourceLayout() const
+{
+
+    ll::throwSystemErrorIf(getTiling() != ll::ImageTiling::Linear, ll::ErrorCode::InvalidArgument,
+        "the memory layout of an image is only defined for linear tiling.");
+
+    const auto subresource = vk::ImageSubresource {vk::ImageAspectFlagBits::eColor, 0, 0};
+    return m_device->get().getImageSubresourceLayout(m_vkImage, subresource);
+}
+
+uint8_t* Image::mapMemory()
+{
+
+    ll::throwSystemErrorIf(getTiling() != ll::ImageTiling::Linear, ll::ErrorCode::MemoryMapFailed,
+        "only images with linear tiling can be mapped.");
+
+    ll::throwSystemErrorIf(m_layout != ll::ImageLayout::General && m_layout != ll::ImageLayout::Preinitialized, ll::ErrorCode::MemoryMapFailed,
+        "image must be in General or Preinitialized layout to be mapped, got: " + ll::imageLayoutToString(ll::ImageLayout {m_layout}));
+
+    ll::throwSystemErrorIf(!m_memory->isPageMappable(m_allocInfo.page), ll::ErrorCode::MemoryMapFailed,
+        "memory page " + std::to_string(m_allocInfo.page) + " is currently mapped by another object or this memory cannot be mapped");
+
+    const auto layout = getSubresourceLayout();
+    return static_cast<uint8_t*>(m_memory->mapImage(*this)) + layout.offset;
+}
+
+void Image::unmap()
+{
+    m_memory->unmapImage(*this);
+}
+
 } // namespace ll
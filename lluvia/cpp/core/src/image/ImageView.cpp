@@ -23,46 +23,20 @@ ImageView::ImageView(const std::shared_ptr<ll::vulkan::Device>& device,
     , m_image {image}
 {
 
-    auto imageViewType = vk::ImageViewType::e2D;
-
-    switch (m_image->getDescriptor().getImageType()) {
-    case vk::ImageType::e1D:
-        imageViewType = vk::ImageViewType::e1D;
-        break;
-    case vk::ImageType::e2D:
-        imageViewType = vk::ImageViewType::e2D;
-        break;
-    case vk::ImageType::e3D:
-        imageViewType = vk::ImageViewType::e3D;
-        break;
-    }
-
-    auto imageViewInfo = vk::ImageViewCreateInfo {}
-                             .setViewType(imageViewType)
-                             .setFormat(m_image->getDescriptor().getFormat())
-                             .setImage(m_image->m_vkImage);
-
-    // TODO
-    imageViewInfo.subresourceRange.setAspectMask(vk::ImageAspectFlagBits::eColor);
-    imageViewInfo.subresourceRange.setBaseMipLevel(0);
-    imageViewInfo.subresourceRange.setLevelCount(1);
-    imageViewInfo.subresourceRange.setBaseArrayLayer(0);
-    imageViewInfo.subresourceRange.setLayerCount(1);
-
-    m_vkImageView = m_device->get().createImageView(imageViewInfo);
+    // the Vulkan image view is owned by the image and shared with its other views
+    m_vkImageView = m_image->getVkImageView();
 
+    // samplers are shared among all the views with the same sampler state
     if (m_descriptor.isSampled()) {
-        m_vkSampler = m_device->get().createSampler(m_descriptor.getVkSamplerCreateInfo());
+        m_vkSampler = m_device->acquireSampler(m_descriptor.getVkSamplerCreateInfo());
     }
 }
 
 ImageView::~ImageView()
 {
 
-    m_device->get().destroyImageView(m_vkImageView);
-
     if (m_descriptor.isSampled()) {
-        m_device->get().destroySampler(m_vkSampler);
+        m_device->releaseSampler(m_vkSampler);
     }
 }
 
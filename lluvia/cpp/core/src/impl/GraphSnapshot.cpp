@@ -0,0 +1,1209 @@
+/**
+@file       GraphSnapshot.cpp
+@brief      GraphSnapshot class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/impl/GraphSnapshot.h"
+
+#include "lluvia/core/CommandBuffer.h"
+#include "lluvia/core/Program.h"
+#include "lluvia/core/Session.h"
+#include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/buffer/BufferView.h"
+#include "lluvia/core/error.h"
+#include "lluvia/core/image/Image.h"
+#include "lluvia/core/image/ImageView.h"
+#include "lluvia/core/memory/Memory.h"
+#include "lluvia/core/node/ComputeNode.h"
+#include "lluvia/core/node/ContainerNode.h"
+#include "lluvia/core/node/NodeBuilder.h"
+
+#include "lluvia/core/vulkan/Device.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace ll {
+namespace impl {
+
+    namespace {
+
+        constexpr const std::array<char, 8> SNAPSHOT_MAGIC {'L', 'L', 'G', 'R', 'A', 'P', 'H', '\0'};
+        constexpr const uint32_t            SNAPSHOT_VERSION = 1;
+
+        // id of null objects
+        constexpr const uint32_t NO_ID = std::numeric_limits<uint32_t>::max();
+
+        enum class MemoryKind : uint32_t {
+            Host     = 0,
+            Device   = 1,
+            Readback = 2,
+            Upload   = 3,
+            Custom   = 4,
+        };
+
+        bool hasUsage(const ll::BufferUsageFlags flags, const ll::BufferUsageFlagBits bit) noexcept
+        {
+            return static_cast<ll::enum_t>(flags & bit) != 0;
+        }
+
+        bool hasUsage(const ll::ImageUsageFlags flags, const ll::ImageUsageFlagBits bit) noexcept
+        {
+            return static_cast<ll::enum_t>(flags & bit) != 0;
+        }
+
+        bool isImageContentStored(const ll::Image& image) noexcept
+        {
+
+            const auto usage  = image.getUsageFlags();
+            const auto layout = image.getLayout();
+
+            return hasUsage(usage, ll::ImageUsageFlagBits::TransferSrc)
+                && hasUsage(usage, ll::ImageUsageFlagBits::TransferDst)
+                && layout != ll::ImageLayout::Undefined
+                && layout != ll::ImageLayout::Preinitialized;
+        }
+
+        bool isBufferContentStored(const ll::Buffer& buffer) noexcept
+        {
+
+            const auto usage = buffer.getUsageFlags();
+
+            return buffer.isMappable()
+                || (hasUsage(usage, ll::BufferUsageFlagBits::TransferSrc) && hasUsage(usage, ll::BufferUsageFlagBits::TransferDst));
+        }
+
+        /**
+        Compute nodes of a snapshot are already configured, initialization runs no user code.
+        */
+        class SnapshotComputeNodeBuilder : public ll::ComputeNodeBuilder {
+
+        public:
+            explicit SnapshotComputeNodeBuilder(const ll::ComputeNodeDescriptor& descriptor)
+                : m_descriptor {descriptor}
+            {
+            }
+
+            ll::ComputeNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+            {
+                return m_descriptor;
+            }
+
+        private:
+            ll::ComputeNodeDescriptor m_descriptor;
+        };
+
+        /**
+        Container nodes of a snapshot replay the commands recorded when the snapshot was saved.
+        */
+        class SnapshotContainerNodeBuilder : public ll::ContainerNodeBuilder {
+
+        public:
+            struct Command {
+                ll::impl::CommandTraceStepType   type {ll::impl::CommandTraceStepType::Run};
+                std::shared_ptr<ll::ComputeNode> node;
+                std::shared_ptr<ll::Image>       image;
+                ll::ImageLayout                  layout {ll::ImageLayout::Undefined};
+            };
+
+            SnapshotContainerNodeBuilder(const ll::ContainerNodeDescriptor& descriptor, std::vector<Command>&& commands)
+                : m_descriptor {descriptor}
+                , m_commands {std::move(commands)}
+            {
+            }
+
+            ll::ContainerNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+            {
+                return m_descriptor;
+            }
+
+            void onNodeRecord(const ll::ContainerNode& /*node*/, ll::CommandBuffer& commandBuffer) override
+            {
+
+                for (const auto& command : m_commands) {
+
+                    switch (command.type) {
+                    case ll::impl::CommandTraceStepType::Run:
+                        commandBuffer.run(*command.node);
+                        break;
+                    case ll::impl::CommandTraceStepType::MemoryBarrier:
+                        commandBuffer.memoryBarrier();
+                        break;
+                    case ll::impl::CommandTraceStepType::IndirectBarrier:
+                        commandBuffer.indirectBarrier();
+                        break;
+                    case ll::impl::CommandTraceStepType::ClearImage:
+                        commandBuffer.clearImage(*command.image);
+                        break;
+                    case ll::impl::CommandTraceStepType::ChangeImageLayout:
+                        commandBuffer.changeImageLayout(*command.image, command.layout);
+                        break;
+                    }
+                }
+            }
+
+        private:
+            ll::ContainerNodeDescriptor m_descriptor;
+            std::vector<Command>        m_commands;
+        };
+
+    } // namespace
+
+    class GraphSnapshot::Writer {
+
+    public:
+        explicit Writer(std::ostream& out)
+            : m_out {out}
+        {
+        }
+
+        template <typename T>
+        void write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            m_out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void write(const std::string& value)
+        {
+            write(uint64_t {value.size()});
+            m_out.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        void write(const std::vector<uint8_t>& value)
+        {
+            write(uint64_t {value.size()});
+            m_out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(value.size()));
+        }
+
+        void write(const ll::vec3ui& value)
+        {
+            write(value.x);
+            write(value.y);
+            write(value.z);
+        }
+
+    private:
+        std::ostream& m_out;
+    };
+
+    class GraphSnapshot::Reader {
+
+    public:
+        explicit Reader(std::istream& in)
+            : m_in {in}
+        {
+
+            const auto begin = m_in.tellg();
+            m_in.seekg(0, std::ios::end);
+            m_end = m_in.tellg();
+            m_in.seekg(begin);
+
+            check();
+        }
+
+        template <typename T>
+        T read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+            auto value = T {};
+            m_in.read(reinterpret_cast<char*>(&value), sizeof(T));
+            check();
+
+            return value;
+        }
+
+        std::string readString()
+        {
+
+            auto value = std::string(readSize(), '\0');
+            m_in.read(value.data(), static_cast<std::streamsize>(value.size()));
+            check();
+
+            return value;
+        }
+
+        std::vector<uint8_t> readBytes()
+        {
+
+            auto value = std::vector<uint8_t>(readSize());
+            m_in.read(reinterpret_cast<char*>(value.data()), static_cast<std::streamsize>(value.size()));
+            check();
+
+            return value;
+        }
+
+        ll::vec3ui readVec3()
+        {
+
+            const auto x = read<uint32_t>();
+            const auto y = read<uint32_t>();
+            const auto z = read<uint32_t>();
+
+            return ll::vec3ui {x, y, z};
+        }
+
+    private:
+        // sizes are checked against the stream length before allocating
+        uint64_t readSize()
+        {
+
+            const auto size      = read<uint64_t>();
+            const auto remaining = static_cast<uint64_t>(m_end - m_in.tellg());
+
+            ll::throwSystemErrorIf(size > remaining, ll::ErrorCode::IOError, "corrupted graph snapshot, size exceeds the file length.");
+            return size;
+        }
+
+        void check()
+        {
+            ll::throwSystemErrorIf(!m_in, ll::ErrorCode::IOError, "unexpected end of graph snapshot.");
+        }
+
+        std::istream&  m_in;
+        std::streampos m_end;
+    };
+
+    GraphSnapshot::GraphSnapshot(const std::shared_ptr<ll::vulkan::Device>& device, ll::Session& session)
+        : m_device {device}
+        , m_session {session}
+    {
+    }
+
+    void GraphSnapshot::save(const std::shared_ptr<ll::vulkan::Device>& device,
+        ll::Session&                                                      session,
+        const std::map<std::string, std::shared_ptr<ll::Program>>&        programs,
+        const std::shared_ptr<ll::Node>&                                  node,
+        std::ostream&                                                     out,
+        const bool                                                        includePipelineCache)
+    {
+
+        auto snapshot = GraphSnapshot {device, session};
+
+        const auto rootId = snapshot.collectNode(node);
+
+        for (const auto& n : snapshot.m_nodes) {
+            if (n->getType() == ll::NodeType::Compute) {
+                snapshot.collectProgram(std::static_pointer_cast<ll::ComputeNode>(n)->m_descriptor.getProgram(), programs);
+            }
+        }
+
+        auto writer = Writer {out};
+
+        writer.write(SNAPSHOT_MAGIC);
+        writer.write(SNAPSHOT_VERSION);
+
+        // pipelines are created when nodes are loaded, the cache goes first
+        writer.write(includePipelineCache ? device->getPipelineCacheData() : std::vector<uint8_t> {});
+
+        writer.write(static_cast<uint32_t>(snapshot.m_programs.size()));
+        for (const auto& [name, program] : snapshot.m_programs) {
+            writer.write(name);
+            writer.write(program->hasSpirV() ? program->getSpirV() : std::vector<uint8_t> {});
+        }
+
+        writer.write(static_cast<uint32_t>(snapshot.m_memories.size()));
+        for (const auto& memory : snapshot.m_memories) {
+
+            auto kind = MemoryKind::Custom;
+            if (memory == session.getHostMemory()) {
+                kind = MemoryKind::Host;
+            } else if (memory == session.getDeviceMemory()) {
+                kind = MemoryKind::Device;
+            } else if (memory == session.getReadbackMemory()) {
+                kind = MemoryKind::Readback;
+            } else if (memory == session.getUploadMemory()) {
+                kind = MemoryKind::Upload;
+            }
+
+            writer.write(kind);
+            writer.write(static_cast<ll::enum_t>(memory->getMemoryPropertyFlags()));
+            writer.write(memory->getPageSize());
+        }
+
+        writer.write(static_cast<uint32_t>(snapshot.m_objects.size()));
+        for (const auto& obj : snapshot.m_objects) {
+            snapshot.writeObject(writer, *obj);
+        }
+
+        writer.write(static_cast<uint32_t>(snapshot.m_nodes.size()));
+        for (const auto& n : snapshot.m_nodes) {
+
+            writer.write(n->getType());
+
+            switch (n->getType()) {
+            case ll::NodeType::Compute:
+                snapshot.writeComputeNode(writer, static_cast<const ll::ComputeNode&>(*n));
+                break;
+            case ll::NodeType::Container:
+                snapshot.writeContainerNode(writer, static_cast<const ll::ContainerNode&>(*n));
+                break;
+            }
+        }
+
+        writer.write(rootId);
+
+        ll::throwSystemErrorIf(!out, ll::ErrorCode::IOError, "error writing graph snapshot.");
+    }
+
+    std::shared_ptr<ll::Node> GraphSnapshot::load(const std::shared_ptr<ll::vulkan::Device>& device,
+        ll::Session&                                                                        session,
+        const std::weak_ptr<ll::Interpreter>&                                               interpreter,
+        std::istream&                                                                       in)
+    {
+
+        auto snapshot = GraphSnapshot {device, session};
+        auto reader   = Reader {in};
+
+        ll::throwSystemErrorIf(reader.read<std::array<char, 8>>() != SNAPSHOT_MAGIC, ll::ErrorCode::IOError, "input is not a graph snapshot.");
+
+        const auto version = reader.read<uint32_t>();
+        ll::throwSystemErrorIf(version != SNAPSHOT_VERSION, ll::ErrorCode::IOError, "unsupported graph snapshot version: " + std::to_string(version));
+
+        device->mergePipelineCacheData(reader.readBytes());
+
+        const auto programCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < programCount; ++i) {
+
+            auto name  = reader.readString();
+            auto spirv = reader.readBytes();
+
+            auto program = spirv.empty() ? session.getProgram(name) : session.createProgram(spirv);
+            ll::throwSystemErrorIf(program == nullptr, ll::ErrorCode::KeyNotFound, "program [" + name + "] of the graph snapshot not found in the session.");
+
+            snapshot.m_programs.emplace_back(std::move(name), std::move(program));
+        }
+
+        const auto memoryCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < memoryCount; ++i) {
+
+            const auto kind     = reader.read<MemoryKind>();
+            const auto flags    = ll::MemoryPropertyFlags {reader.read<ll::enum_t>()};
+            const auto pageSize = reader.read<uint64_t>();
+
+            switch (kind) {
+            case MemoryKind::Host:
+                snapshot.m_memories.push_back(session.getHostMemory());
+                break;
+            case MemoryKind::Device:
+                snapshot.m_memories.push_back(session.getDeviceMemory());
+                break;
+            case MemoryKind::Readback:
+                snapshot.m_memories.push_back(session.getReadbackMemory());
+                break;
+            case MemoryKind::Upload:
+                snapshot.m_memories.push_back(session.getUploadMemory());
+                break;
+            case MemoryKind::Custom:
+                snapshot.m_memories.push_back(session.createMemory(flags, pageSize));
+                break;
+            default:
+                ll::throwSystemError(ll::ErrorCode::IOError, "corrupted graph snapshot, unknown memory kind.");
+            }
+        }
+
+        const auto objectCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < objectCount; ++i) {
+            snapshot.m_objects.push_back(snapshot.readObject(reader));
+        }
+
+        const auto nodeCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < nodeCount; ++i) {
+
+            switch (reader.read<ll::NodeType>()) {
+            case ll::NodeType::Compute:
+                snapshot.m_nodes.push_back(snapshot.readComputeNode(reader, interpreter));
+                break;
+            case ll::NodeType::Container:
+                snapshot.m_nodes.push_back(snapshot.readContainerNode(reader, interpreter));
+                break;
+            default:
+                ll::throwSystemError(ll::ErrorCode::IOError, "corrupted graph snapshot, unknown node type.");
+            }
+        }
+
+        return snapshot.getNode(reader.read<uint32_t>());
+    }
+
+    uint32_t GraphSnapshot::collectNode(const std::shared_ptr<ll::Node>& node)
+    {
+
+        ll::throwSystemErrorIf(node == nullptr, ll::ErrorCode::InvalidArgument, "node cannot be null.");
+
+        const auto it = m_nodeIds.find(node.get());
+        if (it != m_nodeIds.cend()) {
+            return it->second;
+        }
+
+        ll::throwSystemErrorIf(node->getState() != ll::NodeState::Init, ll::ErrorCode::InvalidNodeState, "nodes must be initialized before saving the graph.");
+
+        switch (node->getType()) {
+        case ll::NodeType::Compute: {
+
+            const auto& computeNode = static_cast<const ll::ComputeNode&>(*node);
+
+            ll::throwSystemErrorIf(computeNode.m_descriptor.isParameterBlockEnabled(), ll::ErrorCode::InvalidArgument,
+                "compute nodes in parameter-block mode cannot be saved, node: " + computeNode.m_descriptor.getBuilderName());
+
+            for (const auto& obj : computeNode.m_objects) {
+                collectObject(obj);
+            }
+
+        } break;
+
+        case ll::NodeType::Container: {
+
+            const auto& containerNode = static_cast<const ll::ContainerNode&>(*node);
+
+            for (const auto& kv : containerNode.m_nodes) {
+                collectNode(kv.second);
+            }
+
+            for (const auto& kv : containerNode.m_objects) {
+                collectObject(kv.second);
+            }
+
+            traceContainer(containerNode);
+
+        } break;
+        }
+
+        const auto id = static_cast<uint32_t>(m_nodes.size());
+
+        m_nodeIds[node.get()] = id;
+        m_nodes.push_back(node);
+
+        return id;
+    }
+
+    void GraphSnapshot::collectObject(const std::shared_ptr<ll::Object>& obj)
+    {
+
+        if (obj == nullptr || m_objectIds.count(obj.get()) != 0) {
+            return;
+        }
+
+        switch (obj->getType()) {
+        case ll::ObjectType::Buffer:
+            collectMemory(std::static_pointer_cast<ll::Buffer>(obj)->getMemory());
+            break;
+        case ll::ObjectType::Image:
+            collectMemory(std::static_pointer_cast<ll::Image>(obj)->getMemory());
+            break;
+        case ll::ObjectType::ImageView:
+            collectObject(std::static_pointer_cast<ll::ImageView>(obj)->getImage());
+            break;
+        case ll::ObjectType::BufferView:
+            collectObject(std::static_pointer_cast<ll::BufferView>(obj)->getBuffer());
+            break;
+        }
+
+        m_objectIds[obj.get()] = static_cast<uint32_t>(m_objects.size());
+        m_objects.push_back(obj);
+    }
+
+    void GraphSnapshot::collectMemory(const std::shared_ptr<ll::Memory>& memory)
+    {
+
+        if (m_memoryIds.count(memory.get()) != 0) {
+            return;
+        }
+
+        m_memoryIds[memory.get()] = static_cast<uint32_t>(m_memories.size());
+        m_memories.push_back(memory);
+    }
+
+    void GraphSnapshot::collectProgram(const std::shared_ptr<ll::Program>& program, const std::map<std::string, std::shared_ptr<ll::Program>>& programs)
+    {
+
+        if (m_programIds.count(program.get()) != 0) {
+            return;
+        }
+
+        const auto it   = std::find_if(programs.cbegin(), programs.cend(), [&program](const auto& kv) { return kv.second == program; });
+        const auto name = it == programs.cend() ? std::string {} : it->first;
+
+        ll::throwSystemErrorIf(name.empty() && !program->hasSpirV(), ll::ErrorCode::InvalidArgument,
+            "programs must be either registered in the session or keep their SPIR-V code to be saved.");
+
+        m_programIds[program.get()] = static_cast<uint32_t>(m_programs.size());
+        m_programs.emplace_back(name, program);
+    }
+
+    void GraphSnapshot::traceContainer(const ll::ContainerNode& node)
+    {
+
+        auto trace = ll::impl::CommandTrace {};
+
+        auto cmdBuffer     = m_device->createCommandBuffer();
+        cmdBuffer->m_trace = &trace;
+        cmdBuffer->begin();
+        node.record(*cmdBuffer);
+        cmdBuffer->end();
+
+        // the command buffer is never submitted, restore the layouts tracked by the images
+        for (auto it = trace.steps.crbegin(); it != trace.steps.crend(); ++it) {
+            if (it->type == ll::impl::CommandTraceStepType::ChangeImageLayout) {
+                it->image->m_layout = it->previousLayout;
+            }
+        }
+
+        ll::throwSystemErrorIf(!trace.unsupportedCommand.empty(), ll::ErrorCode::InvalidArgument,
+            "container node [" + node.getDescriptor().getBuilderName() + "] records command " + trace.unsupportedCommand + ", which cannot be saved.");
+
+        for (const auto& step : trace.steps) {
+
+            ll::throwSystemErrorIf(step.node != nullptr && m_nodeIds.count(step.node) == 0, ll::ErrorCode::InvalidArgument,
+                "container node [" + node.getDescriptor().getBuilderName() + "] records a compute node that is not part of the graph.");
+
+            ll::throwSystemErrorIf(step.image != nullptr && m_objectIds.count(step.image) == 0, ll::ErrorCode::InvalidArgument,
+                "container node [" + node.getDescriptor().getBuilderName() + "] records an image that is not bound to any node of the graph.");
+        }
+
+        m_traces[&node] = std::move(trace);
+    }
+
+    void GraphSnapshot::writeObject(Writer& writer, ll::Object& obj)
+    {
+
+        writer.write(obj.getType());
+
+        switch (obj.getType()) {
+        case ll::ObjectType::Buffer: {
+
+            auto& buffer = static_cast<ll::Buffer&>(obj);
+
+            writer.write(m_memoryIds.at(buffer.getMemory().get()));
+            writer.write(buffer.getSize());
+            writer.write(static_cast<ll::enum_t>(buffer.getUsageFlags()));
+            writer.write(readBufferContent(buffer));
+
+        } break;
+
+        case ll::ObjectType::Image: {
+
+            auto&       image      = static_cast<ll::Image&>(obj);
+            const auto& descriptor = image.getDescriptor();
+
+            writer.write(m_memoryIds.at(image.getMemory().get()));
+            writer.write(descriptor.getShape());
+            writer.write(descriptor.getChannelCount());
+            writer.write(descriptor.getChannelType());
+            writer.write(static_cast<ll::enum_t>(descriptor.getUsageFlags()));
+            writer.write(descriptor.getTiling());
+            writer.write(image.getLayout());
+            writer.write(readImageContent(image));
+
+        } break;
+
+        case ll::ObjectType::ImageView: {
+
+            const auto& imageView  = static_cast<const ll::ImageView&>(obj);
+            const auto& descriptor = imageView.getDescriptor();
+
+            writer.write(m_objectIds.at(imageView.getImage().get()));
+            writer.write(descriptor.getFilterMode());
+            writer.write(descriptor.getAddressModeU());
+            writer.write(descriptor.getAddressModeV());
+            writer.write(descriptor.getAddressModeW());
+            writer.write(static_cast<uint8_t>(descriptor.isNormalizedCoordinates()));
+            writer.write(static_cast<uint8_t>(descriptor.isSampled()));
+
+        } break;
+
+        case ll::ObjectType::BufferView: {
+
+            const auto& bufferView = static_cast<const ll::BufferView&>(obj);
+
+            writer.write(m_objectIds.at(bufferView.getBuffer().get()));
+            writer.write(bufferView.getChannelCount());
+            writer.write(bufferView.getChannelType());
+            writer.write(bufferView.getOffset());
+            writer.write(bufferView.getRange());
+
+        } break;
+        }
+    }
+
+    void GraphSnapshot::writeComputeNode(Writer& writer, const ll::ComputeNode& node)
+    {
+
+        const auto& descriptor = node.m_descriptor;
+
+        writer.write(m_programIds.at(descriptor.getProgram().get()));
+        writer.write(descriptor.getFunctionName());
+        writer.write(descriptor.getBuilderName());
+        writer.write(descriptor.getLocalShape());
+        writer.write(descriptor.getGridShape());
+        writer.write(descriptor.getGridOffset());
+
+        writePorts(writer, descriptor.m_ports);
+        writeParameters(writer, descriptor.m_parameters, descriptor.m_parameterIndices);
+
+        writer.write(descriptor.getPushConstants().m_data);
+
+        const auto& specializationConstants = descriptor.getSpecializationConstants().getValues();
+        writer.write(static_cast<uint32_t>(specializationConstants.size()));
+        for (const auto& [id, value] : specializationConstants) {
+            writer.write(id);
+            writer.write(value.type);
+            writer.write(value.data);
+        }
+
+        // empty if indirect dispatch is disabled
+        writer.write(descriptor.getIndirectDispatchPort());
+        writer.write(descriptor.getIndirectDispatchOffset());
+
+        writer.write(descriptor.getStencilRadius());
+        writer.write(descriptor.getDescriptorSetCount());
+
+        for (auto index = uint32_t {0}; index < node.m_objects.size(); ++index) {
+
+            const auto& obj = node.m_objects[index];
+            writer.write(obj == nullptr ? NO_ID : m_objectIds.at(obj.get()));
+
+            const auto it = node.m_bufferRanges.find(index);
+            writer.write(static_cast<uint8_t>(it != node.m_bufferRanges.cend()));
+            writer.write(it != node.m_bufferRanges.cend() ? it->second.first : uint64_t {0});
+            writer.write(it != node.m_bufferRanges.cend() ? it->second.second : uint64_t {0});
+        }
+
+        writer.write(static_cast<uint32_t>(node.m_dynamicOffsets.size()));
+        for (const auto& [binding, offset] : node.m_dynamicOffsets) {
+            writer.write(binding);
+            writer.write(offset);
+        }
+    }
+
+    void GraphSnapshot::writeContainerNode(Writer& writer, const ll::ContainerNode& node)
+    {
+
+        const auto& descriptor = node.m_descriptor;
+
+        writer.write(descriptor.getBuilderName());
+        writer.write(descriptor.getStencilRadius());
+
+        writePorts(writer, descriptor.m_ports);
+        writeParameters(writer, descriptor.m_parameters, descriptor.m_parameterIndices);
+
+        writer.write(static_cast<uint32_t>(node.m_objects.size()));
+        for (const auto& [name, obj] : node.m_objects) {
+            writer.write(name);
+            writer.write(obj == nullptr ? NO_ID : m_objectIds.at(obj.get()));
+        }
+
+        writer.write(static_cast<uint32_t>(node.m_nodes.size()));
+        for (const auto& [name, child] : node.m_nodes) {
+            writer.write(name);
+            writer.write(m_nodeIds.at(child.get()));
+        }
+
+        const auto& steps = m_traces.at(&node).steps;
+
+        writer.write(static_cast<uint32_t>(steps.size()));
+        for (const auto& step : steps) {
+
+            writer.write(step.type);
+            writer.write(step.node == nullptr ? NO_ID : m_nodeIds.at(step.node));
+            writer.write(step.image == nullptr ? NO_ID : m_objectIds.at(step.image));
+            writer.write(step.layout);
+        }
+    }
+
+    void GraphSnapshot::writePorts(Writer& writer, const std::vector<ll::PortDescriptor>& ports)
+    {
+
+        writer.write(static_cast<uint32_t>(ports.size()));
+        for (const auto& port : ports) {
+            writer.write(port.getBinding());
+            writer.write(port.getName());
+            writer.write(port.getDirection());
+            writer.write(port.getPortType());
+        }
+    }
+
+    void GraphSnapshot::writeParameters(Writer& writer, const std::vector<ll::Parameter>& parameters, const std::map<std::string, uint32_t>& indices)
+    {
+
+        auto names = std::vector<std::string>(parameters.size());
+        for (const auto& [name, index] : indices) {
+            names[index] = name;
+        }
+
+        writer.write(static_cast<uint32_t>(parameters.size()));
+        for (auto index = size_t {0}; index < parameters.size(); ++index) {
+
+            const auto& parameter = parameters[index];
+
+            writer.write(names[index]);
+            writer.write(parameter.getType());
+
+            switch (parameter.getType()) {
+            case ll::ParameterType::Int:
+                writer.write(parameter.get<int32_t>());
+                break;
+            case ll::ParameterType::Float:
+                writer.write(parameter.get<float>());
+                break;
+            case ll::ParameterType::String:
+                writer.write(parameter.get<std::string>());
+                break;
+            }
+        }
+    }
+
+    std::shared_ptr<ll::Object> GraphSnapshot::readObject(Reader& reader)
+    {
+
+        switch (reader.read<ll::ObjectType>()) {
+        case ll::ObjectType::Buffer: {
+
+            const auto& memory     = getMemory(reader.read<uint32_t>());
+            const auto  size       = reader.read<uint64_t>();
+            const auto  usageFlags = ll::BufferUsageFlags {reader.read<ll::enum_t>()};
+
+            auto buffer = memory->createBuffer(size, usageFlags);
+            writeBufferContent(*buffer, reader.readBytes());
+
+            return buffer;
+        }
+
+        case ll::ObjectType::Image: {
+
+            const auto& memory       = getMemory(reader.read<uint32_t>());
+            const auto  shape        = reader.readVec3();
+            const auto  channelCount = reader.read<ll::ChannelCount>();
+            const auto  channelType  = reader.read<ll::ChannelType>();
+            const auto  usageFlags   = ll::ImageUsageFlags {reader.read<ll::enum_t>()};
+            const auto  tiling       = reader.read<ll::ImageTiling>();
+            const auto  layout       = reader.read<ll::ImageLayout>();
+
+            auto image = memory->createImage(ll::ImageDescriptor {shape.z, shape.y, shape.x, channelCount, channelType, usageFlags, tiling});
+            writeImageContent(*image, reader.readBytes());
+
+            if (layout != ll::ImageLayout::Undefined && layout != ll::ImageLayout::Preinitialized && image->getLayout() != layout) {
+                image->changeImageLayout(layout);
+            }
+
+            return image;
+        }
+
+        case ll::ObjectType::ImageView: {
+
+            auto image = getObject<ll::Image>(reader.read<uint32_t>(), ll::ObjectType::Image);
+
+            auto descriptor = ll::ImageViewDescriptor {};
+            descriptor.setFilterMode(reader.read<ll::ImageFilterMode>());
+            descriptor.setAddressMode(ll::ImageAxis::U, reader.read<ll::ImageAddressMode>());
+            descriptor.setAddressMode(ll::ImageAxis::V, reader.read<ll::ImageAddressMode>());
+            descriptor.setAddressMode(ll::ImageAxis::W, reader.read<ll::ImageAddressMode>());
+            descriptor.setNormalizedCoordinates(reader.read<uint8_t>() != 0);
+            descriptor.setIsSampled(reader.read<uint8_t>() != 0);
+
+            return image->createImageView(descriptor);
+        }
+
+        case ll::ObjectType::BufferView: {
+
+            auto       buffer       = getObject<ll::Buffer>(reader.read<uint32_t>(), ll::ObjectType::Buffer);
+            const auto channelCount = reader.read<ll::ChannelCount>();
+            const auto channelType  = reader.read<ll::ChannelType>();
+            const auto offset       = reader.read<uint64_t>();
+            const auto range        = reader.read<uint64_t>();
+
+            return buffer->createBufferView(channelCount, channelType, offset, range);
+        }
+
+        default:
+            ll::throwSystemError(ll::ErrorCode::IOError, "corrupted graph snapshot, unknown object type.");
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<ll::Node> GraphSnapshot::readComputeNode(Reader& reader, const std::weak_ptr<ll::Interpreter>& interpreter)
+    {
+
+        const auto programId = reader.read<uint32_t>();
+        ll::throwSystemErrorIf(programId >= m_programs.size(), ll::ErrorCode::IOError, "corrupted graph snapshot, invalid program id.");
+
+        auto descriptor = ll::ComputeNodeDescriptor {};
+        descriptor.setProgram(m_programs[programId].second)
+            .setFunctionName(reader.readString())
+            .setBuilderName(reader.readString())
+            .setLocalShape(reader.readVec3())
+            .setGridShape(reader.readVec3())
+            .setGridOffset(reader.readVec3());
+
+        for (const auto& port : readPorts(reader)) {
+            descriptor.addPort(port);
+        }
+
+        for (const auto& [name, parameter] : readParameters(reader)) {
+            descriptor.setParameter(name, parameter);
+        }
+
+        auto pushConstants   = ll::PushConstants {};
+        pushConstants.m_data = reader.readBytes();
+        descriptor.setPushConstants(pushConstants);
+
+        auto       specializationConstants = ll::SpecializationConstants {};
+        const auto specializationCount     = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < specializationCount; ++i) {
+
+            const auto id   = reader.read<uint32_t>();
+            const auto type = reader.read<ll::SpecializationConstantType>();
+            const auto data = reader.read<uint32_t>();
+
+            switch (type) {
+            case ll::SpecializationConstantType::Int32:
+                specializationConstants.setInt32(id, static_cast<int32_t>(data));
+                break;
+            case ll::SpecializationConstantType::Uint32:
+                specializationConstants.setUint32(id, data);
+                break;
+            case ll::SpecializationConstantType::Float: {
+                auto value = float {0};
+                std::memcpy(&value, &data, sizeof(float));
+                specializationConstants.setFloat(id, value);
+            } break;
+            case ll::SpecializationConstantType::Bool:
+                specializationConstants.setBool(id, data != 0);
+                break;
+            default:
+                ll::throwSystemError(ll::ErrorCode::IOError, "corrupted graph snapshot, unknown specialization constant type.");
+            }
+        }
+
+        descriptor.setSpecializationConstants(specializationConstants);
+
+        const auto indirectPort   = reader.readString();
+        const auto indirectOffset = reader.read<uint64_t>();
+        if (!indirectPort.empty()) {
+            descriptor.setIndirectDispatch(indirectPort, indirectOffset);
+        }
+
+        descriptor.setStencilRadius(reader.read<uint32_t>());
+        descriptor.setDescriptorSetCount(reader.read<uint32_t>());
+
+        auto node = std::make_shared<ll::ComputeNode>(m_device, descriptor, interpreter, std::make_shared<SnapshotComputeNodeBuilder>(descriptor));
+
+        for (auto index = uint32_t {0}; index < descriptor.getPortCount(); ++index) {
+
+            const auto objectId = reader.read<uint32_t>();
+            const auto hasRange = reader.read<uint8_t>() != 0;
+            const auto offset   = reader.read<uint64_t>();
+            const auto range    = reader.read<uint64_t>();
+
+            if (objectId == NO_ID) {
+                continue;
+            }
+
+            if (hasRange) {
+                node->bindRange(descriptor.getPort(index).getName(), getObject<ll::Buffer>(objectId, ll::ObjectType::Buffer), offset, range);
+            } else {
+                node->bind(index, getObject(objectId));
+            }
+        }
+
+        const auto dynamicOffsetCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < dynamicOffsetCount; ++i) {
+
+            const auto binding = reader.read<uint32_t>();
+            const auto offset  = reader.read<uint32_t>();
+
+            for (auto index = uint32_t {0}; index < descriptor.getPortCount(); ++index) {
+                if (descriptor.getPort(index).getBinding() == binding) {
+                    node->setDynamicOffset(descriptor.getPort(index).getName(), offset);
+                }
+            }
+        }
+
+        node->init();
+        return node;
+    }
+
+    std::shared_ptr<ll::Node> GraphSnapshot::readContainerNode(Reader& reader, const std::weak_ptr<ll::Interpreter>& interpreter)
+    {
+
+        auto descriptor = ll::ContainerNodeDescriptor {};
+        descriptor.setBuilderName(reader.readString());
+        descriptor.setStencilRadius(reader.read<uint32_t>());
+
+        for (const auto& port : readPorts(reader)) {
+            descriptor.addPort(port);
+        }
+
+        for (const auto& [name, parameter] : readParameters(reader)) {
+            descriptor.setParameter(name, parameter);
+        }
+
+        auto objects     = std::vector<std::pair<std::string, std::shared_ptr<ll::Object>>> {};
+        auto objectCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < objectCount; ++i) {
+
+            auto       name     = reader.readString();
+            const auto objectId = reader.read<uint32_t>();
+
+            objects.emplace_back(std::move(name), objectId == NO_ID ? nullptr : getObject(objectId));
+        }
+
+        auto nodes     = std::vector<std::pair<std::string, std::shared_ptr<ll::Node>>> {};
+        auto nodeCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < nodeCount; ++i) {
+
+            auto name = reader.readString();
+            nodes.emplace_back(std::move(name), getNode(reader.read<uint32_t>()));
+        }
+
+        auto commands     = std::vector<SnapshotContainerNodeBuilder::Command> {};
+        auto commandCount = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < commandCount; ++i) {
+
+            auto command = SnapshotContainerNodeBuilder::Command {};
+            command.type = reader.read<ll::impl::CommandTraceStepType>();
+
+            const auto nodeId  = reader.read<uint32_t>();
+            const auto imageId = reader.read<uint32_t>();
+            command.layout     = reader.read<ll::ImageLayout>();
+
+            switch (command.type) {
+            case ll::impl::CommandTraceStepType::Run: {
+
+                auto node = getNode(nodeId);
+                ll::throwSystemErrorIf(node->getType() != ll::NodeType::Compute, ll::ErrorCode::IOError, "corrupted graph snapshot, recorded node is not a compute node.");
+                command.node = std::static_pointer_cast<ll::ComputeNode>(node);
+
+            } break;
+            case ll::impl::CommandTraceStepType::MemoryBarrier:
+            case ll::impl::CommandTraceStepType::IndirectBarrier:
+                break;
+            case ll::impl::CommandTraceStepType::ClearImage:
+            case ll::impl::CommandTraceStepType::ChangeImageLayout:
+                command.image = getObject<ll::Image>(imageId, ll::ObjectType::Image);
+                break;
+            default:
+                ll::throwSystemError(ll::ErrorCode::IOError, "corrupted graph snapshot, unknown command type.");
+            }
+
+            commands.push_back(std::move(command));
+        }
+
+        auto builder = std::make_shared<SnapshotContainerNodeBuilder>(descriptor, std::move(commands));
+        auto node    = std::make_shared<ll::ContainerNode>(interpreter, descriptor, builder);
+
+        for (auto index = uint32_t {0}; index < objects.size(); ++index) {
+
+            if (index < descriptor.getPortCount()) {
+                node->bind(index, objects[index].second);
+            } else {
+                node->bind(objects[index].first, objects[index].second);
+            }
+        }
+
+        for (const auto& [name, child] : nodes) {
+            node->bindNode(name, child);
+        }
+
+        node->init();
+        return node;
+    }
+
+    std::vector<ll::PortDescriptor> GraphSnapshot::readPorts(Reader& reader)
+    {
+
+        auto ports = std::vector<ll::PortDescriptor> {};
+
+        const auto count = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < count; ++i) {
+
+            const auto binding   = reader.read<uint32_t>();
+            const auto name      = reader.readString();
+            const auto direction = reader.read<ll::PortDirection>();
+            const auto portType  = reader.read<ll::PortType>();
+
+            ports.emplace_back(binding, name, direction, portType);
+        }
+
+        return ports;
+    }
+
+    std::vector<std::pair<std::string, ll::Parameter>> GraphSnapshot::readParameters(Reader& reader)
+    {
+
+        auto parameters = std::vector<std::pair<std::string, ll::Parameter>> {};
+
+        const auto count = reader.read<uint32_t>();
+        for (auto i = uint32_t {0}; i < count; ++i) {
+
+            auto parameter = ll::Parameter {};
+            auto name      = reader.readString();
+
+            switch (reader.read<ll::ParameterType>()) {
+            case ll::ParameterType::Int:
+                parameter.set(reader.read<int32_t>());
+                break;
+            case ll::ParameterType::Float:
+                parameter.set(reader.read<float>());
+                break;
+            case ll::ParameterType::String:
+                parameter.set(reader.readString());
+                break;
+            default:
+                ll::throwSystemError(ll::ErrorCode::IOError, "corrupted graph snapshot, unknown parameter type.");
+            }
+
+            parameters.emplace_back(std::move(name), std::move(parameter));
+        }
+
+        return parameters;
+    }
+
+    const std::shared_ptr<ll::Memory>& GraphSnapshot::getMemory(const uint32_t id) const
+    {
+
+        ll::throwSystemErrorIf(id >= m_memories.size(), ll::ErrorCode::IOError, "corrupted graph snapshot, invalid memory id.");
+        return m_memories[id];
+    }
+
+    const std::shared_ptr<ll::Node>& GraphSnapshot::getNode(const uint32_t id) const
+    {
+
+        ll::throwSystemErrorIf(id >= m_nodes.size(), ll::ErrorCode::IOError, "corrupted graph snapshot, invalid node id.");
+        return m_nodes[id];
+    }
+
+    const std::shared_ptr<ll::Object>& GraphSnapshot::getObject(const uint32_t id) const
+    {
+
+        ll::throwSystemErrorIf(id >= m_objects.size(), ll::ErrorCode::IOError, "corrupted graph snapshot, invalid object id.");
+        return m_objects[id];
+    }
+
+    template <typename T>
+    std::shared_ptr<T> GraphSnapshot::getObject(const uint32_t id, const ll::ObjectType type) const
+    {
+
+        const auto& obj = getObject(id);
+
+        ll::throwSystemErrorIf(obj->getType() != type, ll::ErrorCode::IOError,
+            "corrupted graph snapshot, expecting object of type " + ll::objectTypeToString(ll::ObjectType {type}) + ", got: " + ll::objectTypeToString(obj->getType()));
+
+        return std::static_pointer_cast<T>(obj);
+    }
+
+    std::vector<uint8_t> GraphSnapshot::readBufferContent(ll::Buffer& buffer)
+    {
+
+        if (!isBufferContentStored(buffer)) {
+            return {};
+        }
+
+        auto content = std::vector<uint8_t>(buffer.getSize());
+
+        if (buffer.isMappable()) {
+            auto ptr = buffer.map<uint8_t[]>();
+            std::memcpy(content.data(), ptr.get(), content.size());
+            return content;
+        }
+
+        auto stageBuffer = m_session.getHostMemory()->createBuffer(buffer.getSize());
+
+        auto cmdBuffer = m_device->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->copyBuffer(buffer, *stageBuffer);
+        cmdBuffer->end();
+        m_device->run(*cmdBuffer);
+
+        auto ptr = stageBuffer->map<uint8_t[]>();
+        std::memcpy(content.data(), ptr.get(), content.size());
+
+        return content;
+    }
+
+    std::vector<uint8_t> GraphSnapshot::readImageContent(ll::Image& image)
+    {
+
+        if (!isImageContentStored(image)) {
+            return {};
+        }
+
+        const auto layout = image.getLayout();
+
+        auto stageBuffer = m_session.getHostMemory()->createBuffer(image.getDescriptor().getSize());
+
+        auto cmdBuffer = m_device->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->changeImageLayout(image, ll::ImageLayout::TransferSrcOptimal);
+        cmdBuffer->copyImageToBuffer(image, *stageBuffer);
+        cmdBuffer->changeImageLayout(image, layout);
+        cmdBuffer->end();
+        m_device->run(*cmdBuffer);
+
+        auto content = std::vector<uint8_t>(stageBuffer->getSize());
+
+        auto ptr = stageBuffer->map<uint8_t[]>();
+        std::memcpy(content.data(), ptr.get(), content.size());
+
+        return content;
+    }
+
+    void GraphSnapshot::writeBufferContent(ll::Buffer& buffer, const std::vector<uint8_t>& content)
+    {
+
+        if (content.empty()) {
+            return;
+        }
+
+        ll::throwSystemErrorIf(content.size() != buffer.getSize(), ll::ErrorCode::IOError, "corrupted graph snapshot, buffer content does not match the buffer size.");
+
+        if (buffer.isMappable()) {
+            auto ptr = buffer.map<uint8_t[]>();
+            std::memcpy(ptr.get(), content.data(), content.size());
+            return;
+        }
+
+        auto stageBuffer = m_session.getHostMemory()->createBuffer(buffer.getSize());
+        {
+            auto ptr = stageBuffer->map<uint8_t[]>();
+            std::memcpy(ptr.get(), content.data(), content.size());
+        }
+
+        auto cmdBuffer = m_device->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->copyBuffer(*stageBuffer, buffer);
+        cmdBuffer->end();
+        m_device->run(*cmdBuffer);
+    }
+
+    void GraphSnapshot::writeImageContent(ll::Image& image, const std::vector<uint8_t>& content)
+    {
+
+        if (content.empty()) {
+            return;
+        }
+
+        ll::throwSystemErrorIf(content.size() != image.getDescriptor().getSize(), ll::ErrorCode::IOError, "corrupted graph snapshot, image content does not match the image size.");
+
+        auto stageBuffer = m_session.getHostMemory()->createBuffer(content.size());
+        {
+            auto ptr = stageBuffer->map<uint8_t[]>();
+            std::memcpy(ptr.get(), content.data(), content.size());
+        }
+
+        auto cmdBuffer = m_device->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->changeImageLayout(image, ll::ImageLayout::TransferDstOptimal);
+        cmdBuffer->copyBufferToImage(*stageBuffer, image);
+        cmdBuffer->end();
+        m_device->run(*cmdBuffer);
+    }
+
+} // namespace impl
+} // namespace ll
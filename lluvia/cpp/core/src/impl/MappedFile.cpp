@@ -0,0 +1,102 @@
+/**
+@file       MappedFile.cpp
+@brief      MappedFile class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/impl/MappedFile.h"
+
+#include "lluvia/core/error.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ll {
+namespace impl {
+
+#if defined(_WIN32)
+
+    MappedFile::MappedFile(const std::string& filename)
+    {
+
+        auto file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        ll::throwSystemErrorIf(file == INVALID_HANDLE_VALUE, ll::ErrorCode::IOError, "error opening file: " + filename);
+
+        auto fileSize = LARGE_INTEGER {};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            ll::throwSystemError(ll::ErrorCode::IOError, "error reading size of file or file is empty: " + filename);
+        }
+
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        ll::throwSystemErrorIf(mapping == nullptr, ll::ErrorCode::IOError, "error mapping file: " + filename);
+
+        // the view keeps the mapping alive after its handle is closed
+        const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        ll::throwSystemErrorIf(view == nullptr, ll::ErrorCode::IOError, "error mapping file: " + filename);
+
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string& filename)
+    {
+
+        const auto fd = open(filename.c_str(), O_RDONLY);
+        ll::throwSystemErrorIf(fd < 0, ll::ErrorCode::IOError, "error opening file: " + filename);
+
+        struct stat fileStat {};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+            close(fd);
+            ll::throwSystemError(ll::ErrorCode::IOError, "error reading size of file or file is empty: " + filename);
+        }
+
+        // the mapping stays valid after the file descriptor is closed
+        const auto size = static_cast<size_t>(fileStat.st_size);
+        const auto ptr  = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        ll::throwSystemErrorIf(ptr == MAP_FAILED, ll::ErrorCode::IOError, "error mapping file: " + filename);
+
+        m_data = static_cast<const uint8_t*>(ptr);
+        m_size = size;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+
+#endif
+
+    const uint8_t* MappedFile::data() const noexcept
+    {
+        return m_data;
+    }
+
+    size_t MappedFile::size() const noexcept
+    {
+        return m_size;
+    }
+
+} // namespace impl
+} // namespace ll
@@ -0,0 +1,94 @@
+/**
+@file       ObjectShape.cpp
+@brief      Helper functions to follow the shape of the images bound to nodes.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/impl/ObjectShape.h"
+
+#include "lluvia/core/Object.h"
+#include "lluvia/core/image/Image.h"
+#include "lluvia/core/image/ImageView.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ll {
+namespace impl {
+
+    std::shared_ptr<ll::Image> getObjectImage(const std::shared_ptr<ll::Object>& obj)
+    {
+
+        if (obj == nullptr) {
+            return nullptr;
+        }
+
+        switch (obj->getType()) {
+        case ll::ObjectType::Image:
+            return std::static_pointer_cast<ll::Image>(obj);
+        case ll::ObjectType::ImageView:
+            return std::static_pointer_cast<ll::ImageView>(obj)->getImage();
+        default:
+            return nullptr;
+        }
+    }
+
+    namespace {
+
+        std::optional<uint32_t> scaleDimension(const uint32_t value, const uint32_t oldRef, const uint32_t newRef) noexcept
+        {
+
+            if (value == oldRef) {
+                return newRef;
+            }
+
+            if (value < 2 || oldRef < 2) {
+                return std::nullopt;
+            }
+
+            constexpr const auto bits = static_cast<uint32_t>(std::numeric_limits<uint32_t>::digits);
+
+            for (auto level = uint32_t {1}; level < bits; ++level) {
+
+                const auto factor = uint64_t {1} << level;
+
+                // pyramid levels, rounded either down or up
+                if (oldRef / factor == value) {
+                    return std::max(static_cast<uint32_t>(newRef / factor), uint32_t {1});
+                }
+
+                if ((oldRef + factor - 1) / factor == value) {
+                    return static_cast<uint32_t>((newRef + factor - 1) / factor);
+                }
+
+                if (oldRef * factor == value) {
+                    const auto scaled = newRef * factor;
+                    if (scaled > std::numeric_limits<uint32_t>::max()) {
+                        return std::nullopt;
+                    }
+
+                    return static_cast<uint32_t>(scaled);
+                }
+            }
+
+            return std::nullopt;
+        }
+
+    } // namespace
+
+    std::optional<ll::vec3ui> scaleShape(const ll::vec3ui& shape, const ll::vec3ui& oldRef, const ll::vec3ui& newRef) noexcept
+    {
+
+        const auto width  = scaleDimension(shape.x, oldRef.x, newRef.x);
+        const auto height = scaleDimension(shape.y, oldRef.y, newRef.y);
+
+        if (!width.has_value() || !height.has_value()) {
+            return std::nullopt;
+        }
+
+        return ll::vec3ui {*width, *height, shape.z};
+    }
+
+} // namespace impl
+} // namespace ll
@@ -12,9 +12,28 @@
 namespace ll {
 namespace impl {
 
+    namespace {
+
+        constexpr const uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+        constexpr const size_t   LOCAL_HEADER_SIZE      = 30;
+
+        uint32_t readLittleEndian(const uint8_t* ptr, const size_t bytes) noexcept
+        {
+
+            auto value = uint32_t {0};
+            for (auto i = 0u; i < bytes; ++i) {
+                value |= static_cast<uint32_t>(ptr[i]) << (8 * i);
+            }
+
+            return value;
+        }
+
+    } // namespace
+
     ZipArchive::ZipArchive(const std::string& filename)
+        : mFile {filename}
     {
-        ll::throwSystemErrorIf(mz_zip_reader_init_file(&mArchive, filename.c_str(), 0) == MZ_FALSE, ll::ErrorCode::IOError, "Error reading archive");
+        ll::throwSystemErrorIf(mz_zip_reader_init_mem(&mArchive, mFile.data(), mFile.size(), 0) == MZ_FALSE, ll::ErrorCode::IOError, "Error reading archive");
     }
 
     ZipArchive::~ZipArchive()
@@ -41,13 +60,17 @@ namespace impl {
     std::string ZipArchive::uncompressTextFile(mz_zip_archive_file_stat& stat)
     {
 
-        auto buffer = std::vector<char> {};
+        if (const auto data = getStoredFileData(stat)) {
+            return std::string {reinterpret_cast<const char*>(data), static_cast<size_t>(stat.m_uncomp_size)};
+        }
+
+        auto buffer = std::string {};
         buffer.resize(stat.m_uncomp_size);
 
-        ll::throwSystemErrorIf(!mz_zip_reader_extract_file_to_mem(&mArchive, stat.m_filename, &buffer[0], buffer.size(), 0),
+        ll::throwSystemErrorIf(!mz_zip_reader_extract_to_mem(&mArchive, stat.m_file_index, &buffer[0], buffer.size(), 0),
             ll::ErrorCode::IOError, "Error extracting text file from archive.");
 
-        return std::string {&buffer[0], buffer.size()};
+        return buffer;
     }
 
     std::vector<uint8_t> ZipArchive::uncompressBinaryFile(mz_zip_archive_file_stat& stat)
@@ -62,5 +85,29 @@ namespace impl {
         return buffer;
     }
 
+    const uint8_t* ZipArchive::getStoredFileData(const mz_zip_archive_file_stat& stat) const
+    {
+
+        if (stat.m_method != 0 || stat.m_is_encrypted || stat.m_comp_size != stat.m_uncomp_size) {
+            return nullptr;
+        }
+
+        // the data follows the entry's local header, whose variable-length
+        // fields may differ from the central directory ones
+        const auto headerOffset = static_cast<size_t>(stat.m_local_header_ofs);
+        ll::throwSystemErrorIf(headerOffset + LOCAL_HEADER_SIZE > mFile.size(), ll::ErrorCode::IOError, "Invalid local header offset in archive.");
+
+        const auto header = mFile.data() + headerOffset;
+        ll::throwSystemErrorIf(readLittleEndian(header, 4) != LOCAL_HEADER_SIGNATURE, ll::ErrorCode::IOError, "Invalid local header signature in archive.");
+
+        const auto filenameLength = readLittleEndian(header + 26, 2);
+        const auto extraLength    = readLittleEndian(header + 28, 2);
+        const auto dataOffset     = headerOffset + LOCAL_HEADER_SIZE + filenameLength + extraLength;
+
+        ll::throwSystemErrorIf(dataOffset + stat.m_uncomp_size > mFile.size(), ll::ErrorCode::IOError, "Stored file exceeds the archive size.");
+
+        return mFile.data() + dataOffset;
+    }
+
 } // namespace impl
 } // namespace ll
@@ -7,6 +7,7 @@
 
 #include "lluvia/core/memory/Memory.h"
 
+#include "lluvia/core/CommandBuffer.h"
 #include "lluvia/core/Session.h"
 #include "lluvia/core/buffer/Buffer.h"
 #include "lluvia/core/error.h"
@@ -15,12 +16,18 @@
 #include "lluvia/core/image/ImageView.h"
 #include "lluvia/core/image/ImageViewDescriptor.h"
 #include "lluvia/core/memory/MemoryAllocationInfo.h"
+#include "lluvia/core/node/ComputeNode.h"
 
 #include "lluvia/core/vulkan/Device.h"
 
 #include <algorithm>
+#include <chrono>
 #include <exception>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
 
 constexpr const uint32_t CAPACITY_INCREASE = 32;
 
@@ -28,6 +35,181 @@ namespace ll {
 
 constexpr const ll::ImageLayout InitialImageLayout = ll::ImageLayout::Undefined;
 
+// linear images keep the content written by the host before their first layout transition
+inline ll::ImageLayout getInitialImageLayout(const ll::ImageDescriptor& descriptor) noexcept
+{
+    return descriptor.getTiling() == ll::ImageTiling::Linear ? ll::ImageLayout::Preinitialized : InitialImageLayout;
+}
+
+namespace impl {
+
+    AliasedMemoryBlock::AliasedMemoryBlock(const std::shared_ptr<ll::Memory>& memory, const ll::MemoryAllocationInfo& allocInfo)
+        : m_memory {memory}
+        , m_allocInfo(allocInfo)
+    {
+    }
+
+    AliasedMemoryBlock::~AliasedMemoryBlock()
+    {
+        m_memory->releaseMemoryAllocation(m_allocInfo);
+    }
+
+    const ll::MemoryAllocationInfo& AliasedMemoryBlock::getAllocationInfo() const noexcept
+    {
+        return m_allocInfo;
+    }
+
+    uint64_t alignOffset(const uint64_t offset, const uint64_t alignment) noexcept
+    {
+        return alignment == 0 ? offset : ((offset + alignment - 1) / alignment) * alignment;
+    }
+
+    // Places each object at the lowest offset not used by any other object alive at the same time.
+    // Larger objects are placed first, which tends to leave fewer holes in the shared block.
+    std::vector<uint64_t> computeAliasedOffsets(const std::vector<vk::MemoryRequirements>& requirements,
+        const std::vector<std::pair<uint32_t, uint32_t>>& lifetimes,
+        vk::MemoryRequirements&                           blockRequirements)
+    {
+
+        auto order = std::vector<size_t>(requirements.size());
+        std::iota(order.begin(), order.end(), size_t {0});
+        std::stable_sort(order.begin(), order.end(), [&requirements](const auto a, const auto b) {
+            return requirements[a].size > requirements[b].size;
+        });
+
+        auto offsets = std::vector<uint64_t>(requirements.size(), 0);
+        auto placed  = std::vector<size_t> {};
+        placed.reserve(requirements.size());
+
+        blockRequirements = vk::MemoryRequirements {0, 1, ~uint32_t {0}};
+
+        for (const auto i : order) {
+
+            const auto& req = requirements[i];
+
+            // ranges used by the placed objects whose lifetime overlaps with this one
+            auto conflicts = std::vector<std::pair<uint64_t, uint64_t>> {};
+            for (const auto j : placed) {
+                if (lifetimes[i].first <= lifetimes[j].second && lifetimes[j].first <= lifetimes[i].second) {
+                    conflicts.emplace_back(offsets[j], offsets[j] + requirements[j].size);
+                }
+            }
+
+            std::sort(conflicts.begin(), conflicts.end());
+
+            auto offset = uint64_t {0};
+            for (const auto& range : conflicts) {
+                if (offset + req.size <= range.first) {
+                    break;
+                }
+
+                offset = std::max(offset, alignOffset(range.second, req.alignment));
+            }
+
+            offsets[i] = offset;
+            placed.push_back(i);
+
+            blockRequirements.size      = std::max(blockRequirements.size, offset + req.size);
+            blockRequirements.alignment = std::max(blockRequirements.alignment, req.alignment);
+            blockRequirements.memoryTypeBits &= req.memoryTypeBits;
+        }
+
+        return offsets;
+    }
+
+    // Buffer or image moved to a new location while defragmenting.
+    struct Relocation {
+        std::shared_ptr<ll::Buffer>   buffer;
+        std::shared_ptr<ll::Image>    image;
+        vk::Buffer                    vkBuffer;
+        vk::Image                     vkImage;
+        impl::MemoryAllocationTryInfo tryInfo;
+    };
+
+    vk::ImageMemoryBarrier createImageLayoutBarrier(const vk::Image& image, const vk::ImageLayout oldLayout, const vk::ImageLayout newLayout,
+        const vk::AccessFlags srcAccessFlags, const vk::AccessFlags dstAccessFlags) noexcept
+    {
+
+        auto barrier = vk::ImageMemoryBarrier {}
+                           .setOldLayout(oldLayout)
+                           .setNewLayout(newLayout)
+                           .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                           .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                           .setImage(image)
+                           .setSrcAccessMask(srcAccessFlags)
+                           .setDstAccessMask(dstAccessFlags);
+
+        barrier.subresourceRange.setAspectMask(vk::ImageAspectFlagBits::eColor);
+        barrier.subresourceRange.setBaseMipLevel(0);
+        barrier.subresourceRange.setLevelCount(1);
+        barrier.subresourceRange.setBaseArrayLayer(0);
+        barrier.subresourceRange.setLayerCount(1);
+
+        return barrier;
+    }
+
+    void recordRelocationCopy(const vk::CommandBuffer& cmdBuffer, const Relocation& relocation)
+    {
+
+        if (relocation.buffer != nullptr) {
+
+            const auto copyInfo = vk::BufferCopy {}
+                                      .setSrcOffset(0)
+                                      .setDstOffset(0)
+                                      .setSize(relocation.buffer->getSize());
+
+            cmdBuffer.copyBuffer(relocation.buffer->m_vkBuffer, relocation.vkBuffer, 1, &copyInfo);
+            return;
+        }
+
+        const auto& image = *relocation.image;
+
+        // the content of images in undefined layout does not need to be preserved
+        if (image.m_layout == ll::ImageLayout::Undefined) {
+            return;
+        }
+
+        const auto memoryAccessFlags = vk::AccessFlags {vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
+        const auto layout            = ll::impl::toVkImageLayout(image.m_layout);
+        const auto finalLayout       = image.m_layout == ll::ImageLayout::Preinitialized ? vk::ImageLayout::eGeneral : layout;
+
+        const auto preCopyBarriers = std::array<vk::ImageMemoryBarrier, 2> {
+            createImageLayoutBarrier(image.m_vkImage, layout, vk::ImageLayout::eTransferSrcOptimal, memoryAccessFlags, vk::AccessFlagBits::eTransferRead),
+            createImageLayoutBarrier(relocation.vkImage, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, {}, vk::AccessFlagBits::eTransferWrite)};
+
+        cmdBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer,
+            vk::DependencyFlags {},
+            0, nullptr,
+            0, nullptr,
+            static_cast<uint32_t>(preCopyBarriers.size()), preCopyBarriers.data());
+
+        auto imgSubresourceLayers = vk::ImageSubresourceLayers {}
+                                        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                                        .setMipLevel(0)
+                                        .setBaseArrayLayer(0)
+                                        .setLayerCount(1);
+
+        const auto copyRegion = vk::ImageCopy {}
+                                    .setSrcSubresource(imgSubresourceLayers)
+                                    .setDstSubresource(imgSubresourceLayers)
+                                    .setExtent({image.getWidth(), image.getHeight(), image.getDepth()});
+
+        cmdBuffer.copyImage(image.m_vkImage, vk::ImageLayout::eTransferSrcOptimal,
+            relocation.vkImage, vk::ImageLayout::eTransferDstOptimal,
+            1, &copyRegion);
+
+        const auto postCopyBarrier = createImageLayoutBarrier(relocation.vkImage, vk::ImageLayout::eTransferDstOptimal, finalLayout,
+            vk::AccessFlagBits::eTransferWrite, memoryAccessFlags);
+
+        cmdBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands,
+            vk::DependencyFlags {},
+            0, nullptr,
+            0, nullptr,
+            1, &postCopyBarrier);
+    }
+
+} // namespace impl
+
 Memory::Memory(
     const std::shared_ptr<ll::vulkan::Device>& device,
     const ll::VkHeapInfo&                      heapInfo,
@@ -42,7 +224,11 @@ Memory::~Memory()
 {
 
     for (auto& memory : m_memoryPages) {
-        m_device->get().freeMemory(memory);
+
+        // pages released by trim() are left as null handles
+        if (memory) {
+            m_device->get().freeMemory(memory);
+        }
     }
 }
 
@@ -58,7 +244,101 @@ uint64_t Memory::getPageSize() const noexcept
 
 uint32_t Memory::getPageCount() const noexcept
 {
-    return static_cast<uint32_t>(m_memoryPages.size());
+    return static_cast<uint32_t>(std::count_if(m_memoryPages.cbegin(), m_memoryPages.cend(),
+        [](const auto& memory) { return static_cast<bool>(memory); }));
+}
+
+ll::MemoryStatistics Memory::getStatistics() const
+{
+
+    auto stats = ll::MemoryStatistics {0, 0, {}};
+
+    for (auto page = 0u; page < m_memoryPages.size(); ++page) {
+
+        if (!m_memoryPages[page]) {
+            continue;
+        }
+
+        const auto& manager = m_pageManagers[page];
+
+        stats.pages.push_back(ll::MemoryPageStatistics {page,
+            m_memoryPageTypeIndices[page],
+            m_memoryPageDedicatedFlags[page],
+            manager.getSize(),
+            manager.getUsedSize(),
+            manager.getLargestFreeSize()});
+
+        stats.committedSize += manager.getSize();
+        stats.usedSize += manager.getUsedSize();
+    }
+
+    return stats;
+}
+
+std::vector<ll::MemoryHeapBudget> Memory::getHeapBudgets() const
+{
+
+    const auto memProperties = m_device->getPhysicalDevice().getMemoryProperties();
+    const auto hasBudget     = m_device->isMemoryBudgetSupported();
+    const auto budget        = hasBudget ? m_device->getMemoryBudgetProperties() : vk::PhysicalDeviceMemoryBudgetPropertiesEXT {};
+
+    auto typeIndices = std::vector<uint32_t> {m_heapInfo.typeIndex};
+    typeIndices.insert(typeIndices.end(), m_heapInfo.fallbackTypeIndices.cbegin(), m_heapInfo.fallbackTypeIndices.cend());
+
+    auto budgets = std::vector<ll::MemoryHeapBudget> {};
+
+    for (const auto typeIndex : typeIndices) {
+
+        const auto heapIndex = memProperties.memoryTypes[typeIndex].heapIndex;
+
+        const auto found = std::any_of(budgets.cbegin(), budgets.cend(), [heapIndex](const auto& b) { return b.heapIndex == heapIndex; });
+        if (found) {
+            continue;
+        }
+
+        if (hasBudget) {
+            budgets.push_back(ll::MemoryHeapBudget {heapIndex, budget.heapBudget[heapIndex], budget.heapUsage[heapIndex]});
+            continue;
+        }
+
+        // without VK_EXT_memory_budget only the pages of this memory are known
+        auto usage = uint64_t {0};
+        for (auto page = 0u; page < m_memoryPages.size(); ++page) {
+            if (m_memoryPages[page] && memProperties.memoryTypes[m_memoryPageTypeIndices[page]].heapIndex == heapIndex) {
+                usage += m_pageManagers[page].getSize();
+            }
+        }
+
+        budgets.push_back(ll::MemoryHeapBudget {heapIndex, memProperties.memoryHeaps[heapIndex].size, usage});
+    }
+
+    return budgets;
+}
+
+uint64_t Memory::trim()
+{
+    return releaseEmptyPages(0);
+}
+
+void Memory::enableAutoTrim(const uint64_t highThreshold, const uint64_t lowThreshold)
+{
+
+    ll::throwSystemErrorIf(lowThreshold > highThreshold, ll::ErrorCode::InvalidArgument,
+        "auto trim low threshold (" + std::to_string(lowThreshold) + ") must be less or equal than the high threshold (" + std::to_string(highThreshold) + ")");
+
+    m_autoTrimHighThreshold = highThreshold;
+    m_autoTrimLowThreshold  = lowThreshold;
+    m_isAutoTrimEnabled     = true;
+}
+
+void Memory::disableAutoTrim() noexcept
+{
+    m_isAutoTrimEnabled = false;
+}
+
+bool Memory::isAutoTrimEnabled() const noexcept
+{
+    return m_isAutoTrimEnabled;
 }
 
 bool Memory::isMappable() const noexcept
@@ -97,50 +377,145 @@ std::shared_ptr<ll::Buffer> Memory::createBufferWithUnsafeFlags(const uint64_t s
 std::shared_ptr<ll::Buffer> Memory::createBuffer(const uint64_t size, const ll::BufferUsageFlags usageFlags)
 {
 
-    const auto vkBufferUsageFlags = ll::impl::toVkBufferUsageFlags(usageFlags);
-
-    vk::BufferCreateInfo bufferInfo = vk::BufferCreateInfo()
-                                          .setSharingMode(vk::SharingMode::eExclusive)
-                                          .setSize(size)
-                                          .setUsage(vkBufferUsageFlags)
-                                          .setQueueFamilyIndexCount(static_cast<uint32_t>(m_heapInfo.familyQueueIndices.size()))
-                                          .setPQueueFamilyIndices(m_heapInfo.familyQueueIndices.data());
-
     // It's safe to not guard this call with a try-catch. If an
     // exception is thrown, let the caller to handle it. The memory
     // manager is still in its original state.
-    auto vkBuffer = m_device->get().createBuffer(bufferInfo);
+    auto vkBuffer = createVkBuffer(size, usageFlags);
 
     // query alignment and offset
-    const auto memRequirements = m_device->get().getBufferMemoryRequirements(vkBuffer);
+    auto dedicated       = false;
+    auto memRequirements = vk::MemoryRequirements {};
+
+    try {
+        memRequirements = getBufferMemoryRequirements(vkBuffer, dedicated);
+    } catch (...) {
+        m_device->get().destroyBuffer(vkBuffer);
+        throw;
+    }
 
 // FIXME: this does not work on Android
 // check that memRequirements.memoryTypeBits is supported in this memory
 #ifndef __ANDROID__
-    const auto memoryTypeBits = static_cast<uint32_t>(0x01 << m_heapInfo.typeIndex);
-    if ((memoryTypeBits & memRequirements.memoryTypeBits) == 0u) {
+    if ((getMemoryTypeBits() & memRequirements.memoryTypeBits) == 0u) {
+        m_device->get().destroyBuffer(vkBuffer);
         throw std::system_error(createErrorCode(ll::ErrorCode::ObjectAllocationError), "memory " + std::to_string(m_heapInfo.typeIndex) + " does not support allocating buffer objects.");
     }
+#else
+    memRequirements.memoryTypeBits = getMemoryTypeBits();
 #endif
 
-    // find or create a new memory page where the buffer can be allocated
-    auto tryInfo = getSuitableMemoryPage(memRequirements);
+    // the dedicated page is owned by this call until the buffer is constructed
+    auto dedicatedPage = std::optional<uint32_t> {};
 
     // build a ll::Buffer object and commit the allocation if the
     // object construction is successful.
     try {
 
+        // find or create a new memory page where the buffer can be allocated
+        const auto tryInfo = dedicated ? getDedicatedMemoryPage(memRequirements, vk::MemoryDedicatedAllocateInfo {}.setBuffer(vkBuffer))
+                                       : getSuitableMemoryPage(memRequirements);
+
+        if (dedicated) {
+            dedicatedPage = tryInfo.allocInfo.page;
+        }
+
         const auto& memoryPage = m_memoryPages[tryInfo.allocInfo.page];
         m_device->get().bindBufferMemory(vkBuffer, memoryPage, tryInfo.allocInfo.offset);
 
         // ll::Buffer can throw exception.
         auto buffer = std::shared_ptr<ll::Buffer> {new ll::Buffer {vkBuffer, usageFlags, shared_from_this(), tryInfo.allocInfo, size}};
         m_pageManagers[tryInfo.allocInfo.page].commitAllocation(tryInfo);
+
+        // the page is now released together with the buffer
+        dedicatedPage.reset();
+
+        pruneObjectRegistry();
+        m_buffers.push_back(buffer);
+        return buffer;
+
+    } catch (...) {
+
+        m_device->get().destroyBuffer(vkBuffer);
+
+        if (dedicatedPage) {
+            releasePage(*dedicatedPage);
+        }
+
+        throw; // rethrow
+    }
+}
+
+std::shared_ptr<ll::Buffer> Memory::importHostMemory(void* ptr, const uint64_t size, const ll::BufferUsageFlags usageFlags)
+{
+
+    ll::throwSystemErrorIf(!m_device->isExternalMemoryHostSupported(), ll::ErrorCode::ExtensionNotFound,
+        std::string {"importing host memory requires extension "} + VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+
+    ll::throwSystemErrorIf(ptr == nullptr, ll::ErrorCode::InvalidArgument, "host pointer cannot be null.");
+    ll::throwSystemErrorIf(size == 0, ll::ErrorCode::InvalidArgument, "imported memory size must be greater than zero.");
+
+    const auto alignment = m_device->getMinImportedHostPointerAlignment();
+    ll::throwSystemErrorIf(reinterpret_cast<uintptr_t>(ptr) % alignment != 0, ll::ErrorCode::InvalidArgument,
+        "host pointer must be aligned to " + std::to_string(alignment) + " bytes.");
+    ll::throwSystemErrorIf(size % alignment != 0, ll::ErrorCode::InvalidArgument,
+        "imported memory size " + std::to_string(size) + " must be a multiple of " + std::to_string(alignment) + " bytes.");
+
+    const auto typeBits = m_device->getHostPointerMemoryTypeBits(ptr) & getMemoryTypeBits();
+    ll::throwSystemErrorIf(typeBits == 0u, ll::ErrorCode::ObjectAllocationError,
+        "memory " + std::to_string(m_heapInfo.typeIndex) + " cannot import the host pointer.");
+
+    const auto externalInfo = vk::ExternalMemoryBufferCreateInfo {}
+                                  .setHandleTypes(vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT);
+
+    const auto bufferInfo = vk::BufferCreateInfo {}
+                                .setPNext(&externalInfo)
+                                .setSize(size)
+                                .setUsage(ll::impl::toVkBufferUsageFlags(usageFlags))
+                                .setSharingMode(vk::SharingMode::eExclusive);
+
+    auto vkBuffer = m_device->get().createBuffer(bufferInfo);
+
+    // the imported page is owned by this call until the buffer is constructed
+    auto importedPage = std::optional<uint32_t> {};
+
+    try {
+
+        const auto memRequirements = m_device->get().getBufferMemoryRequirements(vkBuffer);
+        ll::throwSystemErrorIf((memRequirements.memoryTypeBits & typeBits) == 0u || memRequirements.size > size, ll::ErrorCode::ObjectAllocationError,
+            "the buffer cannot be bound to the imported host memory.");
+
+        const auto importInfo = vk::ImportMemoryHostPointerInfoEXT {}
+                                    .setHandleType(vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT)
+                                    .setPHostPointer(ptr);
+
+        // the page holds exactly the imported memory and is freed with the buffer
+        const auto pageIndex = allocatePage(size, memRequirements.memoryTypeBits & typeBits, &importInfo, true);
+        importedPage         = pageIndex;
+
+        auto tryInfo = impl::MemoryAllocationTryInfo {};
+        m_pageManagers[pageIndex].tryAllocate(size, tryInfo);
+        tryInfo.allocInfo.page = pageIndex;
+
+        m_device->get().bindBufferMemory(vkBuffer, m_memoryPages[pageIndex], 0);
+
+        auto buffer = std::shared_ptr<ll::Buffer> {new ll::Buffer {vkBuffer, usageFlags, shared_from_this(), tryInfo.allocInfo, size}};
+        m_pageManagers[pageIndex].commitAllocation(tryInfo);
+
+        // the page is now released together with the buffer
+        importedPage.reset();
+
+        pruneObjectRegistry();
+        m_buffers.push_back(buffer);
         return buffer;
 
     } catch (...) {
 
         m_device->get().destroyBuffer(vkBuffer);
+
+        if (importedPage) {
+            releasePage(*importedPage);
+        }
+
         throw; // rethrow
     }
 }
@@ -148,83 +523,114 @@ std::shared_ptr<ll::Buffer> Memory::createBuffer(const uint64_t size, const ll::
 void Memory::releaseBuffer(const ll::Buffer& buffer)
 {
 
-    releaseMemoryAllocation(buffer.m_allocInfo);
+    // destroy the buffer first as releasing the allocation can free its page
     m_device->get().destroyBuffer(buffer.m_vkBuffer);
+    releaseMemoryAllocation(buffer.m_allocInfo);
 }
 
-void* Memory::mapBuffer(const ll::Buffer& buffer)
+bool Memory::isPageHostCoherent(const uint32_t page) const noexcept
 {
 
-    const auto page   = buffer.m_allocInfo.page;
-    const auto offset = buffer.m_allocInfo.offset + buffer.m_allocInfo.leftPadding;
-    const auto size   = buffer.m_allocInfo.size;
+    if (page >= m_memoryPageTypeIndices.size()) {
+        return true;
+    }
+
+    const auto memProperties = m_device->getPhysicalDevice().getMemoryProperties();
+    const auto flags         = memProperties.memoryTypes[m_memoryPageTypeIndices[page]].propertyFlags;
+
+    return !(flags & vk::MemoryPropertyFlagBits::eHostVisible) || (flags & vk::MemoryPropertyFlagBits::eHostCoherent);
+}
+
+void* Memory::mapPageRange(const uint32_t page, const uint64_t offset, const uint64_t size)
+{
 
     if (m_memoryPageMappingFlags[page]) {
         throw std::system_error {ll::createErrorCode(ll::ErrorCode::MemoryMapFailed), "Memory page [" + std::to_string(page) + "] is already mapped by another object."};
     }
 
+    if (!isPageHostCoherent(page)) {
+
+        // ranges of non-coherent memory must be aligned to nonCoherentAtomSize,
+        // the whole page is mapped instead.
+        auto ptr = m_device->get().mapMemory(m_memoryPages[page], 0, VK_WHOLE_SIZE);
+
+        // make device writes visible to the host
+        const auto range = vk::MappedMemoryRange {m_memoryPages[page], 0, VK_WHOLE_SIZE};
+        static_cast<void>(m_device->get().invalidateMappedMemoryRanges(1, &range));
+
+        m_memoryPageMappingFlags[page] = true;
+        return static_cast<uint8_t*>(ptr) + offset;
+    }
+
     // set mapping flag for this page to mapped
     m_memoryPageMappingFlags[page] = true;
     return m_device->get().mapMemory(m_memoryPages[page], offset, size);
 }
 
-void Memory::unmapBuffer(const ll::Buffer& buffer)
+void Memory::unmapPage(const uint32_t page)
 {
 
-    const auto page = buffer.m_allocInfo.page;
-
     if (!m_memoryPageMappingFlags[page]) {
         throw std::system_error {ll::createErrorCode(ll::ErrorCode::MemoryMapFailed), "Memory page [" + std::to_string(page) + "] has not been mapped by any object."};
     }
 
+    // make host writes visible to the device
+    if (!isPageHostCoherent(page)) {
+        const auto range = vk::MappedMemoryRange {m_memoryPages[page], 0, VK_WHOLE_SIZE};
+        static_cast<void>(m_device->get().flushMappedMemoryRanges(1, &range));
+    }
+
     m_device->get().unmapMemory(m_memoryPages[page]);
 
     // set mapping flag for this page to unmapped
     m_memoryPageMappingFlags[page] = false;
 }
 
-std::shared_ptr<ll::Image> Memory::createImage(const ll::ImageDescriptor& descriptor)
+void* Memory::mapBuffer(const ll::Buffer& buffer)
 {
+    return mapPageRange(buffer.m_allocInfo.page, buffer.m_allocInfo.offset + buffer.m_allocInfo.leftPadding, buffer.m_allocInfo.size);
+}
 
-    ll::throwSystemErrorIf(descriptor.getWidth() == 0, ll::ErrorCode::InvalidArgument, "Image width must be greater than zero, got: " + std::to_string(descriptor.getWidth()));
-    ll::throwSystemErrorIf(descriptor.getHeight() == 0, ll::ErrorCode::InvalidArgument, "Image height must be greater than zero, got: " + std::to_string(descriptor.getHeight()));
-    ll::throwSystemErrorIf(descriptor.getDepth() == 0, ll::ErrorCode::InvalidArgument, "Image depth must be greater than zero, got: " + std::to_string(descriptor.getDepth()));
-
-    // checks if the combination of image shape, tiling and flags can be used.
-    ll::throwSystemErrorIf(!m_device->isImageDescriptorSupported(descriptor),
-        ll::ErrorCode::ObjectAllocationError,
-        "physical device does not support allocation of image objects with the provided "
-        "combination of shape, tiling and usageFlags.");
+void Memory::unmapBuffer(const ll::Buffer& buffer)
+{
+    unmapPage(buffer.m_allocInfo.page);
+}
 
-    auto imgInfo = vk::ImageCreateInfo {}
-                       .setExtent({descriptor.getWidth(), descriptor.getHeight(), descriptor.getDepth()})
-                       .setImageType(descriptor.getImageType())
-                       .setArrayLayers(1)
-                       .setMipLevels(1)
-                       .setTiling(ll::impl::toVkImageTiling(descriptor.getTiling()))
-                       .setSamples(vk::SampleCountFlagBits::e1)
-                       .setSharingMode(vk::SharingMode::eExclusive)
-                       .setUsage(ll::impl::toVkImageUsageFlags(descriptor.getUsageFlags()))
-                       .setFormat(descriptor.getFormat())
-                       .setInitialLayout(ll::impl::toVkImageLayout(InitialImageLayout));
+std::shared_ptr<ll::Image> Memory::createImage(const ll::ImageDescriptor& descriptor)
+{
 
-    auto vkImage = m_device->get().createImage(imgInfo);
+    auto vkImage = createVkImage(descriptor);
 
     // query alignment and offset
-    const auto memRequirements = m_device->get().getImageMemoryRequirements(vkImage);
+    auto dedicated       = false;
+    auto memRequirements = vk::MemoryRequirements {};
+
+    try {
+        memRequirements = getImageMemoryRequirements(vkImage, dedicated);
+    } catch (...) {
+        m_device->get().destroyImage(vkImage);
+        throw;
+    }
 
     // check that memRequirements.memoryTypeBits is supported in this memory
-    const auto memoryTypeBits = static_cast<uint32_t>(0x01 << m_heapInfo.typeIndex);
-    if ((memoryTypeBits & memRequirements.memoryTypeBits) == 0u) {
+    if ((getMemoryTypeBits() & memRequirements.memoryTypeBits) == 0u) {
 
         m_device->get().destroyImage(vkImage);
         throw std::system_error(createErrorCode(ll::ErrorCode::ObjectAllocationError), "memory " + std::to_string(m_heapInfo.typeIndex) + " does not support allocating image objects.");
     }
 
-    // find or create a new memory page where the image can be allocated
-    auto tryInfo = getSuitableMemoryPage(memRequirements);
+    // the dedicated page is owned by this call until the image is constructed
+    auto dedicatedPage = std::optional<uint32_t> {};
 
     try {
+        // find or create a new memory page where the image can be allocated
+        const auto tryInfo = dedicated ? getDedicatedMemoryPage(memRequirements, vk::MemoryDedicatedAllocateInfo {}.setImage(vkImage))
+                                       : getSuitableMemoryPage(memRequirements);
+
+        if (dedicated) {
+            dedicatedPage = tryInfo.allocInfo.page;
+        }
+
         const auto& memoryPage = m_memoryPages[tryInfo.allocInfo.page];
         m_device->get().bindImageMemory(vkImage, memoryPage, tryInfo.allocInfo.offset);
 
@@ -233,14 +639,25 @@ std::shared_ptr<ll::Image> Memory::createImage(const ll::ImageDescriptor& descri
             descriptor,
             shared_from_this(),
             tryInfo.allocInfo,
-            InitialImageLayout}};
+            getInitialImageLayout(descriptor)}};
 
         m_pageManagers[tryInfo.allocInfo.page].commitAllocation(tryInfo);
+
+        // the page is now released together with the image
+        dedicatedPage.reset();
+
+        pruneObjectRegistry();
+        m_images.push_back(image);
         return image;
 
     } catch (...) {
 
         m_device->get().destroyImage(vkImage);
+
+        if (dedicatedPage) {
+            releasePage(*dedicatedPage);
+        }
+
         throw; // rethrow
     }
 }
@@ -257,64 +674,422 @@ std::shared_ptr<ll::ImageView> Memory::createImageView(
 void Memory::releaseImage(const ll::Image& image)
 {
 
-    releaseMemoryAllocation(image.getAllocationInfo());
+    // destroy the image first as releasing the allocation can free its page
     m_device->get().destroyImage(image.m_vkImage);
+
+    // the memory of aliased images is released by their shared block
+    if (!image.isAliased()) {
+        releaseMemoryAllocation(image.getAllocationInfo());
+    }
 }
 
-impl::MemoryAllocationTryInfo Memory::getSuitableMemoryPage(const vk::MemoryRequirements& memRequirements)
+void* Memory::mapImage(const ll::Image& image)
 {
+    return mapPageRange(image.m_allocInfo.page, image.m_allocInfo.offset, image.m_allocInfo.size);
+}
 
-    auto tryInfo   = impl::MemoryAllocationTryInfo {};
-    auto pageIndex = 0u;
-    for (auto& manager : m_pageManagers) {
+void Memory::unmapImage(const ll::Image& image)
+{
+    unmapPage(image.m_allocInfo.page);
+}
 
-        if (manager.tryAllocate(memRequirements.size, memRequirements.alignment, tryInfo)) {
-            tryInfo.allocInfo.page = pageIndex;
-            manager.reserveManagerSpace();
-            return tryInfo;
-        }
+vk::Buffer Memory::createVkBuffer(const uint64_t size, const ll::BufferUsageFlags usageFlags)
+{
 
-        ++pageIndex;
-    }
+    const auto vkBufferUsageFlags = ll::impl::toVkBufferUsageFlags(usageFlags);
 
-    // None of the existing pages could allocate the object. Create a ne
-    // memory page and allocate the object in it.
+    vk::BufferCreateInfo bufferInfo = vk::BufferCreateInfo()
+                                          .setSharingMode(vk::SharingMode::eExclusive)
+                                          .setSize(size)
+                                          .setUsage(vkBufferUsageFlags)
+                                          .setQueueFamilyIndexCount(static_cast<uint32_t>(m_heapInfo.familyQueueIndices.size()))
+                                          .setPQueueFamilyIndices(m_heapInfo.familyQueueIndices.data());
 
-    // FIXME: Check for the availability of more device memory and see
-    // if it is possible to create a new vk::DeviceMemory object according
-    // to the physical device limits.
+    return m_device->get().createBuffer(bufferInfo);
+}
 
-    const auto newPageSize = std::max(m_pageSize, memRequirements.size);
+vk::Image Memory::createVkImage(const ll::ImageDescriptor& descriptor)
+{
 
-    // reserve space to store a new memory page and manager.
-    if (m_memoryPages.size() == m_memoryPages.capacity()) {
-        m_memoryPages.reserve(m_memoryPages.capacity() + CAPACITY_INCREASE);
-    }
+    ll::throwSystemErrorIf(descriptor.getWidth() == 0, ll::ErrorCode::InvalidArgument, "Image width must be greater than zero, got: " + std::to_string(descriptor.getWidth()));
+    ll::throwSystemErrorIf(descriptor.getHeight() == 0, ll::ErrorCode::InvalidArgument, "Image height must be greater than zero, got: " + std::to_string(descriptor.getHeight()));
+    ll::throwSystemErrorIf(descriptor.getDepth() == 0, ll::ErrorCode::InvalidArgument, "Image depth must be greater than zero, got: " + std::to_string(descriptor.getDepth()));
 
-    if (m_pageManagers.size() == m_pageManagers.capacity()) {
-        m_pageManagers.reserve(m_pageManagers.capacity() + CAPACITY_INCREASE);
-    }
+    // checks if the combination of image shape, tiling and flags can be used.
+    ll::throwSystemErrorIf(!m_device->isImageDescriptorSupported(descriptor),
+        ll::ErrorCode::ObjectAllocationError,
+        "physical device does not support allocation of image objects with the provided "
+        "combination of shape, tiling and usageFlags.");
 
-    if (m_memoryPageMappingFlags.size() == m_memoryPageMappingFlags.capacity()) {
-        m_memoryPageMappingFlags.reserve(m_memoryPageMappingFlags.capacity() + CAPACITY_INCREASE);
-    }
+    auto imgInfo = vk::ImageCreateInfo {}
+                       .setExtent({descriptor.getWidth(), descriptor.getHeight(), descriptor.getDepth()})
+                       .setImageType(descriptor.getImageType())
+                       .setArrayLayers(1)
+                       .setMipLevels(1)
+                       .setTiling(ll::impl::toVkImageTiling(descriptor.getTiling()))
+                       .setSamples(vk::SampleCountFlagBits::e1)
+                       .setSharingMode(vk::SharingMode::eExclusive)
+                       .setUsage(ll::impl::toVkImageUsageFlags(descriptor.getUsageFlags()))
+                       .setFormat(descriptor.getFormat())
+                       .setInitialLayout(ll::impl::toVkImageLayout(getInitialImageLayout(descriptor)));
 
-    vk::MemoryAllocateInfo allocateInfo = vk::MemoryAllocateInfo()
-                                              .setAllocationSize(newPageSize)
-                                              .setMemoryTypeIndex(m_heapInfo.typeIndex);
+    return m_device->get().createImage(imgInfo);
+}
+
+uint64_t Memory::aliasImages(const std::vector<std::shared_ptr<ll::Image>>& images,
+    const std::vector<std::pair<uint32_t, uint32_t>>&                       lifetimes)
+{
+
+    ll::throwSystemErrorIf(images.size() != lifetimes.size(), ll::ErrorCode::InvalidArgument,
+        "images and lifetimes must have the same size, got: " + std::to_string(images.size()) + " and " + std::to_string(lifetimes.size()));
+
+    for (auto i = size_t {0}; i < images.size(); ++i) {
+        ll::throwSystemErrorIf(images[i] == nullptr, ll::ErrorCode::InvalidArgument, "image cannot be null");
+        ll::throwSystemErrorIf(images[i]->m_memory.get() != this, ll::ErrorCode::InvalidArgument, "image is not allocated in this memory");
+        ll::throwSystemErrorIf(images[i]->isAliased(), ll::ErrorCode::InvalidArgument, "image is already aliased");
+        ll::throwSystemErrorIf(lifetimes[i].first > lifetimes[i].second, ll::ErrorCode::InvalidArgument,
+            "image lifetime first step (" + std::to_string(lifetimes[i].first) + ") must be less or equal than the last step (" + std::to_string(lifetimes[i].second) + ")");
+    }
+
+    if (images.empty()) {
+        return 0;
+    }
+
+    // create the new Vulkan images before touching the existing objects, so
+    // they are left in their original state if any creation fails.
+    auto vkImages = std::vector<vk::Image> {};
+    vkImages.reserve(images.size());
+
+    auto memRequirements = std::vector<vk::MemoryRequirements> {};
+    memRequirements.reserve(images.size());
+
+    auto destroyVkImages = [this, &vkImages]() {
+        for (auto& vkImage : vkImages) {
+            m_device->get().destroyImage(vkImage);
+        }
+    };
+
+    try {
+        for (const auto& image : images) {
+            vkImages.push_back(createVkImage(image->m_descriptor));
+            memRequirements.push_back(m_device->get().getImageMemoryRequirements(vkImages.back()));
+
+            ll::throwSystemErrorIf((getMemoryTypeBits() & memRequirements.back().memoryTypeBits) == 0u, ll::ErrorCode::ObjectAllocationError,
+                "memory " + std::to_string(m_heapInfo.typeIndex) + " does not support allocating image objects.");
+        }
+    } catch (...) {
+        destroyVkImages();
+        throw;
+    }
+
+    auto blockRequirements = vk::MemoryRequirements {};
+    const auto offsets     = impl::computeAliasedOffsets(memRequirements, lifetimes, blockRequirements);
+
+    auto tryInfo = impl::MemoryAllocationTryInfo {};
+
+    try {
+        tryInfo = getSuitableMemoryPage(blockRequirements);
+
+        const auto& memoryPage = m_memoryPages[tryInfo.allocInfo.page];
+        for (auto i = size_t {0}; i < vkImages.size(); ++i) {
+            m_device->get().bindImageMemory(vkImages[i], memoryPage, tryInfo.allocInfo.offset + offsets[i]);
+        }
+
+    } catch (...) {
+        destroyVkImages();
+        throw;
+    }
+
+    m_pageManagers[tryInfo.allocInfo.page].commitAllocation(tryInfo);
+    auto block = std::make_shared<impl::AliasedMemoryBlock>(shared_from_this(), tryInfo.allocInfo);
+
+    for (auto i = size_t {0}; i < images.size(); ++i) {
+
+        auto& image = *images[i];
+
+        const auto oldVkImage   = image.m_vkImage;
+        const auto oldAllocInfo = image.m_allocInfo;
+
+        image.m_vkImage      = vkImages[i];
+        image.m_allocInfo    = ll::MemoryAllocationInfo {tryInfo.allocInfo.offset + offsets[i], memRequirements[i].size, 0, tryInfo.allocInfo.page};
+        image.m_layout       = getInitialImageLayout(image.m_descriptor);
+        image.m_aliasedBlock = block;
+
+        // views must point to the new image before the old one is destroyed
+        image.recreateImageViews();
+
+        m_device->get().destroyImage(oldVkImage);
+        releaseMemoryAllocation(oldAllocInfo);
+    }
+
+    return blockRequirements.size;
+}
+
+void Memory::reshapeImage(ll::Image& image, const ll::vec3ui& shape)
+{
+
+    ll::throwSystemErrorIf(image.m_memory.get() != this, ll::ErrorCode::InvalidArgument, "image is not allocated in this memory");
+
+    const auto currentShape = image.getShape();
+    if (currentShape.x == shape.x && currentShape.y == shape.y && currentShape.z == shape.z) {
+        return;
+    }
+
+    auto descriptor = image.m_descriptor;
+    descriptor.setShape(shape);
+
+    auto vkImage = createVkImage(descriptor);
+
+    auto dedicated       = false;
+    auto memRequirements = vk::MemoryRequirements {};
+
+    try {
+        memRequirements = getImageMemoryRequirements(vkImage, dedicated);
+
+        ll::throwSystemErrorIf((getMemoryTypeBits() & memRequirements.memoryTypeBits) == 0u, ll::ErrorCode::ObjectAllocationError,
+            "memory " + std::to_string(m_heapInfo.typeIndex) + " does not support allocating image objects.");
+    } catch (...) {
+        m_device->get().destroyImage(vkImage);
+        throw;
+    }
+
+    const auto oldAllocInfo = image.m_allocInfo;
+
+    // the current allocation is kept if the new image fits in it. Dedicated
+    // pages are tied to the Vulkan image they were allocated for.
+    const auto reuseAllocation = !image.isAliased()
+        && !dedicated
+        && !m_memoryPageDedicatedFlags[oldAllocInfo.page]
+        && memRequirements.size <= oldAllocInfo.size
+        && (oldAllocInfo.offset % memRequirements.alignment) == 0
+        && (memRequirements.memoryTypeBits & (0x01u << m_memoryPageTypeIndices[oldAllocInfo.page])) != 0u;
+
+    auto allocInfo = oldAllocInfo;
+
+    try {
+        if (reuseAllocation) {
+            m_device->get().bindImageMemory(vkImage, m_memoryPages[oldAllocInfo.page], oldAllocInfo.offset);
+
+        } else {
+            const auto tryInfo = dedicated ? getDedicatedMemoryPage(memRequirements, vk::MemoryDedicatedAllocateInfo {}.setImage(vkImage))
+                                           : getSuitableMemoryPage(memRequirements);
+
+            m_device->get().bindImageMemory(vkImage, m_memoryPages[tryInfo.allocInfo.page], tryInfo.allocInfo.offset);
+            m_pageManagers[tryInfo.allocInfo.page].commitAllocation(tryInfo);
+
+            allocInfo = tryInfo.allocInfo;
+        }
+    } catch (...) {
+        m_device->get().destroyImage(vkImage);
+        throw;
+    }
+
+    const auto oldVkImage = image.m_vkImage;
+    const auto oldLayout  = image.m_layout;
+    const auto oldAliased = image.isAliased();
+
+    image.m_vkImage    = vkImage;
+    image.m_allocInfo  = allocInfo;
+    image.m_descriptor = descriptor;
+    image.m_layout     = getInitialImageLayout(descriptor);
+
+    // views must point to the new image before the old one is destroyed
+    image.recreateImageViews();
+
+    m_device->get().destroyImage(oldVkImage);
+
+    if (oldAliased) {
+        // the shared block is released once every image aliasing it moves out of it
+        image.m_aliasedBlock.reset();
+    } else if (!reuseAllocation) {
+        releaseMemoryAllocation(oldAllocInfo);
+    }
+
+    if (oldLayout != ll::ImageLayout::Undefined && oldLayout != ll::ImageLayout::Preinitialized) {
+        image.changeImageLayout(oldLayout);
+    }
+
+    rebindComputeNodes(image.m_boundNodes, image);
+}
+
+vk::MemoryRequirements Memory::getBufferMemoryRequirements(const vk::Buffer& vkBuffer, bool& dedicated) const
+{
+
+    dedicated = false;
+
+    if (!m_device->isDedicatedAllocationSupported()) {
+        return m_device->get().getBufferMemoryRequirements(vkBuffer);
+    }
+
+    const auto info  = vk::BufferMemoryRequirementsInfo2 {}.setBuffer(vkBuffer);
+    const auto chain = m_device->get().getBufferMemoryRequirements2<vk::MemoryRequirements2, vk::MemoryDedicatedRequirements>(info);
+
+    const auto& dedicatedRequirements = chain.get<vk::MemoryDedicatedRequirements>();
+    dedicated                         = dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation;
+
+    return chain.get<vk::MemoryRequirements2>().memoryRequirements;
+}
+
+vk::MemoryRequirements Memory::getImageMemoryRequirements(const vk::Image& vkImage, bool& dedicated) const
+{
+
+    dedicated = false;
+
+    if (!m_device->isDedicatedAllocationSupported()) {
+        return m_device->get().getImageMemoryRequirements(vkImage);
+    }
+
+    const auto info  = vk::ImageMemoryRequirementsInfo2 {}.setImage(vkImage);
+    const auto chain = m_device->get().getImageMemoryRequirements2<vk::MemoryRequirements2, vk::MemoryDedicatedRequirements>(info);
+
+    const auto& dedicatedRequirements = chain.get<vk::MemoryDedicatedRequirements>();
+    dedicated                         = dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation;
+
+    return chain.get<vk::MemoryRequirements2>().memoryRequirements;
+}
+
+uint32_t Memory::getMemoryTypeBits() const noexcept
+{
+
+    auto bits = static_cast<uint32_t>(0x01 << m_heapInfo.typeIndex);
+    for (const auto typeIndex : m_heapInfo.fallbackTypeIndices) {
+        bits |= static_cast<uint32_t>(0x01 << typeIndex);
+    }
+
+    return bits;
+}
+
+uint32_t Memory::allocatePage(const uint64_t size, const uint32_t memoryTypeBits, const void* allocateInfoNext, const bool dedicated)
+{
+
+    // reserve space to store a new memory page and manager.
+    if (m_memoryPages.size() == m_memoryPages.capacity()) {
+        m_memoryPages.reserve(m_memoryPages.capacity() + CAPACITY_INCREASE);
+    }
+
+    if (m_pageManagers.size() == m_pageManagers.capacity()) {
+        m_pageManagers.reserve(m_pageManagers.capacity() + CAPACITY_INCREASE);
+    }
+
+    if (m_memoryPageMappingFlags.size() == m_memoryPageMappingFlags.capacity()) {
+        m_memoryPageMappingFlags.reserve(m_memoryPageMappingFlags.capacity() + CAPACITY_INCREASE);
+    }
+
+    if (m_memoryPageDedicatedFlags.size() == m_memoryPageDedicatedFlags.capacity()) {
+        m_memoryPageDedicatedFlags.reserve(m_memoryPageDedicatedFlags.capacity() + CAPACITY_INCREASE);
+    }
+
+    if (m_memoryPageTypeIndices.size() == m_memoryPageTypeIndices.capacity()) {
+        m_memoryPageTypeIndices.reserve(m_memoryPageTypeIndices.capacity() + CAPACITY_INCREASE);
+    }
 
     // Safe to not try-catch the creation of manager and memory.
     // If exception is thrown, this object is left in its previous
     // state plus the reserved space in memoryPages and pageManagers.
-    auto manager = impl::MemoryFreeSpaceManager {newPageSize};
+    auto manager = impl::MemoryFreeSpaceManager {size};
     manager.reserveManagerSpace();
 
-    auto memory = m_device->get().allocateMemory(allocateInfo);
+    const auto memProperties = m_device->getPhysicalDevice().getMemoryProperties();
+    const auto budget        = m_device->isMemoryBudgetSupported() ? m_device->getMemoryBudgetProperties() : vk::PhysicalDeviceMemoryBudgetPropertiesEXT {};
+
+    auto typeIndices = std::vector<uint32_t> {m_heapInfo.typeIndex};
+    typeIndices.insert(typeIndices.end(), m_heapInfo.fallbackTypeIndices.cbegin(), m_heapInfo.fallbackTypeIndices.cend());
+
+    auto memory    = vk::DeviceMemory {};
+    auto typeIndex = uint32_t {0};
+
+    for (const auto candidateType : typeIndices) {
+
+        if ((memoryTypeBits & (0x01u << candidateType)) == 0u) {
+            continue;
+        }
+
+        // skip heaps without budget left instead of letting the driver fail or start paging
+        const auto heapIndex = memProperties.memoryTypes[candidateType].heapIndex;
+        if (m_device->isMemoryBudgetSupported() && budget.heapUsage[heapIndex] + size > budget.heapBudget[heapIndex]) {
+            continue;
+        }
+
+        const auto allocateInfo = vk::MemoryAllocateInfo {}
+                                      .setPNext(allocateInfoNext)
+                                      .setAllocationSize(size)
+                                      .setMemoryTypeIndex(candidateType);
+
+        try {
+            memory    = m_device->get().allocateMemory(allocateInfo);
+            typeIndex = candidateType;
+            break;
+
+        } catch (vk::OutOfDeviceMemoryError&) {
+            // try the next memory type
+        } catch (vk::OutOfHostMemoryError&) {
+            // try the next memory type
+        }
+    }
+
+    ll::throwSystemErrorIf(!memory, ll::ErrorCode::OutOfMemory,
+        "no memory type matching flags " + std::to_string(static_cast<uint32_t>(m_heapInfo.flags)) + " can allocate a new page of " + std::to_string(size) + " bytes.");
+
+    // reuse the slot of a page released by trim(), if any
+    const auto freeSlot = std::find_if(m_memoryPages.cbegin(), m_memoryPages.cend(),
+        [](const auto& page) { return !page; });
+
+    const auto pageIndex = static_cast<uint32_t>(std::distance(m_memoryPages.cbegin(), freeSlot));
+
+    if (freeSlot != m_memoryPages.cend()) {
+        m_memoryPages[pageIndex]              = memory;
+        m_pageManagers[pageIndex]             = std::move(manager);
+        m_memoryPageMappingFlags[pageIndex]   = false;
+        m_memoryPageDedicatedFlags[pageIndex] = dedicated;
+        m_memoryPageTypeIndices[pageIndex]    = typeIndex;
+    } else {
+        // push objects to vectors after reserving space
+        m_memoryPages.push_back(memory);
+        m_pageManagers.push_back(std::move(manager));
+        m_memoryPageMappingFlags.push_back(false);
+        m_memoryPageDedicatedFlags.push_back(dedicated);
+        m_memoryPageTypeIndices.push_back(typeIndex);
+    }
+
+    return pageIndex;
+}
+
+void Memory::releasePage(const uint32_t page)
+{
+
+    m_device->get().freeMemory(m_memoryPages[page]);
+
+    m_memoryPages[page]              = vk::DeviceMemory {};
+    m_pageManagers[page]             = impl::MemoryFreeSpaceManager {};
+    m_memoryPageDedicatedFlags[page] = false;
+}
+
+impl::MemoryAllocationTryInfo Memory::getSuitableMemoryPage(const vk::MemoryRequirements& memRequirements)
+{
+
+    auto tryInfo   = impl::MemoryAllocationTryInfo {};
+    auto pageIndex = 0u;
+    for (auto& manager : m_pageManagers) {
+
+        // released pages have an empty manager and never succeed. Dedicated
+        // pages and pages of memory types the object cannot use are skipped.
+        const auto typeBit = 0x01u << m_memoryPageTypeIndices[pageIndex];
+
+        if (!m_memoryPageDedicatedFlags[pageIndex] && (memRequirements.memoryTypeBits & typeBit) != 0u
+            && manager.tryAllocate(memRequirements.size, memRequirements.alignment, tryInfo)) {
+            tryInfo.allocInfo.page = pageIndex;
+            manager.reserveManagerSpace();
+            return tryInfo;
+        }
+
+        ++pageIndex;
+    }
+
+    // None of the existing pages could allocate the object. Create a new
+    // memory page and allocate the object in it.
+    const auto newPageSize = std::max(m_pageSize, memRequirements.size);
 
-    // push objects to vectors after reserving space
-    m_memoryPages.push_back(memory);
-    m_pageManagers.push_back(std::move(manager));
-    m_memoryPageMappingFlags.push_back(false);
+    pageIndex = allocatePage(newPageSize, memRequirements.memoryTypeBits, nullptr, false);
 
     // this allocation try is guaranteed to work as there is enough
     // free space in the page to fit memRequirements.size.
@@ -324,6 +1099,19 @@ impl::MemoryAllocationTryInfo Memory::getSuitableMemoryPage(const vk::MemoryRequ
     return tryInfo;
 }
 
+impl::MemoryAllocationTryInfo Memory::getDedicatedMemoryPage(const vk::MemoryRequirements& memRequirements, const vk::MemoryDedicatedAllocateInfo& dedicatedInfo)
+{
+
+    const auto pageIndex = allocatePage(memRequirements.size, memRequirements.memoryTypeBits, &dedicatedInfo, true);
+
+    // the page holds exactly the object, at offset zero
+    auto tryInfo = impl::MemoryAllocationTryInfo {};
+    m_pageManagers[pageIndex].tryAllocate(memRequirements.size, tryInfo);
+    tryInfo.allocInfo.page = pageIndex;
+
+    return tryInfo;
+}
+
 void Memory::releaseMemoryAllocation(const ll::MemoryAllocationInfo& allocInfo)
 {
 
@@ -336,6 +1124,323 @@ void Memory::releaseMemoryAllocation(const ll::MemoryAllocationInfo& allocInfo)
     // should throw and exception and abort the program (since it is
     // declared as noexcept).
     m_pageManagers[allocInfo.page].release(allocInfo);
+
+    // dedicated allocations cannot hold any other object
+    if (m_memoryPageDedicatedFlags[allocInfo.page]) {
+        releasePage(allocInfo.page);
+        return;
+    }
+
+    // hysteresis: only release pages once the empty ones exceed the high threshold,
+    // and then keep up to the low threshold for later allocations.
+    if (m_isAutoTrimEnabled && m_pageManagers[allocInfo.page].isEmpty()
+        && getEmptyPagesSize() > m_autoTrimHighThreshold) {
+
+        releaseEmptyPages(m_autoTrimLowThreshold);
+    }
+}
+
+uint64_t Memory::getEmptyPagesSize() const noexcept
+{
+
+    auto size = uint64_t {0};
+    for (auto page = 0u; page < m_memoryPages.size(); ++page) {
+        if (m_memoryPages[page] && m_pageManagers[page].isEmpty()) {
+            size += m_pageManagers[page].getSize();
+        }
+    }
+
+    return size;
+}
+
+uint64_t Memory::releaseEmptyPages(const uint64_t keepSize)
+{
+
+    auto emptySize    = getEmptyPagesSize();
+    auto releasedSize = uint64_t {0};
+
+    // release the pages at the end first, so that new pages are
+    // created at the lowest available indices.
+    for (auto page = static_cast<uint32_t>(m_memoryPages.size()); page > 0 && emptySize > keepSize; --page) {
+
+        const auto index = page - 1;
+
+        if (!m_memoryPages[index] || !m_pageManagers[index].isEmpty() || m_memoryPageMappingFlags[index]) {
+            continue;
+        }
+
+        const auto pageSize = m_pageManagers[index].getSize();
+
+        releasePage(index);
+
+        emptySize -= pageSize;
+        releasedSize += pageSize;
+    }
+
+    return releasedSize;
+}
+
+ll::MemoryDefragmentationResult Memory::defragment(const uint64_t maxBytes, const uint64_t maxMicroseconds)
+{
+
+    const auto start      = std::chrono::steady_clock::now();
+    const auto byteBudget = maxBytes == 0 ? std::numeric_limits<uint64_t>::max() : maxBytes;
+
+    auto result = ll::MemoryDefragmentationResult {0, 0, true};
+
+    auto isSparse = [this](const uint32_t page) {
+        const auto& manager = m_pageManagers[page];
+        return !manager.isEmpty() && manager.getUsedSize() <= manager.getSize() / 2;
+    };
+
+    auto sparsePages = std::vector<uint32_t> {};
+    for (auto page = 0u; page < m_memoryPages.size(); ++page) {
+        if (m_memoryPages[page] && !m_memoryPageMappingFlags[page] && !m_memoryPageDedicatedFlags[page] && isSparse(page)) {
+            sparsePages.push_back(page);
+        }
+    }
+
+    // evacuate the least used pages first, as they need the fewest copies to become empty
+    std::stable_sort(sparsePages.begin(), sparsePages.end(), [this](const auto a, const auto b) {
+        return m_pageManagers[a].getUsedSize() < m_pageManagers[b].getUsedSize();
+    });
+
+    // objects can be moved to any shared page not evacuated already
+    auto allowedPages = std::vector<bool>(m_memoryPages.size(), true);
+    for (auto page = 0u; page < m_memoryPages.size(); ++page) {
+        allowedPages[page] = !m_memoryPageDedicatedFlags[page];
+    }
+
+    for (const auto page : sparsePages) {
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if (maxMicroseconds != 0 && static_cast<uint64_t>(elapsed) >= maxMicroseconds) {
+            result.complete = false;
+            break;
+        }
+
+        allowedPages[page] = false;
+
+        // the page may have received objects from the pages evacuated before
+        if (!isSparse(page)) {
+            continue;
+        }
+
+        auto budgetReached = false;
+        result.movedBytes += defragmentPage(page, allowedPages, byteBudget - result.movedBytes, result.movedObjects, budgetReached);
+
+        if (budgetReached) {
+            result.complete = false;
+            break;
+        }
+    }
+
+    return result;
+}
+
+bool Memory::tryAllocateInPages(const vk::MemoryRequirements& memRequirements,
+    const std::vector<bool>&                                  allowedPages,
+    impl::MemoryAllocationTryInfo&                            tryInfo)
+{
+
+    for (auto page = 0u; page < allowedPages.size(); ++page) {
+
+        auto&      manager = m_pageManagers[page];
+        const auto typeBit = 0x01u << m_memoryPageTypeIndices[page];
+
+        if (allowedPages[page] && (memRequirements.memoryTypeBits & typeBit) != 0u
+            && manager.tryAllocate(memRequirements.size, memRequirements.alignment, tryInfo)) {
+            tryInfo.allocInfo.page = page;
+            manager.reserveManagerSpace();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64_t Memory::defragmentPage(const uint32_t page, const std::vector<bool>& allowedPages,
+    const uint64_t maxBytes, uint32_t& movedObjects, bool& budgetReached)
+{
+
+    const auto bufferTransferFlags = ll::BufferUsageFlagBits::TransferSrc | ll::BufferUsageFlagBits::TransferDst;
+    const auto imageTransferFlags  = ll::ImageUsageFlagBits::TransferSrc | ll::ImageUsageFlagBits::TransferDst;
+
+    // live objects of the page that can be copied with transfer commands
+    auto candidates = std::vector<impl::Relocation> {};
+
+    for (const auto& weakBuffer : m_buffers) {
+        auto buffer = weakBuffer.lock();
+        if (buffer != nullptr && buffer->m_allocInfo.page == page
+            && (buffer->m_usageFlags & bufferTransferFlags) == bufferTransferFlags) {
+            candidates.push_back(impl::Relocation {std::move(buffer), nullptr, nullptr, nullptr, {}});
+        }
+    }
+
+    for (const auto& weakImage : m_images) {
+        auto image = weakImage.lock();
+        if (image != nullptr && image->m_allocInfo.page == page && !image->isAliased()
+            && (image->getUsageFlags() & imageTransferFlags) == imageTransferFlags) {
+            candidates.push_back(impl::Relocation {nullptr, std::move(image), nullptr, nullptr, {}});
+        }
+    }
+
+    auto allocationSize = [](const impl::Relocation& r) {
+        return r.buffer != nullptr ? r.buffer->m_allocInfo.size : r.image->m_allocInfo.size;
+    };
+
+    // larger objects first, they are the hardest to fit
+    std::stable_sort(candidates.begin(), candidates.end(), [&allocationSize](const auto& a, const auto& b) {
+        return allocationSize(a) > allocationSize(b);
+    });
+
+    auto relocations = std::vector<impl::Relocation> {};
+    relocations.reserve(candidates.size());
+
+    auto undoRelocations = [this, &relocations]() {
+        for (auto& r : relocations) {
+            if (r.buffer != nullptr) {
+                m_device->get().destroyBuffer(r.vkBuffer);
+            } else {
+                m_device->get().destroyImage(r.vkImage);
+            }
+
+            releaseMemoryAllocation(r.tryInfo.allocInfo);
+        }
+    };
+
+    auto movedBytes = uint64_t {0};
+
+    try {
+
+        for (auto& candidate : candidates) {
+
+            const auto size = allocationSize(candidate);
+            if (size > maxBytes - movedBytes) {
+                budgetReached = true;
+                break;
+            }
+
+            auto memRequirements = vk::MemoryRequirements {};
+
+            if (candidate.buffer != nullptr) {
+                candidate.vkBuffer = createVkBuffer(candidate.buffer->getSize(), candidate.buffer->m_usageFlags);
+                memRequirements    = m_device->get().getBufferMemoryRequirements(candidate.vkBuffer);
+            } else {
+                candidate.vkImage = createVkImage(candidate.image->m_descriptor);
+                memRequirements   = m_device->get().getImageMemoryRequirements(candidate.vkImage);
+            }
+
+            // objects that do not fit in any other page stay where they are
+            if (!tryAllocateInPages(memRequirements, allowedPages, candidate.tryInfo)) {
+                if (candidate.buffer != nullptr) {
+                    m_device->get().destroyBuffer(candidate.vkBuffer);
+                } else {
+                    m_device->get().destroyImage(candidate.vkImage);
+                }
+                continue;
+            }
+
+            const auto& memoryPage = m_memoryPages[candidate.tryInfo.allocInfo.page];
+            m_pageManagers[candidate.tryInfo.allocInfo.page].commitAllocation(candidate.tryInfo);
+            relocations.push_back(candidate);
+
+            if (candidate.buffer != nullptr) {
+                m_device->get().bindBufferMemory(candidate.vkBuffer, memoryPage, candidate.tryInfo.allocInfo.offset);
+            } else {
+                m_device->get().bindImageMemory(candidate.vkImage, memoryPage, candidate.tryInfo.allocInfo.offset);
+            }
+
+            movedBytes += size;
+        }
+
+        if (relocations.empty()) {
+            return 0;
+        }
+
+        auto cmdBuffer = m_device->createCommandBuffer();
+        cmdBuffer->begin();
+
+        for (const auto& r : relocations) {
+            impl::recordRelocationCopy(cmdBuffer->getVkCommandBuffer(), r);
+        }
+
+        cmdBuffer->end();
+        m_device->run(*cmdBuffer);
+
+    } catch (...) {
+        undoRelocations();
+        throw;
+    }
+
+    // the copies are complete, replace the Vulkan objects and release their previous locations
+    for (auto& r : relocations) {
+
+        if (r.buffer != nullptr) {
+
+            const auto oldVkBuffer  = r.buffer->m_vkBuffer;
+            const auto oldAllocInfo = r.buffer->m_allocInfo;
+
+            r.buffer->m_vkBuffer  = r.vkBuffer;
+            r.buffer->m_allocInfo = r.tryInfo.allocInfo;
+
+            // views must point to the new buffer before the old one is destroyed
+            r.buffer->recreateBufferViews();
+
+            m_device->get().destroyBuffer(oldVkBuffer);
+            releaseMemoryAllocation(oldAllocInfo);
+
+            rebindComputeNodes(r.buffer->m_boundNodes, *r.buffer);
+
+        } else {
+
+            const auto oldVkImage   = r.image->m_vkImage;
+            const auto oldAllocInfo = r.image->m_allocInfo;
+
+            r.image->m_vkImage   = r.vkImage;
+            r.image->m_allocInfo = r.tryInfo.allocInfo;
+
+            if (r.image->m_layout == ll::ImageLayout::Preinitialized) {
+                r.image->m_layout = ll::ImageLayout::General;
+            }
+
+            r.image->recreateImageViews();
+
+            m_device->get().destroyImage(oldVkImage);
+            releaseMemoryAllocation(oldAllocInfo);
+
+            rebindComputeNodes(r.image->m_boundNodes, *r.image);
+        }
+    }
+
+    movedObjects += static_cast<uint32_t>(relocations.size());
+    return movedBytes;
+}
+
+void Memory::rebindComputeNodes(std::vector<std::weak_ptr<ll::ComputeNode>>& nodes, const ll::Object& obj) const
+{
+
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const auto& node) { return node.expired(); }), nodes.end());
+
+    for (const auto& weakNode : nodes) {
+        if (auto node = weakNode.lock()) {
+            node->rebind(obj);
+        }
+    }
+}
+
+void Memory::pruneObjectRegistry()
+{
+
+    // pruning only before the vectors grow keeps registering objects amortized constant time
+    auto prune = [](auto& objects) {
+        if (objects.size() == objects.capacity()) {
+            objects.erase(std::remove_if(objects.begin(), objects.end(), [](const auto& obj) { return obj.expired(); }), objects.end());
+        }
+    };
+
+    prune(m_buffers);
+    prune(m_images);
 }
 
 } // namespace ll
@@ -7,6 +7,7 @@
 
 #include "lluvia/core/memory/MemoryFreeSpaceManager.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace ll {
@@ -46,6 +47,23 @@ namespace impl {
         return m_offsetVector.size();
     }
 
+    uint64_t MemoryFreeSpaceManager::getUsedSize() const noexcept
+    {
+        return m_usedSize;
+    }
+
+    uint64_t MemoryFreeSpaceManager::getLargestFreeSize() const noexcept
+    {
+
+        const auto it = std::max_element(m_sizeVector.cbegin(), m_sizeVector.cend());
+        return it == m_sizeVector.cend() ? 0 : *it;
+    }
+
+    bool MemoryFreeSpaceManager::isEmpty() const noexcept
+    {
+        return m_usedSize == 0;
+    }
+
     const std::vector<uint64_t>& MemoryFreeSpaceManager::getOffsetVector() const noexcept
     {
         return m_offsetVector;
@@ -102,6 +120,8 @@ namespace impl {
         infoLocal.offset -= infoLocal.leftPadding;
         infoLocal.size += infoLocal.leftPadding;
 
+        m_usedSize -= infoLocal.size;
+
         const auto offsetPlusSize    = infoLocal.offset + infoLocal.size;
         auto       intervalUpdated   = false;
         auto       lowerBoundUpdated = true;
@@ -277,6 +297,8 @@ namespace impl {
         // update offset and size of [index] block
         m_offsetVector[tryInfo.index] += sizePlusAlignment;
         m_sizeVector[tryInfo.index] -= sizePlusAlignment;
+
+        m_usedSize += sizePlusAlignment;
     }
 
 } // namespace impl
@@ -12,30 +12,66 @@
 #include "lluvia/core/Object.h"
 #include "lluvia/core/Program.h"
 #include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/buffer/BufferView.h"
 #include "lluvia/core/error.h"
 #include "lluvia/core/image/Image.h"
 #include "lluvia/core/image/ImageView.h"
+#include "lluvia/core/impl/CommandTrace.h"
+#include "lluvia/core/impl/ObjectShape.h"
 #include "lluvia/core/node/ComputeNodeDescriptor.h"
+#include "lluvia/core/node/NodeBuilder.h"
+#include "lluvia/core/node/ParameterBlock.h"
 #include "lluvia/core/node/PushConstants.h"
+#include "lluvia/core/node/SpecializationConstants.h"
 
 #include "lluvia/core/vulkan/Device.h"
 
 #include <algorithm>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 namespace ll {
 
 using namespace std;
 
+namespace impl {
+
+    void registerBoundNode(std::vector<std::weak_ptr<ll::ComputeNode>>& nodes, const std::weak_ptr<ll::ComputeNode>& node)
+    {
+
+        // nodes not owned by a shared pointer cannot be tracked
+        const auto nodePtr = node.lock();
+        if (nodePtr == nullptr) {
+            return;
+        }
+
+        nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const auto& n) { return n.expired(); }), nodes.end());
+
+        const auto isRegistered = std::any_of(nodes.cbegin(), nodes.cend(), [&nodePtr](const auto& n) { return n.lock() == nodePtr; });
+        if (!isRegistered) {
+            nodes.push_back(node);
+        }
+    }
+
+    bool isDynamicPortType(const ll::PortType portType) noexcept
+    {
+        return portType == ll::PortType::UniformBufferDynamic || portType == ll::PortType::StorageBufferDynamic;
+    }
+
+} // namespace impl
+
 ComputeNode::ComputeNode(const std::shared_ptr<ll::vulkan::Device>& device,
     const ll::ComputeNodeDescriptor&                                descriptor,
-    const std::weak_ptr<ll::Interpreter>&                           interpreter)
+    const std::weak_ptr<ll::Interpreter>&                           interpreter,
+    const std::shared_ptr<ll::ComputeNodeBuilder>&                  builder)
     :
 
     m_device {device}
     , m_descriptor {descriptor}
+    , m_objects(descriptor.getPortCount())
     , m_interpreter {interpreter}
+    , m_builder {builder}
 {
 
     ll::throwSystemErrorIf(m_descriptor.getProgram() == nullptr, ll::ErrorCode::InvalidShaderProgram, "Shader program cannot be null.");
@@ -43,6 +79,31 @@ ComputeNode::ComputeNode(const std::shared_ptr<ll::vulkan::Device>& device,
     ll::throwSystemErrorIf(m_descriptor.getLocalX() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor local shape X must be greater than zero");
     ll::throwSystemErrorIf(m_descriptor.getLocalY() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor local shape Y must be greater than zero");
     ll::throwSystemErrorIf(m_descriptor.getLocalZ() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor local shape Z must be greater than zero");
+    ll::throwSystemErrorIf(m_descriptor.getDescriptorSetCount() == 0, ll::ErrorCode::InvalidArgument, "descriptor set count must be greater than zero");
+
+    if (m_descriptor.isIndirectDispatchEnabled()) {
+        const auto& indirectPort = m_descriptor.getPort(m_descriptor.getIndirectDispatchPort());
+        ll::throwSystemErrorIf(indirectPort.getPortType() != ll::PortType::Buffer, ll::ErrorCode::PortBindingError,
+            "indirect dispatch port [" + indirectPort.getName() + "] must be of type ll::PortType::Buffer");
+    }
+
+    initPortBindings();
+}
+
+ComputeNode::ComputeNode(const std::shared_ptr<const ll::ComputeNode>& prototype)
+    :
+
+    m_device {prototype->m_device}
+    , m_descriptorSetLayout {prototype->m_descriptorSetLayout}
+    , m_pipelineLayout {prototype->m_pipelineLayout}
+    , m_pipeline {prototype->m_pipeline}
+    , m_descriptor {prototype->m_descriptor}
+    , m_objects(prototype->m_objects.size())
+    , m_interpreter {prototype->m_interpreter}
+    , m_builder {prototype->m_builder}
+    , m_prototype {prototype}
+    , m_globalShape {prototype->m_globalShape}
+{
 
     initPortBindings();
 }
@@ -50,10 +111,14 @@ ComputeNode::ComputeNode(const std::shared_ptr<ll::vulkan::Device>& device,
 ComputeNode::~ComputeNode()
 {
 
-    m_device->get().destroyPipeline(m_pipeline, nullptr);
-    m_device->get().destroyPipelineLayout(m_pipelineLayout, nullptr);
     m_device->get().destroyDescriptorPool(m_descriptorPool, nullptr);
-    m_device->get().destroyDescriptorSetLayout(m_descriptorSetLayout);
+
+    // instances share the pipeline and layouts of their prototype
+    if (m_prototype == nullptr) {
+        m_device->get().destroyPipeline(m_pipeline, nullptr);
+        m_device->get().destroyPipelineLayout(m_pipelineLayout, nullptr);
+        m_device->get().destroyDescriptorSetLayout(m_descriptorSetLayout);
+    }
 }
 
 void ComputeNode::initPortBindings()
@@ -64,38 +129,51 @@ void ComputeNode::initPortBindings()
     /////////////////////////////////////////////
     // Descriptor pool and descriptor set
     /////////////////////////////////////////////
-    auto descLayoutInfo = vk::DescriptorSetLayoutCreateInfo()
-                              .setBindingCount(static_cast<uint32_t>(m_parameterBindings.size()))
-                              .setPBindings(m_parameterBindings.data());
+    if (m_prototype == nullptr) {
+
+        auto descLayoutInfo = vk::DescriptorSetLayoutCreateInfo()
+                                  .setBindingCount(static_cast<uint32_t>(m_parameterBindings.size()))
+                                  .setPBindings(m_parameterBindings.data());
 
-    m_descriptorSetLayout = m_device->get().createDescriptorSetLayout(descLayoutInfo);
+        m_descriptorSetLayout = m_device->get().createDescriptorSetLayout(descLayoutInfo);
+    }
 
-    auto descriptorPoolSizes      = getDescriptorPoolSizes();
-    auto descriptorPoolCreateInfo = vk::DescriptorPoolCreateInfo()
-                                        .setMaxSets(1)
-                                        .setPoolSizeCount(static_cast<uint32_t>(descriptorPoolSizes.size()))
-                                        .setPPoolSizes(descriptorPoolSizes.data());
+    const auto descriptorSetCount       = m_descriptor.getDescriptorSetCount();
+    auto       descriptorPoolSizes      = getDescriptorPoolSizes();
+    auto       descriptorPoolCreateInfo = vk::DescriptorPoolCreateInfo()
+                                              .setMaxSets(descriptorSetCount)
+                                              .setPoolSizeCount(static_cast<uint32_t>(descriptorPoolSizes.size()))
+                                              .setPPoolSizes(descriptorPoolSizes.data());
 
     if (const auto errCode = m_device->get().createDescriptorPool(&descriptorPoolCreateInfo, nullptr, &m_descriptorPool); errCode != vk::Result::eSuccess) {
 
         // free previously allocated resources
-        m_device->get().destroyDescriptorSetLayout(m_descriptorSetLayout);
+        if (m_prototype == nullptr) {
+            m_device->get().destroyDescriptorSetLayout(m_descriptorSetLayout);
+        }
 
         // then throw system error
         ll::throwSystemError(ll::ErrorCode::VulkanError, "error creating descriptor pool for compute node (" + vk::to_string(errCode) + ")");
     }
 
-    // only one descriptor set for this Node object
+    // one descriptor set per frame in flight, all with the same layout
+    const auto setLayouts = std::vector<vk::DescriptorSetLayout>(descriptorSetCount, m_descriptorSetLayout);
+
     vk::DescriptorSetAllocateInfo descSetAllocInfo = vk::DescriptorSetAllocateInfo()
                                                          .setDescriptorPool(m_descriptorPool)
-                                                         .setDescriptorSetCount(1)
-                                                         .setPSetLayouts(&m_descriptorSetLayout);
+                                                         .setDescriptorSetCount(descriptorSetCount)
+                                                         .setPSetLayouts(setLayouts.data());
+
+    m_descriptorSets.resize(descriptorSetCount);
+    m_outdatedPorts.resize(descriptorSetCount);
 
-    if (const auto errCode = m_device->get().allocateDescriptorSets(&descSetAllocInfo, &m_descriptorSet); errCode != vk::Result::eSuccess) {
+    if (const auto errCode = m_device->get().allocateDescriptorSets(&descSetAllocInfo, m_descriptorSets.data()); errCode != vk::Result::eSuccess) {
 
         // free previously allocated resources
         m_device->get().destroyDescriptorPool(m_descriptorPool, nullptr);
-        m_device->get().destroyDescriptorSetLayout(m_descriptorSetLayout);
+        if (m_prototype == nullptr) {
+            m_device->get().destroyDescriptorSetLayout(m_descriptorSetLayout);
+        }
 
         ll::throwSystemError(ll::ErrorCode::VulkanError, "error allocating descriptor set (" + vk::to_string(errCode) + ")");
     }
@@ -113,12 +191,20 @@ void ComputeNode::initPipeline()
                 {2, 1 * size, size},
                 {3, 2 * size, size}};
 
-    auto localShape         = m_descriptor.getLocalShape();
+    const auto localShape         = m_descriptor.getLocalShape();
+    auto       specializationData = vector<uint32_t> {localShape.x, localShape.y, localShape.z};
+
+    // user defined constants, starting at LL_SPECIALIZATION_BEGIN
+    for (const auto& [id, value] : m_descriptor.getSpecializationConstants().getValues()) {
+        specializationMapEntries.push_back({id, static_cast<uint32_t>(specializationData.size() * size), size});
+        specializationData.push_back(value.data);
+    }
+
     auto specializationInfo = vk::SpecializationInfo()
-                                  .setMapEntryCount(static_cast<int>(specializationMapEntries.size()))
+                                  .setMapEntryCount(static_cast<uint32_t>(specializationMapEntries.size()))
                                   .setPMapEntries(specializationMapEntries.data())
-                                  .setDataSize(sizeof(ll::vec3ui))
-                                  .setPData(&localShape);
+                                  .setDataSize(specializationData.size() * size)
+                                  .setPData(specializationData.data());
 
     auto stageInfo = vk::PipelineShaderStageCreateInfo()
                          .setStage(vk::ShaderStageFlagBits::eCompute)
@@ -137,8 +223,9 @@ void ComputeNode::initPipeline()
     // Push constants
     auto pushConstantRanges = std::vector<vk::PushConstantRange> {};
 
+    // in parameter-block mode, the constants are read from a uniform buffer
     const auto& pushConstants = m_descriptor.getPushConstants();
-    if (pushConstants.getSize() > 0) {
+    if (pushConstants.getSize() > 0 && !m_descriptor.isParameterBlockEnabled()) {
         auto range = vk::PushConstantRange()
                          .setOffset(0)
                          .setSize(static_cast<uint32_t>(pushConstants.getSize()))
@@ -152,12 +239,15 @@ void ComputeNode::initPipeline()
     /////////////////////////////////////////////
 
     m_pipelineLayout                              = m_device->get().createPipelineLayout(pipeLayoutInfo);
+
+    // eDispatchBase allows recording the node with a non-zero grid offset
     vk::ComputePipelineCreateInfo computePipeInfo = vk::ComputePipelineCreateInfo()
+                                                        .setFlags(vk::PipelineCreateFlagBits::eDispatchBase)
                                                         .setStage(stageInfo)
                                                         .setLayout(m_pipelineLayout);
 
     // create the compute pipeline
-    auto result = m_device->get().createComputePipeline(nullptr, computePipeInfo);
+    auto result = m_device->get().createComputePipeline(m_device->getPipelineCache(), computePipeInfo);
     ll::throwSystemErrorIf(result.result != vk::Result::eSuccess, ll::ErrorCode ::PipelineCreationError, "error creating vulkan compute pipeline for node.");
 
     m_pipeline = result.value;
@@ -211,6 +301,7 @@ uint32_t ComputeNode::getGridX() const noexcept
 void ComputeNode::setGridX(const uint32_t x) noexcept
 {
     m_descriptor.setGridX(x);
+    m_globalShape = ll::vec3ui {};
 }
 
 uint32_t ComputeNode::getGridY() const noexcept
@@ -221,6 +312,7 @@ uint32_t ComputeNode::getGridY() const noexcept
 void ComputeNode::setGridY(const uint32_t y) noexcept
 {
     m_descriptor.setGridY(y);
+    m_globalShape = ll::vec3ui {};
 }
 
 uint32_t ComputeNode::getGridZ() const noexcept
@@ -231,16 +323,54 @@ uint32_t ComputeNode::getGridZ() const noexcept
 void ComputeNode::setGridZ(const uint32_t z) noexcept
 {
     m_descriptor.setGridZ(z);
+    m_globalShape = ll::vec3ui {};
 }
 
 void ComputeNode::setGridShape(const ll::vec3ui& shape) noexcept
 {
     m_descriptor.setGridShape(shape);
+    m_globalShape = ll::vec3ui {};
 }
 
 void ComputeNode::configureGridShape(const ll::vec3ui& globalShape) noexcept
 {
     m_descriptor.configureGridShape(globalShape);
+    m_globalShape = globalShape;
+}
+
+void ComputeNode::scaleGridShape()
+{
+
+    const auto portCount = std::min(m_objects.size(), m_initPortShapes.size());
+
+    for (auto index = size_t {0}; index < portCount; ++index) {
+
+        const auto  image    = impl::getObjectImage(m_objects[index]);
+        const auto& oldShape = m_initPortShapes[index];
+
+        // ports bound to images after init give no reference
+        if (image == nullptr || oldShape.x == 0) {
+            continue;
+        }
+
+        if (image->getWidth() == oldShape.x && image->getHeight() == oldShape.y) {
+            continue;
+        }
+
+        auto globalShape = m_globalShape;
+        if (globalShape.x == 0 || globalShape.y == 0 || globalShape.z == 0) {
+            globalShape = ll::vec3ui {m_descriptor.getGridX() * m_descriptor.getLocalX(),
+                m_descriptor.getGridY() * m_descriptor.getLocalY(),
+                m_descriptor.getGridZ() * m_descriptor.getLocalZ()};
+        }
+
+        // grids not derived from the reference keep their shape
+        if (const auto scaledShape = impl::scaleShape(globalShape, oldShape, image->getShape())) {
+            configureGridShape(*scaledShape);
+        }
+
+        return;
+    }
 }
 
 ll::vec3ui ComputeNode::getGridShape() const noexcept
@@ -248,25 +378,68 @@ ll::vec3ui ComputeNode::getGridShape() const noexcept
     return m_descriptor.getGridShape();
 }
 
+uint32_t ComputeNode::getStencilRadius() const noexcept
+{
+    return m_descriptor.getStencilRadius();
+}
+
+void ComputeNode::setGridOffset(const ll::vec3ui& offset) noexcept
+{
+    m_descriptor.setGridOffset(offset);
+}
+
+void ComputeNode::configureGridRegion(const ll::vec3ui& globalOffset, const ll::vec3ui& globalShape)
+{
+    m_descriptor.configureGridRegion(globalOffset, globalShape);
+}
+
+ll::vec3ui ComputeNode::getGridOffset() const noexcept
+{
+    return m_descriptor.getGridOffset();
+}
+
 bool ComputeNode::hasPort(const std::string& name) const noexcept
 {
 
-    const auto it = m_objects.find(name);
-    return it != m_objects.cend();
+    if (!m_descriptor.hasPort(name)) {
+        return false;
+    }
+
+    return m_objects[m_descriptor.getPortIndex(name)] != nullptr;
 }
 
 std::shared_ptr<ll::Object> ComputeNode::getPort(const std::string& name) const
+{
+    return getPort(m_descriptor.getPortIndex(name));
+}
+
+std::shared_ptr<ll::Object> ComputeNode::getPort(const uint32_t index) const
 {
 
-    const auto it = m_objects.find(name);
-    ll::throwSystemErrorIf(it == m_objects.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
+    if (index >= m_objects.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port index [" + std::to_string(index) + "] out of range.");
+    }
+
+    if (m_objects[index] == nullptr) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port [" + m_descriptor.getPort(index).getName() + "] not found.");
+    }
 
-    return it->second;
+    return m_objects[index];
 }
 
-void ComputeNode::setPushConstants(const ll::PushConstants& constants) noexcept
+uint32_t ComputeNode::getPortIndex(const std::string& name) const
+{
+    return m_descriptor.getPortIndex(name);
+}
+
+void ComputeNode::setPushConstants(const ll::PushConstants& constants)
 {
     m_descriptor.setPushConstants(constants);
+
+    // before Init, the constants are written into every slot by onInit()
+    if (m_parameterBlock != nullptr && getState() == ll::NodeState::Init) {
+        m_parameterBlock->write(m_parameterBlockSlot, constants);
+    }
 }
 
 const ll::PushConstants& ComputeNode::getPushConstants() const noexcept
@@ -274,6 +447,100 @@ const ll::PushConstants& ComputeNode::getPushConstants() const noexcept
     return m_descriptor.getPushConstants();
 }
 
+void ComputeNode::setSpecializationConstants(const ll::SpecializationConstants& constants) noexcept
+{
+    m_descriptor.setSpecializationConstants(constants);
+}
+
+const ll::SpecializationConstants& ComputeNode::getSpecializationConstants() const noexcept
+{
+    return m_descriptor.getSpecializationConstants();
+}
+
+void ComputeNode::bindParameterBlock(const std::shared_ptr<ll::ParameterBlock>& block)
+{
+
+    ll::throwSystemErrorIf(!m_descriptor.isParameterBlockEnabled(), ll::ErrorCode::PortBindingError, "parameter-block mode is not enabled in the node descriptor.");
+    ll::throwSystemErrorIf(block == nullptr, ll::ErrorCode::PortBindingError, "parameter block cannot be null.");
+
+    m_parameterBlock     = block;
+    m_parameterBlockSlot = 0;
+
+    // the range covers one slot, the slot is selected with a dynamic offset at record time
+    auto descBufferInfo = vk::DescriptorBufferInfo()
+                              .setOffset(0)
+                              .setRange(block->getBlockSize())
+                              .setBuffer(block->getBuffer()->m_vkBuffer);
+
+    // the block is the same for all frames, hence all descriptor sets are written
+    for (const auto& descriptorSet : m_descriptorSets) {
+
+        auto writeDescSet = vk::WriteDescriptorSet()
+                                .setDescriptorType(vk::DescriptorType::eUniformBufferDynamic)
+                                .setDstSet(descriptorSet)
+                                .setDstBinding(m_descriptor.getParameterBlockBinding())
+                                .setDescriptorCount(1)
+                                .setPBufferInfo(&descBufferInfo);
+
+        m_device->get().updateDescriptorSets(1, &writeDescSet, 0, nullptr);
+    }
+
+    if (getState() == ll::NodeState::Init) {
+        m_parameterBlock->writeAll(m_descriptor.getPushConstants());
+    }
+}
+
+const std::shared_ptr<ll::ParameterBlock>& ComputeNode::getParameterBlock() const noexcept
+{
+    return m_parameterBlock;
+}
+
+void ComputeNode::setParameterBlockSlot(const uint32_t slot)
+{
+
+    ll::throwSystemErrorIf(m_parameterBlock == nullptr, ll::ErrorCode::InvalidArgument, "no parameter block bound to this node.");
+    ll::throwSystemErrorIf(slot >= m_parameterBlock->getSlotCount(), ll::ErrorCode::InvalidArgument,
+        "slot index " + std::to_string(slot) + " out of range, slot count: " + std::to_string(m_parameterBlock->getSlotCount()));
+
+    m_parameterBlockSlot = slot;
+}
+
+uint32_t ComputeNode::getParameterBlockSlot() const noexcept
+{
+    return m_parameterBlockSlot;
+}
+
+void ComputeNode::setFrameIndex(const uint32_t frameIndex)
+{
+
+    m_descriptorSetIndex = frameIndex % static_cast<uint32_t>(m_descriptorSets.size());
+
+    if (m_parameterBlock != nullptr) {
+        m_parameterBlockSlot = frameIndex % m_parameterBlock->getSlotCount();
+    }
+
+    auto& outdatedPorts = m_outdatedPorts[m_descriptorSetIndex];
+    for (const auto index : outdatedPorts) {
+        writePortDescriptor(index, m_descriptorSets[m_descriptorSetIndex]);
+    }
+
+    outdatedPorts.clear();
+}
+
+uint32_t ComputeNode::getDescriptorSetIndex() const noexcept
+{
+    return m_descriptorSetIndex;
+}
+
+std::shared_ptr<ll::ComputeNode> ComputeNode::instantiate() const
+{
+
+    ll::throwSystemErrorIf(getState() != ll::NodeState::Init, ll::ErrorCode::InvalidNodeState, "node must be in Init state before calling instantiate()");
+
+    // the constructor taking the prototype is private
+    return std::shared_ptr<ll::ComputeNode>(new ll::ComputeNode {shared_from_this()});
+}
+
 void ComputeNode::setParameter(const std::string& name, const ll::Parameter& value)
 {
     m_descriptor.setParameter(name, value);
@@ -284,10 +551,25 @@ const ll::Parameter& ComputeNode::getParameter(const std::string& name) const
     return m_descriptor.getParameter(name);
 }
 
+void ComputeNode::setParameter(const uint32_t index, const ll::Parameter& value)
+{
+    m_descriptor.setParameter(index, value);
+}
+
+const ll::Parameter& ComputeNode::getParameter(const uint32_t index) const
+{
+    return m_descriptor.getParameter(index);
+}
+
 void ComputeNode::bind(const std::string& name, const std::shared_ptr<ll::Object>& obj)
 {
+    bind(m_descriptor.getPortIndex(name), obj);
+}
 
-    const auto& port = m_descriptor.getPort(name);
+void ComputeNode::bind(const uint32_t index, const std::shared_ptr<ll::Object>& obj)
+{
+
+    const auto& port = m_descriptor.getPort(index);
 
     // validate if the object passed is valid under the port descriptor contract
     const auto validationResult = port.isValid(obj);
@@ -296,11 +578,21 @@ void ComputeNode::bind(const std::string& name, const std::shared_ptr<ll::Object
     // bind obj according to its type
     switch (obj->getType()) {
     case ll::ObjectType::Buffer:
-        bindBuffer(port, std::static_pointer_cast<ll::Buffer>(obj));
+        if (impl::isDynamicPortType(port.getPortType())) {
+            ll::throwSystemError(ll::ErrorCode::PortBindingError,
+                "port [" + port.getName() + "] of type ll::PortType::" + ll::portTypeToString(port.getPortType()) + " must be bound with bindRange()");
+        }
+
+        m_bufferRanges.erase(index);
+        bindBuffer(index, std::static_pointer_cast<ll::Buffer>(obj));
         break;
 
     case ll::ObjectType::ImageView:
-        bindImageView(port, std::static_pointer_cast<ll::ImageView>(obj));
+        bindImageView(index, std::static_pointer_cast<ll::ImageView>(obj));
+        break;
+
+    case ll::ObjectType::BufferView:
+        bindBufferView(index, std::static_pointer_cast<ll::BufferView>(obj));
         break;
 
     default:
@@ -309,6 +601,64 @@ void ComputeNode::bind(const std::string& name, const std::shared_ptr<ll::Object
     }
 }
 
+void ComputeNode::bindRange(const std::string& name, const std::shared_ptr<ll::Buffer>& buffer, const uint64_t offset, const uint64_t range)
+{
+
+    const auto  index = m_descriptor.getPortIndex(name);
+    const auto& port  = m_descriptor.getPort(index);
+
+    ll::throwSystemErrorIf(buffer == nullptr, ll::ErrorCode::PortBindingError, "buffer cannot be null.");
+
+    const auto validationResult = port.isValid(buffer);
+    ll::throwSystemErrorIf(!validationResult.first, ll::ErrorCode::PortBindingError, validationResult.second);
+
+    ll::throwSystemErrorIf(range == 0, ll::ErrorCode::InvalidArgument, "buffer range size must be greater than zero.");
+    ll::throwSystemErrorIf(offset + range > buffer->getSize(), ll::ErrorCode::InvalidArgument,
+        "buffer range [" + std::to_string(offset) + ", " + std::to_string(offset + range) + ") exceeds the buffer size: " + std::to_string(buffer->getSize()));
+
+    const auto alignment = getMinOffsetAlignment(port.getPortType());
+    ll::throwSystemErrorIf(offset % alignment != 0, ll::ErrorCode::InvalidArgument,
+        "buffer range offset " + std::to_string(offset) + " must be a multiple of " + std::to_string(alignment));
+
+    m_bufferRanges[index] = std::make_pair(offset, range);
+    m_dynamicOffsets.erase(port.getBinding());
+
+    bindBuffer(index, buffer);
+}
+
+void ComputeNode::setDynamicOffset(const std::string& name, const uint32_t offset)
+{
+
+    const auto  index = m_descriptor.getPortIndex(name);
+    const auto& port  = m_descriptor.getPort(index);
+
+    ll::throwSystemErrorIf(!impl::isDynamicPortType(port.getPortType()), ll::ErrorCode::InvalidArgument,
+        "port [" + name + "] of type ll::PortType::" + ll::portTypeToString(port.getPortType()) + " does not accept dynamic offsets");
+
+    const auto it = m_bufferRanges.find(index);
+    ll::throwSystemErrorIf(it == m_bufferRanges.cend(), ll::ErrorCode::InvalidArgument, "port [" + name + "] is not bound to a buffer range.");
+
+    const auto alignment = getMinOffsetAlignment(port.getPortType());
+    ll::throwSystemErrorIf(offset % alignment != 0, ll::ErrorCode::InvalidArgument,
+        "dynamic offset " + std::to_string(offset) + " must be a multiple of " + std::to_string(alignment));
+
+    const auto& [rangeOffset, rangeSize] = it->second;
+    const auto bufferSize                = std::static_pointer_cast<ll::Buffer>(m_objects[index])->getSize();
+    ll::throwSystemErrorIf(rangeOffset + offset + rangeSize > bufferSize, ll::ErrorCode::InvalidArgument,
+        "dynamic offset " + std::to_string(offset) + " moves the range of port [" + name + "] beyond the buffer size: " + std::to_string(bufferSize));
+
+    m_dynamicOffsets[port.getBinding()] = offset;
+}
+
+uint32_t ComputeNode::getDynamicOffset(const std::string& name) const
+{
+
+    const auto& port = m_descriptor.getPort(name);
+
+    const auto it = m_dynamicOffsets.find(port.getBinding());
+    return it == m_dynamicOffsets.cend() ? 0 : it->second;
+}
+
 void ComputeNode::record(ll::CommandBuffer& commandBuffer) const
 {
 
@@ -316,22 +666,86 @@ void ComputeNode::record(ll::CommandBuffer& commandBuffer) const
 
     auto vkCommandBuffer = commandBuffer.getVkCommandBuffer();
 
-    ll::throwSystemErrorIf(m_descriptor.getGridX() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor grid shape X must be greater than zero");
-    ll::throwSystemErrorIf(m_descriptor.getGridY() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor grid shape Y must be greater than zero");
-    ll::throwSystemErrorIf(m_descriptor.getGridZ() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor grid shape Z must be greater than zero");
+    // in indirect-dispatch mode, the grid shape is read from a buffer by the device
+    const auto isIndirect = m_descriptor.isIndirectDispatchEnabled();
+
+    ll::throwSystemErrorIf(!isIndirect && m_descriptor.getGridX() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor grid shape X must be greater than zero");
+    ll::throwSystemErrorIf(!isIndirect && m_descriptor.getGridY() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor grid shape Y must be greater than zero");
+    ll::throwSystemErrorIf(!isIndirect && m_descriptor.getGridZ() == 0, ll::ErrorCode::InvalidLocalShape, "descriptor grid shape Z must be greater than zero");
+
+    const auto gridOffset = m_descriptor.getGridOffset();
+    ll::throwSystemErrorIf(isIndirect && (gridOffset.x != 0 || gridOffset.y != 0 || gridOffset.z != 0),
+        ll::ErrorCode::InvalidNodeState, "grid offset is not supported in indirect-dispatch mode");
+
+    if (commandBuffer.m_trace != nullptr) {
+        commandBuffer.m_trace->steps.push_back({ll::impl::CommandTraceStepType::Run, this});
+    }
+
+    // The memory of transient images may hold other images up to this node.
+    // Their content is discarded, waiting for any previous access to the memory.
+    if (!m_transientImages.empty()) {
+
+        auto barriers = std::vector<vk::ImageMemoryBarrier> {};
+        barriers.reserve(m_transientImages.size());
+
+        for (const auto& image : m_transientImages) {
+
+            auto barrier = vk::ImageMemoryBarrier {}
+                               .setOldLayout(vk::ImageLayout::eUndefined)
+                               .setNewLayout(vk::ImageLayout::eGeneral)
+                               .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                               .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                               .setImage(image->m_vkImage)
+                               .setSrcAccessMask(vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite)
+                               .setDstAccessMask(vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+
+            barrier.subresourceRange.setAspectMask(vk::ImageAspectFlagBits::eColor);
+            barrier.subresourceRange.setBaseMipLevel(0);
+            barrier.subresourceRange.setLevelCount(1);
+            barrier.subresourceRange.setBaseArrayLayer(0);
+            barrier.subresourceRange.setLayerCount(1);
+
+            barriers.push_back(barrier);
+        }
+
+        vkCommandBuffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::DependencyFlags {},
+            0, nullptr,
+            0, nullptr,
+            static_cast<uint32_t>(barriers.size()), barriers.data());
+    }
 
     vkCommandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_pipeline);
 
+    // dynamic offsets are consumed in binding order. The bindings are sorted by index.
+    auto dynamicOffsets = std::vector<uint32_t> {};
+    for (const auto& binding : m_parameterBindings) {
+
+        if (binding.descriptorType != vk::DescriptorType::eUniformBufferDynamic
+            && binding.descriptorType != vk::DescriptorType::eStorageBufferDynamic) {
+            continue;
+        }
+
+        if (m_descriptor.isParameterBlockEnabled() && binding.binding == m_descriptor.getParameterBlockBinding()) {
+            dynamicOffsets.push_back(static_cast<uint32_t>(m_parameterBlock->getSlotOffset(m_parameterBlockSlot)));
+        } else {
+            const auto it = m_dynamicOffsets.find(binding.binding);
+            dynamicOffsets.push_back(it == m_dynamicOffsets.cend() ? 0 : it->second);
+        }
+    }
+
     vkCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
         m_pipelineLayout,
         0,
         1,
-        &m_descriptorSet,
-        0,
-        nullptr);
+        &m_descriptorSets[m_descriptorSetIndex],
+        static_cast<uint32_t>(dynamicOffsets.size()),
+        dynamicOffsets.data());
 
     const auto& pushConstants = m_descriptor.getPushConstants();
-    if (pushConstants.getSize() != 0) {
+    if (pushConstants.getSize() != 0 && !m_descriptor.isParameterBlockEnabled()) {
         vkCommandBuffer.pushConstants(m_pipelineLayout,
             vk::ShaderStageFlagBits::eCompute,
             0,
@@ -339,16 +753,63 @@ void ComputeNode::record(ll::CommandBuffer& commandBuffer) const
             pushConstants.getPtr());
     }
 
-    vkCommandBuffer.dispatch(m_descriptor.getGridX(),
-        m_descriptor.getGridY(),
-        m_descriptor.getGridZ());
+    if (isIndirect) {
+
+        const auto buffer = std::static_pointer_cast<ll::Buffer>(getPort(m_descriptor.getIndirectDispatchPort()));
+        commandBuffer.dispatchIndirect(*buffer, m_descriptor.getIndirectDispatchOffset());
+
+    } else if (gridOffset.x != 0 || gridOffset.y != 0 || gridOffset.z != 0) {
+
+        vkCommandBuffer.dispatchBase(gridOffset.x, gridOffset.y, gridOffset.z,
+            m_descriptor.getGridX(),
+            m_descriptor.getGridY(),
+            m_descriptor.getGridZ());
+
+    } else {
+        vkCommandBuffer.dispatch(m_descriptor.getGridX(),
+            m_descriptor.getGridY(),
+            m_descriptor.getGridZ());
+    }
+}
+
+void ComputeNode::reinit()
+{
+
+    ll::throwSystemErrorIf(getState() != ll::NodeState::Init, ll::ErrorCode::InvalidNodeState, "node must be in Init state before calling reinit()");
+
+    // the pipeline, ports and parameter block are kept, only the grid is configured for the current ports
+    runBuilderReshape();
+    saveInitPortShapes();
 }
 
 void ComputeNode::onInit()
+{
+
+    // instances are configured by copying the descriptor of their prototype
+    if (m_prototype == nullptr) {
+        runBuilderInit();
+    }
+
+    if (m_descriptor.isParameterBlockEnabled()) {
+        ll::throwSystemErrorIf(m_parameterBlock == nullptr, ll::ErrorCode::PortBindingError, "parameter-block mode is enabled but no parameter block has been bound to the node.");
+        m_parameterBlock->writeAll(m_descriptor.getPushConstants());
+    }
+
+    if (m_prototype == nullptr) {
+        initPipeline();
+    }
+
+    saveInitPortShapes();
+}
+
+void ComputeNode::runBuilderInit()
 {
 
     const auto builderName = m_descriptor.getBuilderName();
-    if (!builderName.empty()) {
+    if (m_builder != nullptr) {
+        m_builder->onNodeInit(*this);
+
+    } else if (!builderName.empty()) {
 
         // this will throw an exception if m_interpreter has been destroyed
         // by the session.
@@ -366,53 +827,214 @@ void ComputeNode::onInit()
             ll::throwSystemError(ll::ErrorCode::SessionLost, "Attempt to access the Lua interpreter of a Session already destroyed.");
         }
     }
+}
+
+void ComputeNode::runBuilderReshape()
+{
+
+    const auto builderName = m_descriptor.getBuilderName();
+    if (m_builder != nullptr) {
+        m_builder->onNodeReshape(*this);
+
+    } else if (!builderName.empty()) {
+
+        if (auto shared_interpreter = m_interpreter.lock()) {
+
+            constexpr const auto lua = R"(
+                local builderName, node = ...
+                local builder = ll.getNodeBuilder(builderName)
+                if builder.onNodeReshape then
+                    builder.onNodeReshape(node)
+                else
+                    node:scaleGridShape()
+                end
+            )";
 
-    initPipeline();
+            shared_interpreter->loadAndRunNoReturn(lua, builderName, shared_from_this());
+
+        } else {
+            ll::throwSystemError(ll::ErrorCode::SessionLost, "Attempt to access the Lua interpreter of a Session already destroyed.");
+        }
+
+    } else {
+        scaleGridShape();
+    }
+}
+
+void ComputeNode::saveInitPortShapes()
+{
+
+    m_initPortShapes.assign(m_objects.size(), ll::vec3ui {});
+
+    for (auto index = size_t {0}; index < m_objects.size(); ++index) {
+
+        if (const auto image = impl::getObjectImage(m_objects[index])) {
+            m_initPortShapes[index] = image->getShape();
+        }
+    }
 }
 
-void ComputeNode::bindBuffer(const ll::PortDescriptor& port, const std::shared_ptr<ll::Buffer>& buffer)
+void ComputeNode::bindBuffer(const uint32_t index, const std::shared_ptr<ll::Buffer>& buffer)
 {
 
     // holds a reference to the object
-    m_objects[port.getName()] = buffer;
+    m_objects[index] = buffer;
+    impl::registerBoundNode(buffer->m_boundNodes, weak_from_this());
 
-    // update the informacion of the descriptor set
-    auto descBufferInfo = vk::DescriptorBufferInfo()
-                              .setOffset(0)
-                              .setRange(VK_WHOLE_SIZE)
-                              .setBuffer(buffer->m_vkBuffer);
+    updatePortDescriptor(index);
+}
+
+void ComputeNode::bindImageView(const uint32_t index, const std::shared_ptr<ll::ImageView>& imgView)
+{
+
+    // binding
+    m_objects[index] = imgView;
+    impl::registerBoundNode(imgView->m_image->m_boundNodes, weak_from_this());
+
+    updatePortDescriptor(index);
+}
+
+void ComputeNode::bindBufferView(const uint32_t index, const std::shared_ptr<ll::BufferView>& bufferView)
+{
+
+    m_objects[index] = bufferView;
+    impl::registerBoundNode(bufferView->m_buffer->m_boundNodes, weak_from_this());
+
+    updatePortDescriptor(index);
+}
+
+void ComputeNode::updatePortDescriptor(const uint32_t index)
+{
+
+    writePortDescriptor(index, m_descriptorSets[m_descriptorSetIndex]);
+
+    // the other descriptor sets may be in use by command buffers still executing
+    for (auto setIndex = uint32_t {0}; setIndex < m_outdatedPorts.size(); ++setIndex) {
+
+        auto& outdatedPorts = m_outdatedPorts[setIndex];
+        if (setIndex != m_descriptorSetIndex && std::find(outdatedPorts.cbegin(), outdatedPorts.cend(), index) == outdatedPorts.cend()) {
+            outdatedPorts.push_back(index);
+        }
+    }
+}
+
+void ComputeNode::writePortDescriptor(const uint32_t index, const vk::DescriptorSet& descriptorSet)
+{
+
+    const auto& port = m_descriptor.getPort(index);
+    const auto& obj  = m_objects[index];
 
     auto writeDescSet = vk::WriteDescriptorSet()
                             .setDescriptorType(ll::portTypeToVkDescriptorType(port.getPortType()))
-                            .setDstSet(m_descriptorSet)
+                            .setDstSet(descriptorSet)
                             .setDstBinding(port.getBinding())
-                            .setDescriptorCount(1)
-                            .setPBufferInfo(&descBufferInfo);
+                            .setDescriptorCount(1);
+
+    switch (obj->getType()) {
+    case ll::ObjectType::Buffer: {
+
+        // ports bound with bindRange() read only a range of the buffer
+        auto       offset = uint64_t {0};
+        auto       range  = uint64_t {VK_WHOLE_SIZE};
+        const auto it     = m_bufferRanges.find(index);
+        if (it != m_bufferRanges.cend()) {
+            std::tie(offset, range) = it->second;
+        }
+
+        const auto descBufferInfo = vk::DescriptorBufferInfo()
+                                        .setOffset(offset)
+                                        .setRange(range)
+                                        .setBuffer(std::static_pointer_cast<ll::Buffer>(obj)->m_vkBuffer);
+
+        writeDescSet.setPBufferInfo(&descBufferInfo);
+        m_device->get().updateDescriptorSets(1, &writeDescSet, 0, nullptr);
+    } break;
+
+    case ll::ObjectType::ImageView: {
+
+        const auto imgView     = std::static_pointer_cast<ll::ImageView>(obj);
+        const auto descImgInfo = vk::DescriptorImageInfo {}
+                                     .setSampler(imgView->m_vkSampler)
+                                     .setImageView(imgView->m_vkImageView)
+                                     .setImageLayout(ll::impl::toVkImageLayout(imgView->m_image->m_layout));
 
-    m_device->get().updateDescriptorSets(1, &writeDescSet, 0, nullptr);
+        writeDescSet.setPImageInfo(&descImgInfo);
+        m_device->get().updateDescriptorSets(1, &writeDescSet, 0, nullptr);
+    } break;
+
+    case ll::ObjectType::BufferView: {
+
+        const auto bufferView = std::static_pointer_cast<ll::BufferView>(obj);
+
+        writeDescSet.setPTexelBufferView(&bufferView->m_vkBufferView);
+        m_device->get().updateDescriptorSets(1, &writeDescSet, 0, nullptr);
+    } break;
+
+    default:
+        break;
+    }
 }
 
-void ComputeNode::bindImageView(const ll::PortDescriptor& port, const std::shared_ptr<ll::ImageView>& imgView)
+uint64_t ComputeNode::getMinOffsetAlignment(const ll::PortType portType) const
 {
 
-    // binding
-    m_objects[port.getName()] = imgView;
+    const auto& limits = m_device->getPhysicalDeviceLimits();
 
-    auto descImgInfo = vk::DescriptorImageInfo {}
-                           .setSampler(imgView->m_vkSampler)
-                           .setImageView(imgView->m_vkImageView)
-                           .setImageLayout(ll::impl::toVkImageLayout(imgView->m_image->m_layout));
+    switch (portType) {
+    case ll::PortType::UniformBuffer:
+    case ll::PortType::UniformBufferDynamic:
+        return limits.minUniformBufferOffsetAlignment;
 
-    auto writeDescSet = vk::WriteDescriptorSet()
-                            .setDstSet(m_descriptorSet)
-                            .setDstBinding(port.getBinding())
-                            .setDescriptorCount(1)
-                            .setPImageInfo(&descImgInfo);
+    default:
+        return limits.minStorageBufferOffsetAlignment;
+    }
+}
 
-    writeDescSet.setDescriptorType(ll::portTypeToVkDescriptorType(port.getPortType()));
+void ComputeNode::rebind(const ll::Object& obj)
+{
 
-    // update the informacion of the descriptor set
-    m_device->get().updateDescriptorSets(1, &writeDescSet, 0, nullptr);
+    for (auto index = uint32_t {0}; index < m_objects.size(); ++index) {
+
+        const auto& bound = m_objects[index];
+        if (bound == nullptr) {
+            continue;
+        }
+
+        auto isBound = false;
+
+        switch (bound->getType()) {
+        case ll::ObjectType::Buffer:
+            isBound = bound.get() == &obj;
+            break;
+
+        case ll::ObjectType::ImageView:
+            isBound = std::static_pointer_cast<ll::ImageView>(bound)->m_image.get() == &obj;
+            break;
+
+        case ll::ObjectType::BufferView:
+            isBound = std::static_pointer_cast<ll::BufferView>(bound)->m_buffer.get() == &obj;
+            break;
+
+        default:
+            break;
+        }
+
+        if (isBound) {
+            writePortDescriptors(index);
+        }
+    }
+}
+
+void ComputeNode::writePortDescriptors(const uint32_t index)
+{
+
+    for (const auto& descriptorSet : m_descriptorSets) {
+        writePortDescriptor(index, descriptorSet);
+    }
+
+    for (auto& outdatedPorts : m_outdatedPorts) {
+        outdatedPorts.erase(std::remove(outdatedPorts.begin(), outdatedPorts.end(), index), outdatedPorts.end());
+    }
 }
 
 std::vector<vk::DescriptorPoolSize> ComputeNode::getDescriptorPoolSizes() const noexcept
@@ -421,15 +1043,19 @@ std::vector<vk::DescriptorPoolSize> ComputeNode::getDescriptorPoolSizes() const
     auto pushDescriptorPoolSize = [this](const vk::DescriptorType type, std::vector<vk::DescriptorPoolSize>& v) {
         const auto count = countDescriptorType(type);
         if (count > 0) {
-            v.push_back({type, count});
+            v.push_back({type, count * m_descriptor.getDescriptorSetCount()});
         }
     };
 
     std::vector<vk::DescriptorPoolSize> poolSizes;
     pushDescriptorPoolSize(vk::DescriptorType::eStorageBuffer, poolSizes);
     pushDescriptorPoolSize(vk::DescriptorType::eUniformBuffer, poolSizes);
+    pushDescriptorPoolSize(vk::DescriptorType::eUniformBufferDynamic, poolSizes);
+    pushDescriptorPoolSize(vk::DescriptorType::eStorageBufferDynamic, poolSizes);
     pushDescriptorPoolSize(vk::DescriptorType::eStorageImage, poolSizes);
     pushDescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, poolSizes);
+    pushDescriptorPoolSize(vk::DescriptorType::eUniformTexelBuffer, poolSizes);
+    pushDescriptorPoolSize(vk::DescriptorType::eStorageTexelBuffer, poolSizes);
 
     return poolSizes;
 }
@@ -38,7 +38,26 @@ ComputeNodeDescriptor& ComputeNodeDescriptor::setProgram(const std::shared_ptr<l
 ComputeNodeDescriptor& ComputeNodeDescriptor::setParameter(const std::string& name, const ll::Parameter& value)
 {
 
-    m_parameters[name] = value;
+    const auto it = m_parameterIndices.find(name);
+    if (it != m_parameterIndices.cend()) {
+        m_parameters[it->second] = value;
+        return *this;
+    }
+
+    m_parameterIndices[name] = static_cast<uint32_t>(m_parameters.size());
+    m_parameters.push_back(value);
+    return *this;
+}
+
+ComputeNodeDescriptor& ComputeNodeDescriptor::setParameter(const uint32_t index, const ll::Parameter& value)
+{
+
+    // index overloads are used in hot paths, build the message only on failure
+    if (index >= m_parameters.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Parameter index [" + std::to_string(index) + "] out of range.");
+    }
+
+    m_parameters[index] = value;
     return *this;
 }
 
@@ -58,7 +77,14 @@ ComputeNodeDescriptor& ComputeNodeDescriptor::setBuilderName(const std::string&
 ComputeNodeDescriptor& ComputeNodeDescriptor::addPort(const ll::PortDescriptor& port)
 {
 
-    m_ports[port.getName()] = port;
+    const auto it = m_portIndices.find(port.getName());
+    if (it != m_portIndices.cend()) {
+        m_ports[it->second] = port;
+        return *this;
+    }
+
+    m_portIndices[port.getName()] = static_cast<uint32_t>(m_ports.size());
+    m_ports.push_back(port);
     return *this;
 }
 
@@ -108,6 +134,31 @@ ComputeNodeDescriptor& ComputeNodeDescriptor::configureGridShape(const ll::vec3u
     return *this;
 }
 
+ComputeNodeDescriptor& ComputeNodeDescriptor::setGridOffset(const ll::vec3ui& offset) noexcept
+{
+    m_gridOffset = offset;
+    return *this;
+}
+
+ComputeNodeDescriptor& ComputeNodeDescriptor::configureGridRegion(const ll::vec3ui& globalOffset, const ll::vec3ui& globalShape)
+{
+
+    ll::throwSystemErrorIf(m_localShape.x == 0 || m_localShape.y == 0 || m_localShape.z == 0,
+        ll::ErrorCode::InvalidLocalShape, "local shape components must be greater than zero");
+
+    ll::throwSystemErrorIf(globalOffset.x % m_localShape.x != 0 || globalOffset.y % m_localShape.y != 0 || globalOffset.z % m_localShape.z != 0,
+        ll::ErrorCode::InvalidArgument,
+        "region offset must be a multiple of the local shape, got offset: (" + std::to_string(globalOffset.x) + ", " + std::to_string(globalOffset.y) + ", " + std::to_string(globalOffset.z)
+            + ") local shape: (" + std::to_string(m_localShape.x) + ", " + std::to_string(m_localShape.y) + ", " + std::to_string(m_localShape.z) + ")");
+
+    m_gridOffset = vec3ui {
+        globalOffset.x / m_localShape.x,
+        globalOffset.y / m_localShape.y,
+        globalOffset.z / m_localShape.z};
+
+    return configureGridShape(globalShape);
+}
+
 ComputeNodeDescriptor& ComputeNodeDescriptor::setLocalX(const uint32_t x) noexcept
 {
     m_localShape.x = x;
@@ -147,6 +198,11 @@ ll::vec3ui ComputeNodeDescriptor::getGridShape() const noexcept
     return m_gridShape;
 }
 
+ll::vec3ui ComputeNodeDescriptor::getGridOffset() const noexcept
+{
+    return m_gridOffset;
+}
+
 ll::vec3ui ComputeNodeDescriptor::getLocalShape() const noexcept
 {
     return m_localShape;
@@ -189,19 +245,59 @@ std::shared_ptr<ll::Program> ComputeNodeDescriptor::getProgram() const noexcept
 
 const ll::PortDescriptor& ComputeNodeDescriptor::getPort(const std::string& name) const
 {
+    return m_ports[getPortIndex(name)];
+}
 
-    auto it = m_ports.find(name);
+const ll::PortDescriptor& ComputeNodeDescriptor::getPort(const uint32_t index) const
+{
 
-    ll::throwSystemErrorIf(it == m_ports.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
+    if (index >= m_ports.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port index [" + std::to_string(index) + "] out of range.");
+    }
+
+    return m_ports[index];
+}
+
+uint32_t ComputeNodeDescriptor::getPortIndex(const std::string& name) const
+{
+
+    auto it = m_portIndices.find(name);
+
+    ll::throwSystemErrorIf(it == m_portIndices.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
     return it->second;
 }
 
+bool ComputeNodeDescriptor::hasPort(const std::string& name) const noexcept
+{
+    return m_portIndices.find(name) != m_portIndices.cend();
+}
+
+size_t ComputeNodeDescriptor::getPortCount() const noexcept
+{
+    return m_ports.size();
+}
+
 const ll::Parameter& ComputeNodeDescriptor::getParameter(const std::string& name) const
+{
+    return m_parameters[getParameterIndex(name)];
+}
+
+const ll::Parameter& ComputeNodeDescriptor::getParameter(const uint32_t index) const
 {
 
-    auto it = m_parameters.find(name);
+    if (index >= m_parameters.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Parameter index [" + std::to_string(index) + "] out of range.");
+    }
 
-    ll::throwSystemErrorIf(it == m_parameters.cend(), ll::ErrorCode::KeyNotFound, "Parameter [" + name + "] not found.");
+    return m_parameters[index];
+}
+
+uint32_t ComputeNodeDescriptor::getParameterIndex(const std::string& name) const
+{
+
+    auto it = m_parameterIndices.find(name);
+
+    ll::throwSystemErrorIf(it == m_parameterIndices.cend(), ll::ErrorCode::KeyNotFound, "Parameter [" + name + "] not found.");
     return it->second;
 }
 
@@ -216,28 +312,130 @@ const ll::PushConstants& ComputeNodeDescriptor::getPushConstants() const noexcep
     return m_pushConstants;
 }
 
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::setSpecializationConstants(const ll::SpecializationConstants& constants) noexcept
+{
+    m_specializationConstants = constants;
+    return *this;
+}
+
+const ll::SpecializationConstants& ComputeNodeDescriptor::getSpecializationConstants() const noexcept
+{
+    return m_specializationConstants;
+}
+
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::setParameterBlockBinding(const uint32_t binding) noexcept
+{
+    m_parameterBlockEnabled = true;
+    m_parameterBlockBinding = binding;
+    return *this;
+}
+
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::disableParameterBlock() noexcept
+{
+    m_parameterBlockEnabled = false;
+    return *this;
+}
+
+bool ComputeNodeDescriptor::isParameterBlockEnabled() const noexcept
+{
+    return m_parameterBlockEnabled;
+}
+
+uint32_t ComputeNodeDescriptor::getParameterBlockBinding() const noexcept
+{
+    return m_parameterBlockBinding;
+}
+
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::setIndirectDispatch(const std::string& portName, const uint64_t offset) noexcept
+{
+    m_indirectDispatchPort   = portName;
+    m_indirectDispatchOffset = offset;
+    return *this;
+}
+
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::disableIndirectDispatch() noexcept
+{
+    m_indirectDispatchPort.clear();
+    m_indirectDispatchOffset = 0;
+    return *this;
+}
+
+bool ComputeNodeDescriptor::isIndirectDispatchEnabled() const noexcept
+{
+    return !m_indirectDispatchPort.empty();
+}
+
+const std::string& ComputeNodeDescriptor::getIndirectDispatchPort() const noexcept
+{
+    return m_indirectDispatchPort;
+}
+
+uint64_t ComputeNodeDescriptor::getIndirectDispatchOffset() const noexcept
+{
+    return m_indirectDispatchOffset;
+}
+
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::setStencilRadius(const uint32_t radius) noexcept
+{
+    m_stencilRadius = radius;
+    return *this;
+}
+
+uint32_t ComputeNodeDescriptor::getStencilRadius() const noexcept
+{
+    return m_stencilRadius;
+}
+
+ll::ComputeNodeDescriptor& ComputeNodeDescriptor::setDescriptorSetCount(const uint32_t count) noexcept
+{
+    m_descriptorSetCount = count;
+    return *this;
+}
+
+uint32_t ComputeNodeDescriptor::getDescriptorSetCount() const noexcept
+{
+    return m_descriptorSetCount;
+}
+
 std::vector<vk::DescriptorSetLayoutBinding> ComputeNodeDescriptor::getParameterBindings() const
 {
 
-    auto bindings = std::vector<vk::DescriptorSetLayoutBinding>(m_ports.size());
+    const auto bindingCount = m_ports.size() + (m_parameterBlockEnabled ? 1 : 0);
+    auto       bindings     = std::vector<vk::DescriptorSetLayoutBinding>(bindingCount);
 
-    for (const auto& it : m_ports) {
+    for (const auto& port : m_ports) {
 
-        const auto& port    = it.second;
-        auto        binding = vk::DescriptorSetLayoutBinding {}
+        auto binding = vk::DescriptorSetLayoutBinding {}
                            .setBinding(port.getBinding())
                            .setDescriptorCount(1)
                            .setDescriptorType(ll::portTypeToVkDescriptorType(port.getPortType()))
                            .setStageFlags(vk::ShaderStageFlagBits::eCompute)
                            .setPImmutableSamplers(nullptr);
 
-        if (port.getBinding() >= m_ports.size()) {
-            throwSystemError(ll::ErrorCode::PortBindingError, "port [" + port.getName() + "] has a binding index [" + std::to_string(port.getBinding()) + "] greater than the maximum allowed for this node: " + std::to_string(m_ports.size()));
+        if (port.getBinding() >= bindingCount) {
+            throwSystemError(ll::ErrorCode::PortBindingError, "port [" + port.getName() + "] has a binding index [" + std::to_string(port.getBinding()) + "] greater than the maximum allowed for this node: " + std::to_string(bindingCount));
         }
 
         bindings[port.getBinding()] = binding;
     }
 
+    if (m_parameterBlockEnabled) {
+
+        ll::throwSystemErrorIf(m_parameterBlockBinding >= bindingCount, ll::ErrorCode::PortBindingError,
+            "parameter block binding index [" + std::to_string(m_parameterBlockBinding) + "] greater than the maximum allowed for this node: " + std::to_string(bindingCount));
+
+        // unused entries have a descriptor count of zero
+        ll::throwSystemErrorIf(bindings[m_parameterBlockBinding].descriptorCount != 0, ll::ErrorCode::PortBindingError,
+            "parameter block binding index [" + std::to_string(m_parameterBlockBinding) + "] is already used by a port");
+
+        bindings[m_parameterBlockBinding] = vk::DescriptorSetLayoutBinding {}
+                                                .setBinding(m_parameterBlockBinding)
+                                                .setDescriptorCount(1)
+                                                .setDescriptorType(vk::DescriptorType::eUniformBufferDynamic)
+                                                .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+                                                .setPImmutableSamplers(nullptr);
+    }
+
     return bindings;
 }
 
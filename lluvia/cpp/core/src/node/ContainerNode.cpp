@@ -9,19 +9,130 @@
 
 #include "lluvia/core/CommandBuffer.h"
 #include "lluvia/core/Interpreter.h"
+#include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/buffer/BufferView.h"
+#include "lluvia/core/error.h"
+#include "lluvia/core/image/Image.h"
+#include "lluvia/core/image/ImageView.h"
+#include "lluvia/core/impl/CommandTrace.h"
+#include "lluvia/core/impl/ObjectShape.h"
+#include "lluvia/core/memory/Memory.h"
+#include "lluvia/core/node/ComputeNode.h"
+#include "lluvia/core/node/NodeBuilder.h"
+#include "lluvia/core/node/ParameterBlock.h"
+
+#include "lluvia/core/vulkan/Device.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
 
 namespace ll {
 
+namespace impl {
+
+    // the buffer or image holding the data of obj
+    std::shared_ptr<ll::Object> getObjectResource(const std::shared_ptr<ll::Object>& obj)
+    {
+
+        switch (obj->getType()) {
+        case ll::ObjectType::ImageView:
+            return std::static_pointer_cast<ll::ImageView>(obj)->getImage();
+        case ll::ObjectType::BufferView:
+            return std::static_pointer_cast<ll::BufferView>(obj)->getBuffer();
+        default:
+            return obj;
+        }
+    }
+
+    // Gets the object of an instance corresponding to obj in its prototype. Buffers and images
+    // in writtenResources are created again, views are created again if their resource is.
+    std::shared_ptr<ll::Object> instantiateObject(const std::shared_ptr<ll::Object>& obj,
+        std::map<const ll::Object*, std::shared_ptr<ll::Object>>&                    objects,
+        const std::set<const ll::Object*>&                                           writtenResources)
+    {
+
+        const auto it = objects.find(obj.get());
+        if (it != objects.cend()) {
+            return it->second;
+        }
+
+        const auto isWritten = writtenResources.count(obj.get()) != 0;
+        auto       instance  = obj;
+
+        switch (obj->getType()) {
+        case ll::ObjectType::Buffer:
+            if (isWritten) {
+                const auto buffer = std::static_pointer_cast<ll::Buffer>(obj);
+                instance          = buffer->getMemory()->createBuffer(buffer->getSize(), buffer->getUsageFlags());
+            }
+            break;
+
+        case ll::ObjectType::Image:
+            if (isWritten) {
+                const auto image    = std::static_pointer_cast<ll::Image>(obj);
+                auto       newImage = image->getMemory()->createImage(image->getDescriptor());
+
+                const auto layout = image->getLayout();
+                if (layout != ll::ImageLayout::Undefined && layout != ll::ImageLayout::Preinitialized) {
+                    newImage->changeImageLayout(layout);
+                }
+
+                instance = newImage;
+            }
+            break;
+
+        case ll::ObjectType::ImageView: {
+            const auto imageView = std::static_pointer_cast<ll::ImageView>(obj);
+            const auto image     = std::static_pointer_cast<ll::Image>(instantiateObject(imageView->getImage(), objects, writtenResources));
+
+            if (image != imageView->getImage()) {
+                instance = image->createImageView(imageView->getDescriptor());
+            }
+        } break;
+
+        case ll::ObjectType::BufferView: {
+            const auto bufferView = std::static_pointer_cast<ll::BufferView>(obj);
+            const auto buffer     = std::static_pointer_cast<ll::Buffer>(instantiateObject(bufferView->getBuffer(), objects, writtenResources));
+
+            if (buffer != bufferView->getBuffer()) {
+                instance = buffer->createBufferView(bufferView->getChannelCount(), bufferView->getChannelType(), bufferView->getOffset(), bufferView->getRange());
+            }
+        } break;
+
+        default:
+            break;
+        }
+
+        objects[obj.get()] = instance;
+        return instance;
+    }
+
+} // namespace impl
+
 ContainerNode::ContainerNode(const std::weak_ptr<ll::Interpreter>& interpreter)
     : m_interpreter {interpreter}
 {
 }
 
 ContainerNode::ContainerNode(const std::weak_ptr<ll::Interpreter>& interpreter,
-    const ll::ContainerNodeDescriptor&                             descriptor)
+    const ll::ContainerNodeDescriptor&                             descriptor,
+    const std::shared_ptr<ll::ContainerNodeBuilder>&               builder)
     : m_descriptor {descriptor}
     , m_interpreter {interpreter}
+    , m_builder {builder}
 {
+
+    // the ports of the descriptor keep their index
+    for (auto index = uint32_t {0}; index < m_descriptor.getPortCount(); ++index) {
+
+        const auto& name = m_descriptor.getPort(index).getName();
+
+        m_objectIndices[name] = index;
+        m_objects.emplace_back(name, nullptr);
+    }
 }
 
 ll::NodeType ContainerNode::getType() const noexcept
@@ -37,15 +148,38 @@ const ll::ContainerNodeDescriptor& ContainerNode::getDescriptor() const noexcept
 bool ContainerNode::hasPort(const std::string& name) const noexcept
 {
 
-    const auto it = m_objects.find(name);
-    return it != m_objects.cend();
+    const auto it = m_objectIndices.find(name);
+    return it != m_objectIndices.cend() && m_objects[it->second].second != nullptr;
 }
 
 std::shared_ptr<ll::Object> ContainerNode::getPort(const std::string& name) const
 {
 
-    const auto it = m_objects.find(name);
-    ll::throwSystemErrorIf(it == m_objects.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
+    const auto it = m_objectIndices.find(name);
+    ll::throwSystemErrorIf(it == m_objectIndices.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
+
+    return getPort(it->second);
+}
+
+std::shared_ptr<ll::Object> ContainerNode::getPort(const uint32_t index) const
+{
+
+    if (index >= m_objects.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port index [" + std::to_string(index) + "] out of range.");
+    }
+
+    if (m_objects[index].second == nullptr) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port [" + m_objects[index].first + "] not found.");
+    }
+
+    return m_objects[index].second;
+}
+
+uint32_t ContainerNode::getPortIndex(const std::string& name) const
+{
+
+    const auto it = m_objectIndices.find(name);
+    ll::throwSystemErrorIf(it == m_objectIndices.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
 
     return it->second;
 }
@@ -60,24 +194,217 @@ const ll::Parameter& ContainerNode::getParameter(const std::string& name) const
     return m_descriptor.getParameter(name);
 }
 
+void ContainerNode::setParameter(const uint32_t index, const ll::Parameter& value)
+{
+    m_descriptor.setParameter(index, value);
+}
+
+const ll::Parameter& ContainerNode::getParameter(const uint32_t index) const
+{
+    return m_descriptor.getParameter(index);
+}
+
 void ContainerNode::bind(const std::string& name, const std::shared_ptr<ll::Object>& obj)
 {
 
     // FIXME: if name is in descriptor ports, do the proper checks
-    m_objects[name] = obj;
+    const auto it = m_objectIndices.find(name);
+    if (it != m_objectIndices.cend()) {
+        m_objects[it->second].second = obj;
+        return;
+    }
+
+    m_objectIndices[name] = static_cast<uint32_t>(m_objects.size());
+    m_objects.emplace_back(name, obj);
+}
+
+void ContainerNode::bind(const uint32_t index, const std::shared_ptr<ll::Object>& obj)
+{
+
+    if (index >= m_objects.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port index [" + std::to_string(index) + "] out of range.");
+    }
+
+    m_objects[index].second = obj;
 }
 
 void ContainerNode::bindNode(const std::string& name, const std::shared_ptr<ll::Node>& node)
 {
-    m_nodes[name] = node;
+
+    const auto it = m_nodeIndices.find(name);
+    if (it != m_nodeIndices.cend()) {
+        m_nodes[it->second].second = node;
+        return;
+    }
+
+    m_nodeIndices[name] = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back(name, node);
+}
+
+uint32_t ContainerNode::getStencilRadius() const noexcept
+{
+
+    if (m_descriptor.getStencilRadius() != 0) {
+        return m_descriptor.getStencilRadius();
+    }
+
+    auto radius = uint32_t {0};
+    for (const auto& kv : m_nodes) {
+        radius += kv.second->getStencilRadius();
+    }
+
+    return radius;
+}
+
+void ContainerNode::markTransient(const std::shared_ptr<ll::Object>& obj)
+{
+
+    ll::throwSystemErrorIf(m_transientImagesAliased, ll::ErrorCode::InvalidNodeState, "transient images must be marked before the container initialization completes");
+
+    auto image = impl::getObjectImage(obj);
+    ll::throwSystemErrorIf(image == nullptr, ll::ErrorCode::InvalidArgument, "transient objects must be either an Image or an ImageView");
+
+    if (std::find(m_transientImages.cbegin(), m_transientImages.cend(), image) == m_transientImages.cend()) {
+        m_transientImages.push_back(image);
+    }
+}
+
+uint64_t ContainerNode::getTransientMemorySize() const noexcept
+{
+    return m_transientMemorySize;
+}
+
+std::shared_ptr<ll::ContainerNode> ContainerNode::instantiate() const
+{
+
+    ll::throwSystemErrorIf(getState() != ll::NodeState::Init, ll::ErrorCode::InvalidNodeState, "container node must be in Init state before calling instantiate()");
+
+    auto instance         = std::make_shared<ll::ContainerNode>(m_interpreter, m_descriptor, m_builder);
+    instance->m_prototype = shared_from_this();
+
+    return instance;
+}
+
+void ContainerNode::setFrameIndex(const uint32_t frameIndex)
+{
+
+    auto computeNodes = std::vector<std::shared_ptr<ll::ComputeNode>> {};
+    collectComputeNodes(computeNodes);
+
+    for (const auto& node : computeNodes) {
+        node->setFrameIndex(frameIndex);
+    }
+}
+
+void ContainerNode::reinit()
+{
+
+    ll::throwSystemErrorIf(getState() != ll::NodeState::Init, ll::ErrorCode::InvalidNodeState, "container node must be in Init state before calling reinit()");
+
+    // objects bound to the ports since the last initialization replace the previous ones
+    auto objects = std::map<const ll::Object*, std::shared_ptr<ll::Object>> {};
+
+    auto hasReference = false;
+    auto oldReference = ll::vec3ui {};
+    auto newReference = ll::vec3ui {};
+
+    for (auto index = size_t {0}; index < m_initPorts.size() && index < m_objects.size(); ++index) {
+
+        const auto& [oldObj, oldShape] = m_initPorts[index];
+        const auto& obj                = m_objects[index].second;
+        if (oldObj == nullptr || obj == nullptr) {
+            continue;
+        }
+
+        if (oldObj != obj) {
+            objects[impl::getObjectResource(oldObj).get()] = impl::getObjectResource(obj);
+            objects[oldObj.get()]                          = obj;
+        }
+
+        // the first port image whose shape changed is used as reference to scale the internal images
+        const auto image = impl::getObjectImage(obj);
+        if (!hasReference && image != nullptr && (image->getWidth() != oldShape.x || image->getHeight() != oldShape.y)) {
+            hasReference = true;
+            oldReference = oldShape;
+            newReference = image->getShape();
+        }
+    }
+
+    if (!objects.empty()) {
+        rebindObjects(objects);
+    }
+
+    if (hasReference) {
+
+        // images bound or reshaped by the caller since the last initialization keep their shape.
+        // Port images created by the builder, such as outputs, follow the reference as internal images.
+        auto portImages = std::set<const ll::Image*> {};
+        for (auto index = size_t {0}; index < m_objects.size(); ++index) {
+
+            const auto image = impl::getObjectImage(m_objects[index].second);
+            if (image == nullptr) {
+                continue;
+            }
+
+            const auto isInitPort = index < m_initPorts.size() && m_initPorts[index].first == m_objects[index].second;
+            if (!isInitPort || image->getWidth() != m_initPorts[index].second.x || image->getHeight() != m_initPorts[index].second.y) {
+                portImages.insert(image.get());
+            }
+        }
+
+        auto computeNodes = std::vector<std::shared_ptr<ll::ComputeNode>> {};
+        collectComputeNodes(computeNodes);
+
+        auto images = std::vector<std::shared_ptr<ll::Image>> {};
+        for (const auto& node : computeNodes) {
+            for (auto index = uint32_t {0}; index < node->m_objects.size(); ++index) {
+
+                auto image = impl::getObjectImage(node->m_objects[index]);
+                if (image == nullptr
+                    || node->m_descriptor.getPort(index).getDirection() == ll::PortDirection::In
+                    || portImages.count(image.get()) != 0
+                    || std::find(images.cbegin(), images.cend(), image) != images.cend()) {
+                    continue;
+                }
+
+                images.push_back(image);
+            }
+        }
+
+        // reshaping an image rewrites the descriptor sets of the nodes it is bound to.
+        // Images whose shape is not derived from the reference, such as lookup tables, are kept.
+        for (const auto& image : images) {
+            if (const auto shape = impl::scaleShape(image->getShape(), oldReference, newReference)) {
+                image->reshape(*shape);
+            }
+        }
+    }
+
+    reinitNodes();
 }
 
 std::shared_ptr<ll::Node> ContainerNode::getNode(const std::string& name) const
 {
 
-    const auto it = m_nodes.find(name);
+    return m_nodes[getNodeIndex(name)].second;
+}
+
+std::shared_ptr<ll::Node> ContainerNode::getNode(const uint32_t index) const
+{
+
+    if (index >= m_nodes.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Node index [" + std::to_string(index) + "] out of range.");
+    }
+
+    return m_nodes[index].second;
+}
+
+uint32_t ContainerNode::getNodeIndex(const std::string& name) const
+{
+
+    const auto it = m_nodeIndices.find(name);
 
-    ll::throwSystemErrorIf(it == m_nodes.cend(), ll::ErrorCode::KeyNotFound, "Node [" + name + "] not found.");
+    ll::throwSystemErrorIf(it == m_nodeIndices.cend(), ll::ErrorCode::KeyNotFound, "Node [" + name + "] not found.");
     return it->second;
 }
 
@@ -87,7 +414,10 @@ void ContainerNode::record(ll::CommandBuffer& commandBuffer) const
     ll::throwSystemErrorIf(getState() != ll::NodeState::Init, ll::ErrorCode::InvalidNodeState, "node must be in Init state before calling record()");
 
     const auto builderName = m_descriptor.getBuilderName();
-    if (!builderName.empty()) {
+    if (m_builder != nullptr) {
+        m_builder->onNodeRecord(*this, commandBuffer);
+
+    } else if (!builderName.empty()) {
 
         if (auto shared_interpreter = m_interpreter.lock()) {
             constexpr const auto lua = R"(
@@ -108,7 +438,13 @@ void ContainerNode::onInit()
 {
 
     const auto builderName = m_descriptor.getBuilderName();
-    if (!builderName.empty()) {
+    if (m_prototype != nullptr) {
+        initInstance();
+
+    } else if (m_builder != nullptr) {
+        m_builder->onNodeInit(*this);
+
+    } else if (!builderName.empty()) {
 
         if (auto shared_interpreter = m_interpreter.lock()) {
             constexpr const auto lua = R"(
@@ -123,6 +459,404 @@ void ContainerNode::onInit()
             ll::throwSystemError(ll::ErrorCode::SessionLost, "Attempt to access the Lua interpreter of a Session already destroyed.");
         }
     }
+
+    if (!m_transientImages.empty()) {
+        aliasTransientImages();
+    }
+
+    m_transientImagesAliased = true;
+    saveInitPorts();
+}
+
+void ContainerNode::initInstance()
+{
+
+    const auto& prototype = *m_prototype;
+
+    auto computeNodes = std::vector<std::shared_ptr<ll::ComputeNode>> {};
+    prototype.collectComputeNodes(computeNodes);
+
+    // buffers and images written by the prototype get their own copy in this instance
+    auto writtenResources = std::set<const ll::Object*> {};
+    for (const auto& node : computeNodes) {
+        for (auto index = uint32_t {0}; index < node->m_objects.size(); ++index) {
+
+            const auto& obj = node->m_objects[index];
+            if (obj != nullptr && node->m_descriptor.getPort(index).getDirection() != ll::PortDirection::In) {
+                writtenResources.insert(impl::getObjectResource(obj).get());
+            }
+        }
+    }
+
+    // objects bound to this instance replace the ones bound to the prototype
+    auto objects = std::map<const ll::Object*, std::shared_ptr<ll::Object>> {};
+    for (auto index = uint32_t {0}; index < prototype.m_objects.size() && index < m_objects.size(); ++index) {
+
+        const auto& obj      = prototype.m_objects[index].second;
+        const auto& instance = m_objects[index].second;
+        if (obj == nullptr || instance == nullptr) {
+            continue;
+        }
+
+        objects[impl::getObjectResource(obj).get()] = impl::getObjectResource(instance);
+        objects[obj.get()]                          = instance;
+    }
+
+    for (auto index = uint32_t {0}; index < prototype.m_objects.size(); ++index) {
+
+        const auto& [name, obj] = prototype.m_objects[index];
+        if (obj != nullptr && (index >= m_objects.size() || m_objects[index].second == nullptr)) {
+            bind(name, impl::instantiateObject(obj, objects, writtenResources));
+        }
+    }
+
+    for (const auto& [name, node] : prototype.m_nodes) {
+
+        switch (node->getType()) {
+        case ll::NodeType::Compute: {
+
+            const auto& computeNode = static_cast<const ll::ComputeNode&>(*node);
+            auto        instance    = computeNode.instantiate();
+
+            for (auto index = uint32_t {0}; index < computeNode.m_objects.size(); ++index) {
+
+                const auto& obj = computeNode.m_objects[index];
+                if (obj == nullptr) {
+                    continue;
+                }
+
+                const auto instanceObj = impl::instantiateObject(obj, objects, writtenResources);
+
+                const auto it = computeNode.m_bufferRanges.find(index);
+                if (it != computeNode.m_bufferRanges.cend()) {
+                    instance->bindRange(computeNode.m_descriptor.getPort(index).getName(), std::static_pointer_cast<ll::Buffer>(instanceObj), it->second.first, it->second.second);
+                } else {
+                    instance->bind(index, instanceObj);
+                }
+            }
+
+            instance->m_dynamicOffsets = computeNode.m_dynamicOffsets;
+
+            // each instance owns its parameters, so updating them does not affect the prototype
+            const auto& prototypeBlock = computeNode.m_parameterBlock;
+            auto        instanceBlock  = std::shared_ptr<ll::ParameterBlock> {};
+
+            if (prototypeBlock != nullptr) {
+                instanceBlock = std::make_shared<ll::ParameterBlock>(prototypeBlock->getBuffer()->getMemory(),
+                    prototypeBlock->getBlockSize(), prototypeBlock->getSlotCount(), prototypeBlock->getSlotStride());
+
+                instance->bindParameterBlock(instanceBlock);
+                instance->setParameterBlockSlot(computeNode.m_parameterBlockSlot);
+            }
+
+            instance->init();
+
+            // init writes the descriptor push constants into every slot, the instance starts
+            // from the current content of the prototype instead
+            if (instanceBlock != nullptr) {
+                instanceBlock->copyFrom(*prototypeBlock);
+            }
+
+            bindNode(name, instance);
+        } break;
+
+        case ll::NodeType::Container: {
+
+            const auto& containerNode = static_cast<const ll::ContainerNode&>(*node);
+            auto        instance      = containerNode.instantiate();
+
+            for (const auto& [objName, obj] : containerNode.m_objects) {
+                if (obj != nullptr) {
+                    instance->bind(objName, impl::instantiateObject(obj, objects, writtenResources));
+                }
+            }
+
+            instance->init();
+            bindNode(name, instance);
+        } break;
+        }
+    }
+
+    for (const auto& image : prototype.m_transientImages) {
+        markTransient(impl::instantiateObject(image, objects, writtenResources));
+    }
+}
+
+void ContainerNode::rebindObjects(std::map<const ll::Object*, std::shared_ptr<ll::Object>>& objects)
+{
+
+    // views over a replaced resource are created again over the new one
+    const auto noWrittenResources = std::set<const ll::Object*> {};
+
+    for (const auto& kv : m_nodes) {
+
+        switch (kv.second->getType()) {
+        case ll::NodeType::Compute: {
+
+            auto& computeNode = static_cast<ll::ComputeNode&>(*kv.second);
+
+            for (auto index = uint32_t {0}; index < computeNode.m_objects.size(); ++index) {
+
+                const auto obj = computeNode.m_objects[index];
+                if (obj == nullptr) {
+                    continue;
+                }
+
+                const auto newObj = impl::instantiateObject(obj, objects, noWrittenResources);
+                if (newObj == obj) {
+                    continue;
+                }
+
+                const auto it = computeNode.m_bufferRanges.find(index);
+                if (it != computeNode.m_bufferRanges.cend()) {
+                    computeNode.bindRange(computeNode.m_descriptor.getPort(index).getName(), std::static_pointer_cast<ll::Buffer>(newObj), it->second.first, it->second.second);
+                } else {
+                    computeNode.bind(index, newObj);
+                }
+            }
+        } break;
+
+        case ll::NodeType::Container: {
+
+            auto& containerNode = static_cast<ll::ContainerNode&>(*kv.second);
+
+            for (auto& kv : containerNode.m_objects) {
+                if (kv.second != nullptr) {
+                    kv.second = impl::instantiateObject(kv.second, objects, noWrittenResources);
+                }
+            }
+
+            containerNode.rebindObjects(objects);
+        } break;
+        }
+    }
+}
+
+void ContainerNode::reinitNodes()
+{
+
+    for (const auto& kv : m_nodes) {
+
+        switch (kv.second->getType()) {
+        case ll::NodeType::Compute:
+            std::static_pointer_cast<ll::ComputeNode>(kv.second)->reinit();
+            break;
+        case ll::NodeType::Container:
+            std::static_pointer_cast<ll::ContainerNode>(kv.second)->reinitNodes();
+            break;
+        }
+    }
+
+    // reshaped transient images are no longer aliased
+    if (!m_transientImages.empty()) {
+        aliasTransientImages();
+    }
+
+    saveInitPorts();
+}
+
+void ContainerNode::saveInitPorts()
+{
+
+    m_initPorts.clear();
+    m_initPorts.reserve(m_objects.size());
+
+    for (const auto& kv : m_objects) {
+        const auto image = impl::getObjectImage(kv.second);
+        m_initPorts.emplace_back(kv.second, image != nullptr ? image->getShape() : ll::vec3ui {});
+    }
+}
+
+void ContainerNode::aliasTransientImages()
+{
+
+    constexpr const auto unused = std::numeric_limits<uint32_t>::max();
+
+    // first and last are indices of trace steps. Images whose first step is not a compute node
+    // cannot be aliased, as their content is discarded by the first node using them.
+    struct Lifetime {
+        uint32_t first {unused};
+        uint32_t last {0};
+        bool     isReadFirst {false};
+        bool     isPinned {false};
+    };
+
+    // record the schedule once to know the order in which the nodes and commands run
+    auto trace = ll::impl::CommandTrace {};
+
+    auto cmdBuffer     = m_transientImages.front()->m_device->createCommandBuffer();
+    cmdBuffer->m_trace = &trace;
+    cmdBuffer->begin();
+    record(*cmdBuffer);
+    cmdBuffer->end();
+
+    // only the descriptor sets of nodes reachable from this container can be updated
+    auto computeNodes = std::vector<std::shared_ptr<ll::ComputeNode>> {};
+    collectComputeNodes(computeNodes);
+
+    auto lifetimes = std::map<const ll::Image*, Lifetime> {};
+    for (const auto& image : m_transientImages) {
+        lifetimes[image.get()] = Lifetime {};
+    }
+
+    const auto stepCount = static_cast<uint32_t>(trace.steps.size());
+    for (auto step = uint32_t {0}; step < stepCount; ++step) {
+
+        const auto& traceStep = trace.steps[step];
+
+        // image clears and layout changes also access the image
+        if (traceStep.type == ll::impl::CommandTraceStepType::ClearImage
+            || traceStep.type == ll::impl::CommandTraceStepType::ChangeImageLayout) {
+
+            const auto it = lifetimes.find(traceStep.image);
+            if (it == lifetimes.end()) {
+                continue;
+            }
+
+            auto& lifetime = it->second;
+            if (lifetime.first == unused) {
+                lifetime.first       = step;
+                lifetime.isReadFirst = true;
+            }
+
+            lifetime.last = step;
+            continue;
+        }
+
+        if (traceStep.type != ll::impl::CommandTraceStepType::Run) {
+            continue;
+        }
+
+        const auto* node = traceStep.node;
+
+        const auto isReachable = std::any_of(computeNodes.cbegin(), computeNodes.cend(), [node](const auto& n) {
+            return n.get() == node;
+        });
+
+        for (auto index = uint32_t {0}; index < node->m_objects.size(); ++index) {
+
+            const auto image = impl::getObjectImage(node->m_objects[index]);
+            const auto it    = lifetimes.find(image.get());
+            if (it == lifetimes.end()) {
+                continue;
+            }
+
+            auto& lifetime = it->second;
+            if (lifetime.first == unused) {
+                lifetime.first = step;
+            }
+
+            if (lifetime.first == step && node->m_descriptor.getPort(index).getDirection() != ll::PortDirection::Out) {
+                lifetime.isReadFirst = true;
+            }
+
+            lifetime.last = step;
+            lifetime.isPinned |= !isReachable;
+        }
+    }
+
+    // commands missing from the trace, such as copies, may access any image
+    if (!trace.unsupportedCommand.empty()) {
+        for (auto& kv : lifetimes) {
+            kv.second.isPinned = true;
+        }
+    }
+
+    // images bound to the ports of this container are used outside of it
+    for (const auto& kv : m_objects) {
+
+        const auto it = lifetimes.find(impl::getObjectImage(kv.second).get());
+        if (it != lifetimes.end()) {
+            it->second.isPinned = true;
+        }
+    }
+
+    // group the images that can be aliased by the memory they are allocated in
+    auto groups = std::map<ll::Memory*, std::pair<std::vector<std::shared_ptr<ll::Image>>, std::vector<std::pair<uint32_t, uint32_t>>>> {};
+
+    for (const auto& image : m_transientImages) {
+
+        const auto& lifetime = lifetimes[image.get()];
+        if (lifetime.first == unused || lifetime.isReadFirst || lifetime.isPinned || image->isAliased()) {
+            continue;
+        }
+
+        auto& group = groups[image->getMemory().get()];
+        group.first.push_back(image);
+        group.second.emplace_back(lifetime.first, lifetime.last);
+    }
+
+    auto aliasedImages = std::set<const ll::Image*> {};
+
+    for (auto& kv : groups) {
+
+        auto& images = kv.second.first;
+
+        // a single image does not save any memory
+        if (images.size() < 2) {
+            continue;
+        }
+
+        images.front()->getMemory()->aliasImages(images, kv.second.second);
+
+        for (auto i = size_t {0}; i < images.size(); ++i) {
+
+            auto& image = images[i];
+            aliasedImages.insert(image.get());
+
+            // descriptor sets are written with the current layout, which is
+            // reached again at every execution by the first node using the image.
+            image->changeImageLayout(ll::ImageLayout::General);
+
+            const auto* firstNode = trace.steps[kv.second.second[i].first].node;
+            for (auto& node : computeNodes) {
+                if (node.get() == firstNode && std::find(node->m_transientImages.cbegin(), node->m_transientImages.cend(), image) == node->m_transientImages.cend()) {
+                    node->m_transientImages.push_back(image);
+                }
+            }
+        }
+    }
+
+    // images reshaped by ll::ContainerNode::reinit leave their previous block
+    auto blocks = std::set<const ll::impl::AliasedMemoryBlock*> {};
+    for (const auto& image : m_transientImages) {
+        if (image->isAliased()) {
+            blocks.insert(image->m_aliasedBlock.get());
+        }
+    }
+
+    m_transientMemorySize = 0;
+    for (const auto* block : blocks) {
+        m_transientMemorySize += block->getAllocationInfo().size;
+    }
+
+    // update the descriptor sets referring to the views of the aliased images
+    for (auto& node : computeNodes) {
+
+        const auto objects = node->m_objects;
+        for (auto index = uint32_t {0}; index < objects.size(); ++index) {
+
+            if (aliasedImages.count(impl::getObjectImage(objects[index]).get()) != 0) {
+                node->bind(index, objects[index]);
+            }
+        }
+    }
+}
+
+void ContainerNode::collectComputeNodes(std::vector<std::shared_ptr<ll::ComputeNode>>& nodes) const
+{
+
+    for (const auto& kv : m_nodes) {
+
+        switch (kv.second->getType()) {
+        case ll::NodeType::Compute:
+            nodes.push_back(std::static_pointer_cast<ll::ComputeNode>(kv.second));
+            break;
+        case ll::NodeType::Container:
+            std::static_pointer_cast<ll::ContainerNode>(kv.second)->collectComputeNodes(nodes);
+            break;
+        }
+    }
 }
 
 } // namespace ll
@@ -7,7 +7,14 @@ namespace ll {
 ContainerNodeDescriptor& ContainerNodeDescriptor::addPort(const ll::PortDescriptor& port)
 {
 
-    m_ports[port.getName()] = port;
+    const auto it = m_portIndices.find(port.getName());
+    if (it != m_portIndices.cend()) {
+        m_ports[it->second] = port;
+        return *this;
+    }
+
+    m_portIndices[port.getName()] = static_cast<uint32_t>(m_ports.size());
+    m_ports.push_back(port);
     return *this;
 }
 
@@ -22,26 +29,80 @@ ContainerNodeDescriptor& ContainerNodeDescriptor::addPorts(const std::initialize
 }
 
 const ll::PortDescriptor& ContainerNodeDescriptor::getPort(const std::string& name) const
+{
+    return m_ports[getPortIndex(name)];
+}
+
+const ll::PortDescriptor& ContainerNodeDescriptor::getPort(const uint32_t index) const
+{
+
+    if (index >= m_ports.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Port index [" + std::to_string(index) + "] out of range.");
+    }
+
+    return m_ports[index];
+}
+
+uint32_t ContainerNodeDescriptor::getPortIndex(const std::string& name) const
 {
 
-    auto it = m_ports.find(name);
+    auto it = m_portIndices.find(name);
 
-    ll::throwSystemErrorIf(it == m_ports.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
+    ll::throwSystemErrorIf(it == m_portIndices.cend(), ll::ErrorCode::KeyNotFound, "Port [" + name + "] not found.");
     return it->second;
 }
 
+size_t ContainerNodeDescriptor::getPortCount() const noexcept
+{
+    return m_ports.size();
+}
+
 ContainerNodeDescriptor& ContainerNodeDescriptor::setParameter(const std::string& name, const ll::Parameter& defaultValue)
 {
-    m_parameters[name] = defaultValue;
+
+    const auto it = m_parameterIndices.find(name);
+    if (it != m_parameterIndices.cend()) {
+        m_parameters[it->second] = defaultValue;
+        return *this;
+    }
+
+    m_parameterIndices[name] = static_cast<uint32_t>(m_parameters.size());
+    m_parameters.push_back(defaultValue);
+    return *this;
+}
+
+ContainerNodeDescriptor& ContainerNodeDescriptor::setParameter(const uint32_t index, const ll::Parameter& value)
+{
+
+    if (index >= m_parameters.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Parameter index [" + std::to_string(index) + "] out of range.");
+    }
+
+    m_parameters[index] = value;
     return *this;
 }
 
 const ll::Parameter& ContainerNodeDescriptor::getParameter(const std::string& name) const
+{
+    return m_parameters[getParameterIndex(name)];
+}
+
+const ll::Parameter& ContainerNodeDescriptor::getParameter(const uint32_t index) const
+{
+
+    if (index >= m_parameters.size()) {
+        ll::throwSystemError(ll::ErrorCode::KeyNotFound, "Parameter index [" + std::to_string(index) + "] out of range.");
+    }
+
+    return m_parameters[index];
+}
+
+uint32_t ContainerNodeDescriptor::getParameterIndex(const std::string& name) const
 {
 
-    auto it = m_parameters.find(name);
+    auto it = m_parameterIndices.find(name);
 
-    ll::throwSystemErrorIf(it == m_parameters.cend(), ll::ErrorCode::KeyNotFound, "Parameter [" + name + "] not found.");
+    ll::throwSystemErrorIf(it == m_parameterIndices.cend(), ll::ErrorCode::KeyNotFound, "Parameter [" + name + "] not found.");
     return it->second;
 }
 
@@ -57,4 +118,15 @@ const std::string& ContainerNodeDescriptor::getBuilderName() const noexcept
     return m_builderName;
 }
 
+ContainerNodeDescriptor& ContainerNodeDescriptor::setStencilRadius(const uint32_t radius) noexcept
+{
+    m_stencilRadius = radius;
+    return *this;
+}
+
+uint32_t ContainerNodeDescriptor::getStencilRadius() const noexcept
+{
+    return m_stencilRadius;
+}
+
 } // namespace ll
@@ -0,0 +1,19 @@
+/**
+@file       NodeBuilder.cpp
+@brief      NodeBuilder classes.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/node/NodeBuilder.h"
+
+#include "lluvia/core/node/ComputeNode.h"
+
+namespace ll {
+
+void ComputeNodeBuilder::onNodeReshape(ll::ComputeNode& node)
+{
+    node.scaleGridShape();
+}
+
+} // namespace ll
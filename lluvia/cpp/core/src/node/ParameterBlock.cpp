@@ -0,0 +1,104 @@
+/**
+@file       ParameterBlock.cpp
+@brief      ParameterBlock class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#include "lluvia/core/node/ParameterBlock.h"
+
+#include "lluvia/core/error.h"
+#include "lluvia/core/memory/Memory.h"
+
+#include <cstring>
+
+namespace ll {
+
+ParameterBlock::ParameterBlock(const std::shared_ptr<ll::Memory>& memory,
+    const uint64_t                                                blockSize,
+    const uint32_t                                                slotCount,
+    const uint64_t                                                slotAlignment)
+    : m_blockSize {blockSize}
+    , m_slotCount {slotCount}
+{
+
+    ll::throwSystemErrorIf(blockSize == 0, ll::ErrorCode::InvalidArgument, "parameter block size must be greater than zero.");
+    ll::throwSystemErrorIf(slotCount == 0, ll::ErrorCode::InvalidArgument, "parameter block slot count must be greater than zero.");
+    ll::throwSystemErrorIf(!memory->isMappable(), ll::ErrorCode::InvalidArgument, "parameter block memory must be mappable to host memory.");
+
+    const auto alignment = slotAlignment == 0 ? uint64_t {1} : slotAlignment;
+    m_slotStride         = ((blockSize + alignment - 1) / alignment) * alignment;
+
+    m_buffer = memory->createBuffer(m_slotStride * slotCount, ll::BufferUsageFlagBits::UniformBuffer);
+
+    // persistent mapping, released when this object is destroyed
+    m_mappedPtr = m_buffer->map<uint8_t[]>();
+    std::memset(m_mappedPtr.get(), 0, m_slotStride * slotCount);
+}
+
+uint64_t ParameterBlock::getBlockSize() const noexcept
+{
+    return m_blockSize;
+}
+
+uint32_t ParameterBlock::getSlotCount() const noexcept
+{
+    return m_slotCount;
+}
+
+uint64_t ParameterBlock::getSlotStride() const noexcept
+{
+    return m_slotStride;
+}
+
+uint64_t ParameterBlock::getSlotOffset(const uint32_t slot) const
+{
+
+    ll::throwSystemErrorIf(slot >= m_slotCount, ll::ErrorCode::InvalidArgument,
+        "slot index " + std::to_string(slot) + " out of range, slot count: " + std::to_string(m_slotCount));
+
+    return slot * m_slotStride;
+}
+
+const std::shared_ptr<ll::Buffer>& ParameterBlock::getBuffer() const noexcept
+{
+    return m_buffer;
+}
+
+void ParameterBlock::write(const uint32_t slot, const void* data, const uint64_t size)
+{
+
+    ll::throwSystemErrorIf(size > m_blockSize, ll::ErrorCode::InvalidArgument,
+        "data size (" + std::to_string(size) + " bytes) is greater than the parameter block size (" + std::to_string(m_blockSize) + " bytes)");
+
+    std::memcpy(m_mappedPtr.get() + getSlotOffset(slot), data, size);
+}
+
+void ParameterBlock::write(const uint32_t slot, const ll::PushConstants& constants)
+{
+
+    if (constants.getSize() == 0) {
+        return;
+    }
+
+    write(slot, constants.getPtr(), constants.getSize());
+}
+
+void ParameterBlock::writeAll(const ll::PushConstants& constants)
+{
+
+    for (auto slot = 0u; slot < m_slotCount; ++slot) {
+        write(slot, constants);
+    }
+}
+
+void ParameterBlock::copyFrom(const ll::ParameterBlock& other)
+{
+
+    ll::throwSystemErrorIf(other.m_blockSize != m_blockSize || other.m_slotCount != m_slotCount || other.m_slotStride != m_slotStride,
+        ll::ErrorCode::InvalidArgument, "parameter blocks must have the same block size, slot count and slot stride.");
+
+    std::memcpy(m_mappedPtr.get(), other.m_mappedPtr.get(), m_slotStride * m_slotCount);
+}
+
+} // namespace ll
@@ -9,6 +9,7 @@
 
 #include "lluvia/core/Object.h"
 #include "lluvia/core/buffer/Buffer.h"
+#include "lluvia/core/buffer/BufferView.h"
 #include "lluvia/core/image/ImageView.h"
 
 namespace ll {
@@ -87,6 +88,9 @@ std::pair<bool, std::string> PortDescriptor::isValid(const std::shared_ptr<ll::O
     case ll::ObjectType::ImageView:
         return validateImageView(std::static_pointer_cast<ll::ImageView>(port));
 
+    case ll::ObjectType::BufferView:
+        return validateBufferView(std::static_pointer_cast<ll::BufferView>(port));
+
     default:
         return std::make_pair(false, "Unsupported object type: " + ll::objectTypeToString(port->getType()));
     }
@@ -97,11 +101,14 @@ std::pair<bool, std::string> PortDescriptor::isValid(const std::shared_ptr<ll::O
 std::pair<bool, std::string> PortDescriptor::validateBuffer(const std::shared_ptr<ll::Buffer>& port) const noexcept
 {
 
-    if (m_portType != ll::PortType::Buffer && m_portType != ll::PortType::UniformBuffer) {
+    if (m_portType != ll::PortType::Buffer
+        && m_portType != ll::PortType::UniformBuffer
+        && m_portType != ll::PortType::UniformBufferDynamic
+        && m_portType != ll::PortType::StorageBufferDynamic) {
         return std::make_pair(false, "Port " + toString() + " cannot receive object of type ll::PortType::Buffer");
     }
 
-    if (m_portType == ll::PortType::UniformBuffer) {
+    if (m_portType == ll::PortType::UniformBuffer || m_portType == ll::PortType::UniformBufferDynamic) {
 
         // check that the buffer contains UniformBuffer in its usage flags
         if (static_cast<ll::enum_t>(port->getUsageFlags() & ll::BufferUsageFlagBits::UniformBuffer) == 0) {
@@ -163,6 +170,53 @@ std::pair<bool, std::string> PortDescriptor::validateImageView(const std::shared
     return std::make_pair(true, std::string {});
 }
 
+std::pair<bool, std::string> PortDescriptor::validateBufferView(const std::shared_ptr<ll::BufferView>& port) const noexcept
+{
+
+    const auto usageFlags = port->getBuffer()->getUsageFlags();
+
+    if (m_portType == ll::PortType::UniformTexelBuffer) {
+        if (static_cast<ll::enum_t>(usageFlags & ll::BufferUsageFlagBits::UniformTexelBuffer) == 0) {
+            return std::make_pair(false, "Port " + toString() + " has received a "
+                                                                "buffer view without ll::BufferUsageFlagBits::UniformTexelBuffer usage flag");
+        }
+
+    } else if (m_portType == ll::PortType::StorageTexelBuffer) {
+        if (static_cast<ll::enum_t>(usageFlags & ll::BufferUsageFlagBits::StorageTexelBuffer) == 0) {
+            return std::make_pair(false, "Port " + toString() + " has received a "
+                                                                "buffer view without ll::BufferUsageFlagBits::StorageTexelBuffer usage flag");
+        }
+
+    } else {
+        return std::make_pair(false, "Port " + toString() + " cannot receive object of type ll::ObjectType::BufferView");
+    }
+
+    ///////////////////////////////////////////////////////
+    // Optional checks
+    ///////////////////////////////////////////////////////
+
+    if (m_checkImageChannelCount.has_value() && m_checkImageChannelCount.value() != port->getChannelCount()) {
+
+        return std::make_pair(false, "Port " + toString() + " invalid texel channel count, expecting: " + std::to_string(static_cast<enum_t>(m_checkImageChannelCount.value())) + " got: " + std::to_string(static_cast<enum_t>(port->getChannelCount())));
+    }
+
+    if (m_checkImageChannelType.has_value()) {
+        const auto& validChannelTypes = m_checkImageChannelType.value();
+
+        if (std::find(validChannelTypes.cbegin(), validChannelTypes.cend(), port->getChannelType()) == validChannelTypes.cend()) {
+
+            auto cTypeString = std::string {};
+            for (const auto& cType : validChannelTypes) {
+                cTypeString += ll::channelTypeToString(cType) + ", ";
+            }
+
+            return std::make_pair(false, "Port " + toString() + " invalid texel channel type," + " expecting any of: [" + cTypeString + "]" + " got: " + ll::channelTypeToString(port->getChannelType()));
+        }
+    }
+
+    return std::make_pair(true, std::string {});
+}
+
 std::string PortDescriptor::toString() const noexcept
 {
     return "{binding: " + std::to_string(m_binding)
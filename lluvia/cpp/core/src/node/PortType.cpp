@@ -28,6 +28,18 @@ vk::DescriptorType portTypeToVkDescriptorType(const ll::PortType& param)
 
     case ll::PortType::UniformBuffer:
         return vk::DescriptorType::eUniformBuffer;
+
+    case ll::PortType::UniformBufferDynamic:
+        return vk::DescriptorType::eUniformBufferDynamic;
+
+    case ll::PortType::StorageBufferDynamic:
+        return vk::DescriptorType::eStorageBufferDynamic;
+
+    case ll::PortType::UniformTexelBuffer:
+        return vk::DescriptorType::eUniformTexelBuffer;
+
+    case ll::PortType::StorageTexelBuffer:
+        return vk::DescriptorType::eStorageTexelBuffer;
     }
 }
 
@@ -47,12 +59,20 @@ ll::PortType vkDescriptorTypeToPortType(const vk::DescriptorType& vkDescType)
     case vk::DescriptorType::eUniformBuffer:
         return ll::PortType::UniformBuffer;
 
-    case vk::DescriptorType::eSampler:
-    case vk::DescriptorType::eSampledImage:
-    case vk::DescriptorType::eUniformTexelBuffer:
-    case vk::DescriptorType::eStorageTexelBuffer:
     case vk::DescriptorType::eUniformBufferDynamic:
+        return ll::PortType::UniformBufferDynamic;
+
     case vk::DescriptorType::eStorageBufferDynamic:
+        return ll::PortType::StorageBufferDynamic;
+
+    case vk::DescriptorType::eUniformTexelBuffer:
+        return ll::PortType::UniformTexelBuffer;
+
+    case vk::DescriptorType::eStorageTexelBuffer:
+        return ll::PortType::StorageTexelBuffer;
+
+    case vk::DescriptorType::eSampler:
+    case vk::DescriptorType::eSampledImage:
     case vk::DescriptorType::eInputAttachment:
     default: // to cover descriptor types added by extensions
         throw std::system_error(createErrorCode(ll::ErrorCode::EnumConversionFailed), "cannot convert from Vulkan DescriptorType enum value to ll::PortType.");
@@ -7,6 +7,7 @@
 #include "lluvia/core/image/ImageUsageFlags.h"
 
 #include <algorithm>
+#include <iterator>
 
 namespace ll::vulkan {
 
@@ -60,21 +61,27 @@ ll::vec3ui computeOptimalLocalShape(ll::ComputeDimension dimension, uint32_t max
 Device::Device(const vk::Device&                 device,
     const vk::PhysicalDevice&                    physicalDevice,
     const uint32_t                               computeQueueFamilyIndex,
-    const std::shared_ptr<ll::vulkan::Instance>& instance)
+    const std::shared_ptr<ll::vulkan::Instance>& instance,
+    const std::vector<std::string>&              enabledExtensions)
     : m_device {device}
     , m_physicalDevice {physicalDevice}
     , m_computeQueueFamilyIndex {computeQueueFamilyIndex}
+    , m_enabledExtensions {enabledExtensions}
     , m_instance {instance}
 {
 
-    m_physicalDeviceLimits    = m_physicalDevice.getProperties().limits;
+    const auto properties = m_physicalDevice.getProperties();
+
+    m_physicalDeviceLimits    = properties.limits;
+    m_apiVersion              = properties.apiVersion;
     m_computeQueueFamilyIndex = getComputeFamilyQueueIndex();
 
     const auto createInfo = vk::CommandPoolCreateInfo()
                                 .setQueueFamilyIndex(m_computeQueueFamilyIndex);
 
-    m_commandPool = m_device.createCommandPool(createInfo);
-    m_queue       = m_device.getQueue(m_computeQueueFamilyIndex, 0);
+    m_commandPool   = m_device.createCommandPool(createInfo);
+    m_pipelineCache = m_device.createPipelineCache(vk::PipelineCacheCreateInfo {});
+    m_queue         = m_device.getQueue(m_computeQueueFamilyIndex, 0);
 
     /////////////////////////////////////////////////////
     // compute optimal compute shapes for all dimensions
@@ -91,10 +98,49 @@ Device::Device(const vk::Device&                 device,
 
 Device::~Device()
 {
+
+    for (const auto& entry : m_samplerCache) {
+        m_device.destroySampler(entry.sampler);
+    }
+
+    m_device.destroyPipelineCache(m_pipelineCache);
     m_device.destroyCommandPool(m_commandPool);
     m_device.destroy();
 }
 
+vk::Sampler Device::acquireSampler(const vk::SamplerCreateInfo& info)
+{
+
+    auto it = std::find_if(m_samplerCache.begin(), m_samplerCache.end(), [&info](const auto& entry) { return entry.info == info; });
+
+    if (it == m_samplerCache.end()) {
+        m_samplerCache.push_back({info, m_device.createSampler(info), 0});
+        it = std::prev(m_samplerCache.end());
+    }
+
+    ++it->referenceCount;
+    return it->sampler;
+}
+
+void Device::releaseSampler(const vk::Sampler& sampler) noexcept
+{
+
+    auto it = std::find_if(m_samplerCache.begin(), m_samplerCache.end(), [&sampler](const auto& entry) { return entry.sampler == sampler; });
+    if (it == m_samplerCache.end()) {
+        return;
+    }
+
+    if (--it->referenceCount == 0) {
+        m_device.destroySampler(it->sampler);
+        m_samplerCache.erase(it);
+    }
+}
+
+size_t Device::getSamplerCount() const noexcept
+{
+    return m_samplerCache.size();
+}
+
 vk::Device& Device::get() noexcept
 {
     return m_device;
@@ -115,6 +161,11 @@ vk::CommandPool& Device::getCommandPool() noexcept
     return m_commandPool;
 }
 
+vk::PipelineCache& Device::getPipelineCache() noexcept
+{
+    return m_pipelineCache;
+}
+
 uint32_t Device::getComputeFamilyQueueIndex() const noexcept
 {
     return m_computeQueueFamilyIndex;
@@ -152,25 +203,116 @@ bool Device::isImageDescriptorSupported(const ll::ImageDescriptor& descriptor) c
     return !(descriptor.getWidth() > formatProperties.maxExtent.width || descriptor.getHeight() > formatProperties.maxExtent.height || descriptor.getDepth() > formatProperties.maxExtent.depth);
 }
 
+bool Device::isExtensionEnabled(const std::string& name) const noexcept
+{
+    return std::find(m_enabledExtensions.cbegin(), m_enabledExtensions.cend(), name) != m_enabledExtensions.cend();
+}
+
+bool Device::isDedicatedAllocationSupported() const noexcept
+{
+    return m_apiVersion >= VK_API_VERSION_1_1;
+}
+
+bool Device::isMemoryBudgetSupported() const noexcept
+{
+    return isExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+}
+
+vk::PhysicalDeviceMemoryBudgetPropertiesEXT Device::getMemoryBudgetProperties()
+{
+
+    ll::throwSystemErrorIf(!isMemoryBudgetSupported(), ll::ErrorCode::ExtensionNotFound,
+        std::string {"extension not enabled: "} + VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    const auto chain = m_physicalDevice.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2, vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+    return chain.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+}
+
+bool Device::isExternalMemoryHostSupported() const noexcept
+{
+    return isExtensionEnabled(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+}
+
+uint64_t Device::getMinImportedHostPointerAlignment()
+{
+
+    ll::throwSystemErrorIf(!isExternalMemoryHostSupported(), ll::ErrorCode::ExtensionNotFound,
+        std::string {"extension not enabled: "} + VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+
+    const auto chain = m_physicalDevice.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>();
+    return chain.get<vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>().minImportedHostPointerAlignment;
+}
+
+uint32_t Device::getHostPointerMemoryTypeBits(const void* ptr)
+{
+
+    ll::throwSystemErrorIf(!isExternalMemoryHostSupported(), ll::ErrorCode::ExtensionNotFound,
+        std::string {"extension not enabled: "} + VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+
+    // extension commands are not exported by the loader, load it from the device
+    const auto getMemoryHostPointerProperties = reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+        m_device.getProcAddr("vkGetMemoryHostPointerPropertiesEXT"));
+
+    ll::throwSystemErrorIf(getMemoryHostPointerProperties == nullptr, ll::ErrorCode::ExtensionNotFound,
+        "cannot load vkGetMemoryHostPointerPropertiesEXT");
+
+    auto properties = VkMemoryHostPointerPropertiesEXT {};
+    properties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+
+    const auto result = getMemoryHostPointerProperties(static_cast<VkDevice>(m_device),
+        VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, ptr, &properties);
+
+    ll::throwSystemErrorIf(result != VK_SUCCESS, ll::ErrorCode::VulkanError,
+        "error querying host pointer properties (" + vk::to_string(static_cast<vk::Result>(result)) + ")");
+
+    return properties.memoryTypeBits;
+}
+
 std::unique_ptr<ll::CommandBuffer> Device::createCommandBuffer()
 {
     return std::make_unique<ll::CommandBuffer>(shared_from_this());
 }
 
 void Device::run(const ll::CommandBuffer& cmdBuffer)
+{
+
+    submit(cmdBuffer, nullptr);
+    m_queue.waitIdle();
+}
+
+void Device::submit(const ll::CommandBuffer& cmdBuffer, const vk::Fence& fence)
 {
 
     vk::SubmitInfo submitInfo = vk::SubmitInfo()
                                     .setCommandBufferCount(1)
                                     .setPCommandBuffers(&cmdBuffer.getVkCommandBuffer());
 
-    auto result = m_queue.submit(1, &submitInfo, nullptr);
+    auto result = m_queue.submit(1, &submitInfo, fence);
 
     ll::throwSystemErrorIf(result != vk::Result::eSuccess,
         ll::ErrorCode::VulkanError,
         "error submitting command buffer for execution.");
+}
 
-    m_queue.waitIdle();
+std::vector<uint8_t> Device::getPipelineCacheData() const
+{
+    return m_device.getPipelineCacheData(m_pipelineCache);
+}
+
+void Device::mergePipelineCacheData(const std::vector<uint8_t>& data)
+{
+
+    if (data.empty()) {
+        return;
+    }
+
+    const auto createInfo = vk::PipelineCacheCreateInfo {}
+                                .setInitialDataSize(data.size())
+                                .setPInitialData(data.data());
+
+    auto source = m_device.createPipelineCache(createInfo);
+    m_device.mergePipelineCaches(m_pipelineCache, 1, &source);
+    m_device.destroyPipelineCache(source);
 }
 
 } // namespace ll::lluvia
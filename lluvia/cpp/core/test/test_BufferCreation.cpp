@@ -9,7 +9,13 @@
 #include "catch2/catch.hpp"
 
 #include "lluvia/core.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <numeric>
+#include <system_error>
 
 /**
  * Test that the returned memory flags meet the Vulkan speficiation
@@ -85,3 +91,217 @@ TEST_CASE("BufferSizeEqualPageSize", "test_BufferCreation")
 
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
 }
+
+TEST_CASE("TrimEmptyPages", "test_BufferCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->createMemory(ll::MemoryPropertyFlagBits::DeviceLocal, 4096, false);
+    REQUIRE(memory != nullptr);
+
+    auto buffer0 = memory->createBuffer(1024);
+    auto buffer1 = memory->createBuffer(8192); // larger than the page size, goes to a new page
+    REQUIRE(memory->getPageCount() == 2);
+
+    auto stats = memory->getStatistics();
+    REQUIRE(stats.pages.size() == 2);
+    REQUIRE(stats.usedSize >= 1024 + 8192);
+    REQUIRE(stats.committedSize >= 4096 + 8192);
+
+    // page 0 is still in use
+    buffer1.reset();
+    const auto released = memory->trim();
+    REQUIRE(released >= 8192);
+    REQUIRE(memory->getPageCount() == 1);
+
+    stats = memory->getStatistics();
+    REQUIRE(stats.pages.size() == 1);
+    REQUIRE(stats.pages[0].page == 0);
+    REQUIRE(stats.pages[0].usedSize >= 1024);
+    REQUIRE(stats.pages[0].largestFreeSize <= 4096 - 1024);
+
+    // the released page slot is reused
+    auto buffer2 = memory->createBuffer(8192);
+    REQUIRE(buffer2->getAllocationInfo().page == 1);
+    REQUIRE(memory->getPageCount() == 2);
+
+    buffer2.reset();
+    buffer0.reset();
+    REQUIRE(memory->trim() >= 4096 + 8192);
+    REQUIRE(memory->getPageCount() == 0);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("AutoTrim", "test_BufferCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->createMemory(ll::MemoryPropertyFlagBits::DeviceLocal, 4096, false);
+    REQUIRE(memory != nullptr);
+
+    REQUIRE_THROWS_AS(memory->enableAutoTrim(4096, 8192), std::system_error);
+
+    // keep up to one empty page, release once there are more than two
+    memory->enableAutoTrim(2 * 4096, 4096);
+    REQUIRE(memory->isAutoTrimEnabled());
+
+    auto buffer0 = memory->createBuffer(4096);
+    auto buffer1 = memory->createBuffer(4096);
+    auto buffer2 = memory->createBuffer(4096);
+    REQUIRE(memory->getPageCount() == 3);
+
+    buffer0.reset();
+    buffer1.reset();
+    REQUIRE(memory->getPageCount() == 3);
+
+    // three empty pages go over the high threshold
+    buffer2.reset();
+    REQUIRE(memory->getPageCount() == 1);
+
+    memory->disableAutoTrim();
+    REQUIRE_FALSE(memory->isAutoTrimEnabled());
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("HeapBudgets", "test_BufferCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->createMemory(ll::MemoryPropertyFlagBits::DeviceLocal, 4096, false);
+    REQUIRE(memory != nullptr);
+
+    auto buffer = memory->createBuffer(1024);
+
+    const auto budgets = memory->getHeapBudgets();
+    REQUIRE_FALSE(budgets.empty());
+
+    for (const auto& budget : budgets) {
+        REQUIRE(budget.budget > 0);
+    }
+
+    const auto stats = memory->getStatistics();
+    REQUIRE(stats.pages.size() == 1);
+
+    // the page is allocated from one of the heaps reported
+    const auto heapIndex = session->getPhysicalDeviceMemoryProperties().memoryTypes[stats.pages[0].memoryTypeIndex].heapIndex;
+    REQUIRE(std::any_of(budgets.cbegin(), budgets.cend(), [heapIndex](const auto& b) { return b.heapIndex == heapIndex; }));
+
+    // dedicated pages are released together with their object
+    const auto dedicated = stats.pages[0].dedicated;
+    buffer.reset();
+    REQUIRE(memory->getPageCount() == (dedicated ? 0u : 1u));
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ImportHostMemory", "test_BufferCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    if (!session->isHostMemoryImportSupported()) {
+        REQUIRE_THROWS_AS(session->getMinImportedHostPointerAlignment(), std::system_error);
+        return;
+    }
+
+    const auto alignment = session->getMinImportedHostPointerAlignment();
+    const auto size      = 4 * alignment;
+    const auto length    = size / sizeof(uint32_t);
+
+    auto hostData = std::unique_ptr<uint32_t, decltype(&std::free)> {static_cast<uint32_t*>(std::aligned_alloc(alignment, size)), &std::free};
+    REQUIRE(hostData != nullptr);
+
+    std::iota(hostData.get(), hostData.get() + length, 0u);
+
+    // not aligned
+    REQUIRE_THROWS_AS(session->importHostMemory(hostData.get() + 1, alignment), std::system_error);
+    REQUIRE_THROWS_AS(session->importHostMemory(hostData.get(), alignment + 1), std::system_error);
+
+    auto imported = session->importHostMemory(hostData.get(), size);
+    REQUIRE(imported != nullptr);
+    REQUIRE(imported->getSize() == size);
+
+    // the device reads the host data through the imported buffer and writes it back
+    auto deviceBuffer = session->getDeviceMemory()->createBuffer(size);
+
+    auto cmdBuffer = session->createCommandBuffer();
+    cmdBuffer->begin();
+    cmdBuffer->copyBuffer(*imported, *deviceBuffer);
+    cmdBuffer->memoryBarrier();
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    std::fill(hostData.get(), hostData.get() + length, 0u);
+
+    auto readback = session->createCommandBuffer();
+    readback->begin();
+    readback->copyBuffer(*deviceBuffer, *imported);
+    readback->end();
+
+    session->run(*readback);
+
+    for (auto i = 0u; i < length; ++i) {
+        REQUIRE(hostData.get()[i] == i);
+    }
+
+    // the buffer is deleted before the host memory
+    imported.reset();
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ReadbackMemory", "test_BufferCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto uploadMemory   = session->getUploadMemory();
+    auto readbackMemory = session->getReadbackMemory();
+
+    REQUIRE(uploadMemory != nullptr);
+    REQUIRE(readbackMemory != nullptr);
+    REQUIRE(uploadMemory->isMappable());
+    REQUIRE(readbackMemory->isMappable());
+
+    constexpr const auto length = 1024u;
+    const auto           size   = length * sizeof(uint32_t);
+
+    auto uploadBuffer   = uploadMemory->createBuffer(size);
+    auto deviceBuffer   = session->getDeviceMemory()->createBuffer(size);
+    auto readbackBuffer = readbackMemory->createBuffer(size);
+
+    {
+        auto uploadMap = uploadBuffer->map<uint32_t[]>();
+        std::iota(uploadMap.get(), uploadMap.get() + length, 0u);
+    }
+
+    auto cmdBuffer = session->createCommandBuffer();
+    cmdBuffer->begin();
+    cmdBuffer->copyBuffer(*uploadBuffer, *deviceBuffer);
+    cmdBuffer->memoryBarrier();
+    cmdBuffer->copyBuffer(*deviceBuffer, *readbackBuffer);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    // mapping invalidates the range if the memory is not host coherent
+    {
+        auto readbackMap = readbackBuffer->map<uint32_t[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(readbackMap[i] == i);
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
@@ -11,6 +11,7 @@
 #include "lluvia/core.h"
 #include <cstdint>
 #include <iostream>
+#include <system_error>
 
 #include "tools/cpp/runfiles/runfiles.h"
 using bazel::tools::cpp::runfiles::Runfiles;
@@ -74,6 +75,75 @@ TEST_CASE("BufferAssignment", "test_ComputeNode")
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
 }
 
+TEST_CASE("GridRegion", "test_ComputeNode")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t   length = 128;
+    constexpr const uint32_t localX = 32;
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto buffer = session->getHostMemory()->createBuffer(length * sizeof(float));
+    REQUIRE(buffer != nullptr);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            bufferMap[i] = -1.0f;
+        }
+    }
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto nodeDescriptor = ll::ComputeNodeDescriptor()
+                              .setProgram(program)
+                              .setFunctionName("main")
+                              .setLocalX(localX)
+                              .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+
+    // offset not aligned to the local shape
+    REQUIRE_THROWS_AS(nodeDescriptor.configureGridRegion({16, 0, 0}, {32, 1, 1}), std::system_error);
+
+    auto node = session->createComputeNode(nodeDescriptor);
+    REQUIRE(node != nullptr);
+
+    node->bind("out_buffer", buffer);
+    node->init();
+
+    // process [32, 64) and [96, 128) in the same command buffer
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+
+    node->configureGridRegion({32, 0, 0}, {32, 1, 1});
+    REQUIRE(node->getGridOffset().x == 1);
+    REQUIRE(node->getGridShape().x == 1);
+    cmdBuffer->run(*node);
+
+    node->setGridOffset({3, 0, 0});
+    cmdBuffer->run(*node);
+
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            const auto inRegion = (i >= 32 && i < 64) || (i >= 96);
+            REQUIRE(bufferMap[i] == (inRegion ? static_cast<float>(i) : -1.0f));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
 TEST_CASE("ConstructWithInterpreter", "test_ComputeNode")
 {
 
@@ -163,4 +233,400 @@ ll.registerNodeBuilder(builder)
     } // unamp bufferMap
 
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
-}
\ No newline at end of file
+}
+TEST_CASE("BufferRange", "test_ComputeNode")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    // 256 bytes is the largest minStorageBufferOffsetAlignment allowed by the spec
+    constexpr const size_t   blockLength = 256 / sizeof(float);
+    constexpr const size_t   blockCount  = 4;
+    constexpr const uint32_t localX      = 16;
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto buffer = session->getHostMemory()->createBuffer(blockCount * blockLength * sizeof(float));
+    REQUIRE(buffer != nullptr);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < blockCount * blockLength; ++i) {
+            bufferMap[i] = -1.0f;
+        }
+    }
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto nodeDescriptor = ll::ComputeNodeDescriptor()
+                              .setProgram(program)
+                              .setFunctionName("main")
+                              .setLocalX(localX)
+                              .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+
+    auto node = session->createComputeNode(nodeDescriptor);
+    REQUIRE(node != nullptr);
+
+    // range beyond the buffer size
+    REQUIRE_THROWS_AS(node->bindRange("out_buffer", buffer, 3 * blockLength * sizeof(float), 2 * blockLength * sizeof(float)), std::system_error);
+
+    // the node writes into the second block
+    node->bindRange("out_buffer", buffer, blockLength * sizeof(float), blockLength * sizeof(float));
+    node->init();
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+    cmdBuffer->run(*node);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < blockCount * blockLength; ++i) {
+            const auto isWritten = i >= blockLength && i < blockLength + localX;
+            REQUIRE(bufferMap[i] == (isWritten ? static_cast<float>(i - blockLength) : -1.0f));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("DynamicOffset", "test_ComputeNode")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t   blockLength = 256 / sizeof(float);
+    constexpr const size_t   blockCount  = 4;
+    constexpr const uint32_t localX      = 16;
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto buffer = session->getHostMemory()->createBuffer(blockCount * blockLength * sizeof(float));
+    REQUIRE(buffer != nullptr);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < blockCount * blockLength; ++i) {
+            bufferMap[i] = -1.0f;
+        }
+    }
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto nodeDescriptor = ll::ComputeNodeDescriptor()
+                              .setProgram(program)
+                              .setFunctionName("main")
+                              .setLocalX(localX)
+                              .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::StorageBufferDynamic});
+
+    auto node = session->createComputeNode(nodeDescriptor);
+    REQUIRE(node != nullptr);
+
+    // dynamic ports need an explicit range
+    REQUIRE_THROWS_AS(node->bind("out_buffer", buffer), std::system_error);
+    REQUIRE_THROWS_AS(node->setDynamicOffset("out_buffer", 0), std::system_error);
+
+    node->bindRange("out_buffer", buffer, 0, blockLength * sizeof(float));
+    node->init();
+
+    // the range cannot be moved beyond the buffer
+    REQUIRE_THROWS_AS(node->setDynamicOffset("out_buffer", blockCount * blockLength * sizeof(float)), std::system_error);
+    REQUIRE(node->getDynamicOffset("out_buffer") == 0);
+
+    // the same descriptor set writes into the third and then the first block
+    for (const auto block : {2u, 0u}) {
+
+        node->setDynamicOffset("out_buffer", static_cast<uint32_t>(block * blockLength * sizeof(float)));
+
+        auto cmdBuffer = session->createCommandBuffer();
+        REQUIRE(cmdBuffer != nullptr);
+
+        cmdBuffer->begin();
+        cmdBuffer->run(*node);
+        cmdBuffer->end();
+
+        session->run(*cmdBuffer);
+    }
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < blockCount * blockLength; ++i) {
+            const auto block     = i / blockLength;
+            const auto index     = i % blockLength;
+            const auto isWritten = (block == 0 || block == 2) && index < localX;
+            REQUIRE(bufferMap[i] == (isWritten ? static_cast<float>(index) : -1.0f));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("TexelBuffer", "test_ComputeNode")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const uint32_t texelCount = 256;
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto hostMemory = session->getHostMemory();
+
+    // buffers without texel usage flags cannot be viewed as texels
+    auto plainBuffer = hostMemory->createBuffer(texelCount * 4);
+    REQUIRE_THROWS_AS(plainBuffer->createBufferView(ll::ChannelCount::C4, ll::ChannelType::Uint8), std::system_error);
+
+    const auto usageFlags = ll::BufferUsageFlags {ll::BufferUsageFlagBits::UniformTexelBuffer | ll::BufferUsageFlagBits::TransferDst};
+
+    auto inBuffer = hostMemory->createBuffer(texelCount * 4, usageFlags);
+    REQUIRE(inBuffer != nullptr);
+
+    // offset out of the buffer and partial texels
+    REQUIRE_THROWS_AS(inBuffer->createBufferView(ll::ChannelCount::C4, ll::ChannelType::Uint8, texelCount * 4), std::system_error);
+    REQUIRE_THROWS_AS(inBuffer->createBufferView(ll::ChannelCount::C4, ll::ChannelType::Uint8, 0, 6), std::system_error);
+
+    auto inView = inBuffer->createBufferView(ll::ChannelCount::C4, ll::ChannelType::Uint8);
+    REQUIRE(inView != nullptr);
+    REQUIRE(inView->getType() == ll::ObjectType::BufferView);
+    REQUIRE(inView->getBuffer() == inBuffer);
+    REQUIRE(inView->getTexelCount() == texelCount);
+    REQUIRE(inView->getRange() == texelCount * 4);
+
+    {
+        auto inMap = inBuffer->map<uint8_t[]>();
+        for (auto i = 0u; i < texelCount * 4; ++i) {
+            inMap[i] = static_cast<uint8_t>(i % 61);
+        }
+    }
+
+    auto outBuffer = hostMemory->createBuffer(texelCount * sizeof(uint32_t));
+    REQUIRE(outBuffer != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/texelBuffer.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto nodeDescriptor = ll::ComputeNodeDescriptor()
+                              .setProgram(program)
+                              .setFunctionName("main")
+                              .setLocalX(32)
+                              .setGridX(texelCount / 32)
+                              .addPort({0, "in_texels", ll::PortDirection::In, ll::PortType::UniformTexelBuffer})
+                              .addPort({1, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+
+    auto node = session->createComputeNode(nodeDescriptor);
+    REQUIRE(node != nullptr);
+
+    // texel ports only accept buffer views
+    REQUIRE_THROWS_AS(node->bind("in_texels", inBuffer), std::system_error);
+
+    node->bind("in_texels", inView);
+    node->bind("out_buffer", outBuffer);
+    node->init();
+
+    REQUIRE(node->getPort("in_texels") == inView);
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+    cmdBuffer->run(*node);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        auto outMap = outBuffer->map<uint32_t[]>();
+        for (auto i = 0u; i < texelCount; ++i) {
+
+            auto expected = uint32_t {0};
+            for (auto c = 0u; c < 4; ++c) {
+                expected += (i * 4 + c) % 61;
+            }
+
+            REQUIRE(outMap[i] == expected);
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("PortHandles", "test_ComputeNode")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t length = 64;
+
+    const auto floatParameter = [](const float value) {
+        auto param = ll::Parameter {};
+        param.set(value);
+        return param;
+    };
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto nodeDescriptor = ll::ComputeNodeDescriptor()
+                              .setProgram(program)
+                              .setFunctionName("main")
+                              .setLocalX(length)
+                              .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                              .setParameter("alpha", floatParameter(0.5f));
+
+    // indices are given in insertion order and kept when a port or parameter is replaced
+    const auto outBuffer = nodeDescriptor.getPortIndex("out_buffer");
+    const auto alpha     = nodeDescriptor.getParameterIndex("alpha");
+    REQUIRE(outBuffer == 0);
+    REQUIRE(alpha == 0);
+    REQUIRE(nodeDescriptor.getPortCount() == 1);
+
+    nodeDescriptor.addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+    REQUIRE(nodeDescriptor.getPortIndex("out_buffer") == outBuffer);
+    REQUIRE(nodeDescriptor.getPortCount() == 1);
+
+    REQUIRE_THROWS_AS(nodeDescriptor.getPortIndex("unknown"), std::system_error);
+    REQUIRE_THROWS_AS(nodeDescriptor.getPort(uint32_t {1}), std::system_error);
+    REQUIRE_THROWS_AS(nodeDescriptor.setParameter(uint32_t {1}, floatParameter(1.0f)), std::system_error);
+
+    auto node = session->createComputeNode(nodeDescriptor);
+    REQUIRE(node != nullptr);
+    REQUIRE(node->getPortIndex("out_buffer") == outBuffer);
+
+    // not bound yet
+    REQUIRE_FALSE(node->hasPort("out_buffer"));
+    REQUIRE_THROWS_AS(node->getPort(outBuffer), std::system_error);
+
+    node->setParameter(alpha, floatParameter(0.25f));
+    REQUIRE(node->getParameter("alpha").get<float>() == 0.25f);
+
+    auto bufferA = session->getHostMemory()->createBuffer(length * sizeof(float));
+    auto bufferB = session->getHostMemory()->createBuffer(length * sizeof(float));
+
+    node->bind(outBuffer, bufferA);
+    node->init();
+    REQUIRE(node->getPort("out_buffer") == bufferA);
+
+    // rebinding by index, as done for each new frame
+    for (const auto& buffer : {bufferA, bufferB}) {
+
+        node->bind(outBuffer, buffer);
+        REQUIRE(node->getPort(outBuffer) == buffer);
+
+        session->run(*node);
+
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("FrameDescriptorSets", "test_ComputeNode")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t length = 128;
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto nodeDescriptor = ll::ComputeNodeDescriptor()
+                              .setProgram(program)
+                              .setFunctionName("main")
+                              .setLocalX(length)
+                              .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+
+    REQUIRE_THROWS_AS(session->createComputeNode(ll::ComputeNodeDescriptor {nodeDescriptor}.setDescriptorSetCount(0)), std::system_error);
+
+    auto node = session->createComputeNode(nodeDescriptor.setDescriptorSetCount(2));
+    REQUIRE(node != nullptr);
+
+    const auto outBuffer = node->getPortIndex("out_buffer");
+
+    auto bufferA = session->getHostMemory()->createBuffer(length * sizeof(float));
+    auto bufferB = session->getHostMemory()->createBuffer(length * sizeof(float));
+
+    auto clearBuffers = [&]() {
+        for (const auto& buffer : {bufferA, bufferB}) {
+            auto bufferMap = buffer->map<float[]>();
+            for (auto i = 0u; i < length; ++i) {
+                bufferMap[i] = -1.0f;
+            }
+        }
+    };
+
+    auto checkBuffer = [&](const std::shared_ptr<ll::Buffer>& buffer, const bool assigned) {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == (assigned ? static_cast<float>(i) : -1.0f));
+        }
+    };
+
+    node->bind(outBuffer, bufferA);
+    node->init();
+
+    // each command buffer keeps the descriptor set selected when it was recorded
+    auto cmdBuffer0 = session->createCommandBuffer();
+    cmdBuffer0->begin();
+    cmdBuffer0->run(*node);
+    cmdBuffer0->end();
+
+    node->setFrameIndex(1);
+    REQUIRE(node->getDescriptorSetIndex() == 1);
+
+    node->bind(outBuffer, bufferB);
+
+    auto cmdBuffer1 = session->createCommandBuffer();
+    cmdBuffer1->begin();
+    cmdBuffer1->run(*node);
+    cmdBuffer1->end();
+
+    clearBuffers();
+    session->run(*cmdBuffer0);
+    checkBuffer(bufferA, true);
+    checkBuffer(bufferB, false);
+
+    clearBuffers();
+    session->run(*cmdBuffer1);
+    checkBuffer(bufferA, false);
+    checkBuffer(bufferB, true);
+
+    // selecting set 0 again writes the binding made while set 1 was selected
+    node->setFrameIndex(2);
+    REQUIRE(node->getDescriptorSetIndex() == 0);
+
+    auto cmdBuffer2 = session->createCommandBuffer();
+    cmdBuffer2->begin();
+    cmdBuffer2->run(*node);
+    cmdBuffer2->end();
+
+    clearBuffers();
+    session->run(*cmdBuffer2);
+    checkBuffer(bufferA, false);
+    checkBuffer(bufferB, true);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
@@ -0,0 +1,360 @@
+/**
+@file       test_FrameProcessor.cpp
+@brief      Test FrameProcessor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+namespace {
+
+constexpr const uint32_t width {96};
+constexpr const uint32_t height {64};
+
+constexpr const auto STENCIL_MAX_BUILDER = R"(
+local builder = ll.class(ll.ComputeNodeBuilder)
+builder.name = 'test/StencilMax'
+
+function builder.newDescriptor()
+
+    local desc = ll.ComputeNodeDescriptor.new()
+
+    desc.builderName   = builder.name
+    desc.localShape    = ll.vec3ui.new(16, 16, 1)
+    desc.gridShape     = ll.vec3ui.new(1, 1, 1)
+    desc.program       = ll.getProgram('test/stencilMax.comp')
+    desc.functionName  = 'main'
+    desc.stencilRadius = 1
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_image', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_image', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function builder.onNodeInit(node)
+
+    local in_image = node:getPort('in_image')
+
+    local imgDesc = ll.ImageDescriptor.new(in_image.imageDescriptor)
+
+    local imgViewDesc = ll.ImageViewDescriptor.new(ll.ImageAddressMode.Repeat, ll.ImageFilterMode.Nearest, false, false)
+
+    local out_image = in_image.memory:createImageView(imgDesc, imgViewDesc)
+    out_image:changeImageLayout(ll.ImageLayout.General)
+
+    node:bind('out_image', out_image)
+    node:configureGridShape(ll.vec3ui.new(out_image.width, out_image.height, 1))
+end
+
+ll.registerNodeBuilder(builder)
+)";
+
+constexpr const auto RUNNING_MAX_BUILDER = R"(
+local builder = ll.class(ll.ComputeNodeBuilder)
+builder.name = 'test/RunningMax'
+
+function builder.newDescriptor()
+
+    local desc = ll.ComputeNodeDescriptor.new()
+
+    desc.builderName  = builder.name
+    desc.localShape   = ll.vec3ui.new(16, 16, 1)
+    desc.gridShape    = ll.vec3ui.new(1, 1, 1)
+    desc.program      = ll.getProgram('test/runningMax.comp')
+    desc.functionName = 'main'
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_image', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_image', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function builder.onNodeInit(node)
+
+    local in_image = node:getPort('in_image')
+
+    local imgDesc = ll.ImageDescriptor.new(in_image.imageDescriptor)
+
+    local imgViewDesc = ll.ImageViewDescriptor.new(ll.ImageAddressMode.Repeat, ll.ImageFilterMode.Nearest, false, false)
+
+    -- the state of the node, read and written by every run
+    local out_image = in_image.memory:createImageView(imgDesc, imgViewDesc)
+    out_image:changeImageLayout(ll.ImageLayout.General)
+    out_image:clear()
+
+    node:bind('out_image', out_image)
+    node:configureGridShape(ll.vec3ui.new(out_image.width, out_image.height, 1))
+end
+
+ll.registerNodeBuilder(builder)
+)";
+
+class NativeStencilContainer : public ll::ContainerNodeBuilder {
+
+public:
+    explicit NativeStencilContainer(ll::Session* session)
+        : m_session {session}
+    {
+    }
+
+    ll::ContainerNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+    {
+
+        return ll::ContainerNodeDescriptor()
+            .addPort({0, "in_image", ll::PortDirection::In, ll::PortType::ImageView})
+            .addPort({1, "out_image", ll::PortDirection::Out, ll::PortType::ImageView});
+    }
+
+    void onNodeInit(ll::ContainerNode& node) override
+    {
+
+        auto stencil = m_session->createComputeNode("test/StencilMax");
+        stencil->bind("in_image", node.getPort("in_image"));
+        stencil->init();
+
+        node.bindNode("stencil", stencil);
+        node.bind("out_image", stencil->getPort("out_image"));
+
+        ++initCount;
+    }
+
+    void onNodeRecord(const ll::ContainerNode& node, ll::CommandBuffer& commandBuffer) override
+    {
+
+        node.getNode("stencil")->record(commandBuffer);
+        commandBuffer.memoryBarrier();
+    }
+
+    int initCount {0};
+
+private:
+    ll::Session* m_session;
+};
+
+std::shared_ptr<ll::Session> createSession()
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("test/stencilMax.comp", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/stencilMax.comp.spv")));
+    session->setProgram("test/runningMax.comp", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/runningMax.comp.spv")));
+    session->script(STENCIL_MAX_BUILDER);
+    session->script(RUNNING_MAX_BUILDER);
+
+    return session;
+}
+
+ll::FrameProcessorDescriptor createDescriptor(const std::string& builderName, const uint32_t inFlightCount)
+{
+
+    return ll::FrameProcessorDescriptor {}
+        .setBuilderName(builderName)
+        .setImageDescriptor(ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, ll::ChannelType::Uint8})
+        .setInputImageViewDescriptor(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false})
+        .setInFlightCount(inFlightCount);
+}
+
+std::vector<uint8_t> createFrame(const uint64_t index)
+{
+
+    auto frame = std::vector<uint8_t>(width * height);
+    for (auto i = 0u; i < frame.size(); ++i) {
+        frame[i] = static_cast<uint8_t>((i * 7919u + index * 31u) % 251u);
+    }
+
+    return frame;
+}
+
+void checkStencilMax(const std::vector<uint8_t>& input, const std::vector<uint8_t>& output)
+{
+
+    for (auto y = 0; y < static_cast<int>(height); ++y) {
+        for (auto x = 0; x < static_cast<int>(width); ++x) {
+
+            auto expected = uint8_t {0};
+            for (auto dy = -1; dy <= 1; ++dy) {
+                for (auto dx = -1; dx <= 1; ++dx) {
+                    const auto px = std::clamp(x + dx, 0, static_cast<int>(width) - 1);
+                    const auto py = std::clamp(y + dy, 0, static_cast<int>(height) - 1);
+                    expected      = std::max(expected, input[py * width + px]);
+                }
+            }
+
+            REQUIRE(output[y * width + x] == expected);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("PushPop", "test_FrameProcessor")
+{
+
+    auto session = createSession();
+
+    auto processor = session->createFrameProcessor(createDescriptor("test/StencilMax", 3));
+    REQUIRE(processor != nullptr);
+    REQUIRE(processor->getInputSize() == width * height);
+    REQUIRE(processor->getOutputSize() == width * height);
+    REQUIRE(processor->getPendingFrameCount() == 0);
+
+    auto output = std::vector<uint8_t>(processor->getOutputSize());
+    REQUIRE_THROWS_AS(processor->pop(output.data()), std::system_error);
+
+    constexpr const uint64_t frameCount {8};
+
+    auto popped = uint64_t {0};
+    for (auto f = uint64_t {0}; f < frameCount; ++f) {
+
+        if (processor->isFull()) {
+            REQUIRE_THROWS_AS(processor->push(createFrame(f).data()), std::system_error);
+
+            REQUIRE(processor->pop(output.data()) == popped);
+            checkStencilMax(createFrame(popped), output);
+            ++popped;
+        }
+
+        REQUIRE(processor->push(createFrame(f).data()) == f);
+    }
+
+    REQUIRE(processor->getPendingFrameCount() == 3);
+
+    while (processor->getPendingFrameCount() > 0) {
+        REQUIRE(processor->pop(output.data()) == popped);
+        checkStencilMax(createFrame(popped), output);
+        ++popped;
+    }
+
+    REQUIRE(popped == frameCount);
+    REQUIRE(processor->getLastFrameDuration().count() >= 0);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerSlots", "test_FrameProcessor")
+{
+
+    auto session = createSession();
+
+    auto builder = std::make_shared<NativeStencilContainer>(session.get());
+    session->registerNodeBuilder("test/NativeStencilContainer", builder);
+
+    auto processor = session->createFrameProcessor(createDescriptor("test/NativeStencilContainer", 2));
+    REQUIRE(processor != nullptr);
+
+    // a single container serves every slot
+    REQUIRE(builder->initCount == 1);
+
+    const auto frames = std::vector<std::vector<uint8_t>> {createFrame(0), createFrame(1)};
+    for (const auto& frame : frames) {
+        processor->push(frame.data());
+    }
+
+    auto output = std::vector<uint8_t>(processor->getOutputSize());
+    for (const auto& frame : frames) {
+        processor->pop(output.data());
+        checkStencilMax(frame, output);
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("StatefulNode", "test_FrameProcessor")
+{
+
+    auto session = createSession();
+
+    constexpr const uint32_t inFlightCount {2};
+    constexpr const uint64_t frameCount {6};
+
+    auto processor = session->createFrameProcessor(createDescriptor("test/RunningMax", inFlightCount));
+    REQUIRE(processor != nullptr);
+
+    auto output = std::vector<uint8_t>(processor->getOutputSize());
+
+    const auto checkFrame = [&](const uint64_t f) {
+
+        // the node is shared by every slot and sees every frame pushed so far, in order
+        auto expected = std::vector<uint8_t>(width * height, 0);
+
+        for (auto g = uint64_t {0}; g <= f; ++g) {
+            const auto frame = createFrame(g);
+            std::transform(expected.cbegin(), expected.cend(), frame.cbegin(), expected.begin(), [](auto a, auto b) { return std::max(a, b); });
+        }
+
+        REQUIRE(output == expected);
+    };
+
+    auto popped = uint64_t {0};
+    for (auto f = uint64_t {0}; f < frameCount; ++f) {
+
+        if (processor->isFull()) {
+            REQUIRE(processor->pop(output.data()) == popped);
+            checkFrame(popped++);
+        }
+
+        processor->push(createFrame(f).data());
+    }
+
+    while (processor->getPendingFrameCount() > 0) {
+        REQUIRE(processor->pop(output.data()) == popped);
+        checkFrame(popped++);
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("NodeFactory", "test_FrameProcessor")
+{
+
+    auto session = createSession();
+
+    auto factoryCount = 0;
+    auto desc         = createDescriptor("", 3).setNodeFactory([&session, &factoryCount]() {
+        ++factoryCount;
+        return session->createComputeNode("test/StencilMax");
+    });
+
+    auto processor = session->createFrameProcessor(desc);
+    REQUIRE(processor != nullptr);
+
+    // the node and its pipeline are created once for every slot
+    REQUIRE(factoryCount == 1);
+
+    const auto frame = createFrame(0);
+    processor->push(frame.data());
+
+    auto output = std::vector<uint8_t>(processor->getOutputSize());
+    processor->pop(output.data());
+    checkStencilMax(frame, output);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("InvalidDescriptor", "test_FrameProcessor")
+{
+
+    auto session = createSession();
+
+    REQUIRE_THROWS_AS(session->createFrameProcessor(createDescriptor("test/StencilMax", 0)), std::system_error);
+    REQUIRE_THROWS_AS(session->createFrameProcessor(createDescriptor("", 2)), std::system_error);
+    REQUIRE_THROWS_AS(session->createFrameProcessor(createDescriptor("test/Missing", 2)), std::system_error);
+}
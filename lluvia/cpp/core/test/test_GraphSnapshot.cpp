@@ -0,0 +1,159 @@
+/**
+ * \file test_GraphSnapshot.cpp
+ * \brief test saving and loading node graphs.
+ * \copyright 2022, Juan David Adarve. See AUTHORS for more details
+ * \license Apache 2.0, see LICENSE for more details
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "lluvia/core.h"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+namespace {
+
+class NativeAssign : public ll::ComputeNodeBuilder {
+
+public:
+    ll::ComputeNodeDescriptor newDescriptor(const ll::Session& session) override
+    {
+
+        return ll::ComputeNodeDescriptor()
+            .setProgram(session.getProgram("assign"))
+            .setFunctionName("main")
+            .setLocalX(32)
+            .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+    }
+
+    void onNodeInit(ll::ComputeNode& node) override
+    {
+
+        const auto buffer = std::static_pointer_cast<ll::Buffer>(node.getPort("out_buffer"));
+        node.configureGridShape({static_cast<uint32_t>(buffer->getSize() / sizeof(float)), 1, 1});
+    }
+};
+
+class NativeContainer : public ll::ContainerNodeBuilder {
+
+public:
+    explicit NativeContainer(ll::Session* session)
+        : m_session {session}
+    {
+    }
+
+    ll::ContainerNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+    {
+
+        return ll::ContainerNodeDescriptor()
+            .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+    }
+
+    void onNodeInit(ll::ContainerNode& node) override
+    {
+
+        auto assign = m_session->createComputeNode("test/NativeAssign");
+        assign->bind("out_buffer", node.getPort("out_buffer"));
+        assign->init();
+
+        node.bindNode("assign", assign);
+    }
+
+    void onNodeRecord(const ll::ContainerNode& node, ll::CommandBuffer& commandBuffer) override
+    {
+
+        node.getNode("assign")->record(commandBuffer);
+        commandBuffer.memoryBarrier();
+        ++recordCount;
+    }
+
+    int recordCount {0};
+
+private:
+    ll::Session* m_session;
+};
+
+std::string getSnapshotPath(const std::string& name)
+{
+
+    const auto tmpDir = std::getenv("TEST_TMPDIR");
+    return (tmpDir != nullptr ? std::string {tmpDir} : std::string {"."}) + "/" + name;
+}
+
+} // namespace
+
+TEST_CASE("SaveLoadGraph", "test_GraphSnapshot")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t length = 128;
+    const auto             path   = getSnapshotPath("graph.llgraph");
+
+    {
+        auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+        REQUIRE(session != nullptr);
+
+        session->setProgram("assign", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv")));
+        session->registerNodeBuilder("test/NativeAssign", std::make_shared<NativeAssign>());
+
+        auto builder = std::make_shared<NativeContainer>(session.get());
+        session->registerNodeBuilder("test/NativeContainer", builder);
+
+        auto buffer = session->getHostMemory()->createBuffer(length * sizeof(float));
+        auto node   = session->createContainerNode("test/NativeContainer");
+        node->bind("out_buffer", buffer);
+
+        // nodes must be initialized before saving
+        REQUIRE_THROWS_AS(session->saveGraph(node, path), std::system_error);
+
+        node->init();
+        session->saveGraph(node, path);
+        REQUIRE(builder->recordCount == 1);
+
+        REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+    }
+
+    // the loading session has no builders registered
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto node = session->loadGraph(path);
+    REQUIRE(node != nullptr);
+    REQUIRE(node->getType() == ll::NodeType::Container);
+    REQUIRE(node->getState() == ll::NodeState::Init);
+
+    auto container = std::static_pointer_cast<ll::ContainerNode>(node);
+    REQUIRE(container->getNode("assign") != nullptr);
+
+    auto buffer = std::static_pointer_cast<ll::Buffer>(container->getPort("out_buffer"));
+    REQUIRE(buffer->getSize() == length * sizeof(float));
+
+    session->run(*container);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("LoadInvalidGraph", "test_GraphSnapshot")
+{
+
+    auto session = ll::Session::create();
+    REQUIRE(session != nullptr);
+
+    REQUIRE_THROWS_AS(session->loadGraph(getSnapshotPath("missing.llgraph")), std::system_error);
+}
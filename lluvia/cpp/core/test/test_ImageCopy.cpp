@@ -9,7 +9,9 @@
 #include "catch2/catch.hpp"
 
 #include "lluvia/core.h"
+#include <cstdint>
 #include <iostream>
+#include <system_error>
 
 using memflags = ll::MemoryPropertyFlagBits;
 
@@ -108,3 +110,104 @@ TEST_CASE("ImageToImage", "ImageCopyTest")
 
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
 }
+
+TEST_CASE("RegionCopy", "ImageCopyTest")
+{
+
+    constexpr const uint32_t  width         = 64;
+    constexpr const uint32_t  height        = 32;
+    constexpr const uint32_t  cropX         = 8;
+    constexpr const uint32_t  cropY         = 4;
+    constexpr const uint32_t  cropWidth     = 16;
+    constexpr const uint32_t  cropHeight    = 8;
+    constexpr const auto      pageSize      = 32 * 1024 * 1024;
+    const ll::ImageUsageFlags imgUsageFlags = {
+        ll::ImageUsageFlagBits::Storage
+        | ll::ImageUsageFlagBits::TransferSrc
+        | ll::ImageUsageFlagBits::TransferDst};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto deviceMemory = session->createMemory(memflags::DeviceLocal, pageSize);
+    REQUIRE(deviceMemory != nullptr);
+
+    auto hostMemory = session->getHostMemory();
+
+    auto desc = ll::ImageDescriptor {}
+                    .setWidth(width)
+                    .setHeight(height)
+                    .setDepth(1)
+                    .setChannelCount(ll::ChannelCount::C1)
+                    .setChannelType(ll::ChannelType::Uint8)
+                    .setUsageFlags(imgUsageFlags);
+
+    auto image = deviceMemory->createImage(desc);
+    REQUIRE(image != nullptr);
+
+    auto srcBuffer = hostMemory->createBuffer(width * height);
+    REQUIRE(srcBuffer != nullptr);
+
+    {
+        auto ptr = srcBuffer->map<uint8_t[]>();
+        for (auto i = 0u; i < srcBuffer->getSize(); ++i) {
+            ptr[i] = i % 251;
+        }
+    }
+
+    // download the crop into the same position of a full size host image, leaving the rest untouched
+    auto dstBuffer = hostMemory->createBuffer(width * height);
+    REQUIRE(dstBuffer != nullptr);
+
+    {
+        auto ptr = dstBuffer->map<uint8_t[]>();
+        for (auto i = 0u; i < dstBuffer->getSize(); ++i) {
+            ptr[i] = 255;
+        }
+    }
+
+    const auto cropBufferOffset = uint64_t {cropY * width + cropX};
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+    cmdBuffer->changeImageLayout(*image, ll::ImageLayout::TransferDstOptimal);
+    cmdBuffer->copyBufferToImage(*srcBuffer, *image);
+    cmdBuffer->changeImageLayout(*image, ll::ImageLayout::TransferSrcOptimal);
+    cmdBuffer->copyImageToBuffer(*image, *dstBuffer, {cropX, cropY, 0}, {cropWidth, cropHeight, 1}, cropBufferOffset, width);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        auto srcPtr = srcBuffer->map<uint8_t[]>();
+        auto dstPtr = dstBuffer->map<uint8_t[]>();
+
+        for (auto y = 0u; y < height; ++y) {
+            for (auto x = 0u; x < width; ++x) {
+                const auto inCrop = x >= cropX && x < cropX + cropWidth && y >= cropY && y < cropY + cropHeight;
+                const auto i      = y * width + x;
+                REQUIRE(dstPtr[i] == (inCrop ? srcPtr[i] : 255));
+            }
+        }
+    }
+
+    auto invalidCmdBuffer = session->createCommandBuffer();
+    REQUIRE(invalidCmdBuffer != nullptr);
+
+    invalidCmdBuffer->begin();
+
+    // region outside the image
+    REQUIRE_THROWS_AS(invalidCmdBuffer->copyImageToBuffer(*image, *dstBuffer, {width - 4, 0, 0}, {8, 1, 1}), std::system_error);
+
+    // row length smaller than the region width
+    REQUIRE_THROWS_AS(invalidCmdBuffer->copyImageToBuffer(*image, *dstBuffer, {0, 0, 0}, {16, 2, 1}, 0, 8), std::system_error);
+
+    // region larger than the buffer
+    REQUIRE_THROWS_AS(invalidCmdBuffer->copyImageToBuffer(*image, *dstBuffer, {0, 0, 0}, {width, height, 1}, 1), std::system_error);
+
+    invalidCmdBuffer->end();
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
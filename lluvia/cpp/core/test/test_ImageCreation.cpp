@@ -9,7 +9,11 @@
 #include "catch2/catch.hpp"
 
 #include "lluvia/core.h"
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <system_error>
+#include <vector>
 
 TEST_CASE("DeviceLocalImage", "test_ImageCreation")
 {
@@ -108,3 +112,158 @@ TEST_CASE("InvalidImageSize", "test_ImageCreation")
 
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
 }
+
+TEST_CASE("SharedSamplers", "test_ImageCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->getDeviceMemory();
+
+    const auto desc = ll::ImageDescriptor {1, 64, 64, ll::ChannelCount::C1, ll::ChannelType::Uint8}
+                          .setUsageFlags(ll::ImageUsageFlagBits::Storage | ll::ImageUsageFlagBits::Sampled);
+
+    const auto samplerCount = session->getSamplerCount();
+
+    auto nearest = ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, true, true};
+    auto linear  = ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Linear, true, true};
+
+    auto images = std::vector<std::shared_ptr<ll::Image>> {};
+    auto views  = std::vector<std::shared_ptr<ll::ImageView>> {};
+
+    for (auto i = 0u; i < 16; ++i) {
+        auto image = memory->createImage(desc);
+
+        views.push_back(image->createImageView(nearest));
+        views.push_back(image->createImageView(nearest));
+        views.push_back(image->createImageView(linear));
+        images.push_back(image);
+    }
+
+    // one sampler per configuration
+    REQUIRE(session->getSamplerCount() == samplerCount + 2);
+
+    views.clear();
+    REQUIRE(session->getSamplerCount() == samplerCount);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("MapLinearImage", "test_ImageCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    constexpr const uint32_t width {37};
+    constexpr const uint32_t height {13};
+
+    const auto desc = ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, ll::ChannelType::Uint8}
+                          .setUsageFlags(ll::ImageUsageFlagBits::TransferSrc | ll::ImageUsageFlagBits::TransferDst)
+                          .setTiling(ll::ImageTiling::Linear);
+
+    // optimal images cannot be mapped
+    auto optimal = session->getDeviceMemory()->createImage(ll::ImageDescriptor {desc}.setTiling(ll::ImageTiling::Optimal));
+    REQUIRE_FALSE(optimal->isMappable());
+    REQUIRE_THROWS_AS(optimal->getRowPitch(), std::system_error);
+    REQUIRE_THROWS_AS(optimal->map<uint8_t>(), std::system_error);
+
+    if (!session->isImageDescriptorSupported(desc)) {
+        return;
+    }
+
+    auto image = session->getHostMemory()->createImage(desc);
+    REQUIRE(image->isMappable());
+    REQUIRE(image->getLayout() == ll::ImageLayout::Preinitialized);
+    REQUIRE(image->getRowPitch() >= width);
+
+    // the mapped type is wider than the channel type
+    REQUIRE_THROWS_AS(image->map<uint32_t>(), std::system_error);
+
+    // written before the first layout transition
+    {
+        auto mapping = image->map<uint8_t>();
+        REQUIRE(mapping.isMapped());
+        REQUIRE_FALSE(image->isMappable());
+
+        for (auto y = 0u; y < height; ++y) {
+            for (auto x = 0u; x < width; ++x) {
+                mapping(x, y) = static_cast<uint8_t>(y * width + x);
+            }
+        }
+    }
+
+    REQUIRE(image->isMappable());
+
+    auto buffer = session->getReadbackMemory()->createBuffer(width * height);
+
+    auto cmdBuffer = session->createCommandBuffer();
+    cmdBuffer->begin();
+    cmdBuffer->changeImageLayout(*image, ll::ImageLayout::TransferSrcOptimal);
+    cmdBuffer->copyImageToBuffer(*image, *buffer);
+    cmdBuffer->changeImageLayout(*image, ll::ImageLayout::General);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    // the copy removes the row padding
+    {
+        auto bufferMap = buffer->map<uint8_t[]>();
+        for (auto i = 0u; i < width * height; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<uint8_t>(i));
+        }
+    }
+
+    // images in transfer layouts cannot be accessed by the host
+    image->changeImageLayout(ll::ImageLayout::TransferDstOptimal);
+    REQUIRE_THROWS_AS(image->map<uint8_t>(), std::system_error);
+    image->changeImageLayout(ll::ImageLayout::General);
+
+    {
+        auto mapping = image->map<uint8_t>();
+        for (auto y = 0u; y < height; ++y) {
+            auto row = mapping.getRow(y);
+            for (auto x = 0u; x < width; ++x) {
+                REQUIRE(row[x] == static_cast<uint8_t>(y * width + x));
+            }
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ReshapeImage", "test_ImageCreation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    const auto desc = ll::ImageDescriptor {1, 480, 640, ll::ChannelCount::C1, ll::ChannelType::Uint8}
+                          .setUsageFlags(ll::ImageUsageFlagBits::Storage | ll::ImageUsageFlagBits::Sampled);
+
+    auto image = session->getDeviceMemory()->createImage(desc);
+    image->changeImageLayout(ll::ImageLayout::General);
+
+    auto view = image->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, true, false});
+
+    REQUIRE_THROWS_AS(image->reshape({0, 240, 1}), std::system_error);
+    REQUIRE(image->getWidth() == 640);
+
+    for (const auto& shape : {ll::vec3ui {320, 240, 1}, ll::vec3ui {1280, 960, 1}}) {
+
+        image->reshape(shape);
+
+        REQUIRE(image->getWidth() == shape.x);
+        REQUIRE(image->getHeight() == shape.y);
+        REQUIRE(image->getChannelType() == ll::ChannelType::Uint8);
+        REQUIRE(image->getLayout() == ll::ImageLayout::General);
+        REQUIRE(image->getSize() >= image->getMinimumSize());
+
+        // views follow the image
+        REQUIRE(view->getWidth() == shape.x);
+        REQUIRE(view->getHeight() == shape.y);
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
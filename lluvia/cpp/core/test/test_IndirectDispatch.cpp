@@ -0,0 +1,140 @@
+/**
+@file       test_IndirectDispatch.cpp
+@brief      Test indirect dispatch of compute nodes.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+TEST_CASE("ComputeNode", "test_IndirectDispatch")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t   N {128};
+    constexpr const uint32_t localX {32};
+    constexpr const uint32_t gridX {2};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->getHostMemory();
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    .setFunctionName("main")
+                    .setProgram(program)
+                    .setLocalShape({localX, 1, 1})
+                    .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                    .addPort({1, "dispatch_args", ll::PortDirection::In, ll::PortType::Buffer})
+                    .setIndirectDispatch("dispatch_args");
+
+    REQUIRE(desc.isIndirectDispatchEnabled());
+
+    auto node = session->createComputeNode(desc);
+    REQUIRE(node != nullptr);
+
+    auto buffer = memory->createBuffer(N * sizeof(float));
+    REQUIRE(buffer != nullptr);
+
+    auto argsBuffer = memory->createBuffer(sizeof(std::array<uint32_t, 3>),
+        ll::BufferUsageFlagBits::StorageBuffer | ll::BufferUsageFlagBits::TransferDst | ll::BufferUsageFlagBits::IndirectBuffer);
+    REQUIRE(argsBuffer != nullptr);
+
+    argsBuffer->mapAndSet(std::array<uint32_t, 3> {gridX, 1, 1});
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < N; ++i) {
+            bufferMap[i] = -1.0f;
+        }
+    }
+
+    node->bind("out_buffer", buffer);
+    node->bind("dispatch_args", argsBuffer);
+    node->init();
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+    cmdBuffer->run(*node);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        // only the workgroups read from the args buffer write to the output
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < N; ++i) {
+            const auto expected = i < gridX * localX ? static_cast<float>(i) : -1.0f;
+            REQUIRE(bufferMap[i] == expected);
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("InvalidPort", "test_IndirectDispatch")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    .setFunctionName("main")
+                    .setProgram(program)
+                    .setLocalShape({32, 1, 1})
+                    .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                    .setIndirectDispatch("dispatch_args");
+
+    // port does not exist
+    REQUIRE_THROWS_AS(session->createComputeNode(desc), std::system_error);
+}
+
+TEST_CASE("CommandBuffer", "test_IndirectDispatch")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->getHostMemory();
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    auto storageBuffer = memory->createBuffer(64);
+    auto argsBuffer    = memory->createBuffer(16, ll::BufferUsageFlagBits::StorageBuffer | ll::BufferUsageFlagBits::IndirectBuffer);
+
+    cmdBuffer->begin();
+
+    // missing IndirectBuffer usage flag
+    REQUIRE_THROWS_AS(cmdBuffer->dispatchIndirect(*storageBuffer), std::system_error);
+
+    // unaligned offset
+    REQUIRE_THROWS_AS(cmdBuffer->dispatchIndirect(*argsBuffer, 2), std::system_error);
+
+    // arguments out of range
+    REQUIRE_THROWS_AS(cmdBuffer->dispatchIndirect(*argsBuffer, 8), std::system_error);
+
+    cmdBuffer->end();
+}
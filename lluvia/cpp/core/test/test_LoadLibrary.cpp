@@ -9,8 +9,12 @@
 #include "catch2/catch.hpp"
 
 #include "lluvia/core.h"
+#include "lluvia/core/impl/ZipArchive.h"
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <system_error>
 
 #include "tools/cpp/runfiles/runfiles.h"
 using bazel::tools::cpp::runfiles::Runfiles;
@@ -28,6 +32,10 @@ TEST_CASE("LoadLibrary", "test_LoadLibrary")
     auto program = session->getProgram("nodes/Assign.comp");
     REQUIRE(program != nullptr);
 
+    // library programs keep their SPIR-V code by default
+    REQUIRE(program->hasSpirV());
+    REQUIRE_FALSE(program->getSpirV().empty());
+
     auto desc = ll::ComputeNodeDescriptor {};
     REQUIRE_NOTHROW(desc = session->createComputeNodeDescriptor("nodes/Assign"));
 
@@ -37,3 +45,95 @@ TEST_CASE("LoadLibrary", "test_LoadLibrary")
 
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
 }
+
+TEST_CASE("LoadLibraryWithoutSpirVCopy", "test_LoadLibrary")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true).enableLibrarySpirVCopy(false));
+    session->loadLibrary(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/nodes/test_node_library.zip"));
+
+    // the SPIR-V code is read in place and not kept after creating the shader module
+    auto program = session->getProgram("nodes/Assign.comp");
+    REQUIRE(program != nullptr);
+    REQUIRE_FALSE(program->hasSpirV());
+
+    auto node = std::shared_ptr<ll::ComputeNode> {nullptr};
+    REQUIRE_NOTHROW(node = session->createComputeNode("nodes/Assign"));
+    REQUIRE(node != nullptr);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("StoredEntries", "test_LoadLibrary")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto archive = ll::impl::ZipArchive {runfiles->Rlocation("lluvia/lluvia/cpp/core/test/nodes/test_node_library.zip")};
+    REQUIRE(archive.numberFiles() > 0);
+
+    // node libraries are built without compression and their entries are read in place
+    for (auto i = 0u; i < archive.numberFiles(); ++i) {
+
+        auto stat = archive.getFileStat(i);
+
+        const auto data = archive.getStoredFileData(stat);
+        REQUIRE(data != nullptr);
+
+        const auto content = archive.uncompressBinaryFile(stat);
+        REQUIRE(content.size() == stat.m_uncomp_size);
+        REQUIRE(std::memcmp(data, content.data(), content.size()) == 0);
+    }
+}
+
+TEST_CASE("LazyLoadLibrary", "test_LoadLibrary")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+
+    REQUIRE_NOTHROW(session->loadLibrary(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/nodes/test_node_library.zip"), true));
+
+    // the program is created on first request and kept in the registry
+    auto program = session->getProgram("nodes/Assign.comp");
+    REQUIRE(program != nullptr);
+    REQUIRE(session->getProgram("nodes/Assign.comp") == program);
+
+    // the builder script runs the first time the builder is used
+    auto desc = ll::ComputeNodeDescriptor {};
+    REQUIRE_NOTHROW(desc = session->createComputeNodeDescriptor("nodes/Assign"));
+    REQUIRE(desc.getProgram() == program);
+
+    REQUIRE_FALSE(session->loadLazyNodeBuilder("nodes/Assign"));
+    REQUIRE_THROWS_AS(session->createComputeNodeDescriptor("nodes/NotInLibrary"), std::system_error);
+
+    auto node = std::shared_ptr<ll::ComputeNode> {nullptr};
+    REQUIRE_NOTHROW(node = session->createComputeNode("nodes/Assign"));
+    REQUIRE(node != nullptr);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("LazyLoadLibraryDescriptors", "test_LoadLibrary")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    session->loadLibrary(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/nodes/test_node_library.zip"), true);
+
+    // pending builders are loaded to build their descriptors
+    const auto descriptors = session->getNodeBuilderDescriptors();
+
+    const auto found = std::find_if(descriptors.cbegin(), descriptors.cend(), [](const auto& d) { return d.name == "nodes/Assign"; });
+    REQUIRE(found != descriptors.cend());
+
+    REQUIRE_FALSE(session->loadLazyNodeBuilder("nodes/Assign"));
+}
@@ -0,0 +1,216 @@
+/**
+@file       test_MemoryDefragmentation.cpp
+@brief      Test moving objects out of sparse memory pages.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+using memflags = ll::MemoryPropertyFlagBits;
+
+namespace {
+
+constexpr const uint32_t length {128};
+constexpr const uint64_t bufferSize {length * sizeof(float)};
+constexpr const uint64_t pageSize {4 * bufferSize};
+
+} // namespace
+
+TEST_CASE("MoveBuffer", "test_MemoryDefragmentation")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->createMemory(memflags::HostVisible | memflags::HostCoherent, pageSize, false);
+    REQUIRE(memory != nullptr);
+
+    // fill the first page and allocate the target buffer in a second one
+    auto fill = std::vector<std::shared_ptr<ll::Buffer>> {};
+    for (auto i = 0u; i < 4; ++i) {
+        fill.push_back(memory->createBuffer(bufferSize));
+    }
+
+    auto buffer = memory->createBuffer(bufferSize);
+    REQUIRE(buffer->getAllocationInfo().page == 1);
+    REQUIRE(memory->getPageCount() == 2);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            bufferMap[i] = static_cast<float>(1000 + i);
+        }
+    }
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto node = session->createComputeNode(ll::ComputeNodeDescriptor()
+                                               .setProgram(program)
+                                               .setFunctionName("main")
+                                               .setLocalX(length)
+                                               .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer}));
+    REQUIRE(node != nullptr);
+
+    node->bind("out_buffer", buffer);
+    node->init();
+
+    // leave the first page half empty
+    fill[1].reset();
+    fill[2].reset();
+
+    const auto result = memory->defragment();
+    REQUIRE(result.complete);
+    REQUIRE(result.movedObjects == 1);
+    REQUIRE(result.movedBytes >= bufferSize);
+
+    REQUIRE(buffer->getAllocationInfo().page == 0);
+    REQUIRE(memory->trim() >= pageSize);
+    REQUIRE(memory->getPageCount() == 1);
+
+    // the content is preserved
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(1000 + i));
+        }
+    }
+
+    // the node writes to the new location once recorded again
+    auto cmdBuffer = session->createCommandBuffer();
+    cmdBuffer->begin();
+    cmdBuffer->run(*node);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    // nothing left to move
+    const auto secondResult = memory->defragment();
+    REQUIRE(secondResult.complete);
+    REQUIRE(secondResult.movedObjects == 0);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("MoveBufferFrameDescriptorSets", "test_MemoryDefragmentation")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->createMemory(memflags::HostVisible | memflags::HostCoherent, pageSize, false);
+    REQUIRE(memory != nullptr);
+
+    auto fill = std::vector<std::shared_ptr<ll::Buffer>> {};
+    for (auto i = 0u; i < 4; ++i) {
+        fill.push_back(memory->createBuffer(bufferSize));
+    }
+
+    auto buffer = memory->createBuffer(bufferSize);
+    REQUIRE(buffer->getAllocationInfo().page == 1);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    auto node = session->createComputeNode(ll::ComputeNodeDescriptor()
+                                               .setProgram(program)
+                                               .setFunctionName("main")
+                                               .setLocalX(length)
+                                               .setDescriptorSetCount(2)
+                                               .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer}));
+    REQUIRE(node != nullptr);
+
+    node->bind("out_buffer", buffer);
+    node->init();
+
+    fill[1].reset();
+    fill[2].reset();
+
+    // set 0 is selected while moving the buffer
+    const auto result = memory->defragment();
+    REQUIRE(result.movedObjects == 1);
+    REQUIRE(buffer->getAllocationInfo().page == 0);
+
+    // the node writes to the new location with every descriptor set
+    for (auto frameIndex = 0u; frameIndex < 2; ++frameIndex) {
+
+        {
+            auto bufferMap = buffer->map<float[]>();
+            for (auto i = 0u; i < length; ++i) {
+                bufferMap[i] = -1.0f;
+            }
+        }
+
+        node->setFrameIndex(frameIndex);
+
+        auto cmdBuffer = session->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->run(*node);
+        cmdBuffer->end();
+
+        session->run(*cmdBuffer);
+
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("Budget", "test_MemoryDefragmentation")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->createMemory(memflags::HostVisible | memflags::HostCoherent, pageSize, false);
+    REQUIRE(memory != nullptr);
+
+    auto fill = std::vector<std::shared_ptr<ll::Buffer>> {};
+    for (auto i = 0u; i < 4; ++i) {
+        fill.push_back(memory->createBuffer(bufferSize));
+    }
+
+    auto buffer = memory->createBuffer(bufferSize);
+    fill[0].reset();
+    fill[1].reset();
+
+    // the buffer does not fit in the byte budget
+    const auto result = memory->defragment(bufferSize / 2);
+    REQUIRE_FALSE(result.complete);
+    REQUIRE(result.movedObjects == 0);
+    REQUIRE(buffer->getAllocationInfo().page == 1);
+
+    const auto secondResult = memory->defragment(bufferSize * 4);
+    REQUIRE(secondResult.movedObjects == 1);
+    REQUIRE(buffer->getAllocationInfo().page == 0);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
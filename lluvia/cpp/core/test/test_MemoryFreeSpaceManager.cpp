@@ -550,3 +550,37 @@ TEST_CASE("offset_AARAR", "test_MemoryFreeSpaceManager")
     auto sizeVector   = std::vector<uint64_t> {size - sizeC};
     checkMemory(manager, offsetVector, sizeVector);
 }
+
+/**
+ * Occupancy
+ */
+TEST_CASE("Occupancy", "test_MemoryFreeSpaceManager")
+{
+
+    auto size  = uint64_t {1024};
+    auto sizeA = uint64_t {100};
+    auto sizeB = uint64_t {256};
+
+    auto manager = MemoryFreeSpaceManager {size};
+
+    REQUIRE(manager.isEmpty());
+    REQUIRE(manager.getUsedSize() == 0);
+    REQUIRE(manager.getLargestFreeSize() == size);
+
+    auto allocA = MemoryAllocationInfo {};
+    auto allocB = MemoryAllocationInfo {};
+    REQUIRE(manager.allocate(sizeA, allocA));
+    REQUIRE(manager.allocate(sizeB, 128, allocB));
+
+    // B is aligned to 128 bytes, the padding counts as used
+    REQUIRE_FALSE(manager.isEmpty());
+    REQUIRE(manager.getUsedSize() == 128 + sizeB);
+    REQUIRE(manager.getLargestFreeSize() == size - 128 - sizeB);
+
+    manager.release(allocA);
+    REQUIRE(manager.getUsedSize() == allocB.leftPadding + sizeB);
+
+    manager.release(allocB);
+    REQUIRE(manager.isEmpty());
+    REQUIRE(manager.getLargestFreeSize() == size);
+}
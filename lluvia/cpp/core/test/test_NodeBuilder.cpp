@@ -0,0 +1,755 @@
+/**
+ * \file test_NodeBuilder.cpp
+ * \brief test native node builders.
+ * \copyright 2022, Juan David Adarve. See AUTHORS for more details
+ * \license Apache 2.0, see LICENSE for more details
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "lluvia/core.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+namespace {
+
+class NativeAssign : public ll::ComputeNodeBuilder {
+
+public:
+    ll::ComputeNodeDescriptor newDescriptor(const ll::Session& session) override
+    {
+
+        return ll::ComputeNodeDescriptor()
+            .setProgram(session.getProgram("assign"))
+            .setFunctionName("main")
+            .setLocalX(32)
+            .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+    }
+
+    void onNodeInit(ll::ComputeNode& node) override
+    {
+
+        configureGrid(node);
+        ++initCount;
+    }
+
+    void onNodeReshape(ll::ComputeNode& node) override
+    {
+
+        // buffer sizes are not followed by the default reshape
+        configureGrid(node);
+        ++reshapeCount;
+    }
+
+    std::string getDoc() const override
+    {
+        return "Assigns the index to each element.\n\nOutputs\n-------\nout_buffer : Buffer.";
+    }
+
+    int initCount {0};
+    int reshapeCount {0};
+
+private:
+    static void configureGrid(ll::ComputeNode& node)
+    {
+
+        const auto buffer = std::static_pointer_cast<ll::Buffer>(node.getPort("out_buffer"));
+        node.configureGridShape({static_cast<uint32_t>(buffer->getSize() / sizeof(float)), 1, 1});
+    }
+};
+
+class NativeContainer : public ll::ContainerNodeBuilder {
+
+public:
+    explicit NativeContainer(ll::Session* session)
+        : m_session {session}
+    {
+    }
+
+    ll::ContainerNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+    {
+
+        return ll::ContainerNodeDescriptor()
+            .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+    }
+
+    void onNodeInit(ll::ContainerNode& node) override
+    {
+
+        auto assign = m_session->createComputeNode("test/NativeAssign");
+        assign->bind("out_buffer", node.getPort("out_buffer"));
+        assign->init();
+
+        node.bindNode("assign", assign);
+    }
+
+    void onNodeRecord(const ll::ContainerNode& node, ll::CommandBuffer& commandBuffer) override
+    {
+
+        node.getNode("assign")->record(commandBuffer);
+        ++recordCount;
+    }
+
+    int recordCount {0};
+
+private:
+    ll::Session* m_session;
+};
+
+class NativeParameterContainer : public ll::ContainerNodeBuilder {
+
+public:
+    explicit NativeParameterContainer(ll::Session* session)
+        : m_session {session}
+    {
+    }
+
+    ll::ContainerNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+    {
+
+        return ll::ContainerNodeDescriptor()
+            .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+    }
+
+    void onNodeInit(ll::ContainerNode& node) override
+    {
+
+        const auto buffer = std::static_pointer_cast<ll::Buffer>(node.getPort("out_buffer"));
+
+        auto constants = ll::PushConstants {};
+        constants.setFloat(0.0f);
+
+        auto desc = ll::ComputeNodeDescriptor {}
+                        .setProgram(m_session->getProgram("parameterBlock"))
+                        .setFunctionName("main")
+                        .setLocalShape({32, 1, 1})
+                        .setGridShape({static_cast<uint32_t>(buffer->getSize() / (32 * sizeof(float))), 1, 1})
+                        .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                        .setPushConstants(constants)
+                        .setParameterBlockBinding(1);
+
+        auto fill = m_session->createComputeNode(desc);
+        fill->bind("out_buffer", buffer);
+        fill->bindParameterBlock(m_session->createParameterBlock(sizeof(float), 1));
+        fill->init();
+
+        node.bindNode("fill", fill);
+    }
+
+    void onNodeRecord(const ll::ContainerNode& node, ll::CommandBuffer& commandBuffer) override
+    {
+
+        node.getNode("fill")->record(commandBuffer);
+    }
+
+private:
+    ll::Session* m_session;
+};
+
+std::shared_ptr<ll::ParameterBlock> getFillParameterBlock(const ll::ContainerNode& node)
+{
+    return std::static_pointer_cast<ll::ComputeNode>(node.getNode("fill"))->getParameterBlock();
+}
+
+std::shared_ptr<ll::Image> getPortImage(const std::shared_ptr<ll::Node>& node, const std::string& port)
+{
+    return std::static_pointer_cast<ll::ImageView>(node->getPort(port))->getImage();
+}
+
+} // namespace
+
+TEST_CASE("ComputeNodeBuilder", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t length = 128;
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("assign", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv")));
+
+    auto builder = std::make_shared<NativeAssign>();
+    session->registerNodeBuilder("test/NativeAssign", builder);
+
+    REQUIRE(session->getNodeBuilder("test/NativeAssign") == builder);
+    REQUIRE(session->getNodeBuilder("test/Unknown") == nullptr);
+
+    REQUIRE_THROWS_AS(session->registerNodeBuilder("", builder), std::system_error);
+    REQUIRE_THROWS_AS(session->registerNodeBuilder("test/Null", nullptr), std::system_error);
+    REQUIRE_THROWS_AS(session->createContainerNode("test/NativeAssign"), std::system_error);
+
+    auto buffer = session->getHostMemory()->createBuffer(length * sizeof(float));
+    REQUIRE(buffer != nullptr);
+
+    auto node = session->createComputeNode("test/NativeAssign");
+    REQUIRE(node != nullptr);
+    REQUIRE(node->getDescriptor().getBuilderName() == "test/NativeAssign");
+
+    node->bind("out_buffer", buffer);
+    node->init();
+    REQUIRE(builder->initCount == 1);
+    REQUIRE(node->getGridShape() == ll::vec3ui {length, 1, 1});
+
+    session->run(*node);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < length; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ComputeNodeBuilderFromLua", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("assign", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv")));
+    session->registerNodeBuilder("test/NativeAssign", std::make_shared<NativeAssign>());
+
+    constexpr auto lua = R"(
+        local builder = ll.class(ll.ContainerNodeBuilder)
+        builder.name = 'test/LuaContainer'
+
+        function builder.newDescriptor()
+            local desc = ll.ContainerNodeDescriptor.new()
+            desc.builderName = builder.name
+            desc:addPort(ll.PortDescriptor.new(0, 'out_buffer', ll.PortDirection.Out, ll.PortType.Buffer))
+            return desc
+        end
+
+        function builder.onNodeInit(node)
+            local assign = ll.createComputeNode('test/NativeAssign')
+            assign:bind('out_buffer', node:getPort('out_buffer'))
+            assign:init()
+            node:bindNode('assign', assign)
+        end
+
+        function builder.onNodeRecord(node, cmdBuffer)
+            node:getNode('assign'):record(cmdBuffer)
+        end
+
+        ll.registerNodeBuilder(builder)
+    )";
+
+    session->script(lua);
+
+    auto buffer = session->getHostMemory()->createBuffer(64 * sizeof(float));
+    auto node   = session->createContainerNode("test/LuaContainer");
+    REQUIRE(node != nullptr);
+
+    node->bind("out_buffer", buffer);
+    node->init();
+
+    session->run(*node);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < 64; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerNodeBuilder", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("assign", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv")));
+    session->registerNodeBuilder("test/NativeAssign", std::make_shared<NativeAssign>());
+
+    auto builder = std::make_shared<NativeContainer>(session.get());
+    session->registerNodeBuilder("test/NativeContainer", builder);
+
+    auto buffer = session->getHostMemory()->createBuffer(64 * sizeof(float));
+    auto node   = session->createContainerNode("test/NativeContainer");
+    REQUIRE(node != nullptr);
+
+    node->bind("out_buffer", buffer);
+    node->init();
+
+    // container ports keep the descriptor index, nodes are indexed in binding order
+    REQUIRE(node->getPortIndex("out_buffer") == node->getDescriptor().getPortIndex("out_buffer"));
+    REQUIRE(node->getPort(node->getPortIndex("out_buffer")) == buffer);
+    REQUIRE(node->getNodeIndex("assign") == 0);
+    REQUIRE(node->getNode(uint32_t {0}) == node->getNode("assign"));
+    REQUIRE_THROWS_AS(node->getNode(uint32_t {1}), std::system_error);
+
+    session->run(*node);
+    REQUIRE(builder->recordCount == 1);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < 64; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerInstance", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("assign", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv")));
+
+    auto assignBuilder = std::make_shared<NativeAssign>();
+    session->registerNodeBuilder("test/NativeAssign", assignBuilder);
+
+    auto builder = std::make_shared<NativeContainer>(session.get());
+    session->registerNodeBuilder("test/NativeContainer", builder);
+
+    auto prototype = session->createContainerNode("test/NativeContainer");
+    REQUIRE_THROWS_AS(prototype->instantiate(), std::system_error);
+
+    auto buffer0 = session->getHostMemory()->createBuffer(64 * sizeof(float));
+    prototype->bind("out_buffer", buffer0);
+    prototype->init();
+    REQUIRE(assignBuilder->initCount == 1);
+
+    auto buffer1  = session->getHostMemory()->createBuffer(64 * sizeof(float));
+    auto instance = prototype->instantiate();
+    instance->bind("out_buffer", buffer1);
+    instance->init();
+
+    // builders do not run for instances, and the inner nodes are bound to the instance ports
+    REQUIRE(assignBuilder->initCount == 1);
+    REQUIRE(instance->getNode("assign") != prototype->getNode("assign"));
+    REQUIRE(std::static_pointer_cast<ll::ComputeNode>(instance->getNode("assign"))->getPort("out_buffer") == buffer1);
+
+    // both are recorded into the same command buffer
+    auto cmdBuffer = session->createCommandBuffer();
+    cmdBuffer->begin();
+    cmdBuffer->run(*prototype);
+    cmdBuffer->run(*instance);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+    REQUIRE(builder->recordCount == 2);
+
+    for (const auto& buffer : {buffer0, buffer1}) {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < 64; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerInstanceParameters", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("parameterBlock", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/parameterBlock.comp.spv")));
+    session->registerNodeBuilder("test/NativeParameterContainer", std::make_shared<NativeParameterContainer>(session.get()));
+
+    auto buffers = std::vector<std::shared_ptr<ll::Buffer>> {};
+    for (auto i = 0u; i < 3; ++i) {
+        buffers.push_back(session->getHostMemory()->createBuffer(64 * sizeof(float)));
+    }
+
+    auto prototype = session->createContainerNode("test/NativeParameterContainer");
+    prototype->bind("out_buffer", buffers[0]);
+    prototype->init();
+
+    getFillParameterBlock(*prototype)->write(0, 1.0f);
+
+    auto instances = std::vector<std::shared_ptr<ll::ContainerNode>> {};
+    for (auto i = 1u; i < 3; ++i) {
+        instances.push_back(prototype->instantiate());
+        instances.back()->bind("out_buffer", buffers[i]);
+        instances.back()->init();
+    }
+
+    // every instance owns its parameter block
+    REQUIRE(getFillParameterBlock(*instances[0]) != getFillParameterBlock(*prototype));
+    REQUIRE(getFillParameterBlock(*instances[1]) != getFillParameterBlock(*instances[0]));
+
+    auto runAndCheck = [&](const std::vector<float>& expected) {
+
+        auto cmdBuffer = session->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->run(*prototype);
+        for (const auto& instance : instances) {
+            cmdBuffer->run(*instance);
+        }
+        cmdBuffer->end();
+
+        session->run(*cmdBuffer);
+
+        for (auto b = 0u; b < buffers.size(); ++b) {
+            auto bufferMap = buffers[b]->map<float[]>();
+            for (auto i = 0u; i < 64; ++i) {
+                REQUIRE(bufferMap[i] == expected[b]);
+            }
+        }
+    };
+
+    // instances start from the parameters of the prototype
+    runAndCheck({1.0f, 1.0f, 1.0f});
+
+    getFillParameterBlock(*instances[0])->write(0, 2.0f);
+    getFillParameterBlock(*instances[1])->write(0, 3.0f);
+
+    runAndCheck({1.0f, 2.0f, 3.0f});
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerReinit", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("assign", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv")));
+
+    auto assignBuilder = std::make_shared<NativeAssign>();
+    session->registerNodeBuilder("test/NativeAssign", assignBuilder);
+
+    auto builder = std::make_shared<NativeContainer>(session.get());
+    session->registerNodeBuilder("test/NativeContainer", builder);
+
+    auto node = session->createContainerNode("test/NativeContainer");
+    REQUIRE_THROWS_AS(node->reinit(), std::system_error);
+
+    node->bind("out_buffer", session->getHostMemory()->createBuffer(64 * sizeof(float)));
+    node->init();
+
+    auto assign = std::static_pointer_cast<ll::ComputeNode>(node->getNode("assign"));
+    REQUIRE(assign->getGridX() == 2);
+
+    // the compute node is kept, its builder reshapes it for the new buffer
+    auto buffer = session->getHostMemory()->createBuffer(256 * sizeof(float));
+    node->bind("out_buffer", buffer);
+    node->reinit();
+
+    REQUIRE(assignBuilder->initCount == 1);
+    REQUIRE(assignBuilder->reshapeCount == 1);
+    REQUIRE(node->getNode("assign") == assign);
+    REQUIRE(assign->getPort("out_buffer") == buffer);
+    REQUIRE(assign->getGridX() == 8);
+
+    session->run(*node);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < 256; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(i));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("LibraryContainerReinit", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->loadLibrary(runfiles->Rlocation("lluvia/lluvia/nodes/lluvia_node_library.zip"));
+
+    session->script(R"(
+local builder = ll.class(ll.ContainerNodeBuilder)
+builder.name = 'test/GrayPyramid'
+
+function builder.newDescriptor()
+
+    local desc = ll.ContainerNodeDescriptor.new()
+
+    desc.builderName = builder.name
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_rgba', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_gray', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function builder.onNodeInit(node)
+
+    local gray = ll.createComputeNode('lluvia/color/RGBA2Gray')
+    gray:bind('in_rgba', node:getPort('in_rgba'))
+    gray:init()
+
+    local pyramid = ll.createContainerNode('lluvia/imgproc/ImagePyramid_r8ui')
+    pyramid:setParameter('levels', 2)
+    pyramid:bind('in_gray', gray:getPort('out_gray'))
+    pyramid:init()
+
+    node:bindNode('gray', gray)
+    node:bindNode('pyramid', pyramid)
+    node:bind('out_gray', pyramid:getPort('out_gray'))
+end
+
+function builder.onNodeRecord(node, cmdBuffer)
+
+    cmdBuffer:run(node:getNode('gray'))
+    cmdBuffer:memoryBarrier()
+    node:getNode('pyramid'):record(cmdBuffer)
+end
+
+ll.registerNodeBuilder(builder)
+    )");
+
+    auto memory     = session->getDeviceMemory();
+    auto hostMemory = session->getHostMemory();
+
+    const auto imgDesc = ll::ImageDescriptor {1, 48, 64, ll::ChannelCount::C4, ll::ChannelType::Uint8};
+
+    auto inImage = memory->createImage(imgDesc);
+    auto inView  = inImage->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false});
+    inImage->changeImageLayout(ll::ImageLayout::General);
+
+    auto node = session->createContainerNode("test/GrayPyramid");
+    node->bind("in_rgba", inView);
+    node->init();
+
+    auto gray    = std::static_pointer_cast<ll::ComputeNode>(node->getNode("gray"));
+    auto pyramid = std::static_pointer_cast<ll::ContainerNode>(node->getNode("pyramid"));
+    auto downX   = std::static_pointer_cast<ll::ComputeNode>(pyramid->getNode("ImageDownsampleX_r8ui_1"));
+    auto downY   = std::static_pointer_cast<ll::ComputeNode>(pyramid->getNode("ImageDownsampleY_r8ui_1"));
+
+    const auto grayImage = getPortImage(gray, "out_gray");
+    const auto outImage  = getPortImage(node, "out_gray");
+
+    REQUIRE(outImage->getWidth() == 32);
+    REQUIRE(outImage->getHeight() == 24);
+
+    // the input stream changes its resolution
+    inImage->reshape({128, 96, 1});
+    node->reinit();
+
+    // the images created by the builders are reshaped, the nodes stay connected to them
+    REQUIRE(getPortImage(gray, "out_gray") == grayImage);
+    REQUIRE(getPortImage(pyramid, "in_gray") == grayImage);
+    REQUIRE(getPortImage(downX, "in_gray") == grayImage);
+    REQUIRE(getPortImage(downY, "in_gray") == getPortImage(downX, "out_gray"));
+    REQUIRE(getPortImage(node, "out_gray") == outImage);
+    REQUIRE(getPortImage(downY, "out_gray") == outImage);
+
+    REQUIRE(grayImage->getWidth() == 128);
+    REQUIRE(grayImage->getHeight() == 96);
+    REQUIRE(getPortImage(downX, "out_gray")->getWidth() == 64);
+    REQUIRE(getPortImage(downX, "out_gray")->getHeight() == 96);
+    REQUIRE(outImage->getWidth() == 64);
+    REQUIRE(outImage->getHeight() == 48);
+
+    // the grids match a container created for the new resolution
+    auto expectedNode = session->createContainerNode("test/GrayPyramid");
+    expectedNode->bind("in_rgba", inView);
+    expectedNode->init();
+
+    const auto checkGrid = [](const std::shared_ptr<ll::Node>& reinitNode, const std::shared_ptr<ll::Node>& expected) {
+        const auto shape         = std::static_pointer_cast<ll::ComputeNode>(reinitNode)->getGridShape();
+        const auto expectedShape = std::static_pointer_cast<ll::ComputeNode>(expected)->getGridShape();
+        REQUIRE(shape.x == expectedShape.x);
+        REQUIRE(shape.y == expectedShape.y);
+        REQUIRE(shape.z == expectedShape.z);
+    };
+
+    auto expectedPyramid = std::static_pointer_cast<ll::ContainerNode>(expectedNode->getNode("pyramid"));
+
+    checkGrid(gray, expectedNode->getNode("gray"));
+    checkGrid(downX, expectedPyramid->getNode("ImageDownsampleX_r8ui_1"));
+    checkGrid(downY, expectedPyramid->getNode("ImageDownsampleY_r8ui_1"));
+
+    // both containers compute the same output
+    auto input = std::vector<uint8_t>(inImage->getSize());
+    for (auto i = 0u; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>((i * 7919u) % 251u);
+    }
+
+    auto uploadBuffer = hostMemory->createBuffer(inImage->getSize());
+    {
+        auto uploadMap = uploadBuffer->map<uint8_t[]>();
+        std::copy(input.cbegin(), input.cend(), uploadMap.get());
+    }
+
+    const auto runAndDownload = [&](const std::shared_ptr<ll::ContainerNode>& container) {
+        auto image          = getPortImage(container, "out_gray");
+        auto downloadBuffer = hostMemory->createBuffer(image->getSize());
+
+        auto cmdBuffer = session->createCommandBuffer();
+        cmdBuffer->begin();
+        cmdBuffer->changeImageLayout(*inImage, ll::ImageLayout::TransferDstOptimal);
+        cmdBuffer->copyBufferToImage(*uploadBuffer, *inImage);
+        cmdBuffer->changeImageLayout(*inImage, ll::ImageLayout::General);
+        cmdBuffer->memoryBarrier();
+        container->record(*cmdBuffer);
+        cmdBuffer->memoryBarrier();
+        cmdBuffer->changeImageLayout(*image, ll::ImageLayout::TransferSrcOptimal);
+        cmdBuffer->copyImageToBuffer(*image, *downloadBuffer);
+        cmdBuffer->changeImageLayout(*image, ll::ImageLayout::General);
+        cmdBuffer->end();
+
+        session->run(*cmdBuffer);
+
+        auto downloadMap = downloadBuffer->map<uint8_t[]>();
+        return std::vector<uint8_t>(downloadMap.get(), downloadMap.get() + image->getSize());
+    };
+
+    REQUIRE(runAndDownload(node) == runAndDownload(expectedNode));
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerReinitFixedShape", "test_NodeBuilder")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->loadLibrary(runfiles->Rlocation("lluvia/lluvia/nodes/lluvia_node_library.zip"));
+
+    // the lookup table is written by a node and does not depend on the input resolution
+    session->script(R"(
+local builder = ll.class(ll.ContainerNodeBuilder)
+builder.name = 'test/GrayWithTable'
+
+function builder.newDescriptor()
+
+    local desc = ll.ContainerNodeDescriptor.new()
+
+    desc.builderName = builder.name
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_rgba', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_gray', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function builder.onNodeInit(node)
+
+    local lutImage = ll.getDeviceMemory():createImage(
+        ll.ImageDescriptor.new(1, 1, 256, ll.ChannelCount.C4, ll.ChannelType.Uint8))
+
+    local lutView = lutImage:createImageView(
+        ll.ImageViewDescriptor.new(ll.ImageAddressMode.Repeat, ll.ImageFilterMode.Nearest, false, false))
+
+    lutImage:changeImageLayout(ll.ImageLayout.General)
+
+    local lut = ll.createComputeNode('lluvia/color/RGBA2Gray')
+    lut:bind('in_rgba', lutView)
+    lut:init()
+
+    local gray = ll.createComputeNode('lluvia/color/RGBA2Gray')
+    gray:bind('in_rgba', node:getPort('in_rgba'))
+    gray:init()
+
+    node:bindNode('lut', lut)
+    node:bindNode('gray', gray)
+    node:bind('out_gray', gray:getPort('out_gray'))
+end
+
+function builder.onNodeRecord(node, cmdBuffer)
+
+    cmdBuffer:run(node:getNode('lut'))
+    cmdBuffer:run(node:getNode('gray'))
+end
+
+ll.registerNodeBuilder(builder)
+    )");
+
+    auto memory = session->getDeviceMemory();
+
+    auto inImage = memory->createImage(ll::ImageDescriptor {1, 48, 64, ll::ChannelCount::C4, ll::ChannelType::Uint8});
+    auto inView  = inImage->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false});
+    inImage->changeImageLayout(ll::ImageLayout::General);
+
+    auto node = session->createContainerNode("test/GrayWithTable");
+    node->bind("in_rgba", inView);
+    node->init();
+
+    auto lut   = std::static_pointer_cast<ll::ComputeNode>(node->getNode("lut"));
+    auto gray  = std::static_pointer_cast<ll::ComputeNode>(node->getNode("gray"));
+
+    const auto lutGrid = lut->getGridShape();
+
+    inImage->reshape({128, 96, 1});
+    node->reinit();
+
+    // the one row lookup table is not a pyramid level nor a multiple of the reference
+    const auto lutImage = getPortImage(lut, "out_gray");
+    REQUIRE(lutImage->getWidth() == 256);
+    REQUIRE(lutImage->getHeight() == 1);
+
+    REQUIRE(lut->getGridShape().x == lutGrid.x);
+    REQUIRE(lut->getGridShape().y == lutGrid.y);
+
+    const auto grayImage = getPortImage(gray, "out_gray");
+    REQUIRE(grayImage->getWidth() == 128);
+    REQUIRE(grayImage->getHeight() == 96);
+
+    auto cmdBuffer = session->createCommandBuffer();
+    cmdBuffer->begin();
+    node->record(*cmdBuffer);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("NodeBuilderDescriptors", "test_NodeBuilder")
+{
+
+    auto session = ll::Session::create();
+    REQUIRE(session != nullptr);
+
+    session->registerNodeBuilder("test/NativeAssign", std::make_shared<NativeAssign>());
+
+    const auto descriptors = session->getNodeBuilderDescriptors();
+    const auto it          = std::find_if(descriptors.cbegin(), descriptors.cend(), [](const auto& desc) { return desc.name == "test/NativeAssign"; });
+
+    REQUIRE(it != descriptors.cend());
+    REQUIRE(it->nodeType == ll::NodeType::Compute);
+    REQUIRE(it->summary == "Assigns the index to each element.");
+
+    REQUIRE(session->help("test/NativeAssign") == NativeAssign {}.getDoc());
+}
@@ -0,0 +1,214 @@
+/**
+@file       test_ParameterBlock.cpp
+@brief      Test parameter blocks.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+TEST_CASE("Creation", "test_ParameterBlock")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto block = session->createParameterBlock(sizeof(float), 3);
+    REQUIRE(block != nullptr);
+
+    REQUIRE(block->getBlockSize() == sizeof(float));
+    REQUIRE(block->getSlotCount() == 3);
+    REQUIRE(block->getSlotStride() >= sizeof(float));
+    REQUIRE(block->getSlotOffset(2) == 2 * block->getSlotStride());
+    REQUIRE(block->getBuffer()->getSize() == 3 * block->getSlotStride());
+
+    REQUIRE_THROWS_AS(block->getSlotOffset(3), std::system_error);
+    REQUIRE_THROWS_AS(block->write(0, double {0.0}), std::system_error);
+
+    REQUIRE_THROWS_AS(session->createParameterBlock(0, 1), std::system_error);
+    REQUIRE_THROWS_AS(session->createParameterBlock(sizeof(float), 0), std::system_error);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("UpdateWithoutRecording", "test_ParameterBlock")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t N {32};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto constants = ll::PushConstants {};
+    constants.setFloat(3.1415f);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/parameterBlock.comp.spv"));
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    .setFunctionName("main")
+                    .setProgram(program)
+                    .setGridShape({N / 32, 1, 1})
+                    .setLocalShape({32, 1, 1})
+                    .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                    .setPushConstants(constants)
+                    .setParameterBlockBinding(1);
+
+    auto node = session->createComputeNode(desc);
+    REQUIRE(node != nullptr);
+
+    auto block = session->createParameterBlock(sizeof(float), 2);
+    REQUIRE(block != nullptr);
+
+    auto buffer = session->getHostMemory()->createBuffer(N * sizeof(float));
+    REQUIRE(buffer != nullptr);
+
+    node->bind("out_buffer", buffer);
+    node->bindParameterBlock(block);
+    node->init();
+
+    // one command buffer per slot, recorded only once
+    auto cmdBuffer0 = session->createCommandBuffer();
+    cmdBuffer0->begin();
+    cmdBuffer0->run(*node);
+    cmdBuffer0->end();
+
+    node->setParameterBlockSlot(1);
+
+    auto cmdBuffer1 = session->createCommandBuffer();
+    cmdBuffer1->begin();
+    cmdBuffer1->run(*node);
+    cmdBuffer1->end();
+
+    auto checkValue = [&](const float expected) {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < N; ++i) {
+            REQUIRE(bufferMap[i] == expected);
+        }
+    };
+
+    // initial push constant values are written into all the slots
+    session->run(*cmdBuffer0);
+    checkValue(3.1415f);
+
+    block->write(0, 1.0f);
+    block->write(1, 2.0f);
+
+    session->run(*cmdBuffer0);
+    checkValue(1.0f);
+
+    session->run(*cmdBuffer1);
+    checkValue(2.0f);
+
+    // setting the push constants updates the current slot
+    constants.setFloat(5.0f);
+    node->setPushConstants(constants);
+
+    session->run(*cmdBuffer1);
+    checkValue(5.0f);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("FrameIndexSelectsSlot", "test_ParameterBlock")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const size_t   N {32};
+    constexpr const uint32_t slotCount {2};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto constants = ll::PushConstants {};
+    constants.setFloat(0.0f);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/parameterBlock.comp.spv"));
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    .setFunctionName("main")
+                    .setProgram(program)
+                    .setGridShape({N / 32, 1, 1})
+                    .setLocalShape({32, 1, 1})
+                    .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                    .setPushConstants(constants)
+                    .setParameterBlockBinding(1);
+
+    auto node   = session->createComputeNode(desc);
+    auto block  = session->createParameterBlock(sizeof(float), slotCount);
+    auto buffer = session->getHostMemory()->createBuffer(N * sizeof(float));
+
+    node->bind("out_buffer", buffer);
+    node->bindParameterBlock(block);
+    node->init();
+
+    // one command buffer per frame in flight, each reading its own slot
+    auto cmdBuffers = std::vector<std::unique_ptr<ll::CommandBuffer>> {};
+    for (auto frame = 0u; frame < slotCount; ++frame) {
+
+        node->setFrameIndex(frame);
+        REQUIRE(node->getParameterBlockSlot() == frame);
+
+        cmdBuffers.push_back(session->createCommandBuffer());
+        cmdBuffers.back()->begin();
+        cmdBuffers.back()->run(*node);
+        cmdBuffers.back()->end();
+    }
+
+    node->setFrameIndex(5);
+    REQUIRE(node->getParameterBlockSlot() == 1);
+
+    for (auto frame = 0u; frame < 6; ++frame) {
+
+        const auto slot = frame % slotCount;
+        block->write(slot, static_cast<float>(frame));
+        session->run(*cmdBuffers[slot]);
+
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < N; ++i) {
+            REQUIRE(bufferMap[i] == static_cast<float>(frame));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("NotEnabled", "test_ParameterBlock")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/parameterBlock.comp.spv"));
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    .setFunctionName("main")
+                    .setProgram(program)
+                    .setLocalShape({32, 1, 1})
+                    .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer});
+
+    auto node = session->createComputeNode(desc);
+    REQUIRE(node != nullptr);
+
+    auto block = session->createParameterBlock(sizeof(float), 1);
+    REQUIRE_THROWS_AS(node->bindParameterBlock(block), std::system_error);
+}
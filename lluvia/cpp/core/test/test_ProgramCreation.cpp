@@ -1040,6 +1040,38 @@ TEST_CASE("FromSPIRV", "test_ProgramCreation")
     REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
 }
 
+TEST_CASE("ReleaseSpirV", "test_ProgramCreation")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/assign.comp.spv"));
+    REQUIRE(program != nullptr);
+    REQUIRE(program->hasSpirV());
+
+    const auto module = program->getShaderModule();
+
+    program->releaseSpirV();
+    REQUIRE_FALSE(program->hasSpirV());
+    REQUIRE(program->getSpirV().empty());
+
+    // the shader module is not affected
+    REQUIRE(program->getShaderModule() == module);
+
+    auto node = session->createComputeNode(ll::ComputeNodeDescriptor()
+                                               .setProgram(program)
+                                               .setFunctionName("main")
+                                               .setLocalX(32)
+                                               .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer}));
+    REQUIRE(node != nullptr);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
 TEST_CASE("FromSPIRV_empty", "test_ProgramCreation")
 {
 
@@ -0,0 +1,124 @@
+/**
+@file       test_SpecializationConstants.cpp
+@brief      Test specialization constants.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+TEST_CASE("Creation", "test_SpecializationConstants")
+{
+
+    constexpr auto begin = ll::SpecializationConstants::BEGIN;
+
+    auto constants = ll::SpecializationConstants {};
+    REQUIRE(constants.getCount() == 0);
+
+    constants.setFloat(begin, 3.1415f);
+    constants.setInt32(begin + 1, -7);
+    constants.setUint32(begin + 2, 789456u);
+    constants.setBool(begin + 3, true);
+
+    REQUIRE(constants.getCount() == 4);
+    REQUIRE(constants.contains(begin));
+    REQUIRE_FALSE(constants.contains(begin + 4));
+
+    REQUIRE(constants.getFloat(begin) == 3.1415f);
+    REQUIRE(constants.getInt32(begin + 1) == -7);
+    REQUIRE(constants.getUint32(begin + 2) == 789456u);
+    REQUIRE(constants.getBool(begin + 3) == true);
+
+    REQUIRE(constants.getType(begin) == ll::SpecializationConstantType::Float);
+    REQUIRE(constants.getType(begin + 3) == ll::SpecializationConstantType::Bool);
+
+    // overwrite with a different type
+    constants.setInt32(begin, 12);
+    REQUIRE(constants.getCount() == 4);
+    REQUIRE(constants.getInt32(begin) == 12);
+}
+
+TEST_CASE("InvalidAccess", "test_SpecializationConstants")
+{
+
+    auto constants = ll::SpecializationConstants {};
+
+    // IDs 1 to 3 are reserved for the local shape
+    REQUIRE_THROWS_AS(constants.setInt32(1, 0), std::system_error);
+    REQUIRE_THROWS_AS(constants.setFloat(3, 0.0f), std::system_error);
+
+    constants.setFloat(ll::SpecializationConstants::BEGIN, 1.0f);
+
+    // type mismatch
+    REQUIRE_THROWS_AS(constants.getInt32(ll::SpecializationConstants::BEGIN), std::system_error);
+
+    // not found
+    REQUIRE_THROWS_AS(constants.getFloat(ll::SpecializationConstants::BEGIN + 1), std::system_error);
+}
+
+TEST_CASE("ComputeNode", "test_SpecializationConstants")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const float   value  = 3.1415f;
+    constexpr const int32_t offset = 2;
+    constexpr const size_t  N {32};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto constants = ll::SpecializationConstants {};
+    constants.setFloat(ll::SpecializationConstants::BEGIN, value);
+    constants.setInt32(ll::SpecializationConstants::BEGIN + 1, offset);
+    constants.setBool(ll::SpecializationConstants::BEGIN + 2, true);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/specializationConstants.comp.spv"));
+
+    auto desc = ll::ComputeNodeDescriptor {}
+                    .setFunctionName("main")
+                    .setProgram(program)
+                    .setGridShape({N / 32, 1, 1})
+                    .setLocalShape({32, 1, 1})
+                    .addPort({0, "out_buffer", ll::PortDirection::Out, ll::PortType::Buffer})
+                    .setSpecializationConstants(constants);
+
+    auto node = session->createComputeNode(desc);
+    REQUIRE(node != nullptr);
+
+    auto buffer = session->getHostMemory()->createBuffer(N * sizeof(value));
+    REQUIRE(buffer != nullptr);
+
+    node->bind("out_buffer", buffer);
+
+    node->init();
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+    cmdBuffer->run(*node);
+    cmdBuffer->end();
+
+    session->run(*cmdBuffer);
+
+    {
+        auto bufferMap = buffer->map<float[]>();
+        for (auto i = 0u; i < N; ++i) {
+            REQUIRE(bufferMap[i] == -(value + offset));
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
@@ -0,0 +1,153 @@
+/**
+@file       test_TiledExecutor.cpp
+@brief      Test TiledExecutor class.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+TEST_CASE("ComputeTiles", "test_TiledExecutor")
+{
+
+    const auto tiles = ll::TiledExecutor::computeTiles({100, 50, 1}, {40, 50, 1}, 5);
+    REQUIRE(tiles.size() == 4);
+
+    const auto expectedInput = std::vector<uint32_t> {0, 25, 55, 60};
+    const auto expectedCore  = std::vector<uint32_t> {0, 30, 60, 90};
+    const auto expectedShape = std::vector<uint32_t> {30, 30, 30, 10};
+
+    for (auto i = 0u; i < tiles.size(); ++i) {
+        REQUIRE(tiles[i].inputOffset.x == expectedInput[i]);
+        REQUIRE(tiles[i].coreOffset.x == expectedCore[i]);
+        REQUIRE(tiles[i].coreShape.x == expectedShape[i]);
+
+        REQUIRE(tiles[i].inputOffset.y == 0);
+        REQUIRE(tiles[i].coreOffset.y == 0);
+        REQUIRE(tiles[i].coreShape.y == 50);
+
+        // the core lies inside the window
+        REQUIRE(tiles[i].coreOffset.x >= tiles[i].inputOffset.x);
+        REQUIRE(tiles[i].coreOffset.x + tiles[i].coreShape.x <= tiles[i].inputOffset.x + 40);
+    }
+
+    // tile not larger than twice the halo
+    REQUIRE_THROWS_AS(ll::TiledExecutor::computeTiles({100, 50, 1}, {10, 50, 1}, 5), std::system_error);
+
+    // tile larger than the image
+    REQUIRE_THROWS_AS(ll::TiledExecutor::computeTiles({100, 50, 1}, {120, 50, 1}, 5), std::system_error);
+}
+
+TEST_CASE("Run", "test_TiledExecutor")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const uint32_t width {150};
+    constexpr const uint32_t height {200};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/stencilMax.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    session->setProgram("test/stencilMax.comp", program);
+
+    session->script(R"(
+local builder = ll.class(ll.ComputeNodeBuilder)
+builder.name = 'test/StencilMax'
+
+function builder.newDescriptor()
+
+    local desc = ll.ComputeNodeDescriptor.new()
+
+    desc.builderName   = builder.name
+    desc.localShape    = ll.vec3ui.new(16, 16, 1)
+    desc.gridShape     = ll.vec3ui.new(1, 1, 1)
+    desc.program       = ll.getProgram('test/stencilMax.comp')
+    desc.functionName  = 'main'
+    desc.stencilRadius = 1
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_image', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_image', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function builder.onNodeInit(node)
+
+    local in_image = node:getPort('in_image')
+
+    local imgDesc = ll.ImageDescriptor.new(in_image.imageDescriptor)
+
+    local imgViewDesc = ll.ImageViewDescriptor.new(ll.ImageAddressMode.Repeat, ll.ImageFilterMode.Nearest, false, false)
+
+    local out_image = in_image.memory:createImageView(imgDesc, imgViewDesc)
+    out_image:changeImageLayout(ll.ImageLayout.General)
+
+    node:bind('out_image', out_image)
+    node:configureGridShape(ll.vec3ui.new(out_image.width, out_image.height, 1))
+end
+
+ll.registerNodeBuilder(builder)
+        )");
+
+    auto desc = ll::TiledExecutorDescriptor {}
+                    .setBuilderName("test/StencilMax")
+                    .setImageDescriptor(ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, ll::ChannelType::Uint8})
+                    .setInputImageViewDescriptor(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false})
+                    .setTileShape({64, 48, 1})
+                    .setInFlightCount(3);
+
+    auto executor = session->createTiledExecutor(desc);
+    REQUIRE(executor != nullptr);
+
+    REQUIRE(executor->getHaloRadius() == 1);
+    REQUIRE(executor->getTiles().size() > 1);
+    REQUIRE(executor->getOutputSize() == width * height);
+
+    auto input = std::vector<uint8_t>(executor->getInputSize());
+    for (auto i = 0u; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>((i * 7919u) % 251u);
+    }
+
+    auto output = std::vector<uint8_t>(executor->getOutputSize(), 0);
+    executor->run(input.data(), output.data());
+
+    for (auto y = 0; y < static_cast<int>(height); ++y) {
+        for (auto x = 0; x < static_cast<int>(width); ++x) {
+
+            auto expected = uint8_t {0};
+            for (auto dy = -1; dy <= 1; ++dy) {
+                for (auto dx = -1; dx <= 1; ++dx) {
+                    const auto px = std::clamp(x + dx, 0, static_cast<int>(width) - 1);
+                    const auto py = std::clamp(y + dy, 0, static_cast<int>(height) - 1);
+                    expected      = std::max(expected, input[py * width + px]);
+                }
+            }
+
+            REQUIRE(output[y * width + x] == expected);
+        }
+    }
+
+    // running again reuses the recorded command buffers
+    std::fill(output.begin(), output.end(), 0);
+    executor->run(input.data(), output.data());
+    REQUIRE(std::any_of(output.cbegin(), output.cend(), [](const auto v) { return v != 0; }));
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
@@ -0,0 +1,388 @@
+/**
+@file       test_TransientImages.cpp
+@brief      Test aliasing of transient images.
+@copyright  2022, Juan David Adarve Bermudez. See AUTHORS for more details.
+            Distributed under the Apache-2 license, see LICENSE for more details.
+*/
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "lluvia/core.h"
+
+#include "tools/cpp/runfiles/runfiles.h"
+using bazel::tools::cpp::runfiles::Runfiles;
+
+namespace {
+
+const ll::ImageUsageFlags imgUsageFlags = {ll::ImageUsageFlagBits::Storage
+                                           | ll::ImageUsageFlagBits::Sampled
+                                           | ll::ImageUsageFlagBits::TransferSrc
+                                           | ll::ImageUsageFlagBits::TransferDst};
+
+constexpr const auto STENCIL_MAX_BUILDER = R"(
+local stencil = ll.class(ll.ComputeNodeBuilder)
+stencil.name = 'test/StencilMax'
+
+function stencil.newDescriptor()
+
+    local desc = ll.ComputeNodeDescriptor.new()
+
+    desc.builderName   = stencil.name
+    desc.localShape    = ll.vec3ui.new(16, 16, 1)
+    desc.gridShape     = ll.vec3ui.new(1, 1, 1)
+    desc.program       = ll.getProgram('test/stencilMax.comp')
+    desc.functionName  = 'main'
+    desc.stencilRadius = 1
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_image', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_image', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function stencil.onNodeInit(node)
+
+    local in_image = node:getPort('in_image')
+
+    local imgDesc = ll.ImageDescriptor.new(in_image.imageDescriptor)
+
+    local imgViewDesc = ll.ImageViewDescriptor.new(ll.ImageAddressMode.Repeat, ll.ImageFilterMode.Nearest, false, false)
+
+    local out_image = in_image.memory:createImageView(imgDesc, imgViewDesc)
+    out_image:changeImageLayout(ll.ImageLayout.General)
+
+    node:bind('out_image', out_image)
+    node:configureGridShape(ll.vec3ui.new(out_image.width, out_image.height, 1))
+end
+
+ll.registerNodeBuilder(stencil)
+)";
+
+std::shared_ptr<ll::Image> getPortImage(const std::shared_ptr<ll::Node>& node, const std::string& port)
+{
+    return std::static_pointer_cast<ll::ImageView>(node->getPort(port))->getImage();
+}
+
+// chain of four stencils, where the output of the first one is cleared after the third one runs
+class ClearingStencilChain : public ll::ContainerNodeBuilder {
+
+public:
+    ClearingStencilChain(ll::Session* session, const std::shared_ptr<ll::Buffer>& copyBuffer)
+        : m_session {session}
+        , m_copyBuffer {copyBuffer}
+    {
+    }
+
+    ll::ContainerNodeDescriptor newDescriptor(const ll::Session& /*session*/) override
+    {
+
+        return ll::ContainerNodeDescriptor()
+            .addPort({0, "in_image", ll::PortDirection::In, ll::PortType::ImageView})
+            .addPort({1, "out_image", ll::PortDirection::Out, ll::PortType::ImageView});
+    }
+
+    void onNodeInit(ll::ContainerNode& node) override
+    {
+
+        auto in_image = node.getPort("in_image");
+
+        for (auto i = 1; i <= 4; ++i) {
+            auto stencil = m_session->createComputeNode("test/StencilMax");
+            stencil->bind("in_image", in_image);
+            stencil->init();
+
+            in_image = stencil->getPort("out_image");
+            node.markTransient(in_image);
+            node.bindNode("stencil_" + std::to_string(i), stencil);
+        }
+
+        node.bind("out_image", in_image);
+    }
+
+    void onNodeRecord(const ll::ContainerNode& node, ll::CommandBuffer& commandBuffer) override
+    {
+
+        for (auto i = 1; i <= 4; ++i) {
+            node.getNode("stencil_" + std::to_string(i))->record(commandBuffer);
+            commandBuffer.memoryBarrier();
+
+            // the third image is alive while the first one is cleared
+            if (i == 3) {
+                commandBuffer.clearImage(*getPortImage(node.getNode("stencil_1"), "out_image"));
+                commandBuffer.memoryBarrier();
+            }
+        }
+
+        // a command the container does not trace
+        if (m_copyBuffer != nullptr) {
+            commandBuffer.copyImageToBuffer(*getPortImage(node.getNode("stencil_4"), "out_image"), *m_copyBuffer);
+        }
+    }
+
+private:
+    ll::Session*                m_session;
+    std::shared_ptr<ll::Buffer> m_copyBuffer;
+};
+
+} // namespace
+
+TEST_CASE("AliasImages", "test_TransientImages")
+{
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto memory = session->getDeviceMemory();
+
+    const auto desc = ll::ImageDescriptor {1, 64, 64, ll::ChannelCount::C1, ll::ChannelType::Uint8}.setUsageFlags(imgUsageFlags);
+
+    auto a = memory->createImage(desc);
+    auto b = memory->createImage(desc);
+    auto c = memory->createImage(desc);
+
+    // views created before aliasing are updated
+    auto viewA = a->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false});
+
+    REQUIRE_FALSE(a->isAliased());
+
+    // a and c are never used at the same time
+    const auto size = memory->aliasImages({a, b, c}, {{0, 1}, {1, 2}, {2, 3}});
+
+    REQUIRE(a->isAliased());
+    REQUIRE(b->isAliased());
+    REQUIRE(c->isAliased());
+
+    REQUIRE(a->getAllocationInfo().page == c->getAllocationInfo().page);
+    REQUIRE(a->getAllocationInfo().offset == c->getAllocationInfo().offset);
+    REQUIRE(a->getAllocationInfo().offset != b->getAllocationInfo().offset);
+
+    REQUIRE(size >= a->getSize() + b->getSize());
+    REQUIRE(size < a->getSize() + b->getSize() + c->getSize());
+
+    REQUIRE(a->getLayout() == ll::ImageLayout::Undefined);
+    viewA->changeImageLayout(ll::ImageLayout::General);
+    viewA->clear();
+
+    // already aliased
+    REQUIRE_THROWS_AS(memory->aliasImages({a}, {{0, 0}}), std::system_error);
+
+    auto d = memory->createImage(desc);
+
+    // lifetimes do not match the images
+    REQUIRE_THROWS_AS(memory->aliasImages({d}, {}), std::system_error);
+    REQUIRE_THROWS_AS(memory->aliasImages({d}, {{2, 1}}), std::system_error);
+    REQUIRE_FALSE(d->isAliased());
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerNode", "test_TransientImages")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const uint32_t width {64};
+    constexpr const uint32_t height {48};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    auto program = session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/stencilMax.comp.spv"));
+    REQUIRE(program != nullptr);
+
+    session->setProgram("test/stencilMax.comp", program);
+
+    session->script(STENCIL_MAX_BUILDER);
+
+    session->script(R"(
+local chain = ll.class(ll.ContainerNodeBuilder)
+chain.name = 'test/StencilChain'
+
+function chain.newDescriptor()
+
+    local desc = ll.ContainerNodeDescriptor.new()
+
+    desc.builderName = chain.name
+
+    desc:addPort(ll.PortDescriptor.new(0, 'in_image', ll.PortDirection.In, ll.PortType.ImageView))
+    desc:addPort(ll.PortDescriptor.new(1, 'out_image', ll.PortDirection.Out, ll.PortType.ImageView))
+
+    return desc
+end
+
+function chain.onNodeInit(node)
+
+    local in_image = node:getPort('in_image')
+
+    for i = 1, 4 do
+        local s = ll.createComputeNode('test/StencilMax')
+        s:bind('in_image', in_image)
+        s:init()
+
+        in_image = s:getPort('out_image')
+        node:markTransient(in_image)
+        node:bindNode(string.format('stencil_%d', i), s)
+    end
+
+    -- the last output is excluded from aliasing as it is bound to the container
+    node:bind('out_image', in_image)
+end
+
+function chain.onNodeRecord(node, cmdBuffer)
+
+    for i = 1, 4 do
+        cmdBuffer:run(node:getNode(string.format('stencil_%d', i)))
+        cmdBuffer:memoryBarrier()
+    end
+end
+
+ll.registerNodeBuilder(chain)
+        )");
+
+    auto memory     = session->getDeviceMemory();
+    auto hostMemory = session->getHostMemory();
+
+    const auto imgDesc = ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, ll::ChannelType::Uint8}.setUsageFlags(imgUsageFlags);
+
+    auto inImage = memory->createImage(imgDesc);
+    auto inView  = inImage->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false});
+    inImage->changeImageLayout(ll::ImageLayout::General);
+
+    auto node = session->createContainerNode("test/StencilChain");
+    REQUIRE(node != nullptr);
+
+    node->bind("in_image", inView);
+    node->init();
+
+    const auto image1 = getPortImage(node->getNode("stencil_1"), "out_image");
+    const auto image2 = getPortImage(node->getNode("stencil_2"), "out_image");
+    const auto image3 = getPortImage(node->getNode("stencil_3"), "out_image");
+    const auto image4 = getPortImage(node->getNode("stencil_4"), "out_image");
+
+    REQUIRE(image1->isAliased());
+    REQUIRE(image2->isAliased());
+    REQUIRE(image3->isAliased());
+    REQUIRE_FALSE(image4->isAliased());
+
+    // the first and third images are never alive at the same time
+    REQUIRE(image1->getAllocationInfo().offset == image3->getAllocationInfo().offset);
+    REQUIRE(image1->getAllocationInfo().offset != image2->getAllocationInfo().offset);
+
+    REQUIRE(node->getTransientMemorySize() < image1->getSize() + image2->getSize() + image3->getSize());
+
+    auto input = std::vector<uint8_t>(imgDesc.getSize());
+    for (auto i = 0u; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>((i * 7919u) % 251u);
+    }
+
+    auto uploadBuffer   = hostMemory->createBuffer(imgDesc.getSize());
+    auto downloadBuffer = hostMemory->createBuffer(imgDesc.getSize());
+
+    {
+        auto uploadMap = uploadBuffer->map<uint8_t[]>();
+        std::copy(input.cbegin(), input.cend(), uploadMap.get());
+    }
+
+    auto cmdBuffer = session->createCommandBuffer();
+    REQUIRE(cmdBuffer != nullptr);
+
+    cmdBuffer->begin();
+    cmdBuffer->changeImageLayout(*inImage, ll::ImageLayout::TransferDstOptimal);
+    cmdBuffer->copyBufferToImage(*uploadBuffer, *inImage);
+    cmdBuffer->changeImageLayout(*inImage, ll::ImageLayout::General);
+    cmdBuffer->run(*node);
+    cmdBuffer->changeImageLayout(*image4, ll::ImageLayout::TransferSrcOptimal);
+    cmdBuffer->copyImageToBuffer(*image4, *downloadBuffer);
+    cmdBuffer->changeImageLayout(*image4, ll::ImageLayout::General);
+    cmdBuffer->end();
+
+    // run twice, the transient images are discarded at every execution
+    session->run(*cmdBuffer);
+    session->run(*cmdBuffer);
+
+    {
+        // four 3x3 stencils are equivalent to a single 9x9 stencil
+        auto downloadMap = downloadBuffer->map<uint8_t[]>();
+
+        for (auto y = 0; y < static_cast<int>(height); ++y) {
+            for (auto x = 0; x < static_cast<int>(width); ++x) {
+
+                auto expected = uint8_t {0};
+                for (auto dy = -4; dy <= 4; ++dy) {
+                    for (auto dx = -4; dx <= 4; ++dx) {
+                        const auto px = std::clamp(x + dx, 0, static_cast<int>(width) - 1);
+                        const auto py = std::clamp(y + dy, 0, static_cast<int>(height) - 1);
+                        expected      = std::max(expected, input[py * width + px]);
+                    }
+                }
+
+                REQUIRE(downloadMap[y * width + x] == expected);
+            }
+        }
+    }
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
+
+TEST_CASE("ContainerCommands", "test_TransientImages")
+{
+
+    auto runfiles = Runfiles::CreateForTest(nullptr);
+    REQUIRE(runfiles != nullptr);
+
+    constexpr const uint32_t width {64};
+    constexpr const uint32_t height {48};
+
+    auto session = ll::Session::create(ll::SessionDescriptor().enableDebug(true));
+    REQUIRE(session != nullptr);
+
+    session->setProgram("test/stencilMax.comp", session->createProgram(runfiles->Rlocation("lluvia/lluvia/cpp/core/test/glsl/stencilMax.comp.spv")));
+    session->script(STENCIL_MAX_BUILDER);
+
+    auto memory = session->getDeviceMemory();
+
+    const auto imgDesc = ll::ImageDescriptor {1, height, width, ll::ChannelCount::C1, ll::ChannelType::Uint8}.setUsageFlags(imgUsageFlags);
+
+    auto inImage = memory->createImage(imgDesc);
+    auto inView  = inImage->createImageView(ll::ImageViewDescriptor {ll::ImageAddressMode::Repeat, ll::ImageFilterMode::Nearest, false, false});
+    inImage->changeImageLayout(ll::ImageLayout::General);
+
+    session->registerNodeBuilder("test/ClearingStencilChain", std::make_shared<ClearingStencilChain>(session.get(), nullptr));
+    session->registerNodeBuilder("test/CopyingStencilChain", std::make_shared<ClearingStencilChain>(session.get(), session->getHostMemory()->createBuffer(imgDesc.getSize())));
+
+    auto node = session->createContainerNode("test/ClearingStencilChain");
+    node->bind("in_image", inView);
+    node->init();
+
+    const auto image1 = getPortImage(node->getNode("stencil_1"), "out_image");
+    const auto image3 = getPortImage(node->getNode("stencil_3"), "out_image");
+
+    // the clear extends the lifetime of the first image over the third one
+    const auto shareMemory = image1->isAliased() && image3->isAliased()
+        && image1->getAllocationInfo().page == image3->getAllocationInfo().page
+        && image1->getAllocationInfo().offset == image3->getAllocationInfo().offset;
+
+    REQUIRE_FALSE(shareMemory);
+
+    // images are not aliased if the trace is incomplete
+    auto copyingNode = session->createContainerNode("test/CopyingStencilChain");
+    copyingNode->bind("in_image", inView);
+    copyingNode->init();
+
+    for (auto i = 1; i <= 4; ++i) {
+        REQUIRE_FALSE(getPortImage(copyingNode->getNode("stencil_" + std::to_string(i)), "out_image")->isAliased());
+    }
+
+    REQUIRE(copyingNode->getTransientMemorySize() == 0);
+
+    REQUIRE_FALSE(session->hasReceivedVulkanWarningMessages());
+}
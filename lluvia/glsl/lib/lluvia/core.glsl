@@ -1,7 +1,8 @@
 #ifndef LLUVIA_CORE_GLSL_
 #define LLUVIA_CORE_GLSL_
 
-// Compute shader global invocation coordinates
+// Compute shader global invocation coordinates.
+// They include the grid offset set through ll::ComputeNode::setGridOffset.
 #define LL_GLOBAL_COORDS_1D gl_GlobalInvocationID.x
 #define LL_GLOBAL_COORDS_2D ivec2(gl_GlobalInvocationID.x, gl_GlobalInvocationID.y)
 #define LL_GLOBAL_COORDS_3D ivec3(gl_GlobalInvocationID.x, gl_GlobalInvocationID.y, gl_GlobalInvocationID.z)
@@ -37,6 +37,11 @@ end
 function ll.getNodeBuilder(name)
     
     local builder = ll.nodeBuilders[name]
+
+    -- builders of libraries loaded lazily are registered on first use
+    if builder == nil and ll.activeSession ~= nil and ll.activeSession:__loadLazyNodeBuilder(name) then
+        builder = ll.nodeBuilders[name]
+    end
     
     if builder == nil then
         error('builder not found: ' .. name)
@@ -60,7 +65,7 @@ function ll.getNodeBuilderDescriptors()
         local builder = ll.nodeBuilders[name]
         
         -- finds the summary string
-        local firstLineIndex = builder.doc:find('\n')
+        local firstLineIndex = builder.doc:find('\n') or (#builder.doc + 1)
         local summary = builder.doc:sub(1, firstLineIndex-1)
 
         local desc = ll.NodeBuilderDescriptor.new(builder.type, name, summary)
@@ -75,9 +80,10 @@ end
 function ll.castObject(obj)
 
     castTable = {
-        [ll.ObjectType.Buffer]    = ll.impl.castObjectToBuffer,
-        [ll.ObjectType.Image]     = ll.impl.castObjectToImage,
-        [ll.ObjectType.ImageView] = ll.impl.castObjectToImageView
+        [ll.ObjectType.Buffer]     = ll.impl.castObjectToBuffer,
+        [ll.ObjectType.Image]      = ll.impl.castObjectToImage,
+        [ll.ObjectType.ImageView]  = ll.impl.castObjectToImageView,
+        [ll.ObjectType.BufferView] = ll.impl.castObjectToBufferView
     }
 
     return castTable[obj.type](obj)
@@ -127,6 +133,22 @@ function ll.getDeviceMemory()
     return ll.activeSession:getDeviceMemory()
 end
 
+function ll.getReadbackMemory()
+    if not ll.activeSession then
+        error('ll.activeSession nil')
+    end
+
+    return ll.activeSession:getReadbackMemory()
+end
+
+function ll.getUploadMemory()
+    if not ll.activeSession then
+        error('ll.activeSession nil')
+    end
+
+    return ll.activeSession:getUploadMemory()
+end
+
 function ll.getProgram(name)
     
     if not ll.activeSession then
@@ -163,6 +185,15 @@ function ll.createContainerNode(name)
     return ll.activeSession:createContainerNode(name)
 end
 
+function ll.createParameterBlock(blockSize, slotCount)
+
+    if not ll.activeSession then
+        error('ll.activeSession nil')
+    end
+
+    return ll.activeSession:createParameterBlock(blockSize, slotCount)
+end
+
 function ll.getGoodComputeLocalShape(dimensions)
 
     if not ll.activeSession then
@@ -209,6 +240,11 @@ function ll.ComputeNodeBuilder.onNodeInit(node)
     -- do nothing
 end
 
+function ll.ComputeNodeBuilder.onNodeReshape(node)
+    -- called by node:reinit(), must not create or bind objects
+    node:scaleGridShape()
+end
+
 
 -----------------------------------------------------------
 --                 ContainerNodeBuilder
@@ -324,9 +360,10 @@ end
 function ll.ComputeNode:bind(name, obj)
 
     castTable = {
-        [ll.ObjectType.Buffer]    = ll.impl.castBufferToObject,
-        [ll.ObjectType.Image]     = ll.impl.castImageToObject,
-        [ll.ObjectType.ImageView] = ll.impl.castImageViewToObject
+        [ll.ObjectType.Buffer]     = ll.impl.castBufferToObject,
+        [ll.ObjectType.Image]      = ll.impl.castImageToObject,
+        [ll.ObjectType.ImageView]  = ll.impl.castImageViewToObject,
+        [ll.ObjectType.BufferView] = ll.impl.castBufferViewToObject
     }
 
     self:__bind(name, castTable[obj.type](obj))
@@ -383,9 +420,10 @@ end
 function ll.ContainerNode:bind(name, obj)
 
     castTable = {
-        [ll.ObjectType.Buffer]    = ll.impl.castBufferToObject,
-        [ll.ObjectType.Image]     = ll.impl.castImageToObject,
-        [ll.ObjectType.ImageView] = ll.impl.castImageViewToObject
+        [ll.ObjectType.Buffer]     = ll.impl.castBufferToObject,
+        [ll.ObjectType.Image]      = ll.impl.castImageToObject,
+        [ll.ObjectType.ImageView]  = ll.impl.castImageViewToObject,
+        [ll.ObjectType.BufferView] = ll.impl.castBufferViewToObject
     }
 
     self:__bind(name, castTable[obj.type](obj))
@@ -403,6 +441,17 @@ function ll.ContainerNode:getNode(name)
 end
 
 
+function ll.ContainerNode:markTransient(obj)
+
+    castTable = {
+        [ll.ObjectType.Image]     = ll.impl.castImageToObject,
+        [ll.ObjectType.ImageView] = ll.impl.castImageViewToObject
+    }
+
+    self:__markTransient(castTable[obj.type](obj))
+end
+
+
 function ll.ContainerNode:bindNode(name, node)
 
     castTable = {
@@ -42,6 +42,7 @@ function builder.newDescriptor()
     desc.gridShape    = ll.vec3ui.new(1, 1, 1)
     desc.program      = ll.getProgram('Sobel')
     desc.functionName = 'main'
+    desc.stencilRadius = 1
 
     desc:addPort(ll.PortDescriptor.new(0, 'in_gray', ll.PortDirection.In, ll.PortType.ImageView))
     desc:addPort(ll.PortDescriptor.new(2, 'out_gradient', ll.PortDirection.Out, ll.PortType.ImageView))
@@ -80,6 +80,9 @@ function builder.onNodeInit(node)
         downY:bind('in_gray', downX:getPort('out_gray'))
         downY:init()
 
+        -- only needed between downX and downY, can share memory with other levels
+        node:markTransient(downX:getPort('out_gray'))
+
         in_gray = downY:getPort('out_gray')
 
         -- bind the output
@@ -88,8 +91,15 @@ function builder.onNodeInit(node)
         end
 
         ll.logd(builder.name, 'onNodeInit: level:', i, 'binding node')
-        node:bindNode(string.format('ImageDownsampleX_r8ui_%d', i), downX)
-        node:bindNode(string.format('ImageDownsampleY_r8ui_%d', i), downY)
+        local downXName = string.format('ImageDownsampleX_r8ui_%d', i)
+        local downYName = string.format('ImageDownsampleY_r8ui_%d', i)
+
+        node:bindNode(downXName, downX)
+        node:bindNode(downYName, downY)
+
+        -- node indices used by onNodeRecord, resolved once
+        node:setParameter(string.format('downX_index_%d', i), node:getNodeIndex(downXName))
+        node:setParameter(string.format('downY_index_%d', i), node:getNodeIndex(downYName))
 
         -- outputs of each level
         node:bind(string.format('out_gray_%d', i), downY:getPort('out_gray'))
@@ -107,8 +117,9 @@ function builder.onNodeRecord(node, cmdBuffer)
     for i = 1, levels -1 do
         ll.logd(node.descriptor.builderName, 'onNodeRecord: level:', i)
 
-        local downX = node:getNode(string.format('ImageDownsampleX_r8ui_%d', i))
-        local downY = node:getNode(string.format('ImageDownsampleY_r8ui_%d', i))
+        -- parameters store numbers as floats, node indices are integers
+        local downX = node:getNode(math.floor(node:getParameter(string.format('downX_index_%d', i))))
+        local downY = node:getNode(math.floor(node:getParameter(string.format('downY_index_%d', i))))
 
         downX:record(cmdBuffer)
         cmdBuffer:memoryBarrier()
@@ -86,6 +86,11 @@ function builder.onNodeInit(node)
 
         in_flow = predictY:getPort('out_flow')
 
+        -- intermediate results can share memory. The output of the last
+        -- iteration is bound to out_flow and keeps its own memory.
+        node:markTransient(predictX:getPort('out_flow'))
+        node:markTransient(in_flow)
+
         node:bindNode(string.format('FlowPredictX_%d', i), predictX)
         node:bindNode(string.format('FlowPredictY_%d', i), predictY)
     end
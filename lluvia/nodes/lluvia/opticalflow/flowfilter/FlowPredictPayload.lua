@@ -117,6 +117,15 @@ function builder.onNodeInit(node)
         in_gray = predictY:getPort('out_gray')
         in_vector = predictY:getPort('out_vector')
 
+        -- intermediate results can share memory. The outputs of the last
+        -- iteration are bound to the node outputs and keep their own memory.
+        node:markTransient(predictX:getPort('out_flow'))
+        node:markTransient(predictX:getPort('out_gray'))
+        node:markTransient(predictX:getPort('out_vector'))
+        node:markTransient(in_flow)
+        node:markTransient(in_gray)
+        node:markTransient(in_vector)
+
         node:bindNode(string.format('FlowPredictPayloadX_%d', i), predictX)
         node:bindNode(string.format('FlowPredictPayloadY_%d', i), predictY)
     end
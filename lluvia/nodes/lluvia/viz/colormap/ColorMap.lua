@@ -164,8 +164,8 @@ function builder.onNodeInit(node)
     local decodedColorMap = ll.fromBase64(encodedColorMap)
     local bufferSize = decodedColorMap:size()
 
-    local hostMemory = ll.getHostMemory()
-    local stagingBuffer = hostMemory:createBuffer(bufferSize)
+    local uploadMemory = ll.getUploadMemory()
+    local stagingBuffer = uploadMemory:createBuffer(bufferSize)
     stagingBuffer:mapAndSetFromVectorUint8(decodedColorMap)
 
     local textureMemory = ll.getDeviceMemory()
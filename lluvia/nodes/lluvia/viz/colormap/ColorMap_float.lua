@@ -74,9 +74,13 @@ function builder.onNodeInit(node)
     pushConstants:pushFloat(min_value)
     pushConstants:pushFloat(max_value)
     pushConstants:pushFloat(alpha)
-    pushConstants:pushFloat(reverse)
     node.pushConstants = pushConstants
 
+    -- reverse is fixed at init, bake it into the pipeline
+    local specializationConstants = ll.SpecializationConstants.new()
+    specializationConstants:setBool(ll.SpecializationConstants.BEGIN, reverse == 1.0)
+    node.specializationConstants = specializationConstants
+
     local memory = in_image.memory
 
     out_rgba = memory:createImageView(
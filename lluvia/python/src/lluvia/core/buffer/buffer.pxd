@@ -17,6 +17,8 @@ from lluvia.core.buffer.buffer_usage_flags cimport _BufferUsageFlags
 
 from lluvia.core.core_object cimport _Object
 
+from lluvia.core.image.image cimport _ChannelCount, _ChannelType
+
 from lluvia.core.memory.memory cimport Memory, _Memory
 from lluvia.core.memory.memory_allocation_info cimport _MemoryAllocationInfo
 
@@ -39,11 +41,36 @@ cdef extern from 'lluvia/core/buffer/Buffer.h' namespace 'll':
 
         unique_ptr[T, _BufferMapDeleter] map[T]()
 
+        shared_ptr[_BufferView] createBufferView(_ChannelCount channelCount, _ChannelType channelType, uint64_t offset, uint64_t range) except +
+
+
+cdef extern from 'lluvia/core/buffer/BufferView.h' namespace 'll':
+
+    cdef cppclass _BufferView 'll::BufferView' (_Object):
+
+        const shared_ptr[_Buffer]& getBuffer() const
+
+        _ChannelCount getChannelCount() const
+        _ChannelType getChannelType() const
+        uint64_t getOffset() const
+        uint64_t getRange() const
+        uint64_t getTexelCount() const
+
 
 cdef _buildBuffer(shared_ptr[_Buffer] ptr, Session session, Memory memory)
+cdef _buildBufferView(shared_ptr[_BufferView] ptr, Session session, Buffer buffer)
 
 
 cdef class Buffer:
     cdef shared_ptr[_Buffer] __buffer
     cdef Session             __session
     cdef Memory              __memory
+
+    # host object whose memory is imported by this buffer, kept alive with it
+    cdef object              __hostObject
+
+
+cdef class BufferView:
+    cdef shared_ptr[_BufferView] __bufferView
+    cdef Session                 __session
+    cdef Buffer                  __buffer
@@ -19,6 +19,9 @@ from lluvia.core import impl
 
 from lluvia.core.buffer.buffer_usage_flags import BufferUsageFlagBits
 
+from lluvia.core.image cimport image
+from lluvia.core.image.image cimport ChannelType
+
 # wrap python symbols in ll_memory module
 import lluvia.core.memory as ll_memory
 
@@ -30,7 +33,8 @@ from lluvia.core.session cimport Session
 
 
 __all__ = [
-    'Buffer'
+    'Buffer',
+    'BufferView'
 ]
 
 
@@ -46,6 +50,20 @@ cdef _buildBuffer(shared_ptr[_Buffer] ptr, Session session, Memory memory):
     return buf
 
 
+cdef _buildBufferView(shared_ptr[_BufferView] ptr, Session session, Buffer buffer):
+
+    cdef BufferView view = BufferView()
+    view.__bufferView = ptr
+    view.__session = session
+
+    if buffer is None:
+        view.__buffer = _buildBuffer(ptr.get().getBuffer(), session, None)
+    else:
+        view.__buffer = buffer
+
+    return view
+
+
 cdef class Buffer:
 
     def __cinit__(self):
@@ -94,6 +112,51 @@ cdef class Buffer:
         def __get__(self):
             return self.__buffer.get().isMappable()
 
+    def createBufferView(self, uint32_t channels, channelType, uint64_t offset=0, range=None):
+        """
+        Creates a view of this buffer as an array of formatted texels.
+
+        The buffer must have been created with either BufferUsageFlagBits.UniformTexelBuffer
+        or BufferUsageFlagBits.StorageTexelBuffer usage flags.
+
+
+        Parameters
+        ----------
+        channels : int
+            Number of channels of each texel. Must be in [1, 2, 3, 4].
+
+        channelType : lluvia.ChannelType
+            Channel type of each texel.
+
+        offset : int. Defaults to 0.
+            Offset in bytes from the start of the buffer. It must be a multiple
+            of the device's minimum texel buffer offset alignment.
+
+        range : int or None. Defaults to None.
+            Size in bytes of the view. It must be a multiple of the texel size.
+            If None, the view covers the rest of the buffer after offset.
+
+
+        Returns
+        -------
+        view : BufferView.
+
+
+        Raises
+        ------
+        RuntimeError : if the buffer usage flags, the texel format, or the
+                       offset and range are not supported by the device.
+        """
+
+        cdef _ChannelCount cCount = image.castChannelCount[uint32_t](channels)
+        cdef _ChannelType cType = <_ChannelType> channelType
+
+        # VK_WHOLE_SIZE
+        cdef uint64_t cRange = 0xFFFFFFFFFFFFFFFF if range is None else range
+
+        return _buildBufferView(self.__buffer.get().createBufferView(cCount, cType, offset, cRange),
+                                self.__session, self)
+
     def toHost(self, np.ndarray output=None, dtype=np.uint8):
         """
         Copies the content of this buffer into a numpy host array.
@@ -153,12 +216,8 @@ cdef class Buffer:
         # not mappable buffer!
         ######################
 
-        # create a stage buffer and copy the content of arr to it
-        mapFlags = [ll_memory.MemoryPropertyFlagBits.HostVisible,
-                    ll_memory.MemoryPropertyFlagBits.HostCoherent]
-        cdef Memory mappableMemory = self.session.createMemory(mapFlags,
-                                                                 sizeBytes,
-                                                                 False)
+        # create a stage buffer in memory optimized for host reads
+        cdef Memory mappableMemory = self.session.getReadbackMemory()
 
         stageFlags = [BufferUsageFlagBits.StorageBuffer,
                       BufferUsageFlagBits.TransferDst]
@@ -217,12 +276,9 @@ cdef class Buffer:
         # not mappable buffer!
         ######################
 
-        # create a stage buffer and copy the content of arr to it
-        mapFlags = [ll_memory.MemoryPropertyFlagBits.HostVisible,
-                    ll_memory.MemoryPropertyFlagBits.HostCoherent]
-        cdef Memory mappableMemory = self.session.createMemory(mapFlags,
-                                                                 sizeBytes,
-                                                                 False)
+        # create a stage buffer in memory optimized for host writes and copy the content of arr to it
+        cdef Memory mappableMemory = self.session.getUploadMemory()
+
         stageFlags = [BufferUsageFlagBits.StorageBuffer,
                       BufferUsageFlagBits.TransferSrc]
         cdef Buffer stageBuffer = mappableMemory.createBuffer(sizeBytes,
@@ -278,3 +334,65 @@ cdef class Buffer:
         self.session.run(cmdBuffer)
 
         return output
+
+
+cdef class BufferView:
+
+    def __cinit__(self):
+        self.__session = None
+        self.__buffer = None
+
+    def __dealloc__(self):
+        pass
+
+    property session:
+        def __get__(self):
+            return self.__session
+
+    property buffer:
+        def __get__(self):
+            """
+            Buffer this view was created from.
+            """
+
+            return self.__buffer
+
+    property channels:
+        def __get__(self):
+            """
+            Number of channels per texel.
+            """
+
+            return <uint32_t> self.__bufferView.get().getChannelCount()
+
+    property channelType:
+        def __get__(self):
+            """
+            Channel type of each texel.
+            """
+
+            return ChannelType(<uint32_t> self.__bufferView.get().getChannelType())
+
+    property offset:
+        def __get__(self):
+            """
+            Offset in bytes from the start of the buffer.
+            """
+
+            return self.__bufferView.get().getOffset()
+
+    property range:
+        def __get__(self):
+            """
+            Size in bytes of the view.
+            """
+
+            return self.__bufferView.get().getRange()
+
+    property texelCount:
+        def __get__(self):
+            """
+            Number of texels in the view.
+            """
+
+            return self.__bufferView.get().getTexelCount()
@@ -15,14 +15,20 @@ cdef extern from 'lluvia/core/buffer/BufferUsageFlags.h' namespace 'll':
         pass
     
     cdef enum _BufferUsageFlagBits 'll::BufferUsageFlagBits':
-        _BufferUsageFlagBits_StorageBuffer     'll::BufferUsageFlagBits::StorageBuffer'
-        _BufferUsageFlagBits_TransferDst       'll::BufferUsageFlagBits::TransferDst'
-        _BufferUsageFlagBits_TransferSrc       'll::BufferUsageFlagBits::TransferSrc'
-        _BufferUsageFlagBits_UniformBuffer     'll::BufferUsageFlagBits::UniformBuffer'
+        _BufferUsageFlagBits_StorageBuffer      'll::BufferUsageFlagBits::StorageBuffer'
+        _BufferUsageFlagBits_TransferDst        'll::BufferUsageFlagBits::TransferDst'
+        _BufferUsageFlagBits_TransferSrc        'll::BufferUsageFlagBits::TransferSrc'
+        _BufferUsageFlagBits_UniformBuffer      'll::BufferUsageFlagBits::UniformBuffer'
+        _BufferUsageFlagBits_IndirectBuffer     'll::BufferUsageFlagBits::IndirectBuffer'
+        _BufferUsageFlagBits_UniformTexelBuffer 'll::BufferUsageFlagBits::UniformTexelBuffer'
+        _BufferUsageFlagBits_StorageTexelBuffer 'll::BufferUsageFlagBits::StorageTexelBuffer'
 
 
 cpdef enum BufferUsageFlagBits:
-    StorageBuffer     = <uint32_t> _BufferUsageFlagBits_StorageBuffer
-    TransferDst       = <uint32_t> _BufferUsageFlagBits_TransferDst
-    TransferSrc       = <uint32_t> _BufferUsageFlagBits_TransferSrc
-    UniformBuffer     = <uint32_t> _BufferUsageFlagBits_UniformBuffer
+    StorageBuffer      = <uint32_t> _BufferUsageFlagBits_StorageBuffer
+    TransferDst        = <uint32_t> _BufferUsageFlagBits_TransferDst
+    TransferSrc        = <uint32_t> _BufferUsageFlagBits_TransferSrc
+    UniformBuffer      = <uint32_t> _BufferUsageFlagBits_UniformBuffer
+    IndirectBuffer     = <uint32_t> _BufferUsageFlagBits_IndirectBuffer
+    UniformTexelBuffer = <uint32_t> _BufferUsageFlagBits_UniformTexelBuffer
+    StorageTexelBuffer = <uint32_t> _BufferUsageFlagBits_StorageTexelBuffer
@@ -18,6 +18,7 @@ from lluvia.core.image.image cimport _Image
 from lluvia.core.image.image_layout cimport _ImageLayout
 from lluvia.core.duration cimport _Duration
 from lluvia.core.session cimport Session
+from lluvia.core.types cimport _vec3ui
 
 from lluvia.core.node.compute_node cimport _ComputeNode
 from lluvia.core.node.container_node cimport _ContainerNode
@@ -37,6 +38,10 @@ cdef extern from 'lluvia/core/CommandBuffer.h' namespace 'll':
         void copyImageToBuffer(const _Image& src, const _Buffer& dst) except +
         void copyImageToImage(const _Image& src, const _Image& dst) except +
 
+        void copyBufferToImage(const _Buffer& src, const _Image& dst, const _vec3ui& imageOffset, const _vec3ui& imageExtent, const uint64_t bufferOffset, const uint32_t bufferRowLength) except +
+        void copyImageToBuffer(const _Image& src, const _Buffer& dst, const _vec3ui& imageOffset, const _vec3ui& imageExtent, const uint64_t bufferOffset, const uint32_t bufferRowLength) except +
+        void copyImageToImage(const _Image& src, const _Image& dst, const _vec3ui& srcOffset, const _vec3ui& dstOffset, const _vec3ui& extent) except +
+
         void changeImageLayout(_Image& image, const _ImageLayout newLayout) except +
 
         void clearImage(_Image& image) except +
@@ -45,6 +50,9 @@ cdef extern from 'lluvia/core/CommandBuffer.h' namespace 'll':
         void durationEnd(_Duration& duration) except +
 
         void memoryBarrier() except +
+        void indirectBarrier() except +
+
+        void dispatchIndirect(const _Buffer& buffer, const uint64_t offset) except +
 
 
 cdef extern from "<utility>" namespace "std":
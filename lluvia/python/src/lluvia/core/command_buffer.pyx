@@ -25,6 +25,15 @@ from lluvia.core.node.container_node cimport ContainerNode
 __all__ = ['CommandBuffer']
 
 
+cdef _vec3ui _toVec3ui(v):
+
+    assert (len(v) == 3)
+
+    cdef _vec3ui out
+    out.x, out.y, out.z = v
+    return out
+
+
 cdef _buildCommandBuffer(shared_ptr[_CommandBuffer] ptr, Session session):
 
     cdef CommandBuffer cmdBuffer = CommandBuffer()
@@ -90,11 +99,13 @@ cdef class CommandBuffer:
             deref(src.__buffer.get()),
             deref(dst.__buffer.get()))
 
-    def copyBufferToImage(self, Buffer src, Image dst):
+    def copyBufferToImage(self, Buffer src, Image dst, imageOffset=None, imageExtent=None,
+                          uint64_t bufferOffset=0, uint32_t bufferRowLength=0):
         """
         Copies the content of src Buffer to dst Image
 
-        No size check is currently being tested.
+        If imageOffset and imageExtent are None, the whole image is copied and
+        the buffer content is interpreted as tightly packed pixels.
 
         Parameters
         ----------
@@ -103,16 +114,48 @@ cdef class CommandBuffer:
 
         dst : Image.
             Source Image.
+
+        imageOffset : 3-tuple of int. Defaults to None.
+            Offset in pixels of the region within dst.
+
+        imageExtent : 3-tuple of int. Defaults to None.
+            Extent in pixels of the region.
+
+        bufferOffset : int. Defaults to 0.
+            Offset in bytes within src. It must be a multiple of the pixel size.
+
+        bufferRowLength : int. Defaults to 0.
+            Row length, in pixels, of the buffer content. Zero means
+            tightly packed according to imageExtent.
+
+        Raises
+        ------
+        RuntimeError : if the region falls outside the image or exceeds the
+            buffer size.
         """
 
+        if imageOffset is None and imageExtent is None:
+            self.__commandBuffer.get().copyBufferToImage(
+                deref(src.__buffer.get()),
+                deref(dst.__image.get()))
+            return
+
+        cdef _vec3ui offset = _toVec3ui(imageOffset if imageOffset is not None else (0, 0, 0))
+        cdef _vec3ui extent = _toVec3ui(imageExtent if imageExtent is not None else (dst.width, dst.height, dst.depth))
+
         self.__commandBuffer.get().copyBufferToImage(
             deref(src.__buffer.get()),
-            deref(dst.__image.get()))
+            deref(dst.__image.get()),
+            offset, extent, bufferOffset, bufferRowLength)
 
-    def copyImageToBuffer(self, Image src, Buffer dst):
+    def copyImageToBuffer(self, Image src, Buffer dst, imageOffset=None, imageExtent=None,
+                          uint64_t bufferOffset=0, uint32_t bufferRowLength=0):
         """
         Copies the content of src Image to dst Buffer.
 
+        If imageOffset and imageExtent are None, the whole image is copied
+        as tightly packed pixels.
+
         Parameters
         ----------
         src : Image.
@@ -120,13 +163,41 @@ cdef class CommandBuffer:
 
         dst : Buffer.
             Destination buffer.
+
+        imageOffset : 3-tuple of int. Defaults to None.
+            Offset in pixels of the region within src.
+
+        imageExtent : 3-tuple of int. Defaults to None.
+            Extent in pixels of the region.
+
+        bufferOffset : int. Defaults to 0.
+            Offset in bytes within dst. It must be a multiple of the pixel size.
+
+        bufferRowLength : int. Defaults to 0.
+            Row length, in pixels, of the buffer content. Zero means
+            tightly packed according to imageExtent.
+
+        Raises
+        ------
+        RuntimeError : if the region falls outside the image or exceeds the
+            buffer size.
         """
 
+        if imageOffset is None and imageExtent is None:
+            self.__commandBuffer.get().copyImageToBuffer(
+                deref(src.__image.get()),
+                deref(dst.__buffer.get()))
+            return
+
+        cdef _vec3ui offset = _toVec3ui(imageOffset if imageOffset is not None else (0, 0, 0))
+        cdef _vec3ui extent = _toVec3ui(imageExtent if imageExtent is not None else (src.width, src.height, src.depth))
+
         self.__commandBuffer.get().copyImageToBuffer(
             deref(src.__image.get()),
-            deref(dst.__buffer.get()))
+            deref(dst.__buffer.get()),
+            offset, extent, bufferOffset, bufferRowLength)
 
-    def copyImageToImage(self, Image src, Image dst):
+    def copyImageToImage(self, Image src, Image dst, srcOffset=None, dstOffset=None, extent=None):
         """
         Copies the content of src Image to dst Image.
 
@@ -146,11 +217,35 @@ cdef class CommandBuffer:
 
         dst : Image.
             Destination buffer.
+
+        srcOffset : 3-tuple of int. Defaults to None.
+            Offset in pixels of the region within src.
+
+        dstOffset : 3-tuple of int. Defaults to None.
+            Offset in pixels of the region within dst.
+
+        extent : 3-tuple of int. Defaults to None.
+            Extent in pixels of the region. If None, the whole src image is copied.
+
+        Raises
+        ------
+        RuntimeError : if the region falls outside src or dst.
         """
 
+        if srcOffset is None and dstOffset is None and extent is None:
+            self.__commandBuffer.get().copyImageToImage(
+                deref(src.__image.get()),
+                deref(dst.__image.get()))
+            return
+
+        cdef _vec3ui srcOffset_ = _toVec3ui(srcOffset if srcOffset is not None else (0, 0, 0))
+        cdef _vec3ui dstOffset_ = _toVec3ui(dstOffset if dstOffset is not None else (0, 0, 0))
+        cdef _vec3ui extent_ = _toVec3ui(extent if extent is not None else (src.width, src.height, src.depth))
+
         self.__commandBuffer.get().copyImageToImage(
             deref(src.__image.get()),
-            deref(dst.__image.get()))
+            deref(dst.__image.get()),
+            srcOffset_, dstOffset_, extent_)
 
     def changeImageLayout(self, Image img, ImageLayout newLayout):
         """
@@ -246,3 +341,37 @@ cdef class CommandBuffer:
         """
 
         self.__commandBuffer.get().durationEnd(deref(d.__duration))
+
+    def indirectBarrier(self):
+        """
+        Adds a memory barrier between shader writes and indirect command reads.
+
+        Use this barrier when the arguments of an indirect dispatch are written
+        by a previous compute node.
+        """
+
+        self.__commandBuffer.get().indirectBarrier()
+
+    def dispatchIndirect(self, Buffer buf, uint64_t offset=0):
+        """
+        Records an indirect dispatch of the currently bound compute pipeline.
+
+        The grid shape is read by the device from buf at offset as three
+        consecutive uint32 values.
+
+        Parameters
+        ----------
+        buf : Buffer.
+            The buffer. It must be created with BufferUsageFlagBits.IndirectBuffer
+            usage flag.
+
+        offset : int. Defaults to 0.
+            Offset in bytes within buf. It must be a multiple of 4.
+
+        Raises
+        ------
+        RuntimeError : if buf does not have the IndirectBuffer usage flag or
+            the dispatch arguments exceed the buffer size.
+        """
+
+        self.__commandBuffer.get().dispatchIndirect(deref(buf.__buffer.get()), offset)
@@ -12,12 +12,14 @@ cdef extern from 'lluvia/core/Object.h' namespace 'll':
 
     cdef enum _ObjectType 'll::ObjectType':
 
-        _ObjectType_Buffer    'll::ObjectType::Buffer'
-        _ObjectType_Image     'll::ObjectType::Image'
-        _ObjectType_ImageView 'll::ObjectType::ImageView'
+        _ObjectType_Buffer     'll::ObjectType::Buffer'
+        _ObjectType_Image      'll::ObjectType::Image'
+        _ObjectType_ImageView  'll::ObjectType::ImageView'
+        _ObjectType_BufferView 'll::ObjectType::BufferView'
 
 
 cpdef enum ObjectType:
-    Buffer    = <uint32_t> _ObjectType_Buffer
-    Image     = <uint32_t> _ObjectType_Image
-    ImageView = <uint32_t> _ObjectType_ImageView
+    Buffer     = <uint32_t> _ObjectType_Buffer
+    Image      = <uint32_t> _ObjectType_Image
+    ImageView  = <uint32_t> _ObjectType_ImageView
+    BufferView = <uint32_t> _ObjectType_BufferView
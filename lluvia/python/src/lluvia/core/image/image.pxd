@@ -6,7 +6,7 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
-from libc.stdint cimport uint64_t, uint32_t
+from libc.stdint cimport uint64_t, uint32_t, uint8_t
 
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr, unique_ptr
@@ -25,6 +25,7 @@ from lluvia.core.memory.memory_allocation_info cimport _MemoryAllocationInfo
 
 from lluvia.core cimport vulkan as vk
 from lluvia.core.core_object cimport _Object
+from lluvia.core.types cimport _vec3ui
 
 from lluvia.core.session cimport Session
 
@@ -94,6 +95,18 @@ cdef extern from 'lluvia/core/image/ImageDescriptor.h' namespace 'll':
 
 cdef extern from 'lluvia/core/image/Image.h' namespace 'll':
 
+    cdef cppclass _ImageMapping 'll::ImageMapping' [T]:
+
+        _ImageMapping()
+
+        bool isMapped() const
+        void unmap()
+
+        T* data() const
+        uint64_t getRowPitch() const
+        uint64_t getDepthPitch() const
+        uint64_t getSize() const
+
     cdef cppclass _Image 'll::Image' (_Object):
 
         const shared_ptr[_Memory]& getMemory()   const
@@ -114,9 +127,17 @@ cdef extern from 'lluvia/core/image/Image.h' namespace 'll':
 
         shared_ptr[_ImageView] createImageView(const _ImageViewDescriptor& descriptor) except +
 
+        void reshape(const _vec3ui& shape) except +
         void clear() except +
         void copyTo(_Image&) except +
 
+        bool isMappable() const
+        uint64_t getRowPitch() except +
+        uint64_t getDepthPitch() except +
+
+        # the preconditions are validated before calling, see Image.map()
+        _ImageMapping[T] map[T]()
+
 
 cdef extern from 'lluvia/core/image/ImageViewDescriptor.h' namespace 'll':
 
@@ -212,6 +233,11 @@ cdef class Image:
     cdef Memory             __memory
 
 
+cdef class ImageMapping:
+    cdef _ImageMapping[uint8_t] __mapping
+    cdef Image                  __image
+
+
 cdef class ImageView:
     cdef shared_ptr[_ImageView] __imageView
     cdef Session                __session
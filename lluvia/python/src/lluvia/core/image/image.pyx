@@ -8,7 +8,7 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint8_t
 
 from libcpp.memory cimport shared_ptr
 from cython.operator cimport dereference as deref
@@ -19,6 +19,7 @@ cimport numpy as np
 from lluvia.core cimport vulkan as vk
 from lluvia.core import impl
 from lluvia.core.session cimport Session
+from lluvia.core.types cimport _vec3ui
 
 from lluvia.core.image.image_usage_flags import ImageUsageFlagBits
 from lluvia.core.image.image_usage_flags cimport ImageUsageFlagBits
@@ -47,6 +48,7 @@ import lluvia.core.buffer as ll_buffer
 
 __all__ = [
     'Image',
+    'ImageMapping',
     'ImageView',
     'ChannelType',
     'ChannelCount',
@@ -201,6 +203,70 @@ cdef class Image:
         def __get__(self):
             return ImageLayout(<uint32_t> self.__image.get().getLayout())
 
+    property isMappable:
+        def __get__(self):
+            """
+            True if the image has linear tiling, is allocated in host-visible
+            memory, and its memory page is not currently mapped.
+            """
+
+            return self.__image.get().isMappable()
+
+    property rowPitch:
+        def __get__(self):
+            """
+            Number of bytes between consecutive rows in memory. Only
+            defined for images with linear tiling.
+            """
+
+            return self.__image.get().getRowPitch()
+
+    property depthPitch:
+        def __get__(self):
+            """
+            Number of bytes between consecutive depth slices in memory.
+            Only defined for images with linear tiling.
+            """
+
+            return self.__image.get().getDepthPitch()
+
+    def map(self):
+        """
+        Maps the pixels of this image to host memory.
+
+        Only images with linear tiling allocated in host-visible memory
+        can be mapped. The image must be in General or Preinitialized layout.
+
+        The returned mapping exposes the pixels as a numpy array whose
+        strides follow the row and depth pitch of the image. The array
+        must not be used after the mapping is unmapped.
+
+            with img.map() as mapping:
+                mapping.array[:] = 0
+
+
+        Returns
+        -------
+        mapping : lluvia.ImageMapping
+
+
+        Raises
+        ------
+        RuntimeError : if the image cannot be mapped.
+        """
+
+        if not self.isMappable:
+            raise RuntimeError('image is not mappable. Its tiling must be Linear, its memory host-visible, and its memory page must not be currently mapped')
+
+        if self.layout not in [ImageLayout.General, ImageLayout.Preinitialized]:
+            raise RuntimeError('image must be in General or Preinitialized layout to be mapped, got: {0}'.format(self.layout))
+
+        cdef ImageMapping mapping = ImageMapping()
+        mapping.__image = self
+        mapping.__mapping = self.__image.get().map[uint8_t]()
+
+        return mapping
+
     def changeLayout(self, ImageLayout newLayout):
         """
         Changes image layout.
@@ -234,6 +300,33 @@ cdef class Image:
 
         self.session.run(cmdBuffer)
 
+    def reshape(self, shape):
+        """
+        Changes the shape of this image.
+
+        The memory of the image is reused if the new shape fits
+        in it. Views of this image and the compute nodes it is
+        bound to are updated. The content of the image is undefined
+        after this call.
+
+        Parameters
+        ----------
+        shape : 3-tuple of ints.
+            The new (width, height, depth) of the image.
+
+        Raises
+        ------
+        RuntimeError
+            If any component of shape is zero.
+        """
+
+        assert (len(shape) == 3)
+
+        cdef _vec3ui s
+        s.x, s.y, s.z = shape
+
+        self.__image.get().reshape(s)
+
     def clear(self):
         """
         Immediately clears the image pixels to zero.
@@ -310,11 +403,18 @@ cdef class Image:
 
         currentLayout = self.layout
 
+        # linear images are written directly, without a transfer stage
+        if self.isMappable and currentLayout in [ImageLayout.General, ImageLayout.Preinitialized]:
+            with self.map() as mapping:
+                mapping.array[...] = arr.reshape(mapping.array.shape)
+
+            return
+
         nextLayout = currentLayout
         if currentLayout in [ImageLayout.Undefined, ImageLayout.Preinitialized]:
             nextLayout = ImageLayout.General
 
-        stageBuffer   = self.memory.createBufferFromHost(arr)
+        stageBuffer   = self.session.getUploadMemory().createBufferFromHost(arr)
         cmdBuffer     = self.session.createCommandBuffer()
 
         cmdBuffer.begin()
@@ -341,40 +441,28 @@ cdef class Image:
         """
 
         if output is None:
-            
-            heightIsOne   = self.height   == 1
-            depthIsOne    = self.depth    == 1
-            channelsIsOne = self.channels == 1
-
-            shape = None
-
-            if heightIsOne and depthIsOne and channelsIsOne:
-                shape = [self.width]
-
-            elif not heightIsOne and depthIsOne and channelsIsOne:
-                shape = [self.height, self.width]
-
-            elif not heightIsOne and depthIsOne and not channelsIsOne:
-                shape = [self.height, self.width, self.channels]
-
-            else:
-                shape = [self.depth, self.height, self.width, self.channels]
-
-            output = np.zeros(shape, dtype=ImageChannelTypeToNumpyMap[self.channelType])
+            output = np.zeros(self.__numpyShape(), dtype=ImageChannelTypeToNumpyMap[self.channelType])
 
         else:
             self.__validateNumpyShape(output)
 
         currentLayout = self.layout
 
+        # linear images are read directly, without a transfer stage
+        if self.isMappable and currentLayout in [ImageLayout.General, ImageLayout.Preinitialized]:
+            with self.map() as mapping:
+                output[...] = mapping.array.reshape(output.shape)
+
+            return output
+
         nextLayout = currentLayout
         if currentLayout in [ImageLayout.Undefined, ImageLayout.Preinitialized]:
             nextLayout = ImageLayout.General
 
-        stageBuffer   = self.memory.createBuffer(output.nbytes,
-                                                   [ll_buffer.BufferUsageFlagBits.StorageBuffer,
-                                                    ll_buffer.BufferUsageFlagBits.TransferSrc,
-                                                    ll_buffer.BufferUsageFlagBits.TransferDst])
+        stageBuffer   = self.session.getReadbackMemory().createBuffer(output.nbytes,
+                                                                     [ll_buffer.BufferUsageFlagBits.StorageBuffer,
+                                                                      ll_buffer.BufferUsageFlagBits.TransferSrc,
+                                                                      ll_buffer.BufferUsageFlagBits.TransferDst])
 
         cmdBuffer     = self.session.createCommandBuffer()
 
@@ -446,6 +534,24 @@ cdef class Image:
         return _buildImageView(self.__image.get().createImageView(desc),
                                self.session, self)
 
+    def __numpyShape(self):
+
+        heightIsOne   = self.height   == 1
+        depthIsOne    = self.depth    == 1
+        channelsIsOne = self.channels == 1
+
+        if heightIsOne and depthIsOne and channelsIsOne:
+            return [self.width]
+
+        elif not heightIsOne and depthIsOne and channelsIsOne:
+            return [self.height, self.width]
+
+        elif not heightIsOne and depthIsOne and not channelsIsOne:
+            return [self.height, self.width, self.channels]
+
+        else:
+            return [self.depth, self.height, self.width, self.channels]
+
     def __validateNumpyShape(self, arr):
 
         shape = arr.shape
@@ -474,6 +580,68 @@ cdef class Image:
             raise ValueError('arr parameter must have between 1 to 4 dimensions, got: {0}'.format(arr.ndim))
 
 
+cdef class ImageMapping:
+    """
+    Host access to the pixels of a mapped lluvia.Image.
+
+    Objects of this class are returned by Image.map(). The image is
+    unmapped when unmap() is called, when leaving a with block, or
+    when this object is deleted.
+    """
+
+    def __cinit__(self):
+        self.__image = None
+
+    def __dealloc__(self):
+        self.__mapping.unmap()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, excType, excValue, traceback):
+        self.unmap()
+
+    property image:
+        def __get__(self):
+            return self.__image
+
+    property isMapped:
+        def __get__(self):
+            return self.__mapping.isMapped()
+
+    property array:
+        def __get__(self):
+            """
+            Numpy view of the mapped pixels with shape (depth, height, width, channels).
+
+            The strides of the array follow the row and depth pitch of the image.
+            The array must not be used after the image is unmapped.
+            """
+
+            if not self.__mapping.isMapped():
+                raise RuntimeError('image is not mapped')
+
+            cdef uint8_t[:] raw = <uint8_t[:self.__mapping.getSize()]> self.__mapping.data()
+
+            img = self.__image
+            dtype = np.dtype(ImageChannelTypeToNumpyMap[img.channelType])
+
+            shape = (img.depth, img.height, img.width, img.channels)
+            strides = (self.__mapping.getDepthPitch(),
+                       self.__mapping.getRowPitch(),
+                       img.channels * dtype.itemsize,
+                       dtype.itemsize)
+
+            return np.ndarray(shape, dtype=dtype, buffer=raw, strides=strides)
+
+    def unmap(self):
+        """
+        Unmaps the image. Arrays obtained from this mapping must not be used afterwards.
+        """
+
+        self.__mapping.unmap()
+
+
 cdef class ImageView:
 
     def __cinit__(self):
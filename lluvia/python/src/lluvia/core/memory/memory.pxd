@@ -10,6 +10,7 @@ from libc.stdint cimport uint64_t, uint32_t
 
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr
+from libcpp.vector cimport vector
 
 from lluvia.core.memory.memory_property_flags cimport _MemoryPropertyFlags
 
@@ -22,6 +23,29 @@ from lluvia.core.session cimport Session
 
 cdef extern from 'lluvia/core/memory/Memory.h' namespace 'll':
 
+    cdef struct _MemoryPageStatistics 'll::MemoryPageStatistics':
+        uint32_t page
+        uint32_t memoryTypeIndex
+        bool dedicated
+        uint64_t committedSize
+        uint64_t usedSize
+        uint64_t largestFreeSize
+
+    cdef struct _MemoryHeapBudget 'll::MemoryHeapBudget':
+        uint32_t heapIndex
+        uint64_t budget
+        uint64_t usage
+
+    cdef struct _MemoryStatistics 'll::MemoryStatistics':
+        uint64_t committedSize
+        uint64_t usedSize
+        vector[_MemoryPageStatistics] pages
+
+    cdef struct _MemoryDefragmentationResult 'll::MemoryDefragmentationResult':
+        uint64_t movedBytes
+        uint32_t movedObjects
+        bool complete
+
     cdef cppclass _Memory 'll::Memory':
 
         _MemoryPropertyFlags getMemoryPropertyFlags() const
@@ -30,6 +54,14 @@ cdef extern from 'lluvia/core/memory/Memory.h' namespace 'll':
         bool isMappable() const
         bool isPageMappable(const uint64_t page) const
 
+        _MemoryStatistics getStatistics() except +
+        vector[_MemoryHeapBudget] getHeapBudgets() except +
+        uint64_t trim() except +
+        void enableAutoTrim(const uint64_t highThreshold, const uint64_t lowThreshold) except +
+        void disableAutoTrim()
+        bool isAutoTrimEnabled() const
+        _MemoryDefragmentationResult defragment(const uint64_t maxBytes, const uint64_t maxMicroseconds) except +
+
         shared_ptr[_Buffer] createBuffer(const uint64_t size, const _BufferUsageFlags usageFlags) except +
         shared_ptr[_Image] createImage(const _ImageDescriptor& descriptor) except +
 
@@ -127,6 +127,136 @@ cdef class Memory:
 
         return self.__memory.get().isPageMappable(page)
 
+    property isAutoTrimEnabled:
+        def __get__(self):
+            """
+            True if empty pages are released automatically.
+            """
+
+            return self.__memory.get().isAutoTrimEnabled()
+
+    def getStatistics(self):
+        """
+        Gets the usage statistics of this memory.
+
+
+        Returns
+        -------
+        stats : dict
+            Dictionary with the committedSize and usedSize in bytes of this memory,
+            and a list of pages. Each page is a dictionary with its page index,
+            memoryTypeIndex, dedicated flag, committedSize, usedSize and largestFreeSize.
+        """
+
+        cdef _MemoryStatistics stats = self.__memory.get().getStatistics()
+
+        pages = list()
+        for p in stats.pages:
+            pages.append({'page': p.page,
+                          'memoryTypeIndex': p.memoryTypeIndex,
+                          'dedicated': p.dedicated,
+                          'committedSize': p.committedSize,
+                          'usedSize': p.usedSize,
+                          'largestFreeSize': p.largestFreeSize})
+
+        return {'committedSize': stats.committedSize,
+                'usedSize': stats.usedSize,
+                'pages': pages}
+
+    def getHeapBudgets(self):
+        """
+        Gets the budget of the heaps this memory can allocate pages from.
+
+        If VK_EXT_memory_budget is not available, the budget is the heap size
+        and the usage only counts the pages of this memory.
+
+
+        Returns
+        -------
+        budgets : list
+            List of dictionaries with the heapIndex, budget and usage in bytes.
+        """
+
+        cdef vector[_MemoryHeapBudget] budgets = self.__memory.get().getHeapBudgets()
+
+        return [{'heapIndex': b.heapIndex, 'budget': b.budget, 'usage': b.usage} for b in budgets]
+
+    def trim(self):
+        """
+        Releases the pages without any object allocated in them.
+
+
+        Returns
+        -------
+        size : uint64_t
+            Number of bytes released.
+        """
+
+        return self.__memory.get().trim()
+
+    def enableAutoTrim(self, uint64_t highThreshold, uint64_t lowThreshold):
+        """
+        Enables releasing empty pages automatically.
+
+        Once the total size of empty pages is greater than highThreshold,
+        empty pages are released until their size is less or equal than lowThreshold.
+
+
+        Parameters
+        ----------
+        highThreshold : uint64_t
+            Size in bytes of empty pages that triggers the release.
+
+        lowThreshold : uint64_t
+            Size in bytes of empty pages kept after the release.
+
+
+        Raises
+        ------
+        RuntimeError : if lowThreshold is greater than highThreshold.
+        """
+
+        self.__memory.get().enableAutoTrim(highThreshold, lowThreshold)
+
+    def disableAutoTrim(self):
+        """
+        Disables releasing empty pages automatically.
+        """
+
+        self.__memory.get().disableAutoTrim()
+
+    def defragment(self, uint64_t maxBytes=0, uint64_t maxMicroseconds=0):
+        """
+        Moves objects out of sparsely used pages.
+
+        Live buffers and images with TransferSrc and TransferDst usage are copied
+        into free space of other pages. Views of moved images are recreated and
+        the compute nodes bound to moved objects are updated. Command buffers
+        recorded with moved objects must be recorded again.
+
+
+        Parameters
+        ----------
+        maxBytes : uint64_t. Defaults to 0.
+            Maximum number of bytes moved. Zero means no limit.
+
+        maxMicroseconds : uint64_t. Defaults to 0.
+            Time budget in microseconds. Zero means no limit.
+
+
+        Returns
+        -------
+        result : dict
+            Dictionary with the movedBytes, movedObjects and whether the
+            defragmentation is complete.
+        """
+
+        cdef _MemoryDefragmentationResult result = self.__memory.get().defragment(maxBytes, maxMicroseconds)
+
+        return {'movedBytes': result.movedBytes,
+                'movedObjects': result.movedObjects,
+                'complete': result.complete}
+
 
     def createBuffer(self, uint64_t size,
                      usageFlags=[ll_buffer.BufferUsageFlagBits.StorageBuffer,
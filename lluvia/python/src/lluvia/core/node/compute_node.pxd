@@ -6,11 +6,12 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 
 from libcpp.memory cimport shared_ptr
 from libcpp.string cimport string
 
+from lluvia.core.buffer.buffer cimport _Buffer
 from lluvia.core.command_buffer cimport _CommandBuffer
 from lluvia.core.core_object cimport _Object
 from lluvia.core.program cimport _Program
@@ -45,18 +46,31 @@ cdef extern from 'lluvia/core/node/ComputeNode.h' namespace 'll':
         uint32_t getLocalY() const
         uint32_t getLocalZ() const
 
-        void setPushConstants(const _PushConstants&)
+        void setPushConstants(const _PushConstants&) except +
         const _PushConstants getPushConstants() const
 
         void setParameter(const string& name, const _Parameter& value)
         const _Parameter& getParameter(const string& name) except +
 
         void configureGridShape(const _vec3ui& globalShape)
+        void configureGridRegion(const _vec3ui& globalOffset, const _vec3ui& globalShape) except +
+
+        void setGridOffset(const _vec3ui& offset)
+        _vec3ui getGridOffset() const
 
         shared_ptr[_Object] getPort(const string& name) except +
+        shared_ptr[_Object] getPort(uint32_t index) except +
+        uint32_t getPortIndex(const string& name) except +
         void bind(const string& name, const shared_ptr[_Object]& obj) except +
+        void bind(uint32_t index, const shared_ptr[_Object]& obj) except +
+        void bindRange(const string& name, const shared_ptr[_Buffer]& buffer, uint64_t offset, uint64_t range) except +
+
+        void setDynamicOffset(const string& name, uint32_t offset) except +
+        uint32_t getDynamicOffset(const string& name) except +
 
         void init() except +
+        shared_ptr[_ComputeNode] instantiate() except +
+        void reinit() except +
         void record(_CommandBuffer& commandBuffer) except +
 
 
@@ -8,7 +8,7 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 
 from libcpp.memory cimport shared_ptr
 
@@ -16,7 +16,7 @@ from cython.operator cimport dereference as deref
 
 from lluvia.core import impl
 from lluvia.core.command_buffer cimport CommandBuffer
-from lluvia.core.buffer.buffer cimport Buffer, _Buffer, _buildBuffer
+from lluvia.core.buffer.buffer cimport Buffer, _Buffer, _buildBuffer, BufferView, _BufferView, _buildBufferView
 from lluvia.core.core_object cimport _Object
 
 from lluvia.core.enums.core_object import ObjectType
@@ -24,6 +24,7 @@ from lluvia.core.enums.core_object import ObjectType
 from lluvia.core.image.image cimport Image, ImageView, _ImageView, _buildImageView
 from lluvia.core.impl.stdcpp cimport static_pointer_cast
 from lluvia.core.session cimport Session
+from lluvia.core.types cimport _vec3ui
 
 from lluvia.core.node.node_type cimport NodeType as NodeType_t
 from lluvia.core.node.parameter cimport Parameter
@@ -64,6 +65,18 @@ cdef class ComputeNode:
             assert (len(v) == 3)
             self.gridX, self.gridY, self.gridZ = v
 
+    property gridOffset:
+        def __get__(self):
+            cdef _vec3ui offset = self.__node.get().getGridOffset()
+            return (offset.x, offset.y, offset.z)
+
+        def __set__(self, v):
+            assert (len(v) == 3)
+
+            cdef _vec3ui offset
+            offset.x, offset.y, offset.z = v
+            self.__node.get().setGridOffset(offset)
+
     property local:
         def __get__(self):
             return (self.localX, self.localY, self.localZ)
@@ -98,6 +111,37 @@ cdef class ComputeNode:
         def __get__(self):
             return self.__node.get().getLocalZ()
 
+    def configureGridRegion(self, globalOffset, globalShape):
+        """
+        Configures the grid offset and shape to cover a region of interest.
+
+        The grid offset is computed as globalOffset / local and the grid
+        shape as ceil(globalShape / local).
+
+        Parameters
+        ----------
+        globalOffset : 3-tuple of int.
+            Offset of the region in global coordinates. Each component must
+            be a multiple of the corresponding local shape component.
+
+        globalShape : 3-tuple of int.
+            Shape of the region in global coordinates.
+
+        Raises
+        ------
+        RuntimeError : if globalOffset is not aligned to the local shape.
+        """
+
+        assert (len(globalOffset) == 3)
+        assert (len(globalShape) == 3)
+
+        cdef _vec3ui offset
+        cdef _vec3ui shape
+        offset.x, offset.y, offset.z = globalOffset
+        shape.x, shape.y, shape.z = globalShape
+
+        self.__node.get().configureGridRegion(offset, shape)
+
     def setParameter(self, str name, Parameter param):
 
         self.__node.get().setParameter(impl.encodeString(name), param.__p)
@@ -108,41 +152,135 @@ cdef class ComputeNode:
         out.__p = self.__node.get().getParameter(impl.encodeString(name))
         return out
 
-    def bind(self, str name, obj):
+    def getPortIndex(self, str name):
+        """
+        Gets the index of a port.
+
+        The index can be passed to bind() and getPort() instead of the
+        port name to avoid looking up the name on every call.
+
+        Parameters
+        ----------
+        name : str
+            Name of the port.
+
+        Returns
+        -------
+        index : int
+            Index of the port.
+        """
+
+        return self.__node.get().getPortIndex(impl.encodeString(name))
+
+    def bind(self, name, obj):
         """
         Binds an object as parameter to this node.
 
 
         Parameters
         ----------
-        index : str
-            Name of the object to bind
+        name : str or int
+            Name of the port, or its index as returned by getPortIndex().
 
-        obj : lluvia.Buffer or lluvia.ImageView
+        obj : lluvia.Buffer, lluvia.ImageView or lluvia.BufferView
             Parameter to bind.
         """
 
-        cdef Buffer    buf     = None
-        cdef ImageView imgView = None
+        cdef Buffer     buf     = None
+        cdef ImageView  imgView = None
+        cdef BufferView bufView = None
+
+        cdef shared_ptr[_Object] ptr
 
         objType = type(obj)
 
         if objType == Buffer:
             buf = obj
-            self.__node.get().bind(impl.encodeString(name),
-                                   static_pointer_cast[_Object](buf.__buffer))
-        
+            ptr = static_pointer_cast[_Object](buf.__buffer)
+
         elif objType == ImageView:
             imgView = obj
-            self.__node.get().bind(impl.encodeString(name),
-                                   static_pointer_cast[_Object](imgView.__imageView))
-            
+            ptr = static_pointer_cast[_Object](imgView.__imageView)
+
+        elif objType == BufferView:
+            bufView = obj
+            ptr = static_pointer_cast[_Object](bufView.__bufferView)
+
         else:
-            raise RuntimeError('Unsupported obj type {0}. Valid types are ll.Buffer and ll.ImageView.'.format(type(obj)))
+            raise RuntimeError('Unsupported obj type {0}. Valid types are ll.Buffer, ll.ImageView and ll.BufferView.'.format(type(obj)))
 
-    def getPort(self, str name):
+        if isinstance(name, int):
+            self.__node.get().bind(<uint32_t> name, ptr)
+        else:
+            self.__node.get().bind(impl.encodeString(name), ptr)
+
+    def bindRange(self, str name, Buffer buffer, uint64_t offset, uint64_t size):
+        """
+        Binds a range of a buffer to a port of this node.
+
+        Ports of type PortType.UniformBufferDynamic and PortType.StorageBufferDynamic
+        must be bound with this method.
+
+        Parameters
+        ----------
+        name : str
+            Name of the port.
 
-        cdef shared_ptr[_Object] obj = self.__node.get().getPort(impl.encodeString(name))
+        buffer : lluvia.Buffer
+            Buffer to bind.
+
+        offset : int
+            Offset in bytes of the range. It must be aligned to the device's
+            minimum uniform or storage buffer offset alignment.
+
+        size : int
+            Size in bytes of the range.
+        """
+
+        self.__node.get().bindRange(impl.encodeString(name), buffer.__buffer, offset, size)
+
+    def setDynamicOffset(self, str name, uint32_t offset):
+        """
+        Sets the dynamic offset of a port.
+
+        The offset is read when the node is recorded into a command buffer.
+
+        Parameters
+        ----------
+        name : str
+            Name of the port. It must be bound with bindRange().
+
+        offset : int
+            Offset in bytes added to the range bound to the port.
+        """
+
+        self.__node.get().setDynamicOffset(impl.encodeString(name), offset)
+
+    def getDynamicOffset(self, str name):
+        """
+        Gets the dynamic offset of a port.
+
+        Parameters
+        ----------
+        name : str
+            Name of the port.
+
+        Returns
+        -------
+        offset : int
+            The dynamic offset in bytes.
+        """
+
+        return self.__node.get().getDynamicOffset(impl.encodeString(name))
+
+    def getPort(self, name):
+
+        cdef shared_ptr[_Object] obj
+
+        if isinstance(name, int):
+            obj = self.__node.get().getPort(<uint32_t> name)
+        else:
+            obj = self.__node.get().getPort(impl.encodeString(name))
 
         oType = ObjectType(<uint32_t> obj.get().getType())
 
@@ -155,6 +293,10 @@ cdef class ComputeNode:
             return _buildImageView(static_pointer_cast[_ImageView](obj),
                                    self.session, None)
 
+        if oType == ObjectType.BufferView:
+            return _buildBufferView(static_pointer_cast[_BufferView](obj),
+                                    self.session, None)
+
         raise RuntimeError('Unsupported object type {0}'.format(oType))
 
     def init(self):
@@ -164,6 +306,46 @@ cdef class ComputeNode:
 
         self.__node.get().init()
 
+    def instantiate(self):
+        """
+        Creates a new node sharing the compute pipeline of this node.
+
+        The new node has a copy of the descriptor of this node
+        and its ports are not bound. Its init() method does not
+        run the node builder.
+
+        Returns
+        -------
+        node : ComputeNode
+            The new node, not initialized.
+
+        Raises
+        ------
+        RuntimeError
+            If this node is not initialized.
+        """
+
+        return _buildComputeNode(self.__node.get().instantiate(), self.session)
+
+    def reinit(self):
+        """
+        Configures this node again for the objects bound to its ports.
+
+        The onNodeReshape function of the node builder configures
+        the grid shape for the current ports, by default following
+        the change of shape of the port images. No object is created
+        or bound again, and the pipeline and parameter block of the
+        node are kept. Command buffers recording this node must be
+        recorded again.
+
+        Raises
+        ------
+        RuntimeError
+            If this node is not initialized.
+        """
+
+        self.__node.get().reinit()
+
     def run(self):
         """
         Runs this node
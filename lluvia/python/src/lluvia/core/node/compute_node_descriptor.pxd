@@ -6,8 +6,9 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 
+from libcpp cimport bool
 from libcpp.memory cimport shared_ptr
 from libcpp.string cimport string
 
@@ -42,6 +43,12 @@ cdef extern from 'lluvia/core/node/ComputeNodeDescriptor.h' namespace 'll':
         _ComputeNodeDescriptor& setParameter(const string& name, const _Parameter& value)
         _Parameter getParameter(const string& name) except +
 
+        _ComputeNodeDescriptor& setIndirectDispatch(const string& portName, const uint64_t offset)
+        _ComputeNodeDescriptor& disableIndirectDispatch()
+        bool isIndirectDispatchEnabled() const
+        string getIndirectDispatchPort() const
+        uint64_t getIndirectDispatchOffset() const
+
         _ComputeNodeDescriptor& setGridX(const uint32_t x)
         _ComputeNodeDescriptor& setGridY(const uint32_t y)
         _ComputeNodeDescriptor& setGridZ(const uint32_t z)
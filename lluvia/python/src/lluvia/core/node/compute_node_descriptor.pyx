@@ -8,7 +8,7 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 
 from libcpp.memory cimport shared_ptr
 from libcpp.string cimport string
@@ -121,6 +121,43 @@ cdef class ComputeNodeDescriptor:
         def __set__(self, uint32_t z):
             self.__descriptor.setLocalZ(z)
 
+    property isIndirectDispatchEnabled:
+        def __get__(self):
+            return self.__descriptor.isIndirectDispatchEnabled()
+
+    property indirectDispatchPort:
+        def __get__(self):
+            return str(self.__descriptor.getIndirectDispatchPort(), 'utf-8')
+
+    property indirectDispatchOffset:
+        def __get__(self):
+            return self.__descriptor.getIndirectDispatchOffset()
+
+    def setIndirectDispatch(self, str portName, uint64_t offset=0):
+        """
+        Enables the indirect-dispatch mode.
+
+        The grid shape of the node is read by the device from the buffer
+        bound to portName, at offset bytes, as three consecutive uint32 values.
+
+        Parameters
+        ----------
+        portName : str.
+            Name of a Buffer port of this descriptor.
+
+        offset : int. Defaults to 0.
+            Offset in bytes. It must be a multiple of 4.
+        """
+
+        self.__descriptor.setIndirectDispatch(impl.encodeString(portName), offset)
+
+    def disableIndirectDispatch(self):
+        """
+        Disables the indirect-dispatch mode.
+        """
+
+        self.__descriptor.disableIndirectDispatch()
+
     def addPort(self, PortDescriptor portDesc):
 
         self.__descriptor.addPort(portDesc.__descriptor)
@@ -6,6 +6,8 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
+from libc.stdint cimport uint32_t
+
 from libcpp.memory cimport shared_ptr
 from libcpp.string cimport string
 
@@ -30,12 +32,16 @@ cdef extern from 'lluvia/core/node/ContainerNode.h' namespace 'll':
         void bind(const string& name, const shared_ptr[_Object]& obj) except +
 
         shared_ptr[_Node] getNode(const string& name) except +
+        shared_ptr[_Node] getNode(uint32_t index) except +
+        uint32_t getNodeIndex(const string& name) except +
         void bindNode(const string& name, const shared_ptr[_Node]& obj) except +
 
         void setParameter(const string& name, const _Parameter& value)
         const _Parameter& getParameter(const string& name) except +
 
         void init() except +
+        shared_ptr[_ContainerNode] instantiate() except +
+        void reinit() except +
         void record(_CommandBuffer& commandBuffer) except +
 
 
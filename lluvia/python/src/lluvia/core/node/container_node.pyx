@@ -16,7 +16,7 @@ from cython.operator cimport dereference as deref
 
 from lluvia.core import impl
 from lluvia.core.command_buffer cimport CommandBuffer
-from lluvia.core.buffer.buffer cimport Buffer, _Buffer, _buildBuffer
+from lluvia.core.buffer.buffer cimport Buffer, _Buffer, _buildBuffer, BufferView, _BufferView, _buildBufferView
 from lluvia.core.core_object cimport _Object
 
 from lluvia.core.enums.core_object import ObjectType
@@ -78,12 +78,13 @@ cdef class ContainerNode:
         index : str
             Name of the object to bind
 
-        obj : lluvia.Buffer or lluvia.ImageView
+        obj : lluvia.Buffer, lluvia.ImageView or lluvia.BufferView
             Parameter to bind.
         """
 
-        cdef Buffer    buf     = None
-        cdef ImageView imgView = None
+        cdef Buffer     buf     = None
+        cdef ImageView  imgView = None
+        cdef BufferView bufView = None
 
         if type(obj) == Buffer:
             buf = obj
@@ -95,6 +96,11 @@ cdef class ContainerNode:
             self.__node.get().bind(impl.encodeString(name),
                                    static_pointer_cast[_Object](imgView.__imageView))
 
+        if type(obj) == BufferView:
+            bufView = obj
+            self.__node.get().bind(impl.encodeString(name),
+                                   static_pointer_cast[_Object](bufView.__bufferView))
+
     def getPort(self, str name):
 
         cdef shared_ptr[_Object] obj = self.__node.get().getPort(impl.encodeString(name))
@@ -108,11 +114,37 @@ cdef class ContainerNode:
             return _buildImageView(static_pointer_cast[_ImageView](obj),
                                    self.session, None)
 
+        if oType == ObjectType.BufferView:
+            return _buildBufferView(static_pointer_cast[_BufferView](obj),
+                                    self.session, None)
+
         raise RuntimeError('Unsupported object type {0}'.format(oType))
 
-    def getNode(self, str name):
+    def getNodeIndex(self, str name):
+        """
+        Gets the index of a node bound to this container.
+
+        Parameters
+        ----------
+        name : str
+            Name of the node.
+
+        Returns
+        -------
+        index : int
+            Index of the node, which can be passed to getNode().
+        """
+
+        return self.__node.get().getNodeIndex(impl.encodeString(name))
 
-        cdef shared_ptr[_Node] node = self.__node.get().getNode(impl.encodeString(name))
+    def getNode(self, name):
+
+        cdef shared_ptr[_Node] node
+
+        if isinstance(name, int):
+            node = self.__node.get().getNode(<uint32_t> name)
+        else:
+            node = self.__node.get().getNode(impl.encodeString(name))
         cdef NodeType nType = NodeType_t(<uint32_t> node.get().getType())
 
         if nType == NodeType.Compute:
@@ -133,6 +165,49 @@ cdef class ContainerNode:
 
         self.__node.get().init()
 
+    def instantiate(self):
+        """
+        Creates a new instance of this container.
+
+        The instance shares the compute pipelines of this container
+        and records the same commands. Buffers and images written
+        by the container are created again for the instance, as well
+        as parameter blocks, so each instance keeps its own parameters.
+        Objects bound to the ports of the instance before calling init()
+        replace the ones bound to this container.
+
+        Returns
+        -------
+        instance : ContainerNode
+            The new instance, not initialized.
+
+        Raises
+        ------
+        RuntimeError
+            If this container is not initialized.
+        """
+
+        return _buildContainerNode(self.__node.get().instantiate(), self.session)
+
+    def reinit(self):
+        """
+        Configures this container again for the objects bound to its ports.
+
+        Objects bound to the ports since the last initialization
+        replace the previous ones within the container. Images
+        written by the container are reshaped following the first
+        port image whose shape changed, and every compute node
+        configures its grid again. Pipelines are kept. Command
+        buffers recording this container must be recorded again.
+
+        Raises
+        ------
+        RuntimeError
+            If this container is not initialized.
+        """
+
+        self.__node.get().reinit()
+
     def run(self):
         """
         Runs this node
@@ -11,14 +11,22 @@ from libc.stdint cimport uint32_t
 cdef extern from "lluvia/core/node/PortType.h" namespace 'll':
 
     cdef enum _PortType 'll::PortType':
-        _PortType_Buffer           'll::PortType::Buffer'
-        _PortType_ImageView        'll::PortType::ImageView'
-        _PortType_SampledImageView 'll::PortType::SampledImageView'
-        _PortType_UniformBuffer    'll::PortType::UniformBuffer'
+        _PortType_Buffer               'll::PortType::Buffer'
+        _PortType_ImageView            'll::PortType::ImageView'
+        _PortType_SampledImageView     'll::PortType::SampledImageView'
+        _PortType_UniformBuffer        'll::PortType::UniformBuffer'
+        _PortType_UniformBufferDynamic 'll::PortType::UniformBufferDynamic'
+        _PortType_StorageBufferDynamic 'll::PortType::StorageBufferDynamic'
+        _PortType_UniformTexelBuffer   'll::PortType::UniformTexelBuffer'
+        _PortType_StorageTexelBuffer   'll::PortType::StorageTexelBuffer'
 
 
 cpdef enum PortType:
-    Buffer           = <uint32_t> _PortType_Buffer
-    ImageView        = <uint32_t> _PortType_ImageView
-    SampledImageView = <uint32_t> _PortType_SampledImageView
-    UniformBuffer    = <uint32_t> _PortType_UniformBuffer
+    Buffer               = <uint32_t> _PortType_Buffer
+    ImageView            = <uint32_t> _PortType_ImageView
+    SampledImageView     = <uint32_t> _PortType_SampledImageView
+    UniformBuffer        = <uint32_t> _PortType_UniformBuffer
+    UniformBufferDynamic = <uint32_t> _PortType_UniformBufferDynamic
+    StorageBufferDynamic = <uint32_t> _PortType_StorageBufferDynamic
+    UniformTexelBuffer   = <uint32_t> _PortType_UniformTexelBuffer
+    StorageTexelBuffer   = <uint32_t> _PortType_StorageTexelBuffer
@@ -8,6 +8,7 @@
 
 from libc.stdint cimport uint8_t
 
+from libcpp cimport bool
 from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
 
@@ -17,6 +18,8 @@ cdef extern from 'lluvia/core/Program.h' namespace 'll':
     cdef cppclass _Program 'll::Program':
 
         const vector[uint8_t]& getSpirV() const
+        bool hasSpirV() const
+        void releaseSpirV()
 
 
 cdef class Program:
@@ -32,3 +32,22 @@ cdef class Program:
             """
             cdef vector[uint8_t] spirV = self.__program.get().getSpirV()
             return spirV
+
+    property hasSpirV:
+        def __get__(self):
+            """
+            Whether or not the program keeps a host copy of its Spir-V code.
+
+            Programs loaded from libraries do not keep a copy if the
+            session was created with librarySpirVCopy set to False.
+            """
+            return self.__program.get().hasSpirV()
+
+    def releaseSpirV(self):
+        """
+        Releases the host copy of the Spir-V code.
+
+        The program can still be used to create compute nodes.
+        """
+
+        self.__program.get().releaseSpirV()
@@ -6,6 +6,7 @@
     :license: Apache-2 license, see LICENSE for more details.
 """
 
+from libc.stddef cimport size_t
 from libc.stdint cimport uint64_t
 
 from libcpp cimport bool
@@ -14,6 +15,7 @@ from libcpp.memory cimport shared_ptr
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 
+from lluvia.core.buffer.buffer cimport _Buffer, _BufferUsageFlags
 from lluvia.core.memory.memory cimport _Memory
 from lluvia.core.memory.memory_property_flags cimport _MemoryPropertyFlags
 
@@ -26,6 +28,7 @@ from lluvia.core.node.compute_node_descriptor cimport _ComputeNodeDescriptor
 from lluvia.core.node.container_node_descriptor cimport _ContainerNodeDescriptor
 from lluvia.core.node.node_builder_descriptor cimport _NodeBuilderDescriptor
 from lluvia.core.node.container_node cimport _ContainerNode
+from lluvia.core.node.node cimport _Node
 
 from lluvia.core.device.device_descriptor cimport _DeviceDescriptor
 from lluvia.core.program cimport _Program
@@ -39,6 +42,8 @@ cdef extern from 'lluvia/core/SessionDescriptor.h' namespace 'll':
 
         _SessionDescriptor& enableDebug(bool enable)
         bool isDebugEnabled()
+        _SessionDescriptor& enableLibrarySpirVCopy(bool enable)
+        bool isLibrarySpirVCopyEnabled()
 
         _SessionDescriptor& setDeviceDescriptor(const _DeviceDescriptor& deviceDescriptor)
 
@@ -60,8 +65,12 @@ cdef extern from 'lluvia/core/Session.h' namespace 'll':
 
         const _DeviceDescriptor& getDeviceDescriptor()
 
+        size_t getSamplerCount() const
+
         shared_ptr[_Memory] getHostMemory() except +
         shared_ptr[_Memory] getDeviceMemory() except +
+        shared_ptr[_Memory] getReadbackMemory() except +
+        shared_ptr[_Memory] getUploadMemory() except +
 
         shared_ptr[_Memory] createMemory(const _MemoryPropertyFlags& flags, const uint64_t pageSize, bool exactFlagsMatch) except +
         shared_ptr[_Program] createProgram(const string& spirvPath) except +
@@ -83,6 +92,10 @@ cdef extern from 'lluvia/core/Session.h' namespace 'll':
 
         unique_ptr[_CommandBuffer] createCommandBuffer() except +
 
+        bool isHostMemoryImportSupported() const
+        uint64_t getMinImportedHostPointerAlignment() except +
+        shared_ptr[_Buffer] importHostMemory(void* ptr, const uint64_t size, const _BufferUsageFlags usageFlags) except +
+
         void run(const _ComputeNode& node) except +
         void run(const _ContainerNode& node) except +
         void run(const _CommandBuffer& cmdBuffer) except +
@@ -90,7 +103,10 @@ cdef extern from 'lluvia/core/Session.h' namespace 'll':
         void script(const string& code) except +
         void scriptFile(const string& filename) except +
 
-        void loadLibrary(const string& filename) except +
+        void loadLibrary(const string& filename, bool lazy) except +
+
+        void saveGraph(const shared_ptr[_Node]& node, const string& filename, bool includePipelineCache) except +
+        shared_ptr[_Node] loadGraph(const string& filename) except +
 
         _vec3ui getGoodComputeLocalShape(_ComputeDimension dimensions) const
 
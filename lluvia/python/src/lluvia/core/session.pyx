@@ -31,6 +31,11 @@ import lluvia.core.memory as ll_memory
 from lluvia.core.device.device_descriptor cimport DeviceDescriptor, _DeviceDescriptor
 
 # Import all C-types needed by Cython
+from cpython.buffer cimport PyObject_GetBuffer, PyBuffer_Release, PyBUF_WRITABLE, PyBUF_C_CONTIGUOUS
+
+import lluvia.core.buffer as ll_buffer
+from lluvia.core.buffer.buffer cimport Buffer, _BufferUsageFlags, _buildBuffer
+
 from lluvia.core.memory.memory cimport _buildMemory, _Memory, Memory
 from lluvia.core.memory.memory_property_flags cimport _MemoryPropertyFlags
 
@@ -50,9 +55,11 @@ from lluvia.core.node.compute_node_descriptor cimport ComputeNodeDescriptor
 from lluvia.core.node.container_node cimport ContainerNode, _buildContainerNode
 from lluvia.core.node.container_node_descriptor cimport ContainerNodeDescriptor
 from lluvia.core.node.node_builder_descriptor cimport NodeBuilderDescriptor
+from lluvia.core.node.node cimport _Node
 from lluvia.core.node.node_type import NodeType
 
 from lluvia.core.types cimport _vec3ui
+from lluvia.core.impl.stdcpp cimport static_pointer_cast
 
 import lluvia.nodes as llnodes
 import lluvia.glsl.lib as llGslsLib
@@ -89,7 +96,7 @@ def getAvailableDevices():
     return output
 
 
-def createSession(bool enableDebug = False, bool loadNodeLibrary = True, DeviceDescriptor device = None):
+def createSession(bool enableDebug = False, bool loadNodeLibrary = True, DeviceDescriptor device = None, bool librarySpirVCopy = True):
     """
     Creates a new lluvia.Session object.
 
@@ -111,6 +118,11 @@ def createSession(bool enableDebug = False, bool loadNodeLibrary = True, DeviceD
         The device used to create the session from. If None, the session will
         be created from the first device available in getAvailableDevices.
 
+    librarySpirVCopy : bool defaults to True.
+        Whether or not programs loaded from libraries keep a host copy
+        of their Spir-V code, see Program.spirV. Disable it to read
+        uncompressed library entries in place.
+
     Returns
     -------
     session : Session.
@@ -123,6 +135,7 @@ def createSession(bool enableDebug = False, bool loadNodeLibrary = True, DeviceD
 
     cdef _SessionDescriptor desc = _SessionDescriptor()
     desc.enableDebug(enableDebug)
+    desc.enableLibrarySpirVCopy(librarySpirVCopy)
 
     if device is not None:
         desc.setDeviceDescriptor(device.__desc)
@@ -151,6 +164,16 @@ cdef class Session:
             desc.__desc = self.__session.get().getDeviceDescriptor()
             return desc
 
+    property samplerCount:
+        def __get__(self):
+            """
+            Number of Vulkan samplers allocated by this session.
+
+            Image views with the same sampler configuration share
+            a single sampler.
+            """
+            return self.__session.get().getSamplerCount()
+
     def getSupportedMemoryPropertyFlags(self):
         """
         Returns the supported memory property flags for
@@ -214,6 +237,39 @@ cdef class Session:
 
         return mem
 
+    def getReadbackMemory(self):
+        """
+        Returns a host-visible memory object optimized for reading device
+        data on the host. It prefers HostCached memory types. This memory
+        should be used for staging buffers of device to host transfers.
+
+        Returns
+        -------
+        mem : ll.Memory
+        """
+
+        cdef Memory mem = Memory()
+        mem.__memory = self.__session.get().getReadbackMemory()
+
+        return mem
+
+    def getUploadMemory(self):
+        """
+        Returns a host-visible memory object optimized for writing data
+        from the host. It prefers uncached, write-combined, memory types.
+        This memory should be used for staging buffers of host to device
+        transfers.
+
+        Returns
+        -------
+        mem : ll.Memory
+        """
+
+        cdef Memory mem = Memory()
+        mem.__memory = self.__session.get().getUploadMemory()
+
+        return mem
+
     def createMemory(self,
                      flags=ll_memory.MemoryPropertyFlagBits.DeviceLocal,
                      uint64_t pageSize=33554432L,
@@ -512,6 +568,74 @@ cdef class Session:
 
         return _buildContainerNode(self.__session.get().createContainerNode(d.__descriptor), self)
 
+    property hostMemoryImportSupported:
+        def __get__(self):
+            """
+            Whether host memory can be imported with importHostMemory().
+            """
+            return self.__session.get().isHostMemoryImportSupported()
+
+    property minImportedHostPointerAlignment:
+        def __get__(self):
+            """
+            Alignment in bytes required for the address and size of imported host memory.
+            """
+            return self.__session.get().getMinImportedHostPointerAlignment()
+
+    def importHostMemory(self, obj,
+                         usageFlags=[ll_buffer.BufferUsageFlagBits.StorageBuffer,
+                                     ll_buffer.BufferUsageFlagBits.TransferSrc,
+                                     ll_buffer.BufferUsageFlagBits.TransferDst]):
+        """
+        Creates a buffer aliasing the memory of a host object, without copying it.
+
+        The buffer keeps a reference to obj. Changes made by the device through the
+        buffer are visible in obj once the commands using the buffer complete.
+
+
+        Parameters
+        ----------
+        obj : object supporting the buffer protocol, such as np.ndarray.
+            Writable and C-contiguous host object. Its address and size in
+            bytes must be multiples of minImportedHostPointerAlignment.
+
+        usageFlags : BufferUsageFlagBits or list of BufferUsageFlagBits.
+            Defaults to:
+                [BufferUsageFlagBits.StorageBuffer,
+                 BufferUsageFlagBits.TransferSrc,
+                 BufferUsageFlagBits.TransferDst]
+            Usage flags for this buffer.
+
+
+        Returns
+        -------
+        buf : lluvia.Buffer object.
+
+
+        Raises
+        ------
+        RuntimeError : if the extension VK_EXT_external_memory_host is not
+            supported or obj is not aligned.
+        """
+
+        cdef uint32_t flattenFlags = impl.flattenFlagBits(usageFlags, ll_buffer.BufferUsageFlagBits)
+        cdef _BufferUsageFlags _usageFlags = <_BufferUsageFlags> flattenFlags
+
+        # the memoryview holds an export of obj, preventing it from being resized
+        hostView = memoryview(obj)
+
+        cdef Py_buffer view
+        PyObject_GetBuffer(hostView, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS)
+
+        cdef Buffer buf
+        try:
+            buf = _buildBuffer(self.__session.get().importHostMemory(view.buf, view.len, _usageFlags), self, None)
+        finally:
+            PyBuffer_Release(&view)
+
+        buf.__hostObject = hostView
+        return buf
+
     def createDuration(self):
         """
         Creates a Duration object.
@@ -564,7 +688,7 @@ cdef class Session:
 
         self.__session.get().scriptFile(impl.encodeString(filename))
 
-    def loadLibrary(self, str filename):
+    def loadLibrary(self, str filename, bool lazy=False):
         """
         Loads a library made of SPIR-V shader code and Lua scripts.
 
@@ -574,13 +698,86 @@ cdef class Session:
             Path to the library file. The file must be a valid
             zip archive.
 
+        lazy : bool. Defaults to False.
+            If True, only the archive's central directory is read. Programs
+            and node builders are decompressed and loaded on first use.
+
         Raises
         ------
         RuntimeError
             If there is problem reading the library file.
         """
 
-        self.__session.get().loadLibrary(impl.encodeString(filename))
+        self.__session.get().loadLibrary(impl.encodeString(filename), lazy)
+
+    def saveGraph(self, node, str filename, bool includePipelineCache=True):
+        """
+        Saves an initialized node graph into a file.
+
+        The graph can be created again with loadGraph() without
+        running any node builder.
+
+        Parameters
+        ----------
+        node : ComputeNode or ContainerNode
+            The root node of the graph. Every node in the graph
+            must be initialized.
+
+        filename : str
+            Path of the file.
+
+        includePipelineCache : bool. Defaults to True.
+            Whether to save the content of the device pipeline cache.
+
+        Raises
+        ------
+        RuntimeError
+            If the graph cannot be saved or there is a problem writing the file.
+        """
+
+        cdef ComputeNode computeNode = None
+        cdef ContainerNode containerNode = None
+        cdef shared_ptr[_Node] root
+
+        if type(node) == ComputeNode:
+            computeNode = node
+            root = static_pointer_cast[_Node](computeNode.__node)
+
+        elif type(node) == ContainerNode:
+            containerNode = node
+            root = static_pointer_cast[_Node](containerNode.__node)
+
+        else:
+            raise RuntimeError('Unsupported node type {0}'.format(type(node)))
+
+        self.__session.get().saveGraph(root, impl.encodeString(filename), includePipelineCache)
+
+    def loadGraph(self, str filename):
+        """
+        Loads a node graph saved by saveGraph().
+
+        Parameters
+        ----------
+        filename : str
+            Path of the file.
+
+        Returns
+        -------
+        node : ComputeNode or ContainerNode
+            The root node of the graph, already initialized.
+
+        Raises
+        ------
+        RuntimeError
+            If the file is not a valid graph snapshot.
+        """
+
+        cdef shared_ptr[_Node] node = self.__session.get().loadGraph(impl.encodeString(filename))
+
+        if <uint32_t> node.get().getType() == <uint32_t> NodeType.Compute.value:
+            return _buildComputeNode(static_pointer_cast[_ComputeNode](node), self)
+
+        return _buildContainerNode(static_pointer_cast[_ContainerNode](node), self)
 
     def run(self, obj):
         """
@@ -19,6 +19,20 @@ def test_load_library():
     assert(not session.hasReceivedVulkanWarningMessages())
 
 
+def test_lazy_load_library():
+
+    session = ll.createSession(enableDebug=True, loadNodeLibrary = False)
+    session.loadLibrary('lluvia/cpp/core/test/nodes/test_node_library.zip', lazy=True)
+
+    program = session.getProgram('nodes/Assign.comp')
+    assert(program != None)
+
+    node = session.createComputeNode("nodes/Assign")
+    assert(node != None)
+
+    assert(not session.hasReceivedVulkanWarningMessages())
+
+
 if __name__ == "__main__":
 
     raise SystemExit(pytest.main([__file__]))